@@ -101,7 +101,57 @@ FString GetCommonRootPath(TArray<FPakInputPair>& FilesToAdd)
 }
 
 
-bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInputPair& InFile, uint8*& InOutPersistentBuffer, int64& InOutBufferSize, FPakEntryPair& OutNewEntry)
+/**
+ * Settings controlling how file data is stored in pak.
+ */
+struct FPakCompressionSettings
+{
+	/** Compression method used for new entries, COMPRESS_None to store files uncompressed. */
+	ECompressionFlags CompressionMethod;
+	/** Uncompressed size of a single compression block. */
+	int32 CompressionBlockSize;
+
+	FPakCompressionSettings()
+		: CompressionMethod(COMPRESS_None)
+		, CompressionBlockSize(64 * 1024)
+	{}
+};
+
+/**
+ * Compresses file data into fixed-size blocks. Block offsets are filled in relative to the start of the compressed data.
+ *
+ * @return true if the compressed data is smaller than the source data, false if the file should be stored uncompressed.
+ */
+bool CompressFileData(const FPakCompressionSettings& Settings, const uint8* Data, int64 DataSize, TArray<uint8>& OutCompressedData, FPakEntry& OutEntry)
+{
+	const int32 NumBlocks = (int32)((DataSize + Settings.CompressionBlockSize - 1) / Settings.CompressionBlockSize);
+	// Worst case zlib expansion of a single block.
+	const int32 MaxCompressedBlockSize = Settings.CompressionBlockSize + (Settings.CompressionBlockSize >> 12) + (Settings.CompressionBlockSize >> 14) + 13;
+
+	OutCompressedData.Reset();
+	OutEntry.CompressionBlocks.Empty(NumBlocks);
+	for (int32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++)
+	{
+		const int64 BlockStart = (int64)BlockIndex * Settings.CompressionBlockSize;
+		const int32 UncompressedBlockSize = (int32)FMath::Min<int64>(Settings.CompressionBlockSize, DataSize - BlockStart);
+		const int32 CompressedStart = OutCompressedData.Num();
+		int32 CompressedBlockSize = MaxCompressedBlockSize;
+		OutCompressedData.AddUninitialized(MaxCompressedBlockSize);
+		if (!FCompression::CompressMemory(Settings.CompressionMethod, OutCompressedData.GetData() + CompressedStart, CompressedBlockSize, Data + BlockStart, UncompressedBlockSize))
+		{
+			return false;
+		}
+		OutCompressedData.SetNum(CompressedStart + CompressedBlockSize, false);
+
+		FPakCompressedBlock Block;
+		Block.CompressedStart = CompressedStart;
+		Block.CompressedEnd = CompressedStart + CompressedBlockSize;
+		OutEntry.CompressionBlocks.Add(Block);
+	}
+	return OutCompressedData.Num() < DataSize;
+}
+
+bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInputPair& InFile, const FPakCompressionSettings& InCompression, uint8*& InOutPersistentBuffer, int64& InOutBufferSize, TArray<uint8>& InOutCompressedBuffer, FPakEntryPair& OutNewEntry)
 {	
 	TAutoPtr<FArchive> FileHandle(IFileManager::Get().CreateFileReader(*InFile.Source));
 	bool bFileExists = FileHandle.IsValid();
@@ -112,7 +162,7 @@ bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInput
 		OutNewEntry.Info.Offset = 0; // Don't serialize offsets here.
 		OutNewEntry.Info.Size = FileSize;
 		OutNewEntry.Info.UncompressedSize = FileSize;
-		OutNewEntry.Info.CompressionMethod = 0;
+		OutNewEntry.Info.CompressionMethod = COMPRESS_None;
 
 		if (InOutBufferSize < FileSize)
 		{
@@ -122,12 +172,37 @@ bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInput
 
 		// Load to buffer
 		FileHandle->Serialize(InOutPersistentBuffer, FileSize);
+
+		const uint8* DataToWrite = InOutPersistentBuffer;
+		if (InCompression.CompressionMethod != COMPRESS_None && FileSize > 0)
+		{
+			if (CompressFileData(InCompression, InOutPersistentBuffer, FileSize, InOutCompressedBuffer, OutNewEntry.Info))
+			{
+				OutNewEntry.Info.CompressionMethod = InCompression.CompressionMethod;
+				OutNewEntry.Info.CompressionBlockSize = InCompression.CompressionBlockSize;
+				OutNewEntry.Info.Size = InOutCompressedBuffer.Num();
+				// Block offsets are stored relative to the start of the entry so they need to skip the entry header.
+				const int64 HeaderSize = OutNewEntry.Info.GetSerializedSize(FPakInfo::PakFile_Version_Latest);
+				for (int32 BlockIndex = 0; BlockIndex < OutNewEntry.Info.CompressionBlocks.Num(); BlockIndex++)
+				{
+					OutNewEntry.Info.CompressionBlocks[BlockIndex].CompressedStart += HeaderSize;
+					OutNewEntry.Info.CompressionBlocks[BlockIndex].CompressedEnd += HeaderSize;
+				}
+				DataToWrite = InOutCompressedBuffer.GetData();
+			}
+			else
+			{
+				// Compression didn't pay off, store the file as is.
+				OutNewEntry.Info.CompressionBlocks.Empty();
+			}
+		}
+
 		// Calculate the buffer hash value
-		FSHA1::HashBuffer(InOutPersistentBuffer, FileSize, OutNewEntry.Info.Hash);
+		FSHA1::HashBuffer(DataToWrite, OutNewEntry.Info.Size, OutNewEntry.Info.Hash);
 
 		// Write to file
 		OutNewEntry.Info.Serialize(InPak, FPakInfo::PakFile_Version_Latest);
-		InPak.Serialize(InOutPersistentBuffer, FileSize);
+		InPak.Serialize((void*)DataToWrite, OutNewEntry.Info.Size);
 	}
 	return bFileExists;
 }
@@ -399,7 +474,7 @@ FArchive* CreatePakWriter(const TCHAR* Filename)
 	return Writer;
 }
 
-bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
+bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd, const FPakCompressionSettings& CompressionSettings)
 {	
 	const double StartTime = FPlatformTime::Seconds();
 
@@ -416,18 +491,28 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 	FString MountPoint = GetCommonRootPath(FilesToAdd);
 	uint8* ReadBuffer = NULL;
 	int64 BufferSize = 0;
+	TArray<uint8> CompressedBuffer;
+	int64 TotalUncompressedSize = 0;
 
 	for (int32 FileIndex = 0; FileIndex < FilesToAdd.Num(); FileIndex++)
 	{
 		//  Remember the offset but don't serialize it with the entry header.
 		const int64 NewEntryOffset = PakFileHandle->Tell();
 		FPakEntryPair NewEntry;
-		if (CopyFileToPak(*PakFileHandle, MountPoint, FilesToAdd[FileIndex], ReadBuffer, BufferSize, NewEntry) == true)
+		if (CopyFileToPak(*PakFileHandle, MountPoint, FilesToAdd[FileIndex], CompressionSettings, ReadBuffer, BufferSize, CompressedBuffer, NewEntry) == true)
 		{
 			// Update offset now and store it in the index (and only in index)
 			NewEntry.Info.Offset = NewEntryOffset;
 			Index.Add(NewEntry);
-			UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes."), *NewEntry.Filename, NewEntry.Info.Size);
+			TotalUncompressedSize += NewEntry.Info.UncompressedSize;
+			if (NewEntry.Info.IsCompressed())
+			{
+				UE_LOG(LogPakFile, Display, TEXT("Added compressed file \"%s\", %lld bytes (%lld uncompressed, %d blocks)."), *NewEntry.Filename, NewEntry.Info.Size, NewEntry.Info.UncompressedSize, NewEntry.Info.CompressionBlocks.Num());
+			}
+			else
+			{
+				UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes."), *NewEntry.Filename, NewEntry.Info.Size);
+			}
 		}
 		else
 		{
@@ -454,6 +539,15 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 		IndexWriter << Entry.Filename;
 		Entry.Info.Serialize(IndexWriter, Info.Version);
 	}
+	// Precompute filename hashes so the runtime doesn't need to build lookup maps from strings.
+	TArray<FPakPathHashEntry> PathHashIndex;
+	PathHashIndex.Empty(Index.Num());
+	for (int32 EntryIndex = 0; EntryIndex < Index.Num(); EntryIndex++)
+	{
+		PathHashIndex.Add(FPakPathHashEntry(FPakFile::HashPath(*Index[EntryIndex].Filename), EntryIndex));
+	}
+	PathHashIndex.Sort();
+	IndexWriter << PathHashIndex;
 	PakFileHandle->Serialize(IndexData.GetData(), IndexData.Num());
 
 	FSHA1::HashBuffer(IndexData.GetData(), IndexData.Num(), Info.IndexHash);
@@ -462,7 +556,7 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 	// Save trailer (offset, size, hash value)
 	Info.Serialize(*PakFileHandle);
 
-	UE_LOG(LogPakFile, Display, TEXT("Added %d files, %lld bytes total, time %.2lfs."), Index.Num(), PakFileHandle->TotalSize(), FPlatformTime::Seconds() - StartTime);
+	UE_LOG(LogPakFile, Display, TEXT("Added %d files, %lld bytes total (%lld bytes uncompressed), time %.2lfs."), Index.Num(), PakFileHandle->TotalSize(), TotalUncompressedSize, FPlatformTime::Seconds() - StartTime);
 
 	PakFileHandle->Close();
 	PakFileHandle.Reset();
@@ -550,8 +644,50 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
 				TAutoPtr<FArchive> FileHandle(IFileManager::Get().CreateFileWriter(*DestFilename));
 				if (FileHandle.IsValid())
 				{
-					BufferedCopyFile(*FileHandle, PakReader, Entry.Size, Buffer, BufferSize);
-					UE_LOG(LogPakFile, Display, TEXT("Extracted \"%s\" to \"%s\"."), *It.Filename(), *DestFilename);
+					bool bExtracted = true;
+					if (Entry.IsCompressed())
+					{
+						if (PakFile.GetInfo().Version < FPakInfo::PakFile_Version_CompressionBlocks)
+						{
+							UE_LOG(LogPakFile, Error, TEXT("Unable to extract \"%s\", compressed entries in pak version %d are not supported."), *It.Filename(), PakFile.GetInfo().Version);
+							bExtracted = false;
+						}
+						else if (!Entry.HasValidCompressionBlocks(PakFile.TotalSize()))
+						{
+							UE_LOG(LogPakFile, Error, TEXT("Unable to extract \"%s\", its compression blocks are corrupted."), *It.Filename());
+							bExtracted = false;
+						}
+						else
+						{
+							// Let the pak handle inflate the data block by block.
+							FPakFileHandle EntryHandle(PakFile, Entry, &PakReader, true);
+							int64 RemainingSizeToCopy = Entry.UncompressedSize;
+							while (RemainingSizeToCopy > 0)
+							{
+								const int64 SizeToCopy = FMath::Min(BufferSize, RemainingSizeToCopy);
+								if (!EntryHandle.Read((uint8*)Buffer, SizeToCopy))
+								{
+									UE_LOG(LogPakFile, Error, TEXT("Unable to decompress \"%s\"."), *It.Filename());
+									bExtracted = false;
+									break;
+								}
+								FileHandle->Serialize(Buffer, SizeToCopy);
+								RemainingSizeToCopy -= SizeToCopy;
+							}
+						}
+					}
+					else
+					{
+						BufferedCopyFile(*FileHandle, PakReader, Entry.Size, Buffer, BufferSize);
+					}
+					if (bExtracted)
+					{
+						UE_LOG(LogPakFile, Display, TEXT("Extracted \"%s\" to \"%s\"."), *It.Filename(), *DestFilename);
+					}
+					else
+					{
+						ErrorCount++;
+					}
 				}
 				else
 				{
@@ -587,6 +723,8 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
  *   -Sign=filename use the key pair in filename to sign a pak file, or: -sign=key_hex_values_separated_with_+, i.e: -sign=0x123456789abcdef+0x1234567+0x12345abc
  *    where the first number is the private key exponend, the second one is modulus and the third one is the public key exponent.
  *   -Signed use with -extract and -test to let the code know this is a signed pak
+ *   -Compress compresses files added to pak in independently decompressable blocks (files that don't shrink are stored uncompressed)
+ *   -CompressionBlockSize=bytes uncompressed size of a single compression block (default is 64KB)
  *   -GenerateKeys=filename generates encryption key pair for signing a pak file
  *   -P=prime will use a predefined prime number for generating encryption key file
  *   -Q=prime same as above, P != Q, GCD(P, Q) = 1 (which is always true if they're both prime)
@@ -660,7 +798,15 @@ int32 main(int32 ArgC, ANSICHAR* ArgV[])
 				TArray<FPakInputPair> FilesToAdd;
 				CollectFilesToAdd(FilesToAdd, Entries, OrderMap);
 
-				Result = CreatePakFile(*PakFilename, FilesToAdd) ? 0 : 1;
+				FPakCompressionSettings CompressionSettings;
+				if (FParse::Param(FCommandLine::Get(), TEXT("Compress")))
+				{
+					CompressionSettings.CompressionMethod = COMPRESS_Default;
+					FParse::Value(FCommandLine::Get(), TEXT("CompressionBlockSize="), CompressionSettings.CompressionBlockSize);
+					CompressionSettings.CompressionBlockSize = FMath::Clamp<int32>(CompressionSettings.CompressionBlockSize, 4 * 1024, FCompression::MaxUncompressedSize);
+				}
+
+				Result = CreatePakFile(*PakFilename, FilesToAdd, CompressionSettings) ? 0 : 1;
 			}
 		}
 	}
@@ -0,0 +1,168 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ParallelFor.cpp: Data parallel loops on top of the TaskGraph
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "ParallelFor.h"
+
+static TAutoConsoleVariable<int32> CVarParallelForSingleThread(
+	TEXT("ParallelFor.SingleThread"),
+	0,
+	TEXT("If non-zero, ParallelFor runs every loop on the calling thread."));
+
+enum
+{
+	/** Number of chunks to aim for per participating thread. More chunks balance uneven work better, fewer chunks have less overhead. **/
+	PARALLELFOR_CHUNKS_PER_THREAD = 4
+};
+
+/**
+ *	Shared state of a single ParallelFor call.
+ *	Reference counted, because helper tasks can start after the loop has already completed; they then find no work and just release.
+ **/
+class FParallelForData
+{
+public:
+	FParallelForData(const IParallelForBody& InBody, int32 InNum, int32 InChunkSize, int32 InNumChunks, int32 InNumReferences)
+		: Body(InBody)
+		, Num(InNum)
+		, ChunkSize(InChunkSize)
+		, NumChunks(InNumChunks)
+		, CompletedEvent(FPlatformProcess::CreateSynchEvent(true))
+	{
+		ChunksRemaining.Set(NumChunks);
+		NumReferences.Set(InNumReferences);
+	}
+
+	~FParallelForData()
+	{
+		delete CompletedEvent;
+		CompletedEvent = NULL;
+	}
+
+	/** Claims and processes chunks until there are none left. **/
+	void Process()
+	{
+		while (1)
+		{
+			const int32 ChunkIndex = NextChunk.Increment() - 1;
+			if (ChunkIndex >= NumChunks)
+			{
+				break;
+			}
+			const int32 StartIndex = ChunkIndex * ChunkSize;
+			const int32 EndIndex = FMath::Min<int32>(StartIndex + ChunkSize, Num);
+			Body.ExecuteRange(StartIndex, EndIndex);
+			if (ChunksRemaining.Decrement() == 0)
+			{
+				CompletedEvent->Trigger();
+			}
+		}
+	}
+
+	/** Blocks until every chunk has been processed. Only called by the thread that started the loop. **/
+	void WaitForCompletion()
+	{
+		if (ChunksRemaining.GetValue() != 0)
+		{
+			CompletedEvent->Wait();
+		}
+		checkSlow(ChunksRemaining.GetValue() == 0);
+	}
+
+	/** Drops a reference and deletes the shared state if it was the last one. **/
+	void Release()
+	{
+		if (NumReferences.Decrement() == 0)
+		{
+			delete this;
+		}
+	}
+
+private:
+	/** Loop body, only touched while there are unclaimed chunks, so it is still alive on the calling thread's stack **/
+	const IParallelForBody&	Body;
+	/** Total number of indices **/
+	int32					Num;
+	/** Number of indices per chunk, the last chunk may be smaller **/
+	int32					ChunkSize;
+	/** Total number of chunks **/
+	int32					NumChunks;
+	/** Next chunk to hand out **/
+	FThreadSafeCounter		NextChunk;
+	/** Number of chunks not yet completed **/
+	FThreadSafeCounter		ChunksRemaining;
+	/** One for the calling thread and one per helper task **/
+	FThreadSafeCounter		NumReferences;
+	/** Triggered when ChunksRemaining drops to zero **/
+	FEvent*					CompletedEvent;
+};
+
+/** Task that helps the calling thread process the chunks of a ParallelFor **/
+class FParallelForTask
+{
+public:
+	FParallelForTask(FParallelForData* InData)
+		: Data(InData)
+	{
+	}
+	static const TCHAR* GetTaskName()
+	{
+		return TEXT("FParallelForTask");
+	}
+	FORCEINLINE static TStatId GetStatId()
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FParallelForTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::FireAndForget;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Data->Process();
+		Data->Release();
+	}
+private:
+	FParallelForData* Data;
+};
+
+void ParallelForInternal(int32 Num, const IParallelForBody& Body, int32 MinBatchSize, uint32 Flags)
+{
+	if (Num <= 0)
+	{
+		return;
+	}
+	const bool bSingleThread = (Flags & EParallelForFlags::ForceSingleThread) != 0
+		|| CVarParallelForSingleThread.GetValueOnAnyThread() != 0
+		|| !FPlatformProcess::SupportsMultithreading();
+	const int32 NumWorkers = bSingleThread ? 0 : FTaskGraphInterface::Get().GetNumWorkerThreads();
+
+	// split into a few chunks per thread so that threads that finish early can pick up more work, but never below the requested batch size
+	const int32 TargetNumChunks = (NumWorkers + 1) * PARALLELFOR_CHUNKS_PER_THREAD;
+	const int32 ChunkSize = FMath::Max<int32>(FMath::Max<int32>(MinBatchSize, 1), FMath::DivideAndRoundUp<int32>(Num, TargetNumChunks));
+	const int32 NumChunks = FMath::DivideAndRoundUp<int32>(Num, ChunkSize);
+	const int32 NumHelpers = FMath::Min<int32>(NumWorkers, NumChunks - 1);
+
+	if (NumHelpers <= 0)
+	{
+		Body.ExecuteRange(0, Num);
+		return;
+	}
+
+	FParallelForData* Data = new FParallelForData(Body, Num, ChunkSize, NumChunks, NumHelpers + 1);
+	const ETaskPriority::Type Priority = (Flags & EParallelForFlags::BackgroundPriority) ? ETaskPriority::Background : ETaskPriority::High;
+	for (int32 HelperIndex = 0; HelperIndex < NumHelpers; HelperIndex++)
+	{
+		TGraphTask<FParallelForTask>::CreateTask(NULL, ENamedThreads::AnyThread, Priority).ConstructAndDispatchWhenReady(Data);
+	}
+	Data->Process();
+	Data->WaitForCompletion();
+	Data->Release();
+}
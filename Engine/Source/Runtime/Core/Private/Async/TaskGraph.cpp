@@ -3,6 +3,7 @@
 
 #include "CorePrivate.h"
 #include "TaskGraphInterfaces.h"
+#include "WorkStealingQueue.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogTaskGraph, Log, All);
 
@@ -12,6 +13,13 @@ DEFINE_STAT(STAT_FTriggerEventGraphTask);
 DEFINE_STAT(STAT_FSimpleDelegateGraphTask);
 DEFINE_STAT(STAT_FDelegateGraphTask);
 
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("High Priority Queue Latency (ms)"), STAT_TaskGraph_HighPriorityLatency, STATGROUP_TaskGraphTasks);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Normal Priority Queue Latency (ms)"), STAT_TaskGraph_NormalPriorityLatency, STATGROUP_TaskGraphTasks);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Background Priority Queue Latency (ms)"), STAT_TaskGraph_BackgroundPriorityLatency, STATGROUP_TaskGraphTasks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("High Priority Tasks"), STAT_TaskGraph_HighPriorityTasks, STATGROUP_TaskGraphTasks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Normal Priority Tasks"), STAT_TaskGraph_NormalPriorityTasks, STATGROUP_TaskGraphTasks);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Background Priority Tasks"), STAT_TaskGraph_BackgroundPriorityTasks, STATGROUP_TaskGraphTasks);
+
 namespace ENamedThreads
 {
 	CORE_API Type RenderThread = ENamedThreads::GameThread; // defaults to game and is set and reset by the render thread itself
@@ -269,22 +277,14 @@ public:
 					// because of stealing, we are only going to take one item
 					for (int32 Count = SPIN_COUNT + 1; !Task && Count ; Count--)
 					{
-						Task = Queue(QueueIndex).IncomingQueue.PopIfNotClosed();
-						if (!Task)
-						{
-							Task = FindWork();
-						}
+						Task = FindWorkByPriority();
 					}
 					if (FPlatformProcess::SupportsMultithreading())
 					{
 						for (int32 Count = SLEEP_COUNT; !Task && Count ; Count--)
 						{
 							FPlatformProcess::Sleep(0.0f);
-							Task = Queue(QueueIndex).IncomingQueue.PopIfNotClosed();
-							if (!Task)
-							{
-								Task = FindWork();
-							}
+							Task = FindWorkByPriority();
 						}
 					}
 					if (!Task)
@@ -298,12 +298,18 @@ public:
 								bTasksOpen = false;
 							}
 #endif
-							if (Stall(QueueIndex))
+							if (StallWorker())
 							{
-								Task = Queue(QueueIndex).IncomingQueue.PopIfNotClosed();
+								Task = FindWorkByPriority();
 							}
 						}
 					}
+#if STATS
+					if (Task)
+					{
+						RecordQueueLatency(Task);
+					}
+#endif
 				}
 			}
 			if (Task)
@@ -344,8 +350,15 @@ public:
 		checkThreadGraph(Queue(QueueIndex).StallRestartEvent); // make sure we are started up
 		if (bAllowsStealsFromMe)
 		{
-			bool bWasReopenedByMe = Queue(QueueIndex).IncomingQueue.ReopenIfClosedAndPush(Task);
-			checkThreadGraph(!bWasReopenedByMe); // if I am stalled, why am I here?
+			checkThreadGraph(!IsStalled.GetValue()); // if I am stalled, why am I here?
+			checkThreadGraph((FTaskThread*)FPlatformTLS::GetTlsValue(PerThreadIDTLSSlot) == this); // only the owner may push to the local deque
+			if (!LocalQueues[Task->Priority].Push(Task))
+			{
+				// deque is full, the shared queue is still stealable
+				Queue(QueueIndex).PriorityQueues[Task->Priority].Push(Task);
+			}
+			// other workers may have stalled while I was busy, get one of them to steal
+			NotifyWorkAvailable();
 		}
 		else
 		{
@@ -371,6 +384,33 @@ public:
 		Queue(QueueIndex).StallRestartEvent->Trigger(); 
 	}
 
+	/** 
+	 *	Wake a stalled unnamed thread so that it looks for work to steal.
+	 **/
+	void WakeUp()
+	{
+		checkThreadGraph(bAllowsStealsFromMe);
+		Queue(0).StallRestartEvent->Trigger();
+	}
+
+	/** 
+	 *	Check the (unsafe) status of an unnamed thread's queues.
+	 *	@return true if any of this thread's queues had work.
+	 *	CAUTION the status of the queues can easily change before this routine returns.
+	 **/
+	bool HasQueuedWork() const
+	{
+		checkThreadGraph(bAllowsStealsFromMe);
+		for (int32 Priority = 0; Priority < ETaskPriority::NumPriorities; Priority++)
+		{
+			if (!LocalQueues[Priority].IsEmpty() || !Queue(0).PriorityQueues[Priority].IsEmpty())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	/** 
 	 *	Check the (unsafe) status of a thread.
 	 *	@return true if this thread was idle. 
@@ -397,6 +437,18 @@ public:
 	bool EnqueueFromOtherThread(int32 QueueIndex, FBaseGraphTask* Task)
 	{
 		checkThreadGraph(Queue(QueueIndex).StallRestartEvent); // make sure we are started up
+		if (bAllowsStealsFromMe)
+		{
+			Queue(QueueIndex).PriorityQueues[Task->Priority].Push(Task);
+			// pairs with the barrier in StallWorker; either we see the stall flag or the worker sees our task
+			FPlatformMisc::MemoryBarrier();
+			if (IsStalled.GetValue())
+			{
+				Queue(QueueIndex).StallRestartEvent->Trigger();
+				return true;
+			}
+			return false;
+		}
 		bool bWasReopenedByMe = Queue(QueueIndex).IncomingQueue.ReopenIfClosedAndPush(Task);
 		if (bWasReopenedByMe)
 		{
@@ -407,12 +459,19 @@ public:
 
 	/** 
 	 *	Attempt to give up a task for another thread.
+	 *	@param Priority; Only tasks of this priority are given up.
 	 *	@return Task; Stolen task, if one was found, otherwise NULL.
 	 **/
-	FBaseGraphTask* RequestSteal()
+	FBaseGraphTask* RequestSteal(ETaskPriority::Type Priority)
 	{
 		checkThreadGraph(bAllowsStealsFromMe); 
-		return Queue(0).IncomingQueue.PopIfNotClosed();
+		// oldest first from the local deque, those are the tasks least likely to be in my cache
+		FBaseGraphTask* Task = LocalQueues[Priority].Steal();
+		if (!Task)
+		{
+			Task = Queue(0).PriorityQueues[Priority].Pop();
+		}
+		return Task;
 	}
 
 	/** 
@@ -482,6 +541,8 @@ private:
 		SPIN_COUNT=0,
 		/** The number of times to call FPlatformProcess::Sleep(0) and look for work before deciding to block on the stall event **/
 		SLEEP_COUNT=0,
+		/** Capacity of each local work stealing deque of an unnamed thread. When full, tasks go to the shared queue instead. **/
+		LOCAL_QUEUE_SIZE=512,
 	};
 
 	/** Grouping of the data for an individual queue. **/
@@ -491,10 +552,16 @@ private:
 		FTaskQueue											PrivateQueue;
 		/** 
 		 *	For named threads, this is a queue of thread locked tasks coming from other threads. They are not stealable.
-		 *	For unnamed thread this is the public queue, subject to stealing.
-		 *	In either case this queue is closely related to the stall event. Other threads that reopen the incoming queue must trigger the stall event to allow the thread to run.
+		 *	This queue is closely related to the stall event. Other threads that reopen the incoming queue must trigger the stall event to allow the thread to run.
+		 *	Unnamed threads do not use this queue.
 		**/
 		TReopenableLockFreePointerList<FBaseGraphTask>		IncomingQueue;
+		/** 
+		 *	For unnamed threads, the queues for tasks coming from other threads, one per ETaskPriority, subject to stealing.
+		 *	Tasks queued by the unnamed thread itself go to its local deque instead.
+		 *	Other threads that push here must trigger the stall event if the thread is stalled, see StallWorker.
+		**/
+		TLockFreePointerList<FBaseGraphTask>				PriorityQueues[ETaskPriority::NumPriorities];
 		/** Used to signal the thread to quit when idle. **/
 		FThreadSafeCounter									QuitWhenIdle;
 		/** We need to disallow reentry of the processing loop **/
@@ -548,17 +615,112 @@ private:
 		return false;
 	}
 
+	/**
+	 *	Internal function to block an unnamed thread on the stall wait event.
+	 *	Unlike named threads, the queues are not closed. Instead the stalled flag is raised and the stall hint is published before the queues of all
+	 *	unnamed threads are checked a final time. Threads pushing a task check the flag or the hints after the push, so at least one of the two sides sees the other.
+	 *	@return true if the thread should look for work again; false in the case of a stop request.
+	 */
+	bool StallWorker()
+	{
+		checkThreadGraph(bAllowsStealsFromMe);
+		checkThreadGraph(Queue(0).StallRestartEvent); // make sure we are started up
+		if (Queue(0).QuitWhenIdle.GetValue() == 0)
+		{
+			// @Hack - Only stall when multithreading is enabled.
+			if (FPlatformProcess::SupportsMultithreading())
+			{
+				Queue(0).StallRestartEvent->Reset();
+				int32 NewValue = IsStalled.Increment(); // this is a full barrier
+				checkThreadGraph(NewValue == 1); // there should be no concurrent calls to Stall!
+				NotifyStalling(); // if we find work below, this hint is stale, which is harmless
+				FPlatformMisc::MemoryBarrier();
+				if (!IsAnyWorkQueued())
+				{
+					Queue(0).StallRestartEvent->Wait();
+				}
+				NewValue = IsStalled.Decrement();
+				checkThreadGraph(NewValue == 0); // there should be no concurrent calls to Stall!
+			}
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 *	Internal function for unnamed threads to find the next task. Checks my own queue, then tries to steal, for each priority from high to low.
+	 *	@return New task to process.
+	 */
+	FBaseGraphTask* FindWorkByPriority()
+	{
+		for (int32 Priority = 0; Priority < ETaskPriority::NumPriorities; Priority++)
+		{
+			FBaseGraphTask* Task = LocalQueues[Priority].Pop();
+			if (!Task)
+			{
+				Task = Queue(0).PriorityQueues[Priority].Pop();
+			}
+			if (!Task)
+			{
+				Task = FindWork(ETaskPriority::Type(Priority));
+			}
+			if (Task)
+			{
+				return Task;
+			}
+		}
+		return NULL;
+	}
+
+#if STATS
+	/**
+	 *	Accumulates the time a task spent in the queues of the unnamed threads into the stat for its priority.
+	 *	@param Task; Task that was just removed from a queue.
+	 */
+	void RecordQueueLatency(FBaseGraphTask* Task)
+	{
+		const float LatencyMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - Task->QueuedCycles);
+		switch (Task->Priority)
+		{
+		case ETaskPriority::High:
+			INC_FLOAT_STAT_BY(STAT_TaskGraph_HighPriorityLatency, LatencyMs);
+			INC_DWORD_STAT(STAT_TaskGraph_HighPriorityTasks);
+			break;
+		case ETaskPriority::Normal:
+			INC_FLOAT_STAT_BY(STAT_TaskGraph_NormalPriorityLatency, LatencyMs);
+			INC_DWORD_STAT(STAT_TaskGraph_NormalPriorityTasks);
+			break;
+		default:
+			INC_FLOAT_STAT_BY(STAT_TaskGraph_BackgroundPriorityLatency, LatencyMs);
+			INC_DWORD_STAT(STAT_TaskGraph_BackgroundPriorityTasks);
+			break;
+		}
+	}
+#endif
+
 	/**
 	 *	Internal function to call the system looking for work. Called from this thread.
+	 *	@param Priority; Priority of the queues to steal from.
 	 *	@return New task to process.
 	 */
-	FBaseGraphTask* FindWork();
+	FBaseGraphTask* FindWork(ETaskPriority::Type Priority);
 
 	/**
 	 *	Internal function to notify the that system that I am stalling. This is a hint to give me a job asap.
 	 */
 	void NotifyStalling();
 
+	/**
+	 *	Internal function to notify the system that I pushed a task to my local deque. Wakes a stalled unnamed thread, if any, to steal it.
+	 */
+	void NotifyWorkAvailable();
+
+	/**
+	 *	Internal function to check the queues of all unnamed threads before stalling.
+	 *	@return true if any unnamed thread appears to have queued work.
+	 */
+	bool IsAnyWorkQueued();
+
 	FORCEINLINE FThreadTaskQueue& Queue(int32 QueueIndex)
 	{
 		checkThreadGraph(QueueIndex >= 0 && QueueIndex < ENamedThreads::NumQueues && (!bAllowsStealsFromMe || !QueueIndex)); // range check, unnamed threads cannot use an alternate queue
@@ -572,6 +734,8 @@ private:
 
 	/** Array of queues, only the first one is used for unnamed threads. **/
 	FThreadTaskQueue Queues[ENamedThreads::NumQueues];
+	/** For unnamed threads, work stealing deques for tasks queued by this thread, one per ETaskPriority. I pop LIFO, other threads steal FIFO. **/
+	TWorkStealingQueue<FBaseGraphTask, LOCAL_QUEUE_SIZE> LocalQueues[ETaskPriority::NumPriorities];
 
 	/** Id / Index of this thread. **/
 	ENamedThreads::Type									ThreadId;
@@ -730,7 +894,12 @@ public:
 			CurrentThreadIfKnown = ENamedThreads::GetThreadIndex(CurrentThreadIfKnown);
 			checkThreadGraph(CurrentThreadIfKnown == GetCurrentThread());
 		}
-		if (ThreadToExecuteOn == ENamedThreads::AnyThread)
+		if (ThreadToExecuteOn == ENamedThreads::AnyThread && CurrentThreadIfKnown >= NumNamedThreads)
+		{
+			// tasks spawned by a worker go to its own deque, stalled workers are woken to steal them
+			ThreadToExecuteOn = CurrentThreadIfKnown;
+		}
+		else if (ThreadToExecuteOn == ENamedThreads::AnyThread)
 		{
 			FTaskThread* TempTarget = StalledUnnamedThreads.Pop(); //@todo it is possible that a thread is in the process of stalling and we just missed it, non-fatal, but we could lose a whole task of potential parallelism.
 			if (TempTarget)
@@ -752,6 +921,9 @@ public:
 		}
 		int32 QueueToExecuteOn = ENamedThreads::GetQueueIndex(ThreadToExecuteOn);
 		ThreadToExecuteOn = ENamedThreads::GetThreadIndex(ThreadToExecuteOn);
+#if STATS
+		Task->QueuedCycles = FPlatformTime::Cycles();
+#endif
 		FTaskThread* Target = Target = &Thread(ThreadToExecuteOn);
 		if (ThreadToExecuteOn == CurrentThreadIfKnown)
 		{
@@ -886,9 +1058,10 @@ public:
 	/** 
 	 *	Attempt to steal some work from another thread.
 	 *	@param	ThreadInNeed; Id of the thread requesting work.
+	 *	@param	Priority; Only tasks of this priority are stolen.
 	 *	@return Task that was stolen if any was found.
 	**/
-	FBaseGraphTask* FindWork(ENamedThreads::Type ThreadInNeed)
+	FBaseGraphTask* FindWork(ENamedThreads::Type ThreadInNeed, ETaskPriority::Type Priority)
 	{
 		// this can be called before my constructor is finished
 		for (int32 Pass = 0; Pass < 2; Pass++)
@@ -897,7 +1070,7 @@ public:
 			{
 				if (Pass || !Thread(Test).IsProbablyStalled())
 				{
-					FBaseGraphTask* Task = Thread(Test).RequestSteal();
+					FBaseGraphTask* Task = Thread(Test).RequestSteal(Priority);
 					if (Task)
 					{
 						return Task;
@@ -908,7 +1081,7 @@ public:
 			{
 				if (Pass || !Thread(Test).IsProbablyStalled())
 				{
-					FBaseGraphTask* Task = Thread(Test).RequestSteal();
+					FBaseGraphTask* Task = Thread(Test).RequestSteal(Priority);
 					if (Task)
 					{
 						return Task;
@@ -919,6 +1092,39 @@ public:
 		return NULL;
 	}
 
+	/** 
+	 *	Wake one stalled unnamed thread, if any, after a worker pushed to its local deque.
+	 *	Hints for threads that are no longer stalled are dropped.
+	**/
+	void WakeStalledUnnamedThread()
+	{
+		FPlatformMisc::MemoryBarrier(); // pairs with the barrier in StallWorker; either we see the hint or the stalling thread sees the task
+		while (FTaskThread* Stalled = StalledUnnamedThreads.Pop())
+		{
+			if (Stalled->IsProbablyStalled())
+			{
+				Stalled->WakeUp();
+				break;
+			}
+		}
+	}
+
+	/** 
+	 *	Check the queues of all unnamed threads.
+	 *	@return true if any unnamed thread appears to have queued work.
+	**/
+	bool IsAnyWorkQueued()
+	{
+		for (int32 Index = NumNamedThreads; Index < NumThreads; Index++)
+		{
+			if (Thread(Index).HasQueuedWork())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	/** 
 	 *	Hint from a worker thread that it is stalling.
 	 *	@param	StallingThread; Id of the thread that is stalling.
@@ -999,9 +1205,9 @@ private:
 
 // Implementations of FTaskThread function that require knowledge of FTaskGraphImplementation
 
-FBaseGraphTask* FTaskThread::FindWork()
+FBaseGraphTask* FTaskThread::FindWork(ETaskPriority::Type Priority)
 {
-	return FTaskGraphImplementation::Get().FindWork(ThreadId);
+	return FTaskGraphImplementation::Get().FindWork(ThreadId, Priority);
 }
 
 void FTaskThread::NotifyStalling()
@@ -1009,6 +1215,16 @@ void FTaskThread::NotifyStalling()
 	return FTaskGraphImplementation::Get().NotifyStalling(ThreadId);
 }
 
+void FTaskThread::NotifyWorkAvailable()
+{
+	FTaskGraphImplementation::Get().WakeStalledUnnamedThread();
+}
+
+bool FTaskThread::IsAnyWorkQueued()
+{
+	return FTaskGraphImplementation::Get().IsAnyWorkQueued();
+}
+
 
 
 // Statics in FTaskGraphInterface
@@ -112,3 +112,16 @@ bool FGenericPlatformMemory::UnmapNamedSharedMemoryRegion(FSharedMemoryRegion *
 	UE_LOG(LogHAL, Error, TEXT("FGenericPlatformMemory::UnmapNamedSharedMemoryRegion not implemented on this platform"));
 	return false;
 }
+
+FGenericPlatformMemory::FSharedMemoryRegion * FGenericPlatformMemory::MapFileReadOnly(const TCHAR* Filename)
+{
+	// Not an error, callers are expected to fall back to regular file reads.
+	UE_LOG(LogHAL, Log, TEXT("FGenericPlatformMemory::MapFileReadOnly not implemented on this platform"));
+	return NULL;
+}
+
+bool FGenericPlatformMemory::UnmapFile(FSharedMemoryRegion * MappedFile)
+{
+	UE_LOG(LogHAL, Error, TEXT("FGenericPlatformMemory::UnmapFile not implemented on this platform"));
+	return false;
+}
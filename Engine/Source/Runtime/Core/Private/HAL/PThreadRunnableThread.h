@@ -271,6 +271,8 @@ protected:
 			delete Runnable;
 			Runnable = NULL;
 		}
+		// Give back memory the allocator cached for this thread
+		FMemory::Trim();
 		// Clean ourselves up without waiting
 		ThreadIsRunning = false;
 		return ExitCode;
@@ -100,6 +100,14 @@ SIZE_T FMemory::GetAllocSize( void* Original )
 	return GMalloc->GetAllocationSize( Original, Size ) ? Size : 0;
 }
 
+void FMemory::Trim()
+{
+	if( GMalloc )
+	{
+		GMalloc->Trim();
+	}
+}
+
 void FMemory::TestMemory()
 {
 #if !UE_BUILD_SHIPPING
@@ -11,6 +11,7 @@
 #include <sys/sysinfo.h>
 #include <sys/file.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>		// sysconf
 
 void FLinuxPlatformMemory::Init()
@@ -246,3 +247,63 @@ bool FLinuxPlatformMemory::UnmapNamedSharedMemoryRegion(FSharedMemoryRegion * Me
 
 	return bAllSucceeded;
 }
+
+FGenericPlatformMemory::FSharedMemoryRegion * FLinuxPlatformMemory::MapFileReadOnly(const TCHAR* Filename)
+{
+	FTCHARToUTF8 FilenameUTF8(Filename);
+	int FileFd = open(FilenameUTF8.Get(), O_RDONLY);
+	if (FileFd == -1)
+	{
+		int ErrNo = errno;
+		UE_LOG(LogHAL, Warning, TEXT("open(name='%s', O_RDONLY) failed with errno = %d (%s)"), Filename, ErrNo, 
+			StringCast< TCHAR >(strerror(ErrNo)).Get());
+		return NULL;
+	}
+
+	struct stat FileInfo;
+	if (fstat(FileFd, &FileInfo) == -1 || FileInfo.st_size <= 0)
+	{
+		int ErrNo = errno;
+		UE_LOG(LogHAL, Warning, TEXT("fstat(fd=%d) failed or file '%s' is empty, errno = %d (%s)"), FileFd, Filename, ErrNo, 
+			StringCast< TCHAR >(strerror(ErrNo)).Get());
+		close(FileFd);
+		return NULL;
+	}
+
+	SIZE_T Size = FileInfo.st_size;
+	void *Ptr = mmap(NULL, Size, PROT_READ, MAP_SHARED, FileFd, 0);
+	if (Ptr == MAP_FAILED)
+	{
+		int ErrNo = errno;
+		UE_LOG(LogHAL, Warning, TEXT("mmap(addr=NULL, length=%llu, prot=PROT_READ, flags=MAP_SHARED, fd=%d, 0) failed with errno = %d (%s)"), (uint64)Size, FileFd, ErrNo, 
+			StringCast< TCHAR >(strerror(ErrNo)).Get());
+		close(FileFd);
+		return NULL;
+	}
+
+	// the mapping stays valid after the descriptor is closed
+	close(FileFd);
+	return new FLinuxSharedMemoryRegion(Filename, FPlatformMemory::ESharedMemoryAccess::Read, Ptr, Size, -1, false);
+}
+
+bool FLinuxPlatformMemory::UnmapFile(FSharedMemoryRegion * MappedFile)
+{
+	bool bSucceeded = true;
+
+	if (MappedFile)
+	{
+		if (munmap(MappedFile->GetAddress(), MappedFile->GetSize()) == -1) 
+		{
+			bSucceeded = false;
+
+			int ErrNo = errno;
+			UE_LOG(LogHAL, Warning, TEXT("munmap(addr=%p, len=%llu) failed with errno = %d (%s)"), MappedFile->GetAddress(), (uint64)MappedFile->GetSize(), ErrNo, 
+				StringCast< TCHAR >(strerror(ErrNo)).Get());
+		}
+
+		// delete the region
+		delete static_cast< FLinuxSharedMemoryRegion* >( MappedFile );
+	}
+
+	return bSucceeded;
+}
@@ -207,4 +207,45 @@ bool FTransform::DebugEqualMatrix(const FMatrix& Matrix) const
 	return true;
 }
 
+void FTransform::BlendIndexed(FTransform* Dest, const FTransform* const* Sources, int32 NumSources, const float* Weights, bool bPerIndexWeights, const uint16* Indices, int32 NumIndices, bool bNormalizeRotation)
+{
+	check(NumSources > 0);
+
+	// With shared weights every index reads the same ones
+	const int32 WeightStride = bPerIndexWeights ? NumSources : 0;
+
+	for (int32 Index = 0; Index < NumIndices; ++Index)
+	{
+		const int32 AtomIndex = Indices[Index];
+		const float* AtomWeights = Weights + Index * WeightStride;
+
+		FTransform Blended = Sources[0][AtomIndex] * AtomWeights[0];
+		for (int32 SourceIndex = 1; SourceIndex < NumSources; ++SourceIndex)
+		{
+			Blended.AccumulateWithShortestRotation(Sources[SourceIndex][AtomIndex], AtomWeights[SourceIndex]);
+		}
+
+		if (bNormalizeRotation)
+		{
+			Blended.NormalizeRotation();
+		}
+		Dest[AtomIndex] = Blended;
+	}
+}
+
+void FTransform::BlendFromIdentityAndAccumulateIndexed(FTransform* Dest, const FTransform* Base, const FTransform* Additive, float BlendWeight, const uint16* Indices, int32 NumIndices)
+{
+	for (int32 Index = 0; Index < NumIndices; ++Index)
+	{
+		const int32 AtomIndex = Indices[Index];
+
+		// BlendFromIdentityAndAccumulate changes the source, so it gets a copy
+		FTransform AdditiveAtom = Additive[AtomIndex];
+		FTransform Blended = Base[AtomIndex];
+		BlendFromIdentityAndAccumulate(Blended, AdditiveAtom, BlendWeight);
+		Blended.NormalizeRotation();
+		Dest[AtomIndex] = Blended;
+	}
+}
+
 #endif // #if !ENABLE_VECTORIZED_TRANSFORM
\ No newline at end of file
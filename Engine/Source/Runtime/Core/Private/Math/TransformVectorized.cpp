@@ -249,4 +249,81 @@ bool FTransform::DebugEqualMatrix(const FMatrix& Matrix) const
 	return true;
 }
 
+template<int32 NumLanes>
+FORCEINLINE void FTransform::BlendIndexedLanes(FTransform* Dest, const FTransform* const* Sources, int32 NumSources, const float* Weights, int32 WeightStride, const uint16* Indices, bool bNormalizeRotation)
+{
+	VectorRegister BlendedRotation[NumLanes];
+	VectorRegister BlendedTranslation[NumLanes];
+	VectorRegister BlendedScale3D[NumLanes];
+
+	// First source overwrites
+	for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+	{
+		const FTransform& Source = Sources[0][Indices[Lane]];
+		const VectorRegister Weight = VectorLoadFloat1(Weights + Lane * WeightStride);
+		BlendedRotation[Lane] = VectorMultiply(Source.Rotation, Weight);
+		BlendedTranslation[Lane] = VectorMultiply(Source.Translation, Weight);
+		BlendedScale3D[Lane] = VectorMultiply(Source.Scale3D, Weight);
+	}
+
+	// Subsequent sources are accumulated, the lanes are independent so their accumulations overlap
+	for (int32 SourceIndex = 1; SourceIndex < NumSources; ++SourceIndex)
+	{
+		const FTransform* SourceAtoms = Sources[SourceIndex];
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			const FTransform& Source = SourceAtoms[Indices[Lane]];
+			const VectorRegister Weight = VectorLoadFloat1(Weights + Lane * WeightStride + SourceIndex);
+			BlendedRotation[Lane] = VectorAccumulateQuaternionShortestPath(BlendedRotation[Lane], VectorMultiply(Source.Rotation, Weight));
+			BlendedTranslation[Lane] = VectorMultiplyAdd(Source.Translation, Weight, BlendedTranslation[Lane]);
+			BlendedScale3D[Lane] = VectorMultiplyAdd(Source.Scale3D, Weight, BlendedScale3D[Lane]);
+		}
+	}
+
+	for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+	{
+		FTransform& Result = Dest[Indices[Lane]];
+		Result.Rotation = bNormalizeRotation ? VectorNormalizeQuaternion(BlendedRotation[Lane]) : BlendedRotation[Lane];
+		Result.Translation = BlendedTranslation[Lane];
+		Result.Scale3D = BlendedScale3D[Lane];
+		Result.DiagnosticCheckNaN_All();
+	}
+}
+
+void FTransform::BlendIndexed(FTransform* Dest, const FTransform* const* Sources, int32 NumSources, const float* Weights, bool bPerIndexWeights, const uint16* Indices, int32 NumIndices, bool bNormalizeRotation)
+{
+	check(NumSources > 0);
+
+	// With shared weights every index reads the same ones
+	const int32 WeightStride = bPerIndexWeights ? NumSources : 0;
+
+	int32 Index = 0;
+	for (; Index + 4 <= NumIndices; Index += 4)
+	{
+		BlendIndexedLanes<4>(Dest, Sources, NumSources, Weights + Index * WeightStride, WeightStride, Indices + Index, bNormalizeRotation);
+	}
+	for (; Index < NumIndices; ++Index)
+	{
+		BlendIndexedLanes<1>(Dest, Sources, NumSources, Weights + Index * WeightStride, WeightStride, Indices + Index, bNormalizeRotation);
+	}
+}
+
+void FTransform::BlendFromIdentityAndAccumulateIndexed(FTransform* Dest, const FTransform* Base, const FTransform* Additive, float BlendWeight, const uint16* Indices, int32 NumIndices)
+{
+	const ScalarRegister VBlendWeight(BlendWeight);
+
+	for (int32 Index = 0; Index < NumIndices; ++Index)
+	{
+		const int32 AtomIndex = Indices[Index];
+
+		// BlendFromIdentityAndAccumulate takes the source by reference, so it gets a copy
+		FTransform AdditiveAtom = Additive[AtomIndex];
+		FTransform Blended = Base[AtomIndex];
+		BlendFromIdentityAndAccumulate(Blended, AdditiveAtom, VBlendWeight);
+		Blended.NormalizeRotation();
+		Blended.DiagnosticCheckNaN_All();
+		Dest[AtomIndex] = Blended;
+	}
+}
+
 #endif // ENABLE_VECTORIZED_TRANSFORM
\ No newline at end of file
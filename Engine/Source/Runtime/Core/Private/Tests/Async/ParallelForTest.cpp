@@ -0,0 +1,152 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ParallelForTest.cpp: Unit test and benchmark for ParallelFor.
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "AutomationTest.h"
+#include "ParallelFor.h"
+
+
+/** Counts how many times each index was visited **/
+struct FCountVisitsBody
+{
+	FCountVisitsBody(TArray<int32>& InVisits)
+		: Visits(InVisits)
+	{
+	}
+	void operator()(int32 Index) const
+	{
+		FPlatformAtomics::InterlockedIncrement(&Visits[Index]);
+	}
+	TArray<int32>& Visits;
+};
+
+/** Runs a small ParallelFor for every index, used to check nesting **/
+struct FNestedBody
+{
+	enum { NumInner = 16 };
+
+	FNestedBody(TArray<int32>& InVisits)
+		: Visits(InVisits)
+	{
+	}
+	void operator()(int32 Index) const
+	{
+		struct FInnerBody
+		{
+			FInnerBody(TArray<int32>& InVisits, int32 InOuterIndex)
+				: Visits(InVisits)
+				, OuterIndex(InOuterIndex)
+			{
+			}
+			void operator()(int32 InnerIndex) const
+			{
+				FPlatformAtomics::InterlockedIncrement(&Visits[OuterIndex * NumInner + InnerIndex]);
+			}
+			TArray<int32>& Visits;
+			int32 OuterIndex;
+		};
+		ParallelFor(NumInner, FInnerBody(Visits, Index));
+	}
+	TArray<int32>& Visits;
+};
+
+/** Does nothing, used to measure the scheduling overhead **/
+struct FEmptyBody
+{
+	void operator()(int32 Index) const
+	{
+	}
+};
+
+/** @return true if every entry of Visits is exactly one **/
+static bool AllVisitedOnce(const TArray<int32>& Visits)
+{
+	for (int32 Index = 0; Index < Visits.Num(); Index++)
+	{
+		if (Visits[Index] != 1)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForTest, "Core.Async.ParallelFor", EAutomationTestFlags::ATF_SmokeTest)
+
+
+bool FParallelForTest::RunTest( const FString& Parameters )
+{
+	const int32 Sizes[] = { 0, 1, 2, 3, 7, 64, 1000, 100003 };
+	const int32 BatchSizes[] = { 1, 16, 4096 };
+
+	for (int32 SizeIndex = 0; SizeIndex < ARRAY_COUNT(Sizes); SizeIndex++)
+	{
+		for (int32 BatchIndex = 0; BatchIndex < ARRAY_COUNT(BatchSizes); BatchIndex++)
+		{
+			TArray<int32> Visits;
+			Visits.AddZeroed(Sizes[SizeIndex]);
+			ParallelFor(Visits.Num(), FCountVisitsBody(Visits), BatchSizes[BatchIndex]);
+			TestTrue(FString::Printf(TEXT("Every index must be visited exactly once (Num=%d, MinBatchSize=%d)"), Sizes[SizeIndex], BatchSizes[BatchIndex]), AllVisitedOnce(Visits));
+		}
+	}
+
+	// forced single threaded and background loops
+	{
+		TArray<int32> Visits;
+		Visits.AddZeroed(5000);
+		ParallelFor(Visits.Num(), FCountVisitsBody(Visits), 1, EParallelForFlags::ForceSingleThread);
+		TestTrue(TEXT("A single threaded loop must visit every index exactly once"), AllVisitedOnce(Visits));
+	}
+	{
+		TArray<int32> Visits;
+		Visits.AddZeroed(5000);
+		ParallelFor(Visits.Num(), FCountVisitsBody(Visits), 1, EParallelForFlags::BackgroundPriority);
+		TestTrue(TEXT("A background priority loop must visit every index exactly once"), AllVisitedOnce(Visits));
+	}
+
+	// loops started from inside a loop body, which runs on worker threads
+	{
+		const int32 NumOuter = 64;
+		TArray<int32> Visits;
+		Visits.AddZeroed(NumOuter * FNestedBody::NumInner);
+		ParallelFor(NumOuter, FNestedBody(Visits));
+		TestTrue(TEXT("A nested loop must visit every index exactly once"), AllVisitedOnce(Visits));
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForBenchmark, "Core.Async.ParallelForBenchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+
+bool FParallelForBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumIterations = 2000;
+	// with one index per chunk, this many indices gives the largest number of chunks ParallelFor will create
+	const int32 NumChunks = (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) * 4;
+
+	const double SingleStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		ParallelFor(NumChunks, FEmptyBody(), 1, EParallelForFlags::ForceSingleThread);
+	}
+	const double SingleTime = FPlatformTime::Seconds() - SingleStart;
+
+	const double ParallelStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		ParallelFor(NumChunks, FEmptyBody());
+	}
+	const double ParallelTime = FPlatformTime::Seconds() - ParallelStart;
+
+	const double MicrosecondsPerCall = (ParallelTime - SingleTime) * 1000000.0 / NumIterations;
+	AddLogItem(FString::Printf(TEXT("ParallelFor with %d chunks: %.2f us per call, %.3f us scheduling overhead per chunk (single threaded %.3f us per call)"),
+		NumChunks, MicrosecondsPerCall, MicrosecondsPerCall / NumChunks, SingleTime * 1000000.0 / NumIterations));
+
+	return true;
+}
@@ -0,0 +1,291 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	TransformBlendTest.cpp: Unit test and benchmark for the indexed transform blends.
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "AutomationTest.h"
+
+
+/** Fills an array with random transforms, like the local bone transforms of a pose */
+static void MakeRandomPose(FRandomStream& RandomStream, int32 NumBones, TArray<FTransform>& OutPose)
+{
+	OutPose.Reset();
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		const FQuat Rotation(RandomStream.GetUnitVector(), RandomStream.FRandRange(-PI, PI));
+		const FVector Translation = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.f, 50.f);
+		const FVector Scale3D(RandomStream.FRandRange(0.5f, 1.5f));
+		OutPose.Add(FTransform(Rotation, Translation, Scale3D));
+	}
+}
+
+/** Blends the way the animation runtime did bone by bone, one pass over the result per pose */
+static void ReferenceBlend(TArray<FTransform>& Result, const TArray<FTransform>* Poses, int32 NumPoses, const float* Weights, bool bPerIndexWeights, const TArray<uint16>& Indices, bool bNormalizeRotation)
+{
+	for (int32 PoseIndex = 0; PoseIndex < NumPoses; PoseIndex++)
+	{
+		for (int32 Index = 0; Index < Indices.Num(); Index++)
+		{
+			const int32 BoneIndex = Indices[Index];
+			const ScalarRegister VBlendWeight(bPerIndexWeights ? Weights[Index * NumPoses + PoseIndex] : Weights[PoseIndex]);
+			if (PoseIndex == 0)
+			{
+				Result[BoneIndex] = Poses[PoseIndex][BoneIndex] * VBlendWeight;
+			}
+			else
+			{
+				Result[BoneIndex].AccumulateWithShortestRotation(Poses[PoseIndex][BoneIndex], VBlendWeight);
+			}
+		}
+	}
+
+	if (bNormalizeRotation)
+	{
+		for (int32 Index = 0; Index < Indices.Num(); Index++)
+		{
+			Result[Indices[Index]].NormalizeRotation();
+		}
+	}
+}
+
+/**
+ * Applies an additive pose the way FAnimationRuntime::BlendAdditivePose did before it used the indexed blend:
+ * every bone is blended from identity and accumulated, then the rotations get a pass of their own to be normalized.
+ * The blend is written out with scalar math, so it doesn't share code with the function it checks.
+ */
+static void ReferenceAdditiveBlend(TArray<FTransform>& Result, const TArray<FTransform>& Base, const TArray<FTransform>& Additive, float BlendWeight, const TArray<uint16>& Indices)
+{
+	for (int32 Index = 0; Index < Indices.Num(); Index++)
+	{
+		const int32 BoneIndex = Indices[Index];
+		const FTransform& BaseAtom = Base[BoneIndex];
+		const FTransform& AdditiveAtom = Additive[BoneIndex];
+
+		// Lerp from identity along the shortest route, identity's W being positive only the sign of the additive W matters
+		const FQuat AdditiveRotation = AdditiveAtom.GetRotation();
+		const float Bias = AdditiveRotation.W >= 0.f ? 1.f : -1.f;
+		FQuat BlendedRotation = AdditiveRotation * BlendWeight;
+		BlendedRotation.W += Bias * (1.f - BlendWeight);
+		BlendedRotation.Normalize();
+
+		const FVector BlendedTranslation = AdditiveAtom.GetTranslation() * BlendWeight;
+		const FVector BlendedScale3D = FMath::Lerp(FVector(1.f), AdditiveAtom.GetScale3D(), BlendWeight);
+
+		Result[BoneIndex] = FTransform(BlendedRotation * BaseAtom.GetRotation(), BaseAtom.GetTranslation() + BlendedTranslation, BaseAtom.GetScale3D() * BlendedScale3D);
+	}
+
+	// The separate NormalizeRotations pass over the required bones
+	for (int32 Index = 0; Index < Indices.Num(); Index++)
+	{
+		Result[Indices[Index]].NormalizeRotation();
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTransformBlendTest, "Core.Math.TransformBlend", EAutomationTestFlags::ATF_SmokeTest)
+
+
+bool FTransformBlendTest::RunTest( const FString& Parameters )
+{
+	const int32 NumBones = 67;
+	const int32 NumPoses = 3;
+	FRandomStream RandomStream(0x1234);
+
+	TArray<FTransform> Poses[NumPoses];
+	const FTransform* PoseData[NumPoses];
+	for (int32 PoseIndex = 0; PoseIndex < NumPoses; PoseIndex++)
+	{
+		MakeRandomPose(RandomStream, NumBones, Poses[PoseIndex]);
+		PoseData[PoseIndex] = Poses[PoseIndex].GetTypedData();
+	}
+
+	// Skip some bones, and leave a count that isn't a multiple of four
+	TArray<uint16> Indices;
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		if (BoneIndex % 7 != 3)
+		{
+			Indices.Add(BoneIndex);
+		}
+	}
+
+	const float SharedWeights[NumPoses] = { 0.5f, 0.3f, 0.2f };
+	TArray<float> PerIndexWeights;
+	for (int32 Index = 0; Index < Indices.Num(); Index++)
+	{
+		const float Alpha = RandomStream.FRand();
+		PerIndexWeights.Add(Alpha);
+		PerIndexWeights.Add((1.f - Alpha) * 0.5f);
+		PerIndexWeights.Add((1.f - Alpha) * 0.5f);
+	}
+
+	const FTransform Untouched(FQuat::Identity, FVector(1.f, 2.f, 3.f));
+	bool bSharedMatches = true;
+	bool bPerIndexMatches = true;
+	bool bAccumulateMatches = true;
+	bool bAdditiveMatches = true;
+	bool bSkippedUntouched = true;
+
+	for (int32 Case = 0; Case < 3; Case++)
+	{
+		const bool bPerIndexWeights = Case == 1;
+		const bool bAccumulate = Case == 2;
+		const float* Weights = bPerIndexWeights ? PerIndexWeights.GetTypedData() : SharedWeights;
+
+		TArray<FTransform> Expected;
+		TArray<FTransform> Result;
+		Expected.Init(Untouched, NumBones);
+		Result.Init(Untouched, NumBones);
+
+		if (bAccumulate)
+		{
+			// Accumulating into a pose that is also the first source, without normalizing
+			const float AccumulateWeights[2] = { 1.f, 0.25f };
+			Expected = Poses[0];
+			Result = Poses[0];
+			const TArray<FTransform> ExpectedPoses[2] = { Poses[0], Poses[1] };
+			ReferenceBlend(Expected, ExpectedPoses, 2, AccumulateWeights, false, Indices, false);
+			const FTransform* Sources[2] = { Result.GetTypedData(), PoseData[1] };
+			FTransform::BlendIndexed(Result.GetTypedData(), Sources, 2, AccumulateWeights, false, Indices.GetTypedData(), Indices.Num(), false);
+		}
+		else
+		{
+			ReferenceBlend(Expected, Poses, NumPoses, Weights, bPerIndexWeights, Indices, true);
+			FTransform::BlendIndexed(Result.GetTypedData(), PoseData, NumPoses, Weights, bPerIndexWeights, Indices.GetTypedData(), Indices.Num(), true);
+		}
+
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			const bool bMatches = Result[BoneIndex].Equals(Expected[BoneIndex], 1.e-3f);
+			if (bAccumulate)
+			{
+				bAccumulateMatches &= bMatches;
+			}
+			else if (bPerIndexWeights)
+			{
+				bPerIndexMatches &= bMatches;
+			}
+			else
+			{
+				bSharedMatches &= bMatches;
+			}
+		}
+		if (!bAccumulate && !Result[3].Equals(Untouched))
+		{
+			bSkippedUntouched = false;
+		}
+	}
+
+	// Additive blend against the old BlendAdditivePose, a blend pass followed by a normalize pass
+	{
+		TArray<FTransform> Expected;
+		TArray<FTransform> Result;
+		Expected.Init(Untouched, NumBones);
+		Result.Init(Untouched, NumBones);
+		ReferenceAdditiveBlend(Expected, Poses[0], Poses[1], 0.7f, Indices);
+		FTransform::BlendFromIdentityAndAccumulateIndexed(Result.GetTypedData(), PoseData[0], PoseData[1], 0.7f, Indices.GetTypedData(), Indices.Num());
+
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			bAdditiveMatches &= Result[BoneIndex].Equals(Expected[BoneIndex], 1.e-3f);
+		}
+		bSkippedUntouched &= Result[3].Equals(Untouched);
+	}
+
+	TestTrue(TEXT("Blending with shared weights matches blending bone by bone"), bSharedMatches);
+	TestTrue(TEXT("Blending with per bone weights matches blending bone by bone"), bPerIndexMatches);
+	TestTrue(TEXT("Accumulating into one of the sources matches blending bone by bone"), bAccumulateMatches);
+	TestTrue(TEXT("Additive blending matches a blend pass followed by a normalize pass"), bAdditiveMatches);
+	TestTrue(TEXT("Bones which aren't blended are left alone"), bSkippedUntouched);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTransformBlendBenchmark, "Core.Math.TransformBlendBenchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+
+bool FTransformBlendBenchmark::RunTest( const FString& Parameters )
+{
+	// A crowd of characters with typical skeletons, each blending three poses a frame
+	const int32 NumCharacters = 300;
+	const int32 NumPoses = 3;
+	const int32 NumIterations = 20;
+	FRandomStream RandomStream(0x5678);
+
+	const int32 SkeletonSizes[] = { 100, 150, 200 };
+	for (int32 SizeIndex = 0; SizeIndex < ARRAY_COUNT(SkeletonSizes); SizeIndex++)
+	{
+		const int32 NumBones = SkeletonSizes[SizeIndex];
+
+		TArray<uint16> Indices;
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			Indices.Add(BoneIndex);
+		}
+
+		TArray<FTransform> Poses[NumPoses];
+		const FTransform* PoseData[NumPoses];
+		for (int32 PoseIndex = 0; PoseIndex < NumPoses; PoseIndex++)
+		{
+			MakeRandomPose(RandomStream, NumBones * NumCharacters, Poses[PoseIndex]);
+			PoseData[PoseIndex] = Poses[PoseIndex].GetTypedData();
+		}
+		const float Weights[NumPoses] = { 0.5f, 0.3f, 0.2f };
+
+		TArray<FTransform> Result;
+		Result.AddUninitialized(NumBones * NumCharacters);
+
+		// Every character has its own bones, so the poses stream through the cache like they would in a frame
+		const double ReferenceStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			for (int32 Character = 0; Character < NumCharacters; Character++)
+			{
+				const int32 FirstBone = Character * NumBones;
+				for (int32 PoseIndex = 0; PoseIndex < NumPoses; PoseIndex++)
+				{
+					const ScalarRegister VBlendWeight(Weights[PoseIndex]);
+					for (int32 Index = 0; Index < NumBones; Index++)
+					{
+						const int32 BoneIndex = FirstBone + Indices[Index];
+						if (PoseIndex == 0)
+						{
+							Result[BoneIndex] = Poses[PoseIndex][BoneIndex] * VBlendWeight;
+						}
+						else
+						{
+							Result[BoneIndex].AccumulateWithShortestRotation(Poses[PoseIndex][BoneIndex], VBlendWeight);
+						}
+					}
+				}
+				for (int32 Index = 0; Index < NumBones; Index++)
+				{
+					Result[FirstBone + Indices[Index]].NormalizeRotation();
+				}
+			}
+		}
+		const double ReferenceTime = FPlatformTime::Seconds() - ReferenceStart;
+
+		const double KernelStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			for (int32 Character = 0; Character < NumCharacters; Character++)
+			{
+				const int32 FirstBone = Character * NumBones;
+				const FTransform* CharacterSources[NumPoses] = { PoseData[0] + FirstBone, PoseData[1] + FirstBone, PoseData[2] + FirstBone };
+				FTransform::BlendIndexed(Result.GetTypedData() + FirstBone, CharacterSources, NumPoses, Weights, false, Indices.GetTypedData(), NumBones, true);
+			}
+		}
+		const double KernelTime = FPlatformTime::Seconds() - KernelStart;
+
+		const double ReferenceMicroseconds = ReferenceTime * 1000000.0 / NumIterations;
+		const double KernelMicroseconds = KernelTime * 1000000.0 / NumIterations;
+		AddLogItem(FString::Printf(TEXT("%d characters with %d bones, %d poses: %.1f us per frame bone by bone, %.1f us per frame with BlendIndexed (%.2fx)"),
+			NumCharacters, NumBones, NumPoses, ReferenceMicroseconds, KernelMicroseconds, ReferenceMicroseconds / FMath::Max(KernelMicroseconds, 0.001)));
+	}
+
+	return true;
+}
@@ -0,0 +1,118 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NameTypesTest.cpp: Unit test and benchmark for concurrent FName creation.
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "AutomationTest.h"
+#include "ParallelFor.h"
+
+
+/** Creates (or finds) the name for every string and stores its index **/
+struct FCreateNamesBody
+{
+	FCreateNamesBody(const TArray<FString>& InStrings, TArray<int32>& InIndices, EFindName InFindType)
+		: Strings(InStrings)
+		, Indices(InIndices)
+		, FindType(InFindType)
+	{
+	}
+	void operator()(int32 Index) const
+	{
+		Indices[Index] = FName(*Strings[Index], FindType).GetIndex();
+	}
+	const TArray<FString>& Strings;
+	TArray<int32>& Indices;
+	EFindName FindType;
+};
+
+/**
+ * Builds strings that are not in the name table yet. Every string is repeated NumCopies times in a row, alternating
+ * the case of the copies, so that threads race to add the same name.
+ */
+static void BuildUniqueStrings(const TCHAR* Prefix, int32 NumNames, int32 NumCopies, TArray<FString>& OutStrings)
+{
+	// make the strings unique across runs of the test in the same process
+	static int32 RunCounter = 0;
+	RunCounter++;
+	OutStrings.Empty(NumNames * NumCopies);
+	for (int32 NameIndex = 0; NameIndex < NumNames; NameIndex++)
+	{
+		const FString String = FString::Printf(TEXT("%s%d_Run%dx"), Prefix, NameIndex, RunCounter);
+		for (int32 CopyIndex = 0; CopyIndex < NumCopies; CopyIndex++)
+		{
+			OutStrings.Add(CopyIndex & 1 ? String.ToUpper() : String);
+		}
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameThreadedCreationTest, "Core.Names.ThreadedCreation", EAutomationTestFlags::ATF_SmokeTest)
+
+
+bool FNameThreadedCreationTest::RunTest( const FString& Parameters )
+{
+	const int32 NumNames = 20000;
+	const int32 NumCopies = 4;
+
+	TArray<FString> Strings;
+	BuildUniqueStrings(TEXT("NameThreadTest"), NumNames, NumCopies, Strings);
+	TArray<int32> Indices;
+	Indices.AddZeroed(Strings.Num());
+	ParallelFor(Strings.Num(), FCreateNamesBody(Strings, Indices, FNAME_Add));
+
+	bool bSameIndex = true;
+	bool bMatchingString = true;
+	for (int32 Index = 0; Index < Strings.Num(); Index++)
+	{
+		// every copy of a name must have ended up with the index of the first copy
+		bSameIndex = bSameIndex && Indices[Index] == Indices[Index - Index % NumCopies];
+		const FName Found(*Strings[Index], FNAME_Find);
+		bMatchingString = bMatchingString && Found.GetIndex() == Indices[Index] && Found.ToString() == Strings[Index];
+	}
+	TestTrue(TEXT("Names added concurrently must get a single index"), bSameIndex);
+	TestTrue(TEXT("Names added concurrently must be found and resolve to their string"), bMatchingString);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameCreationBenchmark, "Core.Names.CreationBenchmark", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+
+bool FNameCreationBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumNames = 200000;
+
+	TArray<int32> Indices;
+	Indices.AddZeroed(NumNames);
+	TArray<FString> SingleStrings;
+	BuildUniqueStrings(TEXT("NameBenchSingle"), NumNames, 1, SingleStrings);
+	TArray<FString> ParallelStrings;
+	BuildUniqueStrings(TEXT("NameBenchParallel"), NumNames, 1, ParallelStrings);
+
+	const double SingleAddStart = FPlatformTime::Seconds();
+	ParallelFor(NumNames, FCreateNamesBody(SingleStrings, Indices, FNAME_Add), 1, EParallelForFlags::ForceSingleThread);
+	const double SingleAddTime = FPlatformTime::Seconds() - SingleAddStart;
+
+	const double SingleFindStart = FPlatformTime::Seconds();
+	ParallelFor(NumNames, FCreateNamesBody(SingleStrings, Indices, FNAME_Find), 1, EParallelForFlags::ForceSingleThread);
+	const double SingleFindTime = FPlatformTime::Seconds() - SingleFindStart;
+
+	const double ParallelAddStart = FPlatformTime::Seconds();
+	ParallelFor(NumNames, FCreateNamesBody(ParallelStrings, Indices, FNAME_Add), 64);
+	const double ParallelAddTime = FPlatformTime::Seconds() - ParallelAddStart;
+
+	const double ParallelFindStart = FPlatformTime::Seconds();
+	ParallelFor(NumNames, FCreateNamesBody(ParallelStrings, Indices, FNAME_Find), 64);
+	const double ParallelFindTime = FPlatformTime::Seconds() - ParallelFindStart;
+
+	const int32 NumThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	AddLogItem(FString::Printf(TEXT("%d new names, add: %.1f ns per name single threaded, %.1f ns per name on %d threads (%.2fx)"),
+		NumNames, SingleAddTime * 1000000000.0 / NumNames, ParallelAddTime * 1000000000.0 / NumNames, NumThreads, SingleAddTime / ParallelAddTime));
+	AddLogItem(FString::Printf(TEXT("%d existing names, find: %.1f ns per name single threaded, %.1f ns per name on %d threads (%.2fx)"),
+		NumNames, SingleFindTime * 1000000000.0 / NumNames, ParallelFindTime * 1000000000.0 / NumNames, NumThreads, SingleFindTime / ParallelFindTime));
+
+	return true;
+}
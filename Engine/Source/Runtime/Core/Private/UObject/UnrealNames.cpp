@@ -15,6 +15,30 @@ DEFINE_LOG_CATEGORY_STATIC(LogUnrealNames, Log, All);
 
 FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* HashNext, bool bIsPureAnsi );
 
+/**
+ * Case insensitive hash of a name, used to pick the NameHash bucket. FNV-1a over the upper case characters followed
+ * by a final avalanche, so the low bits used for the bucket index depend on every character.
+ * ANSI and wide versions of the same pure ANSI string hash to the same value.
+ *
+ * @param	Name	Name to hash
+ * @return	Hash of the name
+ */
+template<typename CharType>
+static FORCEINLINE uint32 GetCaseInsensitiveNameHash( const CharType* Name )
+{
+	uint32 Hash = 0x811c9dc5;
+	while( *Name )
+	{
+		Hash = (Hash ^ (uint32)(TChar<CharType>::ToUpper(*Name++))) * 0x01000193;
+	}
+	Hash ^= Hash >> 16;
+	Hash *= 0x85ebca6b;
+	Hash ^= Hash >> 13;
+	Hash *= 0xc2b2ae35;
+	Hash ^= Hash >> 16;
+	return Hash;
+}
+
 /**
 * Helper function that can be used inside the debuggers watch window. E.g. "DebugFName(Class->Name.Index)". 
 *
@@ -103,11 +127,11 @@ uint32 FNameEntry::GetNameHash() const
 {
 	if( IsWide() )
 	{
-		return FCrc::Strihash_DEPRECATED(WideName);
+		return GetCaseInsensitiveNameHash(WideName);
 	}
 	else
 	{
-		return FCrc::Strihash_DEPRECATED(AnsiName);
+		return GetCaseInsensitiveNameHash(AnsiName);
 	}
 }
 
@@ -223,18 +247,6 @@ FNameEntry*** FName::GetNameTableForDebuggerVisualizers_MT()
 }
 
 
-FCriticalSection* FName::GetCriticalSection()
-{
-	static FCriticalSection*	CriticalSection = NULL;
-	if( CriticalSection == NULL )
-	{
-		check(IsInGameThread());
-		CriticalSection = new FCriticalSection();
-	}
-	return CriticalSection;
-}
-
-
 // Static variables.
 FNameEntry*						FName::NameHash[ FNameDefs::NameHashBucketCount ];
 int32							FName::NameEntryMemorySize;
@@ -432,17 +444,19 @@ void FName::Init(const WIDECHAR* InName, int32 InNumber, EFindName FindType, boo
 	if( bIsPureAnsi )
 	{
 		FCStringAnsi::Strncpy( AnsiName, StringCast<ANSICHAR>(InName).Get(), ARRAY_COUNT(AnsiName) );
-		iHash = FCrc::Strihash_DEPRECATED( AnsiName ) & (ARRAY_COUNT(NameHash)-1);
+		iHash = GetCaseInsensitiveNameHash( AnsiName ) & (ARRAY_COUNT(NameHash)-1);
 	}
 	else
 	{
-		iHash = FCrc::Strihash_DEPRECATED( InName ) & (ARRAY_COUNT(NameHash)-1);
+		iHash = GetCaseInsensitiveNameHash( InName ) & (ARRAY_COUNT(NameHash)-1);
 	}
 
+	// Entries are only ever added at the head of a bucket, so everything from here down is searched below
+	FNameEntry* const SearchedHead = NameHash[iHash];
 	if (OutIndex < 0)
 	{
 		// Try to find the name in the hash.
-		for( FNameEntry* Hash=NameHash[iHash]; Hash; Hash=Hash->HashNext )
+		for( FNameEntry* Hash=SearchedHead; Hash; Hash=Hash->HashNext )
 		{
 			FPlatformMisc::Prefetch( Hash->HashNext );
 			// Compare the passed in string, either ANSI or TCHAR.
@@ -490,48 +504,51 @@ void FName::Init(const WIDECHAR* InName, int32 InNumber, EFindName FindType, boo
 			return;
 		}
 	}
-	// acquire the lock
-	FScopeLock ScopeLock(GetCriticalSection());
-	if (OutIndex < 0)
-	{
-		// Try to find the name in the hash. AGAIN...we might have been adding from a different thread and we just missed it
-		for( FNameEntry* Hash=NameHash[iHash]; Hash; Hash=Hash->HashNext )
-		{
-			// Compare the passed in string, either ANSI or TCHAR.
-			if( ( bIsPureAnsi && Hash->IsEqual( AnsiName )) 
-				||  (!bIsPureAnsi && Hash->IsEqual( InName )) )
-			{
-				// Found it in the hash.
-				OutIndex = Hash->GetIndex();
-				check(FindType == FNAME_Add);  // if this was a replace, well it isn't safe for threading. Find should have already been handled
-				Index = OutIndex;
-				Number = OutNumber;
-				return;
-			}
-		}
-	}
-	FNameEntry* OldHash=NameHash[iHash];
+	Index = AddNameEntry( bIsPureAnsi ? (void const*)AnsiName : (void const*)InName, iHash, SearchedHead, OutIndex, bIsPureAnsi );
+	Number = OutNumber;
+}
+
+NAME_INDEX FName::AddNameEntry( const void* Name, int32 HashIndex, FNameEntry* SearchedHead, int32 HardcodeIndex, bool bIsPureAnsi )
+{
 	TNameEntryArray& Names = GetNames();
+	FNameEntry* OldHash = SearchedHead;
+	NAME_INDEX OutIndex = HardcodeIndex;
 	if (OutIndex < 0)
 	{
 		OutIndex = Names.AddZeroed(1);
 	}
-	else
+	else if (OutIndex >= Names.Num())
 	{
 		Names.AddZeroed(OutIndex + 1 - Names.Num());
 	}
-	FNameEntry* NewEntry = AllocateNameEntry( bIsPureAnsi ? (void const*)AnsiName : (void const*)InName, OutIndex, OldHash, bIsPureAnsi );
-	if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Names[OutIndex], NewEntry, NULL) != NULL) // we use an atomic operation to check for unexpected concurrency, verify alignment, etc
+	FNameEntry* NewEntry = AllocateNameEntry( Name, OutIndex, OldHash, bIsPureAnsi );
+	// the entry must be in the table before the hash can hand out its index
+	if (!Names.SetElement(OutIndex, NewEntry))
 	{
 		UE_LOG(LogUnrealNames, Fatal, TEXT("Hardcoded name '%s' at index %i was duplicated (or unexpected concurrency). Existing entry is '%s'."), *NewEntry->GetPlainNameString(), NewEntry->GetIndex(), *Names[OutIndex]->GetPlainNameString() );
 	}
-	if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&NameHash[iHash], NewEntry, OldHash) != OldHash) // we use an atomic operation to check for unexpected concurrency, verify alignment, etc
+
+	while (true)
 	{
-		check(0); // someone changed this while we were changing it
+		FNameEntry* CurrentHash = (FNameEntry*)FPlatformAtomics::InterlockedCompareExchangePointer((void**)&NameHash[HashIndex], NewEntry, OldHash);
+		if (CurrentHash == OldHash)
+		{
+			return OutIndex;
+		}
+		// Another thread added to this bucket since we looked. Check the new entries for our name, we already checked the older ones.
+		for (FNameEntry* Hash = CurrentHash; Hash != OldHash; Hash = Hash->HashNext)
+		{
+			if( ( bIsPureAnsi && Hash->IsEqual( (const ANSICHAR*)Name )) 
+			||  (!bIsPureAnsi && Hash->IsEqual( (const WIDECHAR*)Name )) )
+			{
+				// The other thread won, our entry stays in the name table but is never referenced.
+				check(HardcodeIndex < 0);
+				return Hash->GetIndex();
+			}
+		}
+		OldHash = CurrentHash;
+		NewEntry->HashNext = OldHash;
 	}
-	check(OutIndex >= 0);
-	Index = OutIndex;
-	Number = OutNumber;
 }
 
 
@@ -810,17 +827,24 @@ FArchive& operator<<( FArchive& Ar, FNameEntry& E )
  * never go away. It simply uses 64K chunks and allocates new ones as space runs out. This reduces
  * allocation overhead significantly (only minor waste on 64k boundaries) and also greatly helps
  * with fragmentation as 50-100k allocations turn into tens of allocations.
+ * Allocation is lock free: threads bump the offset of the current pool atomically and race to install
+ * a new pool when it is exhausted.
  */
 class FNameEntryPoolAllocator
 {
+	/** Header at the start of each pool */
+	struct FPool
+	{
+		/** Offset of the next free byte from the start of the pool, can run past the end when the pool is exhausted */
+		volatile int32 Offset;
+	};
+
 public:
 	/** Initializes all member variables. */
 	FNameEntryPoolAllocator()
 	{
 		TotalAllocatedPages	= 0;
-		CurrentPoolStart	= NULL;
-		CurrentPoolEnd		= NULL;
-		check(ThreadGuard.GetValue() == 0);
+		CurrentPool			= NULL;
 	}
 
 	/**
@@ -831,23 +855,26 @@ public:
 	 */
 	FNameEntry* Allocate( int32 Size )
 	{
-		check(ThreadGuard.Increment() == 1);
 		// Some platforms need all of the name entries to be aligned to 4 bytes, so by
 		// aligning the size here the next allocation will be aligned to 4
 		Size = Align( Size, ALIGNOF(FNameEntry) );
+		check( Size <= PoolSize() - PoolHeaderSize() );
 
-		// Allocate a new pool if current one is exhausted. We don't worry about a little bit
-		// of waste at the end given the relative size of pool to average and max allocation.
-		if( CurrentPoolEnd - CurrentPoolStart < Size )
+		while (true)
 		{
-			AllocateNewPool();
+			FPool* Pool = CurrentPool;
+			if (Pool)
+			{
+				const int32 Offset = FPlatformAtomics::InterlockedAdd(&Pool->Offset, Size);
+				if (Offset + Size <= PoolSize())
+				{
+					return (FNameEntry*)((uint8*)Pool + Offset);
+				}
+			}
+			// Allocate a new pool if current one is exhausted. We don't worry about a little bit
+			// of waste at the end given the relative size of pool to average and max allocation.
+			AllocateNewPool(Pool);
 		}
-		check( CurrentPoolEnd - CurrentPoolStart >= Size );
-		// Return current pool start as allocation and increment by size.
-		FNameEntry* NameEntry = (FNameEntry*) CurrentPoolStart;
-		CurrentPoolStart += Size;
-		check(ThreadGuard.Decrement() == 0);
-		return NameEntry;
 	}
 
 	/**
@@ -872,22 +899,36 @@ public:
 	}
 
 private:
-	/** Allocates a new pool. */
-	void AllocateNewPool()
+	/** @return Size of the pool header, keeping the entries aligned */
+	FORCEINLINE int32 PoolHeaderSize()
+	{
+		return Align( sizeof(FPool), ALIGNOF(FNameEntry) );
+	}
+
+	/**
+	 * Allocates a new pool, unless another thread already replaced the exhausted one.
+	 *
+	 * @param ExhaustedPool	The pool that ran out of space, NULL for the first pool
+	 */
+	void AllocateNewPool(FPool* ExhaustedPool)
 	{
-		TotalAllocatedPages++;
-		CurrentPoolStart = (uint8*) FMemory::Malloc(PoolSize());
-		CurrentPoolEnd = CurrentPoolStart + PoolSize();
+		FPool* NewPool = (FPool*) FMemory::Malloc(PoolSize());
+		NewPool->Offset = PoolHeaderSize();
+		if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&CurrentPool, NewPool, ExhaustedPool) == ExhaustedPool)
+		{
+			FPlatformAtomics::InterlockedIncrement(&TotalAllocatedPages);
+		}
+		else
+		{
+			// another thread installed a new pool first
+			FMemory::Free(NewPool);
+		}
 	}
 
-	/** Beginning of pool. Allocated by AllocateNewPool, incremented by Allocate.	*/
-	uint8* CurrentPoolStart;
-	/** End of current pool. Set by AllocateNewPool and checked by Allocate.		*/
-	uint8* CurrentPoolEnd;
+	/** Pool allocations are currently made from */
+	FPool* volatile CurrentPool;
 	/** Total number of pages that have been allocated.								*/
-	int32 TotalAllocatedPages;
-	/** Threadsafe counter to test for unwanted concurrency							*/
-	FThreadSafeCounter ThreadGuard;
+	volatile int32 TotalAllocatedPages;
 };
 
 /** Global allocator for name entries. */
@@ -898,7 +939,7 @@ FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* H
 	const SIZE_T NameLen  = bIsPureAnsi ? FCStringAnsi::Strlen((ANSICHAR*)Name) : FCString::Strlen((TCHAR*)Name);
 	int32 NameEntrySize	  = FNameEntry::GetSize( NameLen, bIsPureAnsi );
 	FNameEntry* NameEntry = GNameEntryPoolAllocator.Allocate( NameEntrySize );
-	FName::NameEntryMemorySize += NameEntrySize;
+	FPlatformAtomics::InterlockedAdd(&FName::NameEntryMemorySize, NameEntrySize);
 	NameEntry->Index      = (Index << NAME_INDEX_SHIFT) | (bIsPureAnsi ? 0 : 1);
 	NameEntry->HashNext   = HashNext;
 	// Can't rely on the template override for static arrays since the safe crt version of strcpy will fill in
@@ -906,12 +947,12 @@ FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* H
 	if( bIsPureAnsi )
 	{
 		FCStringAnsi::Strcpy( const_cast<ANSICHAR*>(NameEntry->GetAnsiName()), NameLen + 1, (ANSICHAR*) Name );
-		FName::NumAnsiNames++;
+		FPlatformAtomics::InterlockedIncrement(&FName::NumAnsiNames);
 	}
 	else
 	{
 		FCStringWide::Strcpy( const_cast<WIDECHAR*>(NameEntry->GetWideName()), NameLen + 1, (WIDECHAR*) Name );
-		FName::NumWideNames++;
+		FPlatformAtomics::InterlockedIncrement(&FName::NumWideNames);
 	}
 	return NameEntry;
 }
@@ -147,6 +147,8 @@ class FRunnableThreadWinRT : public FRunnableThread
 			delete Runnable;
 			Runnable = NULL;
 		}
+		// Give back memory the allocator cached for this thread
+		FMemory::Trim();
 		// Clean ourselves up without waiting
 		if (bShouldDeleteSelf == true)
 		{
@@ -86,6 +86,8 @@ uint32 FRunnableThreadWin::Run()
 		delete Runnable;
 		Runnable = NULL;
 	}
+	// Give back memory the allocator cached for this thread
+	FMemory::Trim();
 	// Clean ourselves up without waiting
 	if (bShouldDeleteSelf == true)
 	{
@@ -0,0 +1,80 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ParallelFor.h: Data parallel loops on top of the TaskGraph
+=============================================================================*/
+
+#pragma once
+
+#include "TaskGraphInterfaces.h"
+
+/**
+ *	Interface to a loop body which processes a contiguous range of indices.
+ *	Used to keep the scheduling code out of line, the per index call is still inlined by TParallelForBody.
+ **/
+class IParallelForBody
+{
+public:
+	virtual ~IParallelForBody()
+	{
+	}
+	/**
+	 *	Process indices [StartIndex, EndIndex)
+	 *	@param StartIndex; first index to process
+	 *	@param EndIndex; one past the last index to process
+	 **/
+	virtual void ExecuteRange(int32 StartIndex, int32 EndIndex) const = 0;
+};
+
+/** Adapts any callable taking an int32 index to IParallelForBody **/
+template<typename FunctionType>
+class TParallelForBody : public IParallelForBody
+{
+public:
+	explicit TParallelForBody(const FunctionType& InFunction)
+		: Function(InFunction)
+	{
+	}
+	virtual void ExecuteRange(int32 StartIndex, int32 EndIndex) const OVERRIDE
+	{
+		for (int32 Index = StartIndex; Index < EndIndex; Index++)
+		{
+			Function(Index);
+		}
+	}
+private:
+	const FunctionType& Function;
+};
+
+namespace EParallelForFlags
+{
+	enum Type
+	{
+		None				= 0,
+		/** Run the whole loop on the calling thread, useful for debugging or when the body is known to be tiny. */
+		ForceSingleThread	= 0x01,
+		/** Queue the helper tasks at background priority rather than high priority. */
+		BackgroundPriority	= 0x02,
+	};
+}
+
+/**
+ *	Splits Num indices into chunks and processes them on the task graph worker threads. The calling thread works on chunks too and returns when every index has been processed.
+ *	Chunks are claimed dynamically, so uneven work per index is balanced automatically.
+ *	The loop runs on the calling thread when the "ParallelFor.SingleThread" console variable is set, when multithreading is not supported or when there is too little work to split.
+ *	@param Num; number of indices to process, the body is called for every index in [0, Num)
+ *	@param Body; loop body, called with an int32 index. Must be safe to call concurrently for different indices.
+ *	@param MinBatchSize; the minimum number of indices per chunk. Use larger values for cheap bodies to keep the scheduling overhead down.
+ *	@param Flags; EParallelForFlags
+ **/
+CORE_API void ParallelForInternal(int32 Num, const IParallelForBody& Body, int32 MinBatchSize, uint32 Flags);
+
+/**
+ *	Data parallel for loop, see ParallelForInternal
+ *	Example: ParallelFor(Items.Num(), FMyUpdateFunctor(Items));
+ **/
+template<typename FunctionType>
+FORCEINLINE void ParallelFor(int32 Num, const FunctionType& Body, int32 MinBatchSize = 1, uint32 Flags = EParallelForFlags::None)
+{
+	ParallelForInternal(Num, TParallelForBody<FunctionType>(Body), MinBatchSize, Flags);
+}
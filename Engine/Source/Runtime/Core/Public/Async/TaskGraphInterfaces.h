@@ -83,6 +83,33 @@ namespace ESubsequentsMode
 	};
 }
 
+namespace ETaskPriority
+{
+	enum Type
+	{
+		/** Latency sensitive work, such as tasks the game or render thread is about to wait on. Drained first by worker threads. */
+		High,
+		/** The default priority for tasks. */
+		Normal,
+		/** Work that can be deferred whenever anything else is pending, such as streaming or cache maintenance. */
+		Background,
+
+		NumPriorities
+	};
+
+	/** @return a human readable name for a task priority */
+	inline const TCHAR* ToString(Type Priority)
+	{
+		switch (Priority)
+		{
+		case High:			return TEXT("High");
+		case Normal:		return TEXT("Normal");
+		case Background:	return TEXT("Background");
+		}
+		return TEXT("Unknown");
+	}
+}
+
 /** Convenience typedef for a reference counted pointer to a graph event **/
 typedef TRefCountPtr<class FGraphEvent> FGraphEventRef;
 
@@ -210,11 +237,17 @@ protected:
 	/** 
 	 *	Constructor
 	 *	@param InNumberOfPrerequistitesOutstanding; the number of prerequisites outstanding. We actually add one to this to prevent the task from firing while we are setting up the task
+	 *	@param InPriority; the priority used when this task is queued for an unnamed thread. Named threads ignore the priority.
 	 **/
-	FBaseGraphTask(int32 InNumberOfPrerequistitesOutstanding)
+	FBaseGraphTask(int32 InNumberOfPrerequistitesOutstanding, ETaskPriority::Type InPriority = ETaskPriority::Normal)
 		: ThreadToExecuteOn(ENamedThreads::AnyThread)
+		, Priority(InPriority)
 		, NumberOfPrerequistitesOutstanding(InNumberOfPrerequistitesOutstanding + 1) // + 1 is not a prerequisite, it is a lock to prevent it from executing while it is getting prerequisites, one it is safe to execute, call PrerequisitesComplete
+#if STATS
+		, QueuedCycles(0)
+#endif
 	{
+		checkThreadGraph(Priority >= 0 && Priority < ETaskPriority::NumPriorities);
 		checkThreadGraph(LifeStage.Increment() == int32(LS_Contructed));
 	}
 	/** 
@@ -328,8 +361,14 @@ private:
 
 	/**	Thread to execute on, can be ENamedThreads::AnyThread to execute on any unnamed thread **/
 	ENamedThreads::Type			ThreadToExecuteOn;
+	/**	Priority of this task, selects the queue used on unnamed threads **/
+	ETaskPriority::Type			Priority;
 	/**	Number of prerequisites outstanding. When this drops to zero, the thread is queued for execution.  **/
 	FThreadSafeCounter			NumberOfPrerequistitesOutstanding; 
+#if STATS
+	/**	Cycle count when this task was handed to an unnamed thread, used to measure per priority queue latency **/
+	uint32						QueuedCycles;
+#endif
 
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
@@ -612,16 +651,17 @@ public:
 	 *	Factory to create a task and return the helper object to construct the embedded task and set it up for execution.
 	 *	@param Prerequisites; the list of FGraphEvents that must be completed prior to this task executing.
 	 *	@param CurrentThreadIfKnown; provides the index of the thread we are running on. Can be ENamedThreads::AnyThread if the current thread is unknown.
+	 *	@param Priority; queue priority when the task runs on an unnamed thread. Tasks for named threads are always processed in order.
 	 *	@return a temporary helper class which can be used to complete the process.
 	**/
-	static FConstructor CreateTask(const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread)
+	static FConstructor CreateTask(const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread, ETaskPriority::Type Priority = ETaskPriority::Normal)
 	{
 		if (sizeof(TGraphTask) <= FBaseGraphTask::SMALL_TASK_SIZE)
 		{
 			void *Mem = FBaseGraphTask::GetSmallTaskAllocator().Allocate();
-			return FConstructor(new (Mem) TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
+			return FConstructor(new (Mem) TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0, Priority), Prerequisites, CurrentThreadIfKnown);
 		}
-		return FConstructor(new TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
+		return FConstructor(new TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0, Priority), Prerequisites, CurrentThreadIfKnown);
 	}
 
 private:
@@ -704,9 +744,10 @@ private:
 	 *	Private constructor, constructs the base class with the number of prerequisites.
 	 *	@param InSubsequents subsequents to associate with this task
 	 *	@param NumberOfPrerequistitesOutstanding the number of prerequisites this task will have when it is built.
+	 *	@param InPriority the queue priority of this task on unnamed threads.
 	**/
-	TGraphTask(FGraphEventRef InSubsequents, int32 NumberOfPrerequistitesOutstanding)
-		: FBaseGraphTask(NumberOfPrerequistitesOutstanding)
+	TGraphTask(FGraphEventRef InSubsequents, int32 NumberOfPrerequistitesOutstanding, ETaskPriority::Type InPriority = ETaskPriority::Normal)
+		: FBaseGraphTask(NumberOfPrerequistitesOutstanding, InPriority)
 		, TaskConstructed(false)
 		, Subsequents(InSubsequents)
 	{
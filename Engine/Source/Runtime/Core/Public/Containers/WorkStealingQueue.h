@@ -0,0 +1,126 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	WorkStealingQueue.h: A fixed size lock free work stealing deque
+=============================================================================*/
+
+#pragma once
+
+/**
+ *	Chase-Lev style work stealing deque of pointers.
+ *	A single owner thread pushes and pops at the bottom (LIFO), any number of other threads steal from the top (FIFO).
+ *	The capacity is fixed, so Push can fail and the caller is expected to fall back to some other queue. This avoids having to reclaim grown buffers while thieves may still read them.
+ *	T is the type of the pointer the deque will contain, Capacity must be a power of two.
+**/
+template<class T, uint32 Capacity>
+class TWorkStealingQueue
+{
+public:
+	TWorkStealingQueue()
+		: Top(0)
+		, Bottom(0)
+	{
+		checkAtCompileTime(Capacity && !(Capacity & (Capacity - 1)), WorkStealingQueue_Capacity_must_be_a_power_of_two);
+	}
+
+	/**
+	 *	Push an item onto the bottom of the deque. Only the owner thread may call this.
+	 *	@param Item, the new item to push, cannot be NULL
+	 *	@return false if the deque is full, the item was not added.
+	**/
+	bool Push(T* Item)
+	{
+		checkSlow(Item);
+		const int32 LocalBottom = Bottom;
+		const int32 LocalTop = Top;
+		if (Distance(LocalTop, LocalBottom) >= int32(Capacity))
+		{
+			return false;
+		}
+		Items[LocalBottom & (Capacity - 1)] = Item;
+		FPlatformMisc::MemoryBarrier(); // the item must be visible before the new bottom
+		Bottom = Advance(LocalBottom, 1);
+		return true;
+	}
+
+	/**
+	 *	Pop the most recently pushed item. Only the owner thread may call this.
+	 *	@return The popped item or NULL if the deque is empty or the last item was stolen concurrently.
+	**/
+	T* Pop()
+	{
+		const int32 LocalBottom = Advance(Bottom, -1);
+		Bottom = LocalBottom;
+		FPlatformMisc::MemoryBarrier(); // the new bottom must be visible before we read top, so that a thief can't take the same item
+		const int32 LocalTop = Top;
+		const int32 Size = Distance(LocalTop, LocalBottom);
+		if (Size < 0)
+		{
+			// was empty
+			Bottom = LocalTop;
+			return NULL;
+		}
+		T* Item = Items[LocalBottom & (Capacity - 1)];
+		if (Size > 0)
+		{
+			return Item;
+		}
+		// this is the last item, race the thieves for it
+		if (FPlatformAtomics::InterlockedCompareExchange(&Top, Advance(LocalTop, 1), LocalTop) != LocalTop)
+		{
+			Item = NULL;
+		}
+		Bottom = Advance(LocalTop, 1);
+		return Item;
+	}
+
+	/**
+	 *	Steal the oldest item. Can be called from any thread.
+	 *	@return The stolen item or NULL if the deque is empty or another thread won the race for the item.
+	**/
+	T* Steal()
+	{
+		const int32 LocalTop = Top;
+		FPlatformMisc::MemoryBarrier(); // read top before bottom
+		const int32 LocalBottom = Bottom;
+		if (Distance(LocalTop, LocalBottom) <= 0)
+		{
+			return NULL;
+		}
+		T* Item = Items[LocalTop & (Capacity - 1)];
+		if (FPlatformAtomics::InterlockedCompareExchange(&Top, Advance(LocalTop, 1), LocalTop) != LocalTop)
+		{
+			return NULL;
+		}
+		return Item;
+	}
+
+	/**
+	 *	Check if the deque is empty
+	 *	@return true if the deque is empty.
+	 *	CAUTION: Unless called by the owner with no thieves around, the return value is no better than a best guess.
+	**/
+	bool IsEmpty() const
+	{
+		return Distance(Top, Bottom) <= 0;
+	}
+
+private:
+	/** @return To - From, correct across wrap around of the indices **/
+	static FORCEINLINE int32 Distance(int32 From, int32 To)
+	{
+		return int32(uint32(To) - uint32(From));
+	}
+	/** @return Index + Amount, wrapping around rather than overflowing **/
+	static FORCEINLINE int32 Advance(int32 Index, int32 Amount)
+	{
+		return int32(uint32(Index) + uint32(Amount));
+	}
+
+	/** Ring buffer of items, indexed by the low bits of Top and Bottom **/
+	T*				Items[Capacity];
+	/** Index of the oldest item, advanced by thieves and by the owner when it takes the last item **/
+	volatile int32	Top;
+	/** Index one past the newest item, only written by the owner **/
+	volatile int32	Bottom;
+};
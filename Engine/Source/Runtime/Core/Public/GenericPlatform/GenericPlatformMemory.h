@@ -268,4 +268,22 @@ struct CORE_API FGenericPlatformMemory
 	 * @return true if successful
 	 */
 	static bool UnmapNamedSharedMemoryRegion(FSharedMemoryRegion * MemoryRegion);
+
+	/**
+	 * Maps a whole file into process address space for reading. Pages are backed by the OS file cache and shared between processes mapping the same file.
+	 *
+	 * @param Filename absolute (platform) path of the file to map.
+	 *
+	 * @return pointer to FSharedMemoryRegion (or its descendants) describing the mapping if successful, NULL if not supported on this platform or mapping failed.
+	 */
+	static FSharedMemoryRegion * MapFileReadOnly(const TCHAR* Filename);
+
+	/**
+	 * Unmaps a file mapped with MapFileReadOnly
+	 *
+	 * @param MappedFile an object that encapsulates a mapped file (will be destroyed even if function fails!)
+	 *
+	 * @return true if successful
+	 */
+	static bool UnmapFile(FSharedMemoryRegion * MappedFile);
 };
@@ -30,6 +30,19 @@
 #	define USE_FINE_GRAIN_LOCKS
 #endif
 
+// Per-thread caches trade memory for lock traffic, which only pays off on desktop and server platforms.
+#if defined USE_FINE_GRAIN_LOCKS && !defined USE_LOCKFREE_DELETE && (PLATFORM_DESKTOP || UE_SERVER)
+#	define USE_THREAD_CACHES
+#endif
+
+#if defined USE_THREAD_CACHES
+// Blocks up to this size are served from per-thread free lists
+#	define THREAD_CACHE_MAX_BLOCK_SIZE (1024)
+// Each per-thread free list holds at most this many bytes (but at least THREAD_CACHE_MIN_BLOCKS blocks) before half of it is returned to the pools
+#	define THREAD_CACHE_MAX_BYTES_PER_BIN (16*1024)
+#	define THREAD_CACHE_MIN_BLOCKS (8)
+#endif
+
 #include "LockFreeList.h"
 #include "Array.h"
 
@@ -136,6 +149,34 @@ private:
 	/** Default alignment for binned allocator */
 	enum { DEFAULT_BINNED_ALLOCATOR_ALIGNMENT = sizeof(FFreeMem) };
 
+#ifdef USE_THREAD_CACHES
+	/** A block sitting in a per-thread free list. Only the first pointer is used, so this fits the smallest block size. */
+	struct FCachedBlock
+	{
+		FCachedBlock*	Next;
+	};
+
+	/** Per-thread free list for one pool table. */
+	struct FThreadCacheBin
+	{
+		/** Most recently freed block */
+		FCachedBlock*	FirstBlock;
+		/** Number of blocks in the list */
+		uint32			NumBlocks;
+	};
+
+	/** 
+	 * Free lists owned by a single thread, one per entry of PoolTable. Blocks in here still count as taken from their pools.
+	 * Caches are created by the first small allocation of a thread and released by Trim, which runnable threads call on exit.
+	 */
+	struct FThreadCache
+	{
+		FThreadCacheBin	Bins[POOL_COUNT];
+		/** Next cache in the list of all caches, used for stats. */
+		FThreadCache*	NextCache;
+	};
+#endif
+
 #ifdef CACHE_FREED_OS_ALLOCS
 	/**  */
 	struct FFreePageBlock
@@ -291,6 +332,13 @@ private:
 	uint32			CachedTotal;
 #endif
 
+#ifdef USE_THREAD_CACHES
+	/** TLS slot holding the FThreadCache of the current thread */
+	uint32			ThreadCacheTLSSlot;
+	/** List of all thread caches, guarded by AccessGuard */
+	FThreadCache*	FirstThreadCache;
+#endif
+
 #if STATS
 	uint32		OsCurrent;
 	uint32		OsPeak;
@@ -574,38 +622,7 @@ private:
 #ifdef USE_FINE_GRAIN_LOCKS
 			FScopeLock TableLock(&Table->CriticalSection);
 #endif
-#if STATS
-			Table->ActiveRequests--;
-#endif
-			// If this pool was exhausted, move to available list.
-			if( !Pool->FirstMem )
-			{
-				Pool->Unlink();
-				Pool->Link( Table->FirstPool );
-			}
-
-			// Free a pooled allocation.
-			FFreeMem* Free		= (FFreeMem*)Ptr;
-			Free->NumFreeBlocks	= 1;
-			Free->Next			= Pool->FirstMem;
-			Pool->FirstMem		= Free;
-			STAT(UsedCurrent -= Table->BlockSize);
-
-			// Free this pool.
-			checkSlow(Pool->Taken >= 1);
-			if( --Pool->Taken == 0 )
-			{
-#if STATS
-				Table->NumActivePools--;
-#endif
-				// Free the OS memory.
-				SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
-				STAT(OsCurrent -= OsBytes);
-				STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
-				Pool->Unlink();
-				Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
-				OSFree((void*)BasePtr, OsBytes);
-			}
+			FreeBlockToPool(Table, Pool, BasePtr, Ptr);
 		}
 		else
 		{
@@ -621,6 +638,262 @@ private:
 		MEM_TIME(MemTime += FPlatformTime::Seconds());
 	}
 
+	/**
+	* Returns a block to its pool and frees the pool if it became empty. It's the callers responsibility
+	* to Lock the table's critical section before calling this.
+	*/
+	FORCEINLINE void FreeBlockToPool(FPoolTable* Table, FPoolInfo* Pool, UPTRINT BasePtr, void* Ptr)
+	{
+#if STATS
+		Table->ActiveRequests--;
+#endif
+		// If this pool was exhausted, move to available list.
+		if( !Pool->FirstMem )
+		{
+			Pool->Unlink();
+			Pool->Link( Table->FirstPool );
+		}
+
+		// Free a pooled allocation.
+		FFreeMem* Free		= (FFreeMem*)Ptr;
+		Free->NumFreeBlocks	= 1;
+		Free->Next			= Pool->FirstMem;
+		Pool->FirstMem		= Free;
+		STAT(UsedCurrent -= Table->BlockSize);
+
+		// Free this pool.
+		checkSlow(Pool->Taken >= 1);
+		if( --Pool->Taken == 0 )
+		{
+#if STATS
+			Table->NumActivePools--;
+#endif
+			// Free the OS memory.
+			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
+			STAT(OsCurrent -= OsBytes);
+			STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
+			Pool->Unlink();
+			Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
+			OSFree((void*)BasePtr, OsBytes);
+		}
+	}
+
+#ifdef USE_THREAD_CACHES
+	/** 
+	 * Returns the free lists of the calling thread, creating them on first use.
+	 * The cache is allocated straight from the OS since we can't recurse into Malloc.
+	 */
+	FORCEINLINE FThreadCache* GetThreadCache()
+	{
+		FThreadCache* Cache = (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTLSSlot);
+		if (!Cache)
+		{
+			Cache = CreateThreadCache();
+		}
+		return Cache;
+	}
+
+	FThreadCache* CreateThreadCache()
+	{
+		const UPTRINT CacheBytes = Align(sizeof(FThreadCache), PageSize);
+		FThreadCache* Cache = (FThreadCache*)FPlatformMemory::BinnedAllocFromOS(CacheBytes);
+		if (!Cache)
+		{
+			OutOfMemory(CacheBytes);
+		}
+		FMemory::Memzero(Cache, sizeof(FThreadCache));
+		{
+			FScopeLock MainLock(&AccessGuard);
+			STAT(OsPeak = FMath::Max(OsPeak, OsCurrent += CacheBytes));
+			STAT(WastePeak = FMath::Max(WastePeak, WasteCurrent += CacheBytes));
+			Cache->NextCache = FirstThreadCache;
+			FirstThreadCache = Cache;
+		}
+		FPlatformTLS::SetTlsValue(ThreadCacheTLSSlot, Cache);
+		return Cache;
+	}
+
+	/** @return the number of blocks a per-thread free list for this table may hold */
+	FORCEINLINE uint32 GetThreadCacheCapacity(const FPoolTable* Table) const
+	{
+		return FMath::Max<uint32>(THREAD_CACHE_MAX_BYTES_PER_BIN / Table->BlockSize, THREAD_CACHE_MIN_BLOCKS);
+	}
+
+	/** 
+	 * Allocates a block of a small pool table from the calling thread's free list.
+	 * When the list is empty, it is refilled with half its capacity under a single lock of the table.
+	 */
+	FORCEINLINE void* AllocateFromThreadCache(FPoolTable* Table)
+	{
+		checkSlow(Table >= PoolTable && Table < PoolTable + POOL_COUNT);
+		FThreadCacheBin& Bin = GetThreadCache()->Bins[Table - PoolTable];
+		if (!Bin.FirstBlock)
+		{
+			RefillThreadCacheBin(Table, Bin);
+		}
+		FCachedBlock* Block = Bin.FirstBlock;
+		Bin.FirstBlock = Block->Next;
+		Bin.NumBlocks--;
+		return Block;
+	}
+
+	void RefillThreadCacheBin(FPoolTable* Table, FThreadCacheBin& Bin)
+	{
+		checkSlow(!Bin.FirstBlock && !Bin.NumBlocks);
+		const uint32 NumToAllocate = FMath::Max<uint32>(GetThreadCacheCapacity(Table) / 2, 1);
+		FScopeLock TableLock(&Table->CriticalSection);
+		for (uint32 Index = 0; Index < NumToAllocate; Index++)
+		{
+			// table stats count blocks handed to thread caches, not the individual requests
+			TrackStats(Table, Table->BlockSize);
+
+			FPoolInfo* Pool = Table->FirstPool;
+			if( !Pool )
+			{
+				Pool = AllocatePoolMemory(Table, BINNED_ALLOC_POOL_SIZE, Table->BlockSize);
+			}
+			FCachedBlock* Block = (FCachedBlock*)AllocateBlockFromPool(Table, Pool);
+			Block->Next = Bin.FirstBlock;
+			Bin.FirstBlock = Block;
+		}
+		Bin.NumBlocks = NumToAllocate;
+	}
+
+	/** 
+	 * Puts a freed block of a small pool table on the calling thread's free list.
+	 * When the list is over capacity, the older half is returned to the pools under a single lock of the table.
+	 * Frees never create a cache, so a thread that has been trimmed on exit doesn't get a new one while it tears down.
+	 * @return false if the block does not belong to a cached table or the thread has no cache, and must be freed normally
+	 */
+	FORCEINLINE bool FreeToThreadCache(void* Ptr)
+	{
+		FThreadCache* Cache = (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTLSSlot);
+		if (!Cache)
+		{
+			return false;
+		}
+		UPTRINT BasePtr;
+		FPoolInfo* Pool = FindPoolInfo((UPTRINT)Ptr, BasePtr);
+		checkSlow(Pool);
+		if (Pool->TableIndex >= BinnedOSTableIndex)
+		{
+			return false;
+		}
+		FPoolTable* Table = MemSizeToPoolTable[Pool->TableIndex];
+		if (Table->BlockSize > THREAD_CACHE_MAX_BLOCK_SIZE)
+		{
+			return false;
+		}
+		STAT(CurrentAllocs--);
+		FThreadCacheBin& Bin = Cache->Bins[Table - PoolTable];
+		FCachedBlock* Block = (FCachedBlock*)Ptr;
+		Block->Next = Bin.FirstBlock;
+		Bin.FirstBlock = Block;
+		const uint32 Capacity = GetThreadCacheCapacity(Table);
+		if (++Bin.NumBlocks > Capacity)
+		{
+			FlushThreadCacheBin(Table, Bin, Capacity / 2);
+		}
+		return true;
+	}
+
+	/** Returns all but the NumToKeep most recently freed blocks of a per-thread free list to the pools. */
+	void FlushThreadCacheBin(FPoolTable* Table, FThreadCacheBin& Bin, uint32 NumToKeep)
+	{
+		if (Bin.NumBlocks <= NumToKeep)
+		{
+			return;
+		}
+		FCachedBlock* ToFree;
+		if (NumToKeep)
+		{
+			FCachedBlock* LastKept = Bin.FirstBlock;
+			for (uint32 Index = 1; Index < NumToKeep; Index++)
+			{
+				LastKept = LastKept->Next;
+			}
+			ToFree = LastKept->Next;
+			LastKept->Next = NULL;
+		}
+		else
+		{
+			ToFree = Bin.FirstBlock;
+			Bin.FirstBlock = NULL;
+		}
+		Bin.NumBlocks = NumToKeep;
+
+		FScopeLock TableLock(&Table->CriticalSection);
+		while (ToFree)
+		{
+			FCachedBlock* Next = ToFree->Next;
+			UPTRINT BasePtr;
+			FPoolInfo* Pool = FindPoolInfo((UPTRINT)ToFree, BasePtr);
+			checkSlow(Pool && MemSizeToPoolTable[Pool->TableIndex] == Table);
+			FreeBlockToPool(Table, Pool, BasePtr, ToFree);
+			ToFree = Next;
+		}
+	}
+
+	/** Returns all blocks cached by the calling thread to the pools and releases its cache. */
+	void ReleaseThreadCache()
+	{
+		FThreadCache* Cache = (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTLSSlot);
+		if (!Cache)
+		{
+			return;
+		}
+		for (int32 PoolIndex = 0; PoolIndex < POOL_COUNT; PoolIndex++)
+		{
+			FlushThreadCacheBin(&PoolTable[PoolIndex], Cache->Bins[PoolIndex], 0);
+		}
+		FPlatformTLS::SetTlsValue(ThreadCacheTLSSlot, NULL);
+		{
+			FScopeLock MainLock(&AccessGuard);
+			FThreadCache** Link = &FirstThreadCache;
+			while (*Link != Cache)
+			{
+				Link = &(*Link)->NextCache;
+			}
+			*Link = Cache->NextCache;
+			const UPTRINT CacheBytes = Align(sizeof(FThreadCache), PageSize);
+			STAT(OsCurrent -= CacheBytes);
+			STAT(WasteCurrent -= CacheBytes);
+		}
+		FPlatformMemory::BinnedFreeToOS(Cache);
+	}
+
+	/**
+	 * Sums up what is held in the per-thread free lists. Reads other threads' lists without locking, so this is only an estimate.
+	 * @param OutCachedBlocks	[out] optional, number of cached blocks per entry of PoolTable
+	 * @param OutNumCaches		[out] number of threads that have a cache
+	 * @return total number of bytes in all per-thread free lists
+	 */
+	uint64 GetThreadCacheStats(uint32* OutCachedBlocks, uint32& OutNumCaches)
+	{
+		uint64 CachedBytes = 0;
+		OutNumCaches = 0;
+		if (OutCachedBlocks)
+		{
+			FMemory::Memzero(OutCachedBlocks, sizeof(uint32) * POOL_COUNT);
+		}
+		FScopeLock MainLock(&AccessGuard);
+		for (FThreadCache* Cache = FirstThreadCache; Cache; Cache = Cache->NextCache)
+		{
+			OutNumCaches++;
+			for (int32 PoolIndex = 0; PoolIndex < POOL_COUNT; PoolIndex++)
+			{
+				const uint32 NumBlocks = Cache->Bins[PoolIndex].NumBlocks;
+				CachedBytes += (uint64)NumBlocks * PoolTable[PoolIndex].BlockSize;
+				if (OutCachedBlocks)
+				{
+					OutCachedBlocks[PoolIndex] += NumBlocks;
+				}
+			}
+		}
+		return CachedBytes;
+	}
+#endif
+
 	void PushFreeLockless(void* Ptr)
 	{
 #ifdef USE_LOCKFREE_DELETE
@@ -766,6 +1039,10 @@ public:
 		,	FreedPageBlocksNum(0)
 		,	CachedTotal(0)
 #endif
+#ifdef USE_THREAD_CACHES
+		,	ThreadCacheTLSSlot(FPlatformTLS::AllocTlsSlot())
+		,	FirstThreadCache(NULL)
+#endif
 #if STATS
 		,	OsCurrent		( 0 )
 		,	OsPeak			( 0 )
@@ -897,6 +1174,14 @@ public:
 		{
 			// Allocate from pool.
 			FPoolTable* Table = MemSizeToPoolTable[Size];
+#ifdef USE_THREAD_CACHES
+			if (Table->BlockSize <= THREAD_CACHE_MAX_BLOCK_SIZE)
+			{
+				Free = (FFreeMem*)AllocateFromThreadCache(Table);
+				MEM_TIME(MemTime += FPlatformTime::Seconds());
+				return Free;
+			}
+#endif
 #ifdef USE_FINE_GRAIN_LOCKS
 			FScopeLock TableLock(&Table->CriticalSection);
 #endif
@@ -1035,6 +1320,16 @@ public:
 		return NewPtr;
 	}
 	
+	/**
+	 * Returns the blocks cached by the calling thread to the pools.
+	 */
+	virtual void Trim() OVERRIDE
+	{
+#ifdef USE_THREAD_CACHES
+		ReleaseThreadCache();
+#endif
+	}
+
 	/** 
 	 * Free
 	 */
@@ -1045,6 +1340,12 @@ public:
 			return;
 		}
 
+#ifdef USE_THREAD_CACHES
+		if (FreeToThreadCache(Ptr))
+		{
+			return;
+		}
+#endif
 		PushFreeLockless(Ptr);
 	}
 
@@ -1094,6 +1395,13 @@ public:
 		}
 		MemStats.CPUWaste += ( uint32 )Waste;
 		MemStats.CPUSlack = OsCurrent - WasteCurrent - UsedCurrent;
+#ifdef USE_THREAD_CACHES
+		// blocks in the per-thread free lists are taken from the pools but not used by anyone
+		uint32 NumThreadCaches = 0;
+		const uint32 ThreadCachedBytes = (uint32)GetThreadCacheStats(NULL, NumThreadCaches);
+		MemStats.CPUUsed -= ThreadCachedBytes;
+		MemStats.CPUSlack += ThreadCachedBytes;
+#endif
 #endif
 	}
 
@@ -1208,6 +1516,24 @@ public:
 		Ar.Logf( TEXT( "%iK allocated in pools (with %iK slack and %iK waste). Efficiency %.2f%%" ), TotalMemory, TotalSlack, TotalWaste, TotalMemory ? 100.0f * (TotalMemory - TotalWaste) / TotalMemory : 100.0f );
 		Ar.Logf( TEXT( "Allocations %i Current / %i Total (in %i pools)"), TotalActiveRequests, TotalTotalRequests, TotalPools );
 		Ar.Logf( TEXT("") );
+
+#ifdef USE_THREAD_CACHES
+		// Blocks up to THREAD_CACHE_MAX_BLOCK_SIZE are handed out through per-thread free lists, the table stats above count blocks moved to and from those lists.
+		uint32 CachedBlocks[POOL_COUNT];
+		uint32 NumThreadCaches = 0;
+		const uint64 ThreadCachedBytes = GetThreadCacheStats(CachedBlocks, NumThreadCaches);
+		Ar.Logf( TEXT("Thread caches: %i threads, %iK cached in per-thread free lists"), NumThreadCaches, ( uint32 )( ThreadCachedBytes / 1024 ) );
+		Ar.Logf( TEXT("Block Size Cached Blocks Cached Mem") );
+		Ar.Logf( TEXT("---------- ------------- ----------") );
+		for( int32 PoolIndex = 0; PoolIndex < POOL_COUNT; PoolIndex++ )
+		{
+			if (CachedBlocks[PoolIndex])
+			{
+				Ar.Logf( TEXT("% 10i % 13i % 9iK"), PoolTable[PoolIndex].BlockSize, CachedBlocks[PoolIndex], ( CachedBlocks[PoolIndex] * PoolTable[PoolIndex].BlockSize ) / 1024 );
+			}
+		}
+		Ar.Logf( TEXT("") );
+#endif
 #endif
 	}
 
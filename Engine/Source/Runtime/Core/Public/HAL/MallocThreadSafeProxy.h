@@ -109,6 +109,12 @@ public:
 		return( UsedMalloc->ValidateHeap() );
 	}
 
+	virtual void Trim() OVERRIDE
+	{
+		FScopeLock Lock( &SynchronizationObject );
+		UsedMalloc->Trim();
+	}
+
 	bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE
 	{
 		FScopeLock ScopeLock( &SynchronizationObject );
@@ -207,6 +207,13 @@ public:
 		return false; 
 	}
 
+	/**
+	 * Releases memory the allocator keeps cached for the calling thread. Called by runnable threads on exit.
+	 */
+	virtual void Trim()
+	{
+	}
+
 	/**
 	 * Gathers all current memory stats
 	 *
@@ -117,6 +117,9 @@ struct CORE_API FMemory
 
 	static SIZE_T GetAllocSize( void* Original );
 
+	/** Releases memory the allocator keeps cached for the calling thread. */
+	static void Trim();
+
 	/**
 	 * A helper function that will perform a series of random heap allocations to test
 	 * the internal validity of the heap. Note, this function will "leak" memory, but another call
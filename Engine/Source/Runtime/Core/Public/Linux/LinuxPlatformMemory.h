@@ -53,6 +53,8 @@ struct CORE_API FLinuxPlatformMemory : public FGenericPlatformMemory
 	static void BinnedFreeToOS( void* Ptr );
 	static FSharedMemoryRegion * MapNamedSharedMemoryRegion(const FString & InName, bool bCreate, uint32 AccessMode, SIZE_T Size);
 	static bool UnmapNamedSharedMemoryRegion(FSharedMemoryRegion * MemoryRegion);
+	static FSharedMemoryRegion * MapFileReadOnly(const TCHAR* Filename);
+	static bool UnmapFile(FSharedMemoryRegion * MappedFile);
 	// End FGenericPlatformMemory interface
 };
 
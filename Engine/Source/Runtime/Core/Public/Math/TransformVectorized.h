@@ -986,6 +986,43 @@ public:
 		checkSlow( FinalAtom.IsRotationNormalized() );
 	}
 
+	/**
+	 * Blends the transforms at the given indices of several arrays into the same indices of another array
+	 *
+	 * For each index this is the same as scaling the first source by its weight, accumulating the others with
+	 * AccumulateWithShortestRotation and then normalizing the rotation if asked to, done without a pass over Dest per source.
+	 * Four indices are blended per iteration with their running sums kept in registers, so the dependent accumulations of different indices overlap.
+	 *
+	 * @param Dest The array to blend into, transforms at other indices are left alone; may be one of the sources
+	 * @param Sources The arrays to blend
+	 * @param NumSources The number of arrays in Sources
+	 * @param Weights The weight of each source, or if bPerIndexWeights is set NumSources weights for each index in turn
+	 * @param bPerIndexWeights Whether every index has its own weights
+	 * @param Indices The indices to blend
+	 * @param NumIndices The number of indices
+	 * @param bNormalizeRotation Whether to normalize the blended rotations
+	 */
+	static CORE_API void BlendIndexed(FTransform* Dest, const FTransform* const* Sources, int32 NumSources, const float* Weights, bool bPerIndexWeights, const uint16* Indices, int32 NumIndices, bool bNormalizeRotation);
+
+	/**
+	 * Sets the transforms at the given indices of an array to a base pose with an additive pose applied by BlendFromIdentityAndAccumulate,
+	 * normalizing their rotations in the same pass
+	 *
+	 * @param Dest The array to write, transforms at other indices are left alone; may be the base array
+	 * @param Base The base pose
+	 * @param Additive The additive pose
+	 * @param BlendWeight The blend weight between Identity and the additive pose
+	 * @param Indices The indices to blend
+	 * @param NumIndices The number of indices
+	 */
+	static CORE_API void BlendFromIdentityAndAccumulateIndexed(FTransform* Dest, const FTransform* Base, const FTransform* Additive, float BlendWeight, const uint16* Indices, int32 NumIndices);
+
+private:
+	/** Blends NumLanes consecutive entries of Indices for BlendIndexed */
+	template<int32 NumLanes>
+	static FORCEINLINE void BlendIndexedLanes(FTransform* Dest, const FTransform* const* Sources, int32 NumSources, const float* Weights, int32 WeightStride, const uint16* Indices, bool bNormalizeRotation);
+
+public:
 
 	/**
 	 * Returns the rotation component
@@ -534,6 +534,12 @@ public:
 		return( UsedMalloc->ValidateHeap() );
 	}
 
+	virtual void Trim() OVERRIDE
+	{
+		FScopeLock Lock( &CriticalSection );
+		UsedMalloc->Trim();
+	}
+
 	/**
 	* If possible determine the size of the memory allocated at the given address
 	*
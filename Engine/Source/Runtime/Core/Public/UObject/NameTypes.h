@@ -256,39 +256,30 @@ class TStaticIndirectArrayThreadSafeRead
 	/** Static master table to chunks of pointers **/
 	ElementType** Chunks[ChunkTableSize];
 	/** Number of elements we currently have **/
-	int32 NumElements;
-	/** Number of chunks we currently have **/
-	int32 NumChunks;
+	volatile int32 NumElements;
 
 	/**
 	 * Expands the array so that Element[Index] is allocated. New pointers are all zero.
+	 * Thread safe, if two threads race to allocate the same chunk, the loser frees its chunk.
 	 * @param Index The Index of an element we want to be sure is allocated
 	 **/
 	void ExpandChunksToIndex(int32 Index)
 	{
 		check(Index >= 0 && Index < MaxTotalElements);
 		int32 ChunkIndex = Index / ElementsPerChunk;
-		while (1)
+		// chunks below ChunkIndex are allocated by the threads that added the elements in them
+		ElementType*** Chunk = &Chunks[ChunkIndex];
+		if (*Chunk == NULL)
 		{
-			if (ChunkIndex < NumChunks)
-			{
-				break;
-			}
-			// add a chunk, and make sure nobody else tries
-			ElementType*** Chunk = &Chunks[ChunkIndex];
 			ElementType** NewChunk = (ElementType**)FMemory::Malloc(sizeof(ElementType*) * ElementsPerChunk);
 			FMemory::Memzero(NewChunk, sizeof(ElementType*) * ElementsPerChunk);
 			if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)Chunk, NewChunk, NULL))
 			{
-				// someone else beat us to the add, we don't support multiple concurrent adds
-				check(0)
-			}
-			else
-			{
-				NumChunks++;
+				// someone else beat us to the add
+				FMemory::Free(NewChunk);
 			}
 		}
-		check(ChunkIndex < NumChunks && Chunks[ChunkIndex]); // should have a valid pointer now
+		check(Chunks[ChunkIndex]); // should have a valid pointer now
 	}
 	/**
 	 * Return a pointer to the pointer to a given element
@@ -298,9 +289,14 @@ class TStaticIndirectArrayThreadSafeRead
 	{
 		int32 ChunkIndex = Index / ElementsPerChunk;
 		int32 WithinChunkIndex = Index % ElementsPerChunk;
-		check(IsValidIndex(Index) && ChunkIndex < NumChunks && Index < MaxTotalElements);
+		check(IsValidIndex(Index) && Index < MaxTotalElements);
 		ElementType** Chunk = Chunks[ChunkIndex];
-		check(Chunk);
+		if (!Chunk)
+		{
+			// the element was added by another thread which hasn't allocated the chunk yet, so the element is still NULL
+			static ElementType const* const NullElement = NULL;
+			return &NullElement;
+		}
 		return Chunk + WithinChunkIndex;
 	}
 
@@ -308,7 +304,6 @@ public:
 	/** Constructor : Probably not thread safe **/
 	TStaticIndirectArrayThreadSafeRead()
 		: NumElements(0)
-		, NumChunks(0)
 	{
 		FMemory::MemZero(Chunks);
 	}
@@ -347,18 +342,33 @@ public:
 	 * Add more elements to the array
 	 * @param	NumToAdd	Number of elements to add
 	 * @return	the number of elements in the container before we did the add. In other words, the add index.
-	 * Not thread safe. This should only be called by one thread, but the other methods can be called while this is going on.
+	 * Thread safe. The new elements are NULL until the caller sets them with SetElement.
 	**/
 	int32 AddZeroed(int32 NumToAdd)
 	{
-		int32 Result = NumElements;
-		check(NumElements + NumToAdd <= MaxTotalElements);
-		ExpandChunksToIndex(NumElements + NumToAdd - 1);
-		check(Result == NumElements);
-		NumElements += NumToAdd;
-		FPlatformMisc::MemoryBarrier();
+		check(NumToAdd > 0);
+		int32 Result = FPlatformAtomics::InterlockedAdd(&NumElements, NumToAdd);
+		check(Result + NumToAdd <= MaxTotalElements);
+		for (int32 ChunkIndex = Result / ElementsPerChunk; ChunkIndex <= (Result + NumToAdd - 1) / ElementsPerChunk; ChunkIndex++)
+		{
+			ExpandChunksToIndex(ChunkIndex * ElementsPerChunk);
+		}
 		return Result;
 	}
+	/**
+	 * Set an element added with AddZeroed, which must still be NULL.
+	 * @param	Index	Index of the element to set
+	 * @param	Element	The new element
+	 * @return	false if the element was not NULL and has not been set
+	 * Thread safe, the write is a full memory barrier so the element is visible before anything the caller publishes afterwards.
+	**/
+	bool SetElement(int32 Index, ElementType* Element)
+	{
+		check(IsValidIndex(Index));
+		ElementType** Chunk = Chunks[Index / ElementsPerChunk];
+		check(Chunk);
+		return FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Chunk[Index % ElementsPerChunk], Element, NULL) == NULL;
+	}
 	/** 
 	 * Return a naked pointer to the fundamental data structure for debug visualizers.
 	**/
@@ -708,7 +718,7 @@ private:
 	/** Number portion of the string/number pair (stored internally as 1 more than actual, so zero'd memory will be the default, no-instance case) */
 	int32		Number;
 
-	/** Name hash.												*/
+	/** Name hash. Lock free, entries are only ever added at the head of a bucket with a compare and swap. */
 	static FNameEntry*						NameHash[ FNameDefs::NameHashBucketCount ];
 	/** Size of all name entries.								*/
 	static int32							NameEntryMemorySize;	
@@ -754,8 +764,18 @@ private:
 		Init(StringCast<WIDECHAR>(InName).Get(), InNumber, FindType, bSplitName, HardcodeIndex);
 	}
 
-	/** Singleton to retrieve the critical section. */
-	static FCriticalSection* GetCriticalSection();
+	/**
+	 * Adds a name entry to the name table without taking a lock. If another thread adds the same name at the same time,
+	 * the index of its entry is returned and ours is left unused.
+	 *
+	 * @param Name			Name to add, ANSICHAR if bIsPureAnsi is set, WIDECHAR otherwise
+	 * @param HashIndex		Bucket of the name in NameHash
+	 * @param SearchedHead	Head of the bucket when the caller searched it for the name
+	 * @param HardcodeIndex	If >= 0, the index the name must get
+	 * @param bIsPureAnsi	Whether the name is pure ANSI or not
+	 * @return Index of the name in the name table
+	 */
+	static NAME_INDEX AddNameEntry(const void* Name, int32 HashIndex, class FNameEntry* SearchedHead, int32 HardcodeIndex, bool bIsPureAnsi);
 
 };
 
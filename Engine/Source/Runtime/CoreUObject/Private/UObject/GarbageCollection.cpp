@@ -50,6 +50,144 @@ static volatile bool GIsRunningParallelReachability = false;
 /** Whether we are currently purging an object in the GC purge pass. */
 static bool GIsPurgingObject = false;
 
+/** Time in seconds spent in the reachability analysis of the last garbage collection. */
+COREUOBJECT_API double GLastGCReachabilityTime = 0.0;
+
+/** Whether an incremental reachability analysis started by IncrementalCollectGarbage is in progress. */
+COREUOBJECT_API volatile bool GIsIncrementalReachabilityPending = false;
+
+/**
+ * State of an incremental reachability analysis, which is spread over several calls to IncrementalCollectGarbage.
+ *
+ * RF_Unreachable can't be used while the game keeps running between steps, because iterators, weak pointers and
+ * FindObject treat such objects as gone. Objects that have not been reached yet are tracked in a bit array indexed
+ * by object index instead and only flagged RF_Unreachable once the analysis has completed. Objects created while
+ * the analysis is in progress have no bit set, so they are always kept.
+ *
+ * References stored while the game runs between steps are caught by the write barrier, which marks the objects they
+ * point to as reached. Those objects and the ones created in the meantime are queued as barrier objects, whose
+ * references are processed by the following steps. The analysis completes once no object is left to process and no
+ * barrier object has been queued.
+ */
+class FIncrementalReachabilityAnalysis
+{
+public:
+	/** Objects that have been reached but whose references have not been processed yet */
+	TArray<UObject*>	ObjectsToSerialize;
+	/** Number of calls to IncrementalCollectGarbage spent on the current analysis */
+	int32				NumSteps;
+	/** Time spent in reachability analysis steps in seconds */
+	double				ReachabilityTime;
+
+	FIncrementalReachabilityAnalysis()
+		: NumSteps(0)
+		, ReachabilityTime(0.0)
+	{
+	}
+
+	/**
+	 * Prepares the bit array for a new analysis, every object counts as reached.
+	 *
+	 * @param NumObjects	Number of object indices in use
+	 */
+	void Reset(int32 NumObjects)
+	{
+		UnreachedBits.Reset();
+		UnreachedBits.AddZeroed((NumObjects + 31) / 32);
+		ObjectsToSerialize.Reset();
+		NumSteps = 0;
+		ReachabilityTime = 0.0;
+	}
+
+	/** Marks an object as not reached yet. Only called while setting up the analysis. */
+	FORCEINLINE void MarkUnreached(const UObjectBase* Object)
+	{
+		const int32 Index = GUObjectArray.ObjectToIndex(Object);
+		UnreachedBits[Index >> 5] |= 1 << (Index & 31);
+	}
+
+	/** @return true if the object has not been reached by the analysis */
+	FORCEINLINE bool IsUnreached(const UObjectBase* Object) const
+	{
+		const int32 Index = GUObjectArray.ObjectToIndex(Object);
+		return (Index >> 5) < UnreachedBits.Num() && (UnreachedBits[Index >> 5] & (1 << (Index & 31))) != 0;
+	}
+
+	/**
+	 * Atomically marks an object as reached.
+	 *
+	 * @return true if the object had not been reached before, so the caller needs to process its references
+	 */
+	FORCEINLINE bool MarkReached(const UObjectBase* Object)
+	{
+		const int32 Index = GUObjectArray.ObjectToIndex(Object);
+		if ((Index >> 5) >= UnreachedBits.Num())
+		{
+			// created after the analysis started
+			return false;
+		}
+		volatile int32* Word = &UnreachedBits[Index >> 5];
+		const int32 Mask = 1 << (Index & 31);
+		while (true)
+		{
+			const int32 Value = *Word;
+			if (!(Value & Mask))
+			{
+				return false;
+			}
+			if (FPlatformAtomics::InterlockedCompareExchange(Word, Value & ~Mask, Value) == Value)
+			{
+				return true;
+			}
+		}
+	}
+
+	/** Queues an object reached through the write barrier or created during the analysis, can be called from any thread. */
+	void AddBarrierObject(UObject* Object)
+	{
+		FScopeLock Lock(&BarrierCritical);
+		BarrierObjects.Add(Object);
+	}
+
+	/**
+	 * Moves the barrier objects to ObjectsToSerialize. Ends the analysis if there is no work left, under the barrier
+	 * lock so no other thread can queue an object after the last check.
+	 *
+	 * @return false if the analysis has ended
+	 */
+	bool FlushBarrierObjects()
+	{
+		FScopeLock Lock(&BarrierCritical);
+		ObjectsToSerialize.Append(BarrierObjects);
+		BarrierObjects.Reset();
+		if (ObjectsToSerialize.Num() == 0)
+		{
+			GIsIncrementalReachabilityPending = false;
+			return false;
+		}
+		return true;
+	}
+
+	/** Frees the bit array after the analysis has completed. */
+	void Empty()
+	{
+		UnreachedBits.Empty();
+		ObjectsToSerialize.Empty();
+		BarrierObjects.Empty();
+	}
+
+private:
+	/** One bit per object index, set while the object has not been reached */
+	TArray<int32>		UnreachedBits;
+	/** Objects queued by the barriers since the last flush */
+	TArray<UObject*>	BarrierObjects;
+	/** Guards BarrierObjects */
+	FCriticalSection	BarrierCritical;
+};
+
+/** The incremental reachability analysis in progress, if GIsIncrementalReachabilityPending is set. */
+static FIncrementalReachabilityAnalysis GIncrementalReachability;
+
 /**
  * If set and VERIFY_DISREGARD_GC_ASSUMPTIONS is true, we verify GC assumptions about "Disregard For GC" objects. We also
  * verify that no unreachable actors/ components are referenced if VERIFY_NO_UNREACHABLE_OBJECTS_ARE_REFERENCED
@@ -179,6 +317,14 @@ static FORCEINLINE void HandleObjectReference( TArray<UObject*>& ObjectsToSerial
 				// Null out reference.
 				Object = NULL;
 			}
+			// Objects not reached yet by an incremental analysis are tracked outside of the object flags.
+			else if( GIsIncrementalReachabilityPending )
+			{
+				if( GIncrementalReachability.MarkReached( Object ) )
+				{
+					ObjectsToSerialize.Add( Object );
+				}
+			}
 			// Add encountered object reference to list of to be serialized objects if it hasn't already been added.
 			else if( Object->HasAnyFlags( RF_Unreachable ) )
 			{				
@@ -329,8 +475,134 @@ void FReferenceFinder::HandleObjectReference( UObject*& InObject, const UObject*
 	}
 }
 
+enum
+{
+	/** Number of objects in a block of work shared between the reachability analysis threads */
+	GC_WORK_BLOCK_SIZE = 128,
+	/** Number of objects processed between checks of the time limit of an incremental reachability analysis */
+	GC_INCREMENTAL_TIME_CHECK_INTERVAL = 64,
+};
+
+/**
+ * Pool of not yet processed objects shared by the threads of a parallel reachability analysis.
+ *
+ * Threads take blocks of objects from the pool and hand part of their newly discovered objects back to it whenever
+ * another thread runs out of work, so deep or lopsided object graphs are rebalanced while they are traversed
+ * instead of being split once up front. The analysis is complete when the pool is empty and no thread is
+ * processing a block, because only threads processing a block can add new work.
+ */
+class FGCWorkPool
+{
+	/** A block of objects to process */
+	struct FWorkBlock
+	{
+		TArray<UObject*> Objects;
+	};
+
+	/** Blocks waiting to be processed */
+	TLockFreePointerList<FWorkBlock>	WorkBlocks;
+	/** Processed blocks, kept around for reuse to avoid reallocating the object arrays */
+	TLockFreePointerList<FWorkBlock>	FreeBlocks;
+	/** Number of threads currently processing a block */
+	FThreadSafeCounter					ActiveThreads;
+	/** Number of threads taking part in the analysis */
+	int32								NumThreads;
+
+public:
+	FGCWorkPool(int32 InNumThreads)
+		: NumThreads(InNumThreads)
+	{
+	}
+
+	~FGCWorkPool()
+	{
+		check(WorkBlocks.IsEmpty());
+		while (FWorkBlock* Block = FreeBlocks.Pop())
+		{
+			delete Block;
+		}
+	}
+
+	/**
+	 * Adds a range of objects to the pool, split into blocks.
+	 *
+	 * @param Objects		Array to copy objects from
+	 * @param StartIndex	First object to add
+	 * @param NumObjects	Number of objects to add
+	 */
+	void PushWork(const TArray<UObject*>& Objects, int32 StartIndex, int32 NumObjects)
+	{
+		while (NumObjects > 0)
+		{
+			const int32 NumThisBlock = FMath::Min<int32>(NumObjects, GC_WORK_BLOCK_SIZE);
+			FWorkBlock* Block = FreeBlocks.Pop();
+			if (!Block)
+			{
+				Block = new FWorkBlock;
+			}
+			Block->Objects.Reset();
+			// one extra slot for the prefetch code in ProcessObjectArray
+			Block->Objects.Reserve(NumThisBlock + 1);
+			Block->Objects.Append(Objects.GetTypedData() + StartIndex, NumThisBlock);
+			WorkBlocks.Push(Block);
+			StartIndex += NumThisBlock;
+			NumObjects -= NumThisBlock;
+		}
+	}
+
+	/**
+	 * Waits for a block of work. On success, the calling thread counts as active until it calls FinishedWork.
+	 *
+	 * @param OutObjects	Receives the objects of the block
+	 * @return	false if the analysis is complete and there will be no more work
+	 */
+	bool PopWork(TArray<UObject*>& OutObjects)
+	{
+		while (true)
+		{
+			if (!WorkBlocks.IsEmpty())
+			{
+				// count as active before popping, so other threads can't see an empty pool with no active threads while we hold a block
+				ActiveThreads.Increment();
+				if (FWorkBlock* Block = WorkBlocks.Pop())
+				{
+					Exchange(OutObjects, Block->Objects);
+					FreeBlocks.Push(Block);
+					return true;
+				}
+				ActiveThreads.Decrement();
+			}
+			else if (ActiveThreads.GetValue() == 0)
+			{
+				// an active thread might have pushed work right before it finished, so check the pool again
+				FPlatformMisc::MemoryBarrier();
+				if (WorkBlocks.IsEmpty())
+				{
+					return false;
+				}
+			}
+			else
+			{
+				FPlatformProcess::Sleep(0.0f);
+			}
+		}
+	}
+
+	/** Called when the calling thread has processed the block returned by PopWork. */
+	void FinishedWork()
+	{
+		ActiveThreads.Decrement();
+	}
+
+	/** @return true if some thread is looking for work, so sharing is worth the overhead */
+	FORCEINLINE bool HasIdleThreads() const
+	{
+		return ActiveThreads.GetValue() < NumThreads;
+	}
+};
+
 /**
- * Implementation of parallel realtime garbage collector using recursive subdivision
+ * Implementation of parallel realtime garbage collector using a shared pool of work
  *
  * The approach is to create an array of uint32 tokens for each class that describe object references. This is done for 
  * script exposed classes by traversing the properties and additionally via manual function calls to emit tokens for
@@ -359,18 +631,13 @@ private:
 	class FGCTask
 	{
 		FArchiveRealtimeGC*	Owner;
-		TArray<UObject*>	ObjectsToSerialize;
+		FGCWorkPool*		WorkPool;
 
 	public:
-		FGCTask(FArchiveRealtimeGC* InOwner, const TArray<UObject*>* InObjectsToSerialize,int32 StartIndex, int32 NumObjects)
+		FGCTask(FArchiveRealtimeGC* InOwner, FGCWorkPool* InWorkPool)
 			: Owner(InOwner)
+			, WorkPool(InWorkPool)
 		{
-			ObjectsToSerialize.Reserve(NumObjects);
-			while (NumObjects)
-			{
-				ObjectsToSerialize.Add((*InObjectsToSerialize)[StartIndex++]);
-				NumObjects--;
-			}
 		}
 		static const TCHAR* GetTaskName()
 		{
@@ -390,7 +657,7 @@ private:
 		}
 		void DoTask(ENamedThreads::Type CurrentThread, FGraphEventRef& MyCompletionGraphEvent)
 		{
-			Owner->ProcessObjectArray(ObjectsToSerialize, MyCompletionGraphEvent);
+			Owner->ProcessWorkPool(*WorkPool);
 		}
 	};
 
@@ -403,14 +670,72 @@ public:
 	 * Performs reachability analysis.
 	 *
 	 * @param KeepFlags		Objects with these flags will be kept regardless of being referenced or not
+	 * @param bForceSingleThreaded	Whether to run the whole analysis on the calling thread
+	 * @param MaxThreads	Maximum number of threads to use including the calling thread, 0 to use every task graph worker thread
 	 */
-	void PerformReachabilityAnalysis( EObjectFlags KeepFlags, bool bForceSingleThreaded = false )
+	void PerformReachabilityAnalysis( EObjectFlags KeepFlags, bool bForceSingleThreaded = false, int32 MaxThreads = 0 )
 	{
-		UObject* CurrentObject = NULL;
-
 		/** Growing array of objects that require serialization */
 		TArray<UObject*>	ObjectsToSerialize;
 
+		MarkObjectsAsUnreachable( ObjectsToSerialize, KeepFlags, NULL );
+		ProcessObjectsToSerialize( ObjectsToSerialize, bForceSingleThreaded, MaxThreads );
+	}
+
+	/**
+	 * Traverses the object graph starting with the passed in objects, sharing the work with task graph threads unless forced not to.
+	 *
+	 * @param ObjectsToSerialize	Objects to start with, also used as scratch space
+	 * @param bForceSingleThreaded	Whether to run the whole traversal on the calling thread
+	 * @param MaxThreads			Maximum number of threads to use including the calling thread, 0 to use every task graph worker thread
+	 */
+	void ProcessObjectsToSerialize( TArray<UObject*>& ObjectsToSerialize, bool bForceSingleThreaded, int32 MaxThreads )
+	{
+		if( ObjectsToSerialize.Num() )
+		{
+			check(!GIsRunningParallelReachability);
+
+			// the calling thread takes part in the analysis, so only start helpers for the remaining threads
+			int32 NumHelpers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+			if ( MaxThreads > 0 )
+			{
+				NumHelpers = FMath::Min<int32>(NumHelpers, MaxThreads - 1);
+			}
+
+			if ( bForceSingleThreaded || NumHelpers <= 0 )
+			{
+				ProcessObjectArray( ObjectsToSerialize, NULL );
+			}
+			else
+			{				
+				GIsRunningParallelReachability = true;
+
+				FGCWorkPool WorkPool(NumHelpers + 1);
+				WorkPool.PushWork(ObjectsToSerialize, 0, ObjectsToSerialize.Num());
+
+				FGraphEventArray HelperTasks;
+				HelperTasks.Empty(NumHelpers);
+				for (int32 Helper = 0; Helper < NumHelpers; Helper++)
+				{
+					HelperTasks.Add(TGraphTask<FGCTask>::CreateTask(NULL, ENamedThreads::AnyThread, ETaskPriority::High).ConstructAndDispatchWhenReady(this, &WorkPool));
+				}
+				ProcessWorkPool(WorkPool);
+				// the pool lives on this stack frame, so wait for the helpers even though there is no work left
+				FTaskGraphInterface::Get().WaitUntilTasksComplete(HelperTasks, ENamedThreads::GameThread_Local);
+				GIsRunningParallelReachability = false;
+			}
+		}
+	}
+
+	/**
+	 * Marks all objects that aren't kept by the root set or the keep flags as unreachable and gathers the others.
+	 *
+	 * @param ObjectsToSerialize	Receives the objects to start the reachability analysis with
+	 * @param KeepFlags				Objects with these flags will be kept regardless of being referenced or not
+	 * @param IncrementalAnalysis	If not NULL, unreachable objects are tracked by this analysis rather than flagged RF_Unreachable
+	 */
+	void MarkObjectsAsUnreachable( TArray<UObject*>& ObjectsToSerialize, EObjectFlags KeepFlags, FIncrementalReachabilityAnalysis* IncrementalAnalysis )
+	{
 		// Reset object count.
 		GObjectCountDuringLastMarkPhase = 0;
 
@@ -445,6 +770,10 @@ public:
 				{	
 					ObjectsToSerialize.Add( Object );
 				}
+				else if( IncrementalAnalysis )
+				{
+					IncrementalAnalysis->MarkUnreached( Object );
+				}
 				else
 				{
 					Object->SetFlags( RF_Unreachable );
@@ -461,38 +790,20 @@ public:
 				}
 			}
 		}
+	}
 
-		if( ObjectsToSerialize.Num() )
+	/**
+	 * Processes blocks from the work pool until the whole object graph has been traversed.
+	 *
+	 * @param WorkPool	Pool shared by all threads of the analysis
+	 */
+	void ProcessWorkPool(FGCWorkPool& WorkPool)
+	{
+		TArray<UObject*> ObjectsToSerialize;
+		while (WorkPool.PopWork(ObjectsToSerialize))
 		{
-			check(!GIsRunningParallelReachability);
-
-			if ( bForceSingleThreaded )
-			{
-				FGraphEventRef InvalidRef;
-				ProcessObjectArray( ObjectsToSerialize, InvalidRef );
-			}
-			else
-			{				
-				GIsRunningParallelReachability = true;
-
-				int32 NumChunks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), ObjectsToSerialize.Num());
-				int32 NumPerChunk = ObjectsToSerialize.Num() / NumChunks;
-				check(NumPerChunk > 0);
-				FGraphEventArray ChunkTasks;
-				ChunkTasks.Empty(NumChunks);
-				int32 StartIndex = 0;
-				for (int32 Chunk = 0; Chunk < NumChunks; Chunk++)
-				{
-					if (Chunk + 1 == NumChunks)
-					{
-						NumPerChunk = ObjectsToSerialize.Num() - StartIndex; // last chunk takes all remaining items
-					}
-					ChunkTasks.Add(TGraphTask<FGCTask>::CreateTask().ConstructAndDispatchWhenReady(this, &ObjectsToSerialize, StartIndex, NumPerChunk));
-					StartIndex += NumPerChunk;
-				}
-				FTaskGraphInterface::Get().WaitUntilTasksComplete(ChunkTasks, ENamedThreads::GameThread_Local);
-				GIsRunningParallelReachability = false;
-			}
+			ProcessObjectArray(ObjectsToSerialize, &WorkPool);
+			WorkPool.FinishedWork();
 		}
 	}
 
@@ -500,11 +811,19 @@ public:
 	{
 	}
 
-	void ProcessObjectArray(TArray<UObject*>& InObjectsToSerializeArray, FGraphEventRef& MyCompletionGraphEvent)
+	/**
+	 * Traverses the object graph starting at the passed in objects.
+	 *
+	 * @param InObjectsToSerializeArray	Objects to start with, also used as scratch space
+	 * @param WorkPool					If not NULL, newly discovered objects are shared with idle threads through this pool
+	 * @param EndTime					If not 0, stop when FPlatformTime::Seconds() passes this time and leave the objects still to process in InObjectsToSerializeArray
+	 * @return false if the time ran out before the traversal completed
+	 */
+	bool ProcessObjectArray(TArray<UObject*>& InObjectsToSerializeArray, FGCWorkPool* WorkPool, double EndTime = 0.0)
 	{		
 		UObject* CurrentObject = NULL;
+		int32 ObjectsUntilTimeCheck = GC_INCREMENTAL_TIME_CHECK_INTERVAL;
 
-		const int32 MinDesiredObjectsPerSubTask = 128; // sometimes there will be less, a lot less
 		const int32 NewObjectsArrayLength = InObjectsToSerializeArray.Num() * 2;
 		int32 TotalObjectsSerialized = InObjectsToSerializeArray.Num();
 
@@ -531,6 +850,24 @@ public:
 			FGCCollector ReferenceCollector( NewObjectsToSerialize );
 			while( CurrentIndex < ObjectsToSerialize.Num() )
 			{
+				if( EndTime > 0.0 && --ObjectsUntilTimeCheck <= 0 )
+				{
+					ObjectsUntilTimeCheck = GC_INCREMENTAL_TIME_CHECK_INTERVAL;
+					if( FPlatformTime::Seconds() >= EndTime )
+					{
+						// Out of time, keep the objects still to process for the next call.
+						ObjectsToSerialize.RemoveAt( 0, CurrentIndex, false );
+						ObjectsToSerialize.Append( NewObjectsToSerialize );
+						return false;
+					}
+				}
+				// Hand part of the new objects to threads that ran out of work, keeping a block for ourselves.
+				if( WorkPool && NewObjectsToSerialize.Num() >= GC_WORK_BLOCK_SIZE * 2 && WorkPool->HasIdleThreads() )
+				{
+					const int32 StartIndex = NewObjectsToSerialize.Num() - GC_WORK_BLOCK_SIZE;
+					WorkPool->PushWork( NewObjectsToSerialize, StartIndex, GC_WORK_BLOCK_SIZE );
+					NewObjectsToSerialize.RemoveAt( StartIndex, GC_WORK_BLOCK_SIZE, false );
+				}
 #if PERF_DETAILED_PER_CLASS_GC_STATS
 				uint32 StartCycles = FPlatformTime::Cycles();
 #endif
@@ -722,20 +1059,9 @@ public:
 #else
 			}
 #endif
-			if( GIsRunningParallelReachability && NewObjectsToSerialize.Num() >= MinDesiredObjectsPerSubTask )
-			{			
-				int32 ObjectsPerSubTask = FMath::Max<int32>(MinDesiredObjectsPerSubTask,NewObjectsToSerialize.Num() / FTaskGraphInterface::Get().GetNumWorkerThreads());
-				int32 StartIndex = 0;
-				while (StartIndex < NewObjectsToSerialize.Num())
-				{
-					int32 NumThisTask = FMath::Min<int32>(ObjectsPerSubTask, NewObjectsToSerialize.Num() - StartIndex);
-					MyCompletionGraphEvent->DontCompleteUntil(TGraphTask<FGCTask>::CreateTask().ConstructAndDispatchWhenReady(this, &NewObjectsToSerialize, StartIndex, NumThisTask));
-					StartIndex += NumThisTask;
-				}
-			}
-			else if( NewObjectsToSerialize.Num() )
+			if( NewObjectsToSerialize.Num() )
 			{
-				// Don't spawn a new task, continue in the current one
+				// Continue with the next generation of objects
 				// To avoid allocating and moving memory around swap ObjectsToSerialize and NewObjectsToSerialize arrays
 				Exchange( ObjectsToSerialize, NewObjectsToSerialize );
 				// Empty but don't free allocated memory
@@ -746,6 +1072,7 @@ public:
 			}
 		}
 		while( CurrentIndex < ObjectsToSerialize.Num() );
+		return true;
 	}
 };
 
@@ -1020,14 +1347,30 @@ COREUOBJECT_API EditorPostReachabilityAnalysisCallbackType EditorPostReachabilit
 static const auto CVarAllowParallelGC = 
 	IConsoleManager::Get().RegisterConsoleVariable( TEXT("AllowParallelGC"), 1, TEXT("Used to control parallel GC.") )->AsVariableInt();
 
-/** 
- * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
- *
- * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
- * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+// Limit the number of threads used by parallel GC, mostly useful to measure how reachability analysis scales.
+static const auto CVarMaxParallelGCThreads = 
+	IConsoleManager::Get().RegisterConsoleVariable( TEXT("MaxParallelGCThreads"), 0, TEXT("Maximum number of threads used by parallel GC reachability analysis, including the game thread. 0 uses all task graph worker threads.") )->AsVariableInt();
+
+/**
+ * Returns whether the reachability analysis has to run on the game thread only: if processor count is 1 or parallel GC is
+ * disabled or detailed per class gc stats are enabled (not thread safe).
  */
+static bool ShouldForceSingleThreadedGC()
+{
+	// Temporarily forcing single-threaded GC in the editor until Modify() can be safely removed from HandleObjectReference.
+	return !FApp::ShouldUseThreadingForPerformance() || !FPlatformProcess::SupportsMultithreading() ||
+#if PLATFORM_SUPPORTS_MULTITHREADED_GC
+		( FPlatformMisc::NumberOfCores() < 2 || CVarAllowParallelGC->GetValueOnGameThread() == 0 || PERF_DETAILED_PER_CLASS_GC_STATS );
+#else	//PLATFORM_SUPPORTS_MULTITHREADED_GC
+		true;
+#endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
+}
 
-void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
+/**
+ * Prepares a garbage collection: flushes async loading and any pending purge and verifies the GC assumptions.
+ * Sets GIsGarbageCollecting.
+ */
+static void BeginCollectGarbage()
 {
 	// Helper class to register FlushAsyncLoadingCallback on first GC run.
 	struct FAddFlushAsyncLoadingCallback
@@ -1106,25 +1449,16 @@ void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
 		}
 	}
 #endif
+}
 
-	// Fall back to single threaded GC if processor count is 1 or parallel GC is disabled
-	// or detailed per class gc stats are enabled (not thread safe)
-	// Temporarily forcing single-threaded GC in the editor until Modify() can be safely removed from HandleObjectReference.
-	const bool bForceSingleThreadedGC = !FApp::ShouldUseThreadingForPerformance() || !FPlatformProcess::SupportsMultithreading() ||
-#if PLATFORM_SUPPORTS_MULTITHREADED_GC
-		( FPlatformMisc::NumberOfCores() < 2 || CVarAllowParallelGC->GetValueOnGameThread() == 0 || PERF_DETAILED_PER_CLASS_GC_STATS );
-#else	//PLATFORM_SUPPORTS_MULTITHREADED_GC
-		true;
-#endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
-
-	// Perform reachability analysis.
-	{
-		const double StartTime = FPlatformTime::Seconds();
-		FArchiveRealtimeGC TagUsedRealtimeGC;
-		TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, bForceSingleThreadedGC );
-		UE_LOG(LogGarbage, Log, TEXT("%f ms for GC"), (FPlatformTime::Seconds() - StartTime) * 1000 );
-	}
-
+/**
+ * Completes a garbage collection after the reachability analysis has flagged unreachable objects: begins their
+ * destruction and optionally purges them. Clears GIsGarbageCollecting.
+ *
+ * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+ */
+static void FinishCollectGarbage( bool bPerformFullPurge )
+{
 #if WITH_EDITOR
 	if ( GIsEditor && EditorPostReachabilityAnalysisCallback )
 	{
@@ -1165,6 +1499,122 @@ void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
 	FCoreDelegates::PostGarbageCollect.Broadcast();
 }
 
+/** 
+ * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
+ *
+ * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
+ * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+ */
+
+void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
+{
+	// Complete an incremental reachability analysis in progress first, as the analysis below starts from scratch.
+	if( GIsIncrementalReachabilityPending )
+	{
+		IncrementalCollectGarbage( KeepFlags, 0.0f );
+	}
+
+	BeginCollectGarbage();
+
+	// Perform reachability analysis.
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		FArchiveRealtimeGC TagUsedRealtimeGC;
+		TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, ShouldForceSingleThreadedGC(), CVarMaxParallelGCThreads->GetValueOnGameThread() );
+		GLastGCReachabilityTime = FPlatformTime::Seconds() - StartTime;
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for GC"), GLastGCReachabilityTime * 1000 );
+	}
+
+	FinishCollectGarbage( bPerformFullPurge );
+}
+
+bool IncrementalCollectGarbage( EObjectFlags KeepFlags, float TimeLimit )
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = TimeLimit > 0.0f ? StartTime + TimeLimit : 0.0;
+
+	if( !GIsIncrementalReachabilityPending )
+	{
+		BeginCollectGarbage();
+
+		// Gather the roots and remember which objects haven't been reached yet.
+		GIncrementalReachability.Reset( GUObjectArray.GetObjectArrayNum() );
+		FArchiveRealtimeGC TagUsedRealtimeGC;
+		TagUsedRealtimeGC.MarkObjectsAsUnreachable( GIncrementalReachability.ObjectsToSerialize, KeepFlags, &GIncrementalReachability );
+		GIsIncrementalReachabilityPending = true;
+	}
+	else
+	{
+		GIsGarbageCollecting = true;
+	}
+	GIncrementalReachability.NumSteps++;
+
+	// Process objects until there are none left or we run out of time. Objects queued by the barriers since the last
+	// step are picked up here as well, so the step completing the analysis only re-scans what the barriers recorded.
+	bool bCompleted = false;
+	{
+		FArchiveRealtimeGC TagUsedRealtimeGC;
+		while( true )
+		{
+			if( !GIncrementalReachability.FlushBarrierObjects() )
+			{
+				bCompleted = true;
+				break;
+			}
+			if( !TagUsedRealtimeGC.ProcessObjectArray( GIncrementalReachability.ObjectsToSerialize, NULL, EndTime ) )
+			{
+				break;
+			}
+			GIncrementalReachability.ObjectsToSerialize.Reset();
+		}
+	}
+	GIncrementalReachability.ReachabilityTime += FPlatformTime::Seconds() - StartTime;
+
+	if( !bCompleted )
+	{
+		GIsGarbageCollecting = false;
+		return false;
+	}
+
+	// Flag the objects that were never reached, so the rest of the collection works as usual.
+	for ( FRawObjectIterator It(true); It; ++It )
+	{
+		UObject* Object = *It;
+		if( GIncrementalReachability.IsUnreached( Object ) )
+		{
+			Object->SetFlags( RF_Unreachable );
+		}
+	}
+	GLastGCReachabilityTime = GIncrementalReachability.ReachabilityTime;
+	UE_LOG(LogGarbage, Log, TEXT("%f ms for incremental GC in %d steps"), GLastGCReachabilityTime * 1000, GIncrementalReachability.NumSteps );
+	GIncrementalReachability.Empty();
+
+	FinishCollectGarbage( false );
+	return true;
+}
+
+bool IsIncrementalReachabilityAnalysisPending()
+{
+	return GIsIncrementalReachabilityPending;
+}
+
+void IncrementalReachabilityWriteBarrier( const UObjectBase* Object )
+{
+	if( GIsIncrementalReachabilityPending && GIncrementalReachability.MarkReached( Object ) )
+	{
+		GIncrementalReachability.AddBarrierObject( (UObject*)Object );
+	}
+}
+
+void IncrementalReachabilityNewObject( const UObjectBase* Object )
+{
+	// New objects count as reached already, but nothing has looked at their references yet
+	if( GIsIncrementalReachabilityPending )
+	{
+		GIncrementalReachability.AddBarrierObject( (UObject*)Object );
+	}
+}
+
 /**
  * Helper function to add referenced objects via serialization
  *
@@ -219,6 +219,10 @@ void UObjectBase::AddObject(FName InName)
 	check(InName != NAME_None && InternalIndex >= 0);
 	HashObject(this);
 	check(IsValidLowLevel());
+	if( GIsIncrementalReachabilityPending )
+	{
+		IncrementalReachabilityNewObject( this );
+	}
 }
 
 /**
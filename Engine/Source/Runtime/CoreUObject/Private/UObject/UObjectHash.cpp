@@ -179,6 +179,8 @@ UObject* StaticFindObjectFastInternal( UClass* ObjectClass, UObject* ObjectPacka
 			}
 		}
 	}
+	// The caller may store the result, so it must survive an incremental garbage collection in progress.
+	GCWriteBarrier( Result );
 	// Not found.
 	return Result;
 }
@@ -271,6 +271,7 @@ UObject * FWeakObjectPtr::Get(bool bEvenIfPendingKill) const
 	if (IsValid(true))
 	{
 		Result = (UObject*)(GUObjectArray.IndexToObject(GetObjectIndex(), bEvenIfPendingKill));
+		GCWriteBarrier(Result);
 	}
 	return Result;
 }
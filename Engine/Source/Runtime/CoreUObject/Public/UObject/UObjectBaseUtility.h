@@ -83,6 +83,7 @@ public:
 	FORCEINLINE void AddToRoot()
 	{
 		SetFlags( RF_RootSet );
+		GCWriteBarrier( this );
 	}
 
 	//
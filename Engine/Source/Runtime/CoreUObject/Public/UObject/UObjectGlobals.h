@@ -297,6 +297,56 @@ COREUOBJECT_API float GetAsyncLoadPercentage( const FString& PackageName );
 COREUOBJECT_API void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge = true );
 COREUOBJECT_API void SerializeRootSet( FArchive& Ar, EObjectFlags KeepFlags );
 
+/** Time in seconds spent in the reachability analysis of the last CollectGarbage call */
+COREUOBJECT_API extern double GLastGCReachabilityTime;
+
+/**
+ * Deletes all unreferenced objects like CollectGarbage, but spreads the reachability analysis over several calls.
+ * The first call starts an analysis, every call works on it for up to TimeLimit seconds and the call that completes it
+ * begins the destruction of unreachable objects, which still need to be purged with IncrementalPurgeGarbage.
+ *
+ * The game keeps running between calls. Objects created, added to the root set, found by name, resolved through a weak
+ * pointer or assigned to an object property through reflection while the analysis is in progress are kept, and their
+ * references are processed by a later call. Native code storing object references in any other way must pass them to
+ * GCWriteBarrier, or the objects they point to may be destroyed while still referenced. Only use this if all code
+ * that runs between calls follows that rule.
+ *
+ * @param	KeepFlags	objects with those flags will be kept regardless of being referenced or not, only used by the call starting an analysis
+ * @param	TimeLimit	time budget of this call in seconds, 0 to complete the analysis
+ * @return	true if the reachability analysis has completed
+ */
+COREUOBJECT_API bool IncrementalCollectGarbage( EObjectFlags KeepFlags, float TimeLimit );
+
+/**
+ * Returns whether an incremental reachability analysis started by IncrementalCollectGarbage is in progress.
+ *
+ * @return	true if IncrementalCollectGarbage needs to be called again to complete the analysis
+ */
+COREUOBJECT_API bool IsIncrementalReachabilityAnalysisPending();
+
+/** Whether an incremental reachability analysis is in progress, only exposed for the barriers below */
+COREUOBJECT_API extern volatile bool GIsIncrementalReachabilityPending;
+
+/** Keeps an object alive during the incremental reachability analysis in progress, use GCWriteBarrier instead */
+COREUOBJECT_API void IncrementalReachabilityWriteBarrier( const class UObjectBase* Object );
+
+/** Queues an object created during the incremental reachability analysis in progress, so its references are processed */
+COREUOBJECT_API void IncrementalReachabilityNewObject( const class UObjectBase* Object );
+
+/**
+ * Write barrier for the incremental reachability analysis. Must be called with the new value when native code stores an
+ * object reference that is visible to the garbage collector, unless it is known that no incremental analysis is in progress.
+ *
+ * @param	Object	object being referenced, can be NULL
+ */
+FORCEINLINE void GCWriteBarrier( const class UObjectBase* Object )
+{
+	if( GIsIncrementalReachabilityPending && Object )
+	{
+		IncrementalReachabilityWriteBarrier( Object );
+	}
+}
+
 /**
  * Returns whether an incremental purge is still pending/ in progress.
  *
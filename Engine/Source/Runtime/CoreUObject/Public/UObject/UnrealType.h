@@ -1775,6 +1775,7 @@ class COREUOBJECT_API UObjectProperty : public TUObjectPropertyBase<UObject*>
 	}
 	virtual void SetObjectPropertyValue(void* PropertyValueAddress, UObject* Value) const OVERRIDE
 	{
+		GCWriteBarrier(Value);
 		SetPropertyValue(PropertyValueAddress, Value);
 	}
 	// End of UObjectPropertyBase interface
@@ -0,0 +1,35 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "GCBenchmarkCommandlet.generated.h"
+
+/** Node of the synthetic object graphs built by UGCBenchmarkCommandlet */
+UCLASS(transient)
+class UGCBenchmarkObject : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+	/** Objects referenced by this node */
+	UPROPERTY()
+	TArray<UObject*> References;
+};
+
+/**
+ * Measures garbage collection reachability analysis on synthetic object graphs.
+ *
+ * Usage: GCBenchmark [-Shape=Tree|Chain|Random] [-Objects=N] [-FanOut=N] [-Iterations=N] [-MaxThreads=N]
+ *	Tree builds a tree where every node references FanOut children.
+ *	Chain builds a single linked list, which can't be traversed in parallel.
+ *	Random links every node to a random earlier node and adds FanOut - 1 references to random nodes.
+ * The graph is marked with every thread count from 1 to MaxThreads and the average and best mark time is logged for each.
+ */
+UCLASS()
+class UGCBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) OVERRIDE;
+	// End UCommandlet Interface
+};
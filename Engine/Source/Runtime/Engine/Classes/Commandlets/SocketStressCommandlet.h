@@ -0,0 +1,23 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "SocketStressCommandlet.generated.h"
+
+/**
+ * Floods a loopback UDP server socket from many client sockets and measures how fast the server side receives and replies,
+ * once a datagram per socket call (RecvFrom/SendTo) and once batched (RecvFromMulti/SendToMulti), like UIpNetDriver does with BatchDatagrams.
+ *
+ * Usage: SocketStress [-Clients=N] [-Ticks=N] [-Packets=N] [-Size=N]
+ *	Every tick each of the Clients sockets sends Packets datagrams of Size bytes to the server, which replies to every datagram.
+ * Logs the packets per second, the socket system calls per tick and the packet loss of both paths.
+ */
+UCLASS()
+class USocketStressCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) OVERRIDE;
+	// End UCommandlet Interface
+};
@@ -0,0 +1,27 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/**
+ * Connection used by UDemoNetDriver. While recording it is the spectator connection everything is replicated to,
+ * and the packets it sends end up in the replay. During playback it is the server connection the recorded packets
+ * are fed to. All packets are acked internally, nothing goes over the network.
+ */
+
+#pragma once
+#include "DemoNetConnection.generated.h"
+
+UCLASS(HeaderGroup=Network, transient, config=Engine)
+class ENGINE_API UDemoNetConnection : public UNetConnection
+{
+	GENERATED_UCLASS_BODY()
+
+	// Begin UNetConnection interface.
+	virtual void InitConnection(UNetDriver* InDriver, EConnectionState InState, const FURL& InURL, int32 InConnectionSpeed = 0) OVERRIDE;
+	virtual FString LowLevelGetRemoteAddress(bool bAppendPort = false) OVERRIDE;
+	virtual FString LowLevelDescribe() OVERRIDE;
+	virtual void LowLevelSend(void* Data, int32 Count) OVERRIDE;
+	virtual int32 IsNetReady(bool Saturate) OVERRIDE;
+	// End UNetConnection interface.
+
+	/** Set when a checkpoint connection is done, it is only cleaned up and must not add anything to the replay */
+	uint32 bDiscardPackets:1;
+};
@@ -0,0 +1,150 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/**
+ * Net driver that records a match into a replay, and plays replays back into a client world.
+ *
+ * While recording, the driver lives next to the game net driver of a server world and replicates every actor to a
+ * single spectator connection. The packets that connection sends are written to the replay by a background thread.
+ * Every CheckpointInterval seconds a snapshot of the replicated state is written next to them, by a second
+ * connection that only lives while the snapshot is taken, so the recording connection carries on as if nothing
+ * happened.
+ *
+ * During playback, the driver is the net driver of the world and acts as the connection to a server that sends the
+ * recorded packets, at the speed set with SetPlaybackSpeed. Snapshots are skipped while playing, GotoTime loads the
+ * last one before the time and fast forwards from there.
+ *
+ * Startup actors (placed in the level) are never spawned by the replay, so GotoTime can't bring back one that was
+ * destroyed while playing. Jumping back to before such an actor was destroyed leaves it missing until the replay
+ * is started over with DEMOPLAY.
+ */
+
+#pragma once
+#include "DemoNetDriver.generated.h"
+
+UCLASS(HeaderGroup=Network, transient, config=Engine)
+class ENGINE_API UDemoNetDriver : public UNetDriver
+{
+	GENERATED_UCLASS_BODY()
+
+	/** Seconds between checkpoints, playback can only jump to a checkpoint and fast forward from there */
+	UPROPERTY(Config)
+	float CheckpointInterval;
+
+	/** Maximum number of times per second the actors are replicated into the replay */
+	UPROPERTY(Config)
+	float MaxRecordHz;
+
+	/** Bytes recorded on the game thread before they are handed to the writer thread */
+	UPROPERTY(Config)
+	int32 WriteBufferSize;
+
+	/** Time in the replay, while recording or playing */
+	UPROPERTY(Transient)
+	float DemoCurrentTime;
+
+	/** Length of the replay being played */
+	UPROPERTY(Transient)
+	float DemoTotalTime;
+
+	/** Playback speed, 1 is real time */
+	UPROPERTY(Transient)
+	float PlaybackSpeed;
+
+	/** Replay file being recorded or played */
+	UPROPERTY(Transient)
+	FString DemoFilename;
+
+	// Begin UNetDriver interface.
+	virtual bool IsAvailable() const OVERRIDE { return true; }
+	virtual bool InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error) OVERRIDE;
+	virtual bool InitConnect(FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error) OVERRIDE;
+	virtual bool InitListen(FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error) OVERRIDE;
+	virtual void LowLevelDestroy() OVERRIDE;
+	virtual FString LowLevelGetNetworkNumber() OVERRIDE;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) OVERRIDE;
+	virtual void ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject = NULL) OVERRIDE;
+	virtual void TickDispatch(float DeltaSeconds) OVERRIDE;
+	virtual void TickFlush(float DeltaSeconds) OVERRIDE;
+	virtual class ISocketSubsystem* GetSocketSubsystem() OVERRIDE { return NULL; }
+	virtual bool IsNetResourceValid() OVERRIDE { return true; }
+	// End UNetDriver interface.
+
+	/** @return true if the driver is recording a replay */
+	bool IsRecording() const
+	{
+		return Writer != NULL;
+	}
+
+	/** @return true if the driver is playing a replay */
+	bool IsPlaying() const
+	{
+		return Reader != NULL;
+	}
+
+	/** Appends a packet sent by the recording connection to the current frame */
+	void QueuePacket(const uint8* Data, int32 Count);
+
+	/** Sets the playback speed, 1 is real time, 0 pauses playback */
+	void SetPlaybackSpeed(float InPlaybackSpeed);
+
+	/**
+	 * Jumps to a time in the replay being played
+	 * Playback restarts at the last checkpoint before the time, and the frames up to the time are replayed at once.
+	 * Startup actors destroyed during playback are not restored when jumping back to before they were destroyed.
+	 *
+	 * @param SeekTime	Seconds from the start of the replay
+	 */
+	void GotoTime(float SeekTime);
+
+	/** @return Path of the replay with the given name */
+	static FString GetDemoFilename(const FString& DemoName);
+
+protected:
+	/** Creates a connection that replicates everything from scratch, the first one is the recording connection */
+	class UDemoNetConnection* CreateRecordConnection();
+
+	/** Writes the packets of the current frame to the replay */
+	void WriteFrame();
+
+	/**
+	 * Writes a snapshot of everything the recording connection replicates, so playback can jump here.
+	 * The recording connection isn't touched, a temporary connection sends the whole state of its actors, on the
+	 * same channels, and the packets it sends are written to the checkpoint chunk instead of the frames.
+	 */
+	void SaveCheckpoint();
+
+	/** Creates a new connection the recorded packets are fed to */
+	void CreatePlaybackConnection();
+
+	/** Closes the playback connection and destroys the dynamic actors it spawned */
+	void CleanUpPlaybackConnection();
+
+	/**
+	 * Rebuilds the replicated state from the snapshot of a checkpoint, on a new playback connection
+	 *
+	 * @return false if the snapshot is corrupted
+	 */
+	bool LoadCheckpoint(const TArray<uint8>& Snapshot);
+
+	/** Feeds the packets of a frame to the playback connection */
+	void PlayFrame(const TArray<uint8>& Payload);
+
+	/** Plays all chunks up to DemoCurrentTime */
+	void TickDemoPlayback();
+
+	/** Buffered writer of the replay being recorded */
+	class FReplayStreamWriter* Writer;
+
+	/** Reader of the replay being played */
+	class FReplayStreamReader* Reader;
+
+	/** Packets sent by the recording connection this frame, or by the checkpoint connection, in the replay frame format */
+	TArray<uint8> FramePackets;
+
+	/** Payload of the chunk being played, kept around so it isn't reallocated every frame */
+	TArray<uint8> PlaybackPayload;
+
+	/** Time of the last replication and checkpoint while recording */
+	float LastRecordTime;
+	float LastCheckpointTime;
+};
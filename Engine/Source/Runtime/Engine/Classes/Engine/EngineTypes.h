@@ -1923,15 +1923,47 @@ namespace EAutoReceiveInput
 	};
 }
 
+/** Precision a replicated vector is rounded to */
+UENUM()
+namespace EVectorQuantization
+{
+	enum Type
+	{
+		/** Each component is rounded to the nearest whole number */
+		RoundWholeNumber,
+		/** Each component is rounded, keeping one decimal */
+		RoundOneDecimal,
+		/** Each component is rounded, keeping two decimals */
+		RoundTwoDecimals,
+	};
+}
+
+/** Precision a replicated rotator is compressed to */
+UENUM()
+namespace ERotatorQuantization
+{
+	enum Type
+	{
+		/** Each component is compressed to 8 bits */
+		ByteComponents,
+		/** Each component is compressed to 16 bits */
+		ShortComponents,
+	};
+}
+
 /** Replicated movement data of our RootComponent.
   * Struct used for efficient replication as velocity and location are generally replicated together (this saves a repindex) 
   * and velocity.Z is commonly zero (most position replications are for walking pawns). 
+  * When replicated as an actor property, it is sent as a delta against the last state the connection acked (see FRepMovementDelta).
   */
 USTRUCT()
 struct FRepMovement
 {
 	GENERATED_USTRUCT_BODY()
 
+	/** Largest quantized value of a vector component, keeps deltas between two values in 31 bits */
+	static const int32 MaxQuantizedComponent = ( 1 << 29 ) - 1;
+
 	UPROPERTY()
 	FVector_NetQuantize100 LinearVelocity;
 
@@ -1952,6 +1984,18 @@ struct FRepMovement
 	UPROPERTY()
 	uint8 bRepPhysics : 1;
 
+	/** Precision Location is replicated with. Not replicated, so it must only be changed in the class defaults. */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, AdvancedDisplay)
+	TEnumAsByte<EVectorQuantization::Type> LocationQuantizationLevel;
+
+	/** Precision LinearVelocity and AngularVelocity are replicated with. Not replicated, so it must only be changed in the class defaults. */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, AdvancedDisplay)
+	TEnumAsByte<EVectorQuantization::Type> VelocityQuantizationLevel;
+
+	/** Precision Rotation is replicated with. Not replicated, so it must only be changed in the class defaults. */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, AdvancedDisplay)
+	TEnumAsByte<ERotatorQuantization::Type> RotationQuantizationLevel;
+
 	FRepMovement()
 		: LinearVelocity(ForceInit)
 		, AngularVelocity(ForceInit)
@@ -1959,8 +2003,66 @@ struct FRepMovement
 		, Rotation(ForceInit)
 		, bSimulatedPhysicSleep(false)
 		, bRepPhysics(false)
+		, LocationQuantizationLevel(EVectorQuantization::RoundTwoDecimals)
+		, VelocityQuantizationLevel(EVectorQuantization::RoundTwoDecimals)
+		, RotationQuantizationLevel(ERotatorQuantization::ByteComponents)
 	{}
 
+	/** @return Number a vector is multiplied by before it is rounded */
+	static float GetQuantizationScale(EVectorQuantization::Type Level)
+	{
+		switch (Level)
+		{
+			case EVectorQuantization::RoundWholeNumber:	return 1.f;
+			case EVectorQuantization::RoundOneDecimal:	return 10.f;
+			default:									return 100.f;
+		}
+	}
+
+	/** Rounds a vector to the precision of Level, in units of 1 / GetQuantizationScale(Level) */
+	static void QuantizeVector(const FVector& Vector, EVectorQuantization::Type Level, int32* OutComponents)
+	{
+		const float Scale = GetQuantizationScale(Level);
+		const bool bNaN = Vector.ContainsNaN();
+
+		for (int32 i = 0; i < 3; i++)
+		{
+			OutComponents[i] = bNaN ? 0 : FMath::Clamp<int32>(FMath::Round(Vector[i] * Scale), -MaxQuantizedComponent, MaxQuantizedComponent);
+		}
+	}
+
+	static FVector DequantizeVector(const int32* Components, EVectorQuantization::Type Level)
+	{
+		const float Scale = GetQuantizationScale(Level);
+		return FVector((float)Components[0] / Scale, (float)Components[1] / Scale, (float)Components[2] / Scale);
+	}
+
+	/** @return Number of bits a rotator component is compressed to */
+	static int32 GetRotationBits(ERotatorQuantization::Type Level)
+	{
+		return Level == ERotatorQuantization::ShortComponents ? 16 : 8;
+	}
+
+	/** Compresses a rotator to the precision of Level, components are in [0, 1 << GetRotationBits(Level)) */
+	static void QuantizeRotator(const FRotator& Rotator, ERotatorQuantization::Type Level, int32* OutComponents)
+	{
+		const bool bShort = Level == ERotatorQuantization::ShortComponents;
+
+		OutComponents[0] = bShort ? FRotator::CompressAxisToShort(Rotator.Pitch) : FRotator::CompressAxisToByte(Rotator.Pitch);
+		OutComponents[1] = bShort ? FRotator::CompressAxisToShort(Rotator.Yaw) : FRotator::CompressAxisToByte(Rotator.Yaw);
+		OutComponents[2] = bShort ? FRotator::CompressAxisToShort(Rotator.Roll) : FRotator::CompressAxisToByte(Rotator.Roll);
+	}
+
+	static FRotator DequantizeRotator(const int32* Components, ERotatorQuantization::Type Level)
+	{
+		if (Level == ERotatorQuantization::ShortComponents)
+		{
+			return FRotator(FRotator::DecompressAxisFromShort(Components[0]), FRotator::DecompressAxisFromShort(Components[1]), FRotator::DecompressAxisFromShort(Components[2]));
+		}
+
+		return FRotator(FRotator::DecompressAxisFromByte(Components[0]), FRotator::DecompressAxisFromByte(Components[1]), FRotator::DecompressAxisFromByte(Components[2]));
+	}
+
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 	{
 		// pack bitfield with flags
@@ -1971,26 +2073,64 @@ struct FRepMovement
 
 		bOutSuccess = true;
 
-		bool bOutSuccessLocal = true;
-
 		// update location, linear velocity
-		Location.NetSerialize( Ar, Map, bOutSuccessLocal );
-		bOutSuccess &= bOutSuccessLocal;
-		Rotation.NetSerialize( Ar, Map, bOutSuccessLocal );
-		bOutSuccess &= bOutSuccessLocal;
-		LinearVelocity.NetSerialize( Ar, Map, bOutSuccessLocal );
-		bOutSuccess &= bOutSuccessLocal;
+		bOutSuccess &= SerializeQuantizedVector( Ar, Location, LocationQuantizationLevel );
+		SerializeQuantizedRotator( Ar, Rotation, RotationQuantizationLevel );
+		bOutSuccess &= SerializeQuantizedVector( Ar, LinearVelocity, VelocityQuantizationLevel );
 
 		// update angular velocity if required
 		if ( bRepPhysics )
 		{
-			AngularVelocity.NetSerialize( Ar, Map, bOutSuccessLocal );
-			bOutSuccess &= bOutSuccessLocal;
+			bOutSuccess &= SerializeQuantizedVector( Ar, AngularVelocity, VelocityQuantizationLevel );
 		}
 
 		return true;
 	}
 
+	static bool SerializeQuantizedVector(FArchive& Ar, FVector& Vector, EVectorQuantization::Type Level)
+	{
+		switch (Level)
+		{
+			case EVectorQuantization::RoundWholeNumber:	return SerializePackedVector<1, 24>(Vector, Ar);
+			case EVectorQuantization::RoundOneDecimal:	return SerializePackedVector<10, 27>(Vector, Ar);
+			default:									return SerializePackedVector<100, 30>(Vector, Ar);
+		}
+	}
+
+	static void SerializeQuantizedRotator(FArchive& Ar, FRotator& Rotator, ERotatorQuantization::Type Level)
+	{
+		if (Level == ERotatorQuantization::ByteComponents)
+		{
+			Rotator.SerializeCompressed(Ar);
+			return;
+		}
+
+		// Same layout as FRotator::SerializeCompressed, with 16 bit components
+		int32 Components[3];
+		QuantizeRotator(Rotator, Level, Components);
+
+		for (int32 i = 0; i < 3; i++)
+		{
+			uint16 Component = Components[i];
+			uint8 B = (Component != 0);
+			Ar.SerializeBits(&B, 1);
+			if (B)
+			{
+				Ar << Component;
+			}
+			else
+			{
+				Component = 0;
+			}
+			Components[i] = Component;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Rotator = DequantizeRotator(Components, Level);
+		}
+	}
+
 	void FillFrom(const struct FRigidBodyState& RBState)
 	{
 		Location = RBState.Position;
@@ -72,7 +72,7 @@ struct FActorPriority
 		Priority(0), Actor(NULL), Channel(NULL), DestructionInfo(NULL)
 	{}
 
-	FActorPriority(class UNetConnection* InConnection, class UActorChannel* InChannel, class AActor* InActor, const TArray<struct FNetViewer>& Viewers, bool bLowBandwidth);
+	FActorPriority(class UNetConnection* InConnection, class UActorChannel* InChannel, class AActor* InActor, const TArray<struct FNetViewer>& Viewers, bool bLowBandwidth, float PriorityScale = 1.0f);
 	FActorPriority(class UNetConnection* InConnection, struct FActorDestructionInfo * DestructInfo, const TArray<struct FNetViewer>& Viewers );
 };
 
@@ -134,6 +134,14 @@ public:
 	UPROPERTY(Config)
 	float RelevantTimeout;
 
+	/** If true, a spatial grid narrows down the actors checked for relevancy per connection, see FSpatialGridRelevancyPolicy */
+	UPROPERTY(Config)
+	bool bUseSpatialGridRelevancy;
+
+	/** Size of the cells of the spatial grid used when bUseSpatialGridRelevancy is set */
+	UPROPERTY(Config)
+	float SpatialGridCellSize;
+
 	/** @todo document */
 	UPROPERTY(Config)
 	float KeepAliveTime;
@@ -281,6 +289,12 @@ public:
 	/** Used to invalidate properties marked "unchanged" in FRepChangedPropertyTracker's */
 	uint32																		ReplicationFrame;
 
+	/** Narrows down the actors considered per connection in ServerReplicateActors, every actor is considered when not set */
+	TSharedPtr< class INetRelevancyPolicy >										RelevancyPolicy;
+
+	/** Sets the policy used to narrow down the actors considered per connection, NULL to consider every actor */
+	ENGINE_API void SetRelevancyPolicy( TSharedPtr< class INetRelevancyPolicy > InRelevancyPolicy );
+
 	/** Maps FRepLayout to the respective UClass */
 	TMap< TWeakObjectPtr< UObject >, TSharedPtr< FRepLayout > >					RepLayoutMap;
 
@@ -546,4 +560,14 @@ protected:
 	ENGINE_API void UnregisterTickEvents(class UWorld* InWorld) const;
 	/** Returns true if this actor is considered to be in a loaded level */
 	bool IsLevelInitializedForActor(class AActor* InActor, class UNetConnection* InConnection);
+
+	friend struct FPrioritizeConnectionBody;
+
+	/**
+	 * Builds and sorts the priority list of one connection for ServerReplicateActors.
+	 * Only writes to the job and its connection, so it can run for several connections at once; dormancy changes are recorded in the job
+	 * and applied on the game thread afterwards. With net.ParallelReplication this calls AActor::IsNetRelevantFor,
+	 * GetNetDormancy and GetNetPriority from worker threads.
+	 */
+	void ServerReplicateActors_PrioritizeActors(struct FNetConnectionReplicationJob& Job);
 };
@@ -342,6 +342,13 @@ class UStaticMesh : public UObject, public IInterface_CollisionDataProvider, pub
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=StaticMesh, meta=(UIMin = "0.0", UIMax = "3.0"))
 	float LpvBiasMultiplier;
 
+	/**
+	 * The LOD whose triangles hide the primitives behind instances of this mesh in software occlusion culling, or -1 if the mesh is not an occluder.
+	 * Use a low poly LOD that stays inside the mesh, an occluder that covers more than the mesh hides primitives that should be visible.
+	 */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category=StaticMesh, meta=(ClampMin = "-1"))
+	int32 LODForOccluderMesh;
+
 	/** A fence which is used to keep track of the rendering thread releasing the static mesh resources. */
 	FRenderCommandFence ReleaseResourcesFence;
 
@@ -409,6 +409,10 @@ class ENGINE_API UWorld : public UObject, public FNetworkNotify
 	UPROPERTY(Transient)
 	class UNetDriver*							NetDriver;
 
+	/** The NAME_DemoNetDriver replay recording or playback driver, also the NetDriver while playing back */
+	UPROPERTY(Transient)
+	class UDemoNetDriver*						DemoNetDriver;
+
 	/** Line Batchers. All lines to be drawn in the world. */
 	UPROPERTY(Transient)
 	class ULineBatchComponent*					LineBatcher;
@@ -1152,6 +1156,34 @@ public:
 	 */
 	bool ComponentOverlapMulti(TArray<struct FOverlapResult>& OutOverlaps, const class UPrimitiveComponent* PrimComp, const FVector& Pos, const FRotator& Rot, ECollisionChannel TestChannel, const struct FComponentQueryParams& Params, const struct FCollisionObjectQueryParams& ObjectQueryParams=FCollisionObjectQueryParams::DefaultObjectQueryParam) const;
 
+	/**
+	 *  Trace a batch of rays against the world and return the first blocking hit of each, without allocating per trace
+	 *  The traces are run as batched scene queries split across the task graph worker threads, and this returns once all of them are done. Game thread only
+	 *  @param  Queries         Start and end locations of NumQueries rays
+	 *  @param  NumQueries      Number of rays in Queries
+	 *  @param  OutHits         NumQueries hit results, the bBlockingHit of a result is set if its ray found a blocking hit
+	 *  @param  TraceChannel    The 'channel' that the rays are in, used to determine which components to hit
+	 *  @param  Params          Additional parameters used for all traces
+	 * 	@param 	ResponseParam	ResponseContainer to be used for all traces
+	 *  @return Number of rays which found a blocking hit
+	 */
+	int32 BatchLineTraceSingle(const struct FBatchTraceQuery* Queries, int32 NumQueries, struct FHitResult* OutHits, ECollisionChannel TraceChannel, const struct FCollisionQueryParams& Params, const struct FCollisionResponseParams& ResponseParam = FCollisionResponseParams::DefaultResponseParam) const;
+
+	/**
+	 *  Sweep a batch of shapes against the world and return the first blocking hit of each, without allocating per sweep
+	 *  The sweeps are run as batched scene queries split across the task graph worker threads, and this returns once all of them are done. Game thread only
+	 *  @param  Queries         Start and end locations of NumQueries sweeps
+	 *  @param  NumQueries      Number of sweeps in Queries
+	 *  @param  OutHits         NumQueries hit results, the bBlockingHit of a result is set if its sweep found a blocking hit
+	 *  @param  Rot             Rotation of the shape for all sweeps
+	 *  @param  TraceChannel    The 'channel' that the sweeps are in, used to determine which components to hit
+	 *  @param	CollisionShape	CollisionShape - supports Box, Sphere, Capsule
+	 *  @param  Params          Additional parameters used for all sweeps
+	 * 	@param 	ResponseParam	ResponseContainer to be used for all sweeps
+	 *  @return Number of sweeps which found a blocking hit
+	 */
+	int32 BatchSweepSingle(const struct FBatchTraceQuery* Queries, int32 NumQueries, struct FHitResult* OutHits, const FQuat& Rot, ECollisionChannel TraceChannel, const struct FCollisionShape& CollisionShape, const struct FCollisionQueryParams& Params, const struct FCollisionResponseParams& ResponseParam = FCollisionResponseParams::DefaultResponseParam) const;
+
 	/**
 	 * Interface for Async. Pretty much same parameter set except you can optional set delegate to be called when execution is completed and you can set UserData if you'd like
 	 * if no delegate, you can query trace data using QueryTraceData or QueryOverlapData
@@ -157,8 +157,8 @@ public:
 	UPROPERTY()
 	uint32 bWantsInitialize:1;
 
-	/** Used for replication of our RootComponent's position and velocity */
-	UPROPERTY(ReplicatedUsing=OnRep_ReplicatedMovement)
+	/** Used for replication of our RootComponent's position and velocity, with the precision set in the class defaults */
+	UPROPERTY(ReplicatedUsing=OnRep_ReplicatedMovement, Category=Replication, EditDefaultsOnly, AdvancedDisplay)
 	struct FRepMovement ReplicatedMovement;
 
 	/** Used for replicating attachment of this actor's rootcomponent to another actor */
@@ -1287,9 +1287,15 @@ public:
 	* @param Time			Time since actor was last replicated
 	* @param bLowBandwidth True if low bandwith of viewer
 	* @return				Priority of this actor for replication
+	*
+	* With net.ParallelReplication enabled this is called from worker threads, so overrides must only read game state.
 	 */
 	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, class APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth);
 
+	/**
+	* Same parameters as GetNetPriority, also called from worker threads with net.ParallelReplication enabled.
+	* @return				true if the actor can go dormant for the viewer
+	*/
 	virtual bool GetNetDormancy(const FVector& ViewPos, const FVector& ViewDir, class APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth);
 
 	/** 
@@ -1432,9 +1438,20 @@ public:
 	  * @param SrcLocation - is the viewing location
 	  *
 	  * @return bool - true if this actor is network relevant to the client associated with RealViewer 
+	  *
+	  * With net.ParallelReplication enabled this is called from worker threads, so overrides must only read game state.
 	  */
 	virtual bool IsNetRelevantFor(class APlayerController* RealViewer, AActor* Viewer, const FVector& SrcLocation);
 
+	/**
+	 * Used by relevancy policies that only consider the actor for viewers within its net cull distance (see FSpatialGridRelevancyPolicy).
+	 * By default derived from the replication settings IsNetRelevantFor looks at. Classes overriding IsNetRelevantFor with rules that
+	 * can make the actor relevant further away than NetCullDistanceSquared must override this too.
+	 *
+	 * @return bool - true if the actor can be skipped for viewers outside of its net cull distance
+	 */
+	virtual bool UsesDistanceBasedNetRelevancy() const;
+
 	/**
 	 * Check if this actor is the owner when doing relevancy checks for actors marked bOnlyRelevantToOwner
 	 *
@@ -2678,14 +2678,23 @@ int32 AActor::GetFunctionCallspace( UFunction* Function, void* Parameters, FFram
 
 bool AActor::CallRemoteFunction( UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack )
 {
+	bool bProcessed = false;
+
 	UNetDriver* NetDriver = GetNetDriver();
 	if (NetDriver)
 	{
 		NetDriver->ProcessRemoteFunction(this, Function, Parameters, OutParms, Stack, NULL);
-		return true;
+		bProcessed = true;
 	}
 
-	return false;
+	// Let the replay being recorded pick up multicast functions
+	UWorld* World = GetWorld();
+	if (World && World->DemoNetDriver && World->DemoNetDriver != NetDriver)
+	{
+		World->DemoNetDriver->ProcessRemoteFunction(this, Function, Parameters, OutParms, Stack, NULL);
+	}
+
+	return bProcessed;
 }
 
 void AActor::DispatchPhysicsCollisionHit(const FRigidBodyCollisionInfo& MyInfo, const FRigidBodyCollisionInfo& OtherInfo, const FCollisionImpactData& RigidCollisionData)
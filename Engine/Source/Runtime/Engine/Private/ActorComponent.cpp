@@ -309,14 +309,23 @@ bool UActorComponent::CallRemoteFunction( UFunction* Function, void* Parameters,
 		return false;
 	}
 	
+	bool bProcessed = false;
+
 	UNetDriver* NetDriver = Owner->GetNetDriver();
 	if (NetDriver)
 	{
 		NetDriver->ProcessRemoteFunction(Owner, Function, Parameters, OutParms, Stack, this);
-		return true;
+		bProcessed = true;
 	}
 
-	return false;
+	// Let the replay being recorded pick up multicast functions
+	UWorld* World = Owner->GetWorld();
+	if (World && World->DemoNetDriver && World->DemoNetDriver != NetDriver)
+	{
+		World->DemoNetDriver->ProcessRemoteFunction(Owner, Function, Parameters, OutParms, Stack, this);
+	}
+
+	return bProcessed;
 }
 
 /** FComponentReregisterContexts for components which have had PreEditChange called but not PostEditChange. */
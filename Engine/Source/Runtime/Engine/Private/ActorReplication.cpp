@@ -162,6 +162,22 @@ bool AActor::IsNetRelevantFor(APlayerController* RealViewer, AActor* Viewer, con
 	return true;
 }
 
+bool AActor::UsesDistanceBasedNetRelevancy() const
+{
+	// Anything that could make IsNetRelevantFor return true for a viewer outside of the cull distance rules it out
+	if ( bAlwaysRelevant || bOnlyRelevantToOwner || bNetUseOwnerRelevancy || Owner != NULL || Instigator != NULL )
+	{
+		return false;
+	}
+
+	if ( RootComponent == NULL || RootComponent->AttachParent != NULL || !FMath::IsFinite( NetCullDistanceSquared ) )
+	{
+		return false;
+	}
+
+	return GetDefault<AGameNetworkManager>()->bUseDistanceBasedRelevancy;
+}
+
 void AActor::GatherCurrentMovement()
 {
 	UPrimitiveComponent* RootPrimComp = Cast<UPrimitiveComponent>(GetRootComponent());
@@ -220,6 +220,14 @@ void AnimationFormat_GetAnimationPose(
 	float Time,
 	bool bLooping)
 {
+	// a codec which decodes all three components can do the whole pose in one pass
+	if (Seq.TranslationCodec == Seq.RotationCodec && Seq.ScaleCodec == Seq.RotationCodec)
+	{
+		checkSlow(Seq.RotationCodec != NULL);
+		((AnimEncoding*)Seq.RotationCodec)->GetPoseAtoms(Atoms, RotationPairs, TranslationPairs, ScalePairs, Seq, Time, bLooping);
+		return;
+	}
+
 	// decompress the translation component using the proper method
 	checkSlow(Seq.TranslationCodec != NULL);
 	((AnimEncoding*)Seq.TranslationCodec)->GetPoseTranslations(Atoms, TranslationPairs, Seq, Time, bLooping);
@@ -235,6 +243,36 @@ void AnimationFormat_GetAnimationPose(
 		((AnimEncoding*)Seq.ScaleCodec)->GetPoseScales(Atoms, ScalePairs, Seq, Time, bLooping);
 	}
 }
+
+/**
+ * Decompress all requested rotation, translation and scale components from an Animation Sequence.
+ *
+ * @param	Atoms				The FTransform array to fill in.
+ * @param	RotationPairs		Array of bones requesting rotation data
+ * @param	TranslationPairs	Array of bones requesting translation data
+ * @param	ScalePairs			Array of bones requesting scale data
+ * @param	Seq					The animation sequence to use.
+ * @param	Time				Current time to solve for.
+ * @param	bLooping			True when looping the stream in intended.
+ */
+void AnimEncoding::GetPoseAtoms(
+	FTransformArray& Atoms,
+	const BoneTrackArray& RotationPairs,
+	const BoneTrackArray& TranslationPairs,
+	const BoneTrackArray& ScalePairs,
+	const UAnimSequence& Seq,
+	float Time,
+	bool bLooping)
+{
+	GetPoseTranslations(Atoms, TranslationPairs, Seq, Time, bLooping);
+	GetPoseRotations(Atoms, RotationPairs, Seq, Time, bLooping);
+
+	// we allow scale key to be empty
+	if (Seq.CompressedScaleOffsets.IsValid())
+	{
+		GetPoseScales(Atoms, ScalePairs, Seq, Time, bLooping);
+	}
+}
 #endif
 
 /**
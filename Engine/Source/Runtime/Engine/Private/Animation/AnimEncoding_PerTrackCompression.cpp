@@ -281,6 +281,50 @@ static FORCEINLINE_DEBUGGABLE VectorRegister DecompressSingleTrackRotationVector
 
 #endif // USE_VECTOR_PTC_DECOMPRESSOR
 
+// Offset and scale for turning fixed48 rotation components back into -1..1
+static const VectorRegister Fix48RotationOffset = MakeVectorRegister( 32767.0f, 32767.0f, 32767.0f, 0.0f );
+static const VectorRegister Fix48RotationScale = MakeVectorRegister( 3.0518509475997192297128208258309e-5f, 3.0518509475997192297128208258309e-5f, 3.0518509475997192297128208258309e-5f, 0.0f );
+
+/**
+ * Decompress a single rotation key from a single track that was compressed with the PerTrack codec into a vector register.
+ * Unlike DecompressSingleTrackRotationVectorized this doesn't need a byte permute, only the components are unpacked
+ * one at a time and W is rebuilt with vector math.  The seldom used formats go through the scalar decompressor.
+ */
+static FORCEINLINE_DEBUGGABLE VectorRegister DecompressSingleTrackRotationRegister(int32 Format, int32 FormatFlags, const uint8* RESTRICT TopOfStream, const uint8* RESTRICT KeyData)
+{
+	VectorRegister XYZ;
+	if (Format == ACF_Fixed48NoW)
+	{
+		const uint16* RESTRICT TypedKeyData = (const uint16*)KeyData;
+
+		const float Xa = (FormatFlags & 1) ? (float)(*TypedKeyData++) : 32767.0f;
+		const float Ya = (FormatFlags & 2) ? (float)(*TypedKeyData++) : 32767.0f;
+		const float Za = (FormatFlags & 4) ? (float)(*TypedKeyData++) : 32767.0f;
+
+		XYZ = VectorMultiply(VectorSubtract(MakeVectorRegister(Xa, Ya, Za, 0.0f), Fix48RotationOffset), Fix48RotationScale);
+	}
+	else if (Format == ACF_Float96NoW)
+	{
+		// Not VectorLoadFloat3, which reads a fourth float that may be past the end of the stream
+		const float* RESTRICT TypedKeyData = (const float*)KeyData;
+		XYZ = MakeVectorRegister(TypedKeyData[0], TypedKeyData[1], TypedKeyData[2], 0.0f);
+	}
+	else
+	{
+		FQuat Out;
+		FAnimationCompression_PerTrackUtils::DecompressRotation(Format, FormatFlags, Out, TopOfStream, KeyData);
+		return VectorLoadAligned(&Out);
+	}
+
+	const VectorRegister LengthSquared = VectorDot3(XYZ, XYZ);
+
+	const VectorRegister WSquared = VectorSubtract(VectorOne(), LengthSquared);
+	const VectorRegister WSquaredSqrt = VectorReciprocalAccurate(VectorReciprocalSqrtAccurate(WSquared));
+	const VectorRegister WWWW = VectorSelect(VectorCompareGT(WSquared, VectorZero()), WSquaredSqrt, VectorZero());
+
+	return VectorMergeVecXYZ_VecW(XYZ, WWWW);
+}
+
 /**
  * Handles Byte-swapping a single track of animation data from a MemoryReader or to a MemoryWriter
  *
@@ -444,6 +488,89 @@ void AEFPerTrackCompressionCodec::ByteSwapOut(
 
 
 
+/**
+ * Finds the two keys of a track to interpolate
+ *
+ * @param	Seq				The animation sequence to use.
+ * @param	TrackData		The compressed track, past its header.
+ * @param	NumKeys			The number of keys in the track.
+ * @param	FormatFlags		The format flags from the track header.
+ * @param	BytesPerKey		The size of each key.
+ * @param	FixedBytes		The size of the data ahead of the keys.
+ * @param	RelativePos		Current position within the animation to solve for in the range [0.0,1.0].
+ * @param	bLooping		True when looping the stream in intended.
+ * @param	KeyLookups		Key lookups already made for the pose.
+ * @param	Index0			Output value for the key before RelativePos.
+ * @param	Index1			Output value for the key after RelativePos.
+ * @return					The rate at which to interpolate the two keys.
+ */
+FORCEINLINE_DEBUGGABLE float AEFPerTrackCompressionCodec::GetTrackKeyIndices(
+	const UAnimSequence& Seq,
+	const uint8* RESTRICT TrackData,
+	int32 NumKeys,
+	int32 FormatFlags,
+	int32 BytesPerKey,
+	int32 FixedBytes,
+	float RelativePos,
+	bool bLooping,
+	FAnimKeyLookupCache& KeyLookups,
+	int32& Index0,
+	int32& Index1)
+{
+	if ((FormatFlags & 0x8) == 0)
+	{
+		// Uniformly spaced keys, so every other track with as many keys interpolates the same two
+		return TimeToIndex(Seq, RelativePos, bLooping, NumKeys, KeyLookups, Index0, Index1);
+	}
+
+	const uint8* RESTRICT FrameTable = Align(TrackData + FixedBytes + BytesPerKey * NumKeys, 4);
+	return TimeToIndex(Seq, FrameTable, RelativePos, bLooping, NumKeys, Index0, Index1);
+}
+
+/**
+ * Prefetches the keys of a track which will be interpolated
+ *
+ * @param	Seq				The animation sequence to use.
+ * @param	Offset			The offset of the track in the compressed byte stream, or INDEX_NONE for an identity track.
+ * @param	RelativePos		Current position within the animation to solve for in the range [0.0,1.0].
+ * @param	bLooping		True when looping the stream in intended.
+ * @param	KeyLookups		Key lookups already made for the pose.
+ * @param	OutKeys			Output value for the keys to interpolate, left alone for an identity track.
+ */
+void AEFPerTrackCompressionCodec::PrefetchTrackKeys(
+	const UAnimSequence& Seq,
+	int32 Offset,
+	float RelativePos,
+	bool bLooping,
+	FAnimKeyLookupCache& KeyLookups,
+	FPerTrackKeyIndices& OutKeys)
+{
+	if (Offset == INDEX_NONE)
+	{
+		// Identity track, nothing to load
+		return;
+	}
+
+	const uint8* RESTRICT TrackData = Seq.CompressedByteStream.GetTypedData() + Offset + 4;
+	const int32 Header = *((int32*)(Seq.CompressedByteStream.GetTypedData() + Offset));
+
+	int32 KeyFormat;
+	int32 NumKeys;
+	int32 FormatFlags;
+	int32 BytesPerKey;
+	int32 FixedBytes;
+	FAnimationCompression_PerTrackUtils::DecomposeHeader(Header, /*OUT*/ KeyFormat, /*OUT*/ NumKeys, /*OUT*/ FormatFlags, /*OUT*/BytesPerKey, /*OUT*/ FixedBytes);
+
+	OutKeys = FPerTrackKeyIndices();
+	if (NumKeys > 1)
+	{
+		OutKeys.Alpha = GetTrackKeyIndices(Seq, TrackData, NumKeys, FormatFlags, BytesPerKey, FixedBytes, RelativePos, bLooping, KeyLookups, OutKeys.Index0, OutKeys.Index1);
+	}
+
+	FPlatformMisc::Prefetch(TrackData + FixedBytes + (OutKeys.Index0 * BytesPerKey));
+	FPlatformMisc::Prefetch(TrackData + FixedBytes + (OutKeys.Index1 * BytesPerKey));
+}
+
 /**
  * Extracts a single BoneAtom from an Animation Sequence.
  *
@@ -468,14 +595,15 @@ void AEFPerTrackCompressionCodec::GetBoneAtom(
 	const int32 TransKeysOffset = TrackData[0];
 	const int32 RotKeysOffset = TrackData[1];
 	const float RelativePos = Time / (float)Seq.SequenceLength;
+	FAnimKeyLookupCache KeyLookups;
 
-	GetBoneAtomTranslation(OutAtom, Seq, TransKeysOffset, Time, RelativePos, bLooping);
-	GetBoneAtomRotation(OutAtom, Seq, RotKeysOffset, Time, RelativePos, bLooping);
+	GetBoneAtomTranslation(OutAtom, Seq, TransKeysOffset, Time, RelativePos, bLooping, KeyLookups);
+	GetBoneAtomRotation(OutAtom, Seq, RotKeysOffset, Time, RelativePos, bLooping, KeyLookups);
 	const bool bHasScaleData = Seq.CompressedScaleOffsets.IsValid();
 	if (bHasScaleData)
 	{
 		const int32 ScaleKeysOffset = Seq.CompressedScaleOffsets.GetOffsetData(TrackIndex, 0);
-		GetBoneAtomScale(OutAtom, Seq, ScaleKeysOffset, Time, RelativePos, bLooping);
+		GetBoneAtomScale(OutAtom, Seq, ScaleKeysOffset, Time, RelativePos, bLooping, KeyLookups);
 	}
 }
 	
@@ -490,7 +618,9 @@ void AEFPerTrackCompressionCodec::GetBoneAtomRotation(
 	int32 Offset,
 	float Time,
 	float RelativePos,
-	bool bLooping)
+	bool bLooping,
+	FAnimKeyLookupCache& KeyLookups,
+	const FPerTrackKeyIndices* KnownKeys)
 {
 	if (Offset != INDEX_NONE)
 	{
@@ -511,61 +641,47 @@ void AEFPerTrackCompressionCodec::GetBoneAtomRotation(
 		// Alpha is volatile to force the compiler to store it to memory immediately, so it is ready to be loaded into a vector register without a LHS after decompressing a track 
 		volatile float Alpha = 0.0f;
 
-		if (NumKeys > 1)
+		if (KnownKeys != NULL)
 		{
-			if ((FormatFlags & 0x8) == 0)
-			{
-				Alpha = TimeToIndex(Seq, RelativePos, bLooping, NumKeys, Index0, Index1);
-			}
-			else
-			{
-				const uint8* RESTRICT FrameTable = Align(TrackData + FixedBytes + BytesPerKey * NumKeys, 4);
-				Alpha = TimeToIndex(Seq, FrameTable, RelativePos, bLooping, NumKeys, Index0, Index1);
-			}
+			Index0 = KnownKeys->Index0;
+			Index1 = KnownKeys->Index1;
+			Alpha = KnownKeys->Alpha;
+		}
+		else if (NumKeys > 1)
+		{
+			Alpha = GetTrackKeyIndices(Seq, TrackData, NumKeys, FormatFlags, BytesPerKey, FixedBytes, RelativePos, bLooping, KeyLookups, Index0, Index1);
 		}
 
 		// Unpack the first key
 		const uint8* RESTRICT KeyData0 = TrackData + FixedBytes + (Index0 * BytesPerKey);
 
+		// Rotations are rebuilt, blended and normalized in vector registers whichever decompressor is used
 #if USE_VECTOR_PTC_DECOMPRESSOR
 		const VectorRegister R0 = DecompressSingleTrackRotationVectorized(KeyFormat, FormatFlags, TrackData, KeyData0);
 #else
-		FQuat R0;
-		FAnimationCompression_PerTrackUtils::DecompressRotation(KeyFormat, FormatFlags, R0, TrackData, KeyData0);
+		const VectorRegister R0 = DecompressSingleTrackRotationRegister(KeyFormat, FormatFlags, TrackData, KeyData0);
 #endif
+		VectorRegister Rotation = R0;
 
 		// If there is a second key, figure out the lerp between the two of them
 		if (Index0 != Index1)
 		{
 			const uint8* RESTRICT KeyData1 = TrackData + FixedBytes + (Index1 * BytesPerKey);
+			const ScalarRegister VAlpha(static_cast<float>(Alpha));
 
 #if USE_VECTOR_PTC_DECOMPRESSOR
-			ScalarRegister VAlpha(static_cast<float>(Alpha));
-
 			const VectorRegister R1 = DecompressSingleTrackRotationVectorized(KeyFormat, FormatFlags, TrackData, KeyData1);
-
-			const VectorRegister BlendedQuat = VectorLerpQuat(R0, R1, VAlpha);
-			const VectorRegister BlendedNormalizedQuat = VectorNormalizeQuaternion(BlendedQuat);
-			OutAtom.SetRotation(BlendedNormalizedQuat);
 #else
-			FQuat R1;
-			FAnimationCompression_PerTrackUtils::DecompressRotation(KeyFormat, FormatFlags, R1, TrackData, KeyData1);
-
-			// Fast linear quaternion interpolation.
-			// To ensure the 'shortest route', we make sure the dot product between the two keys is positive.
-			const float DotResult = (R0 | R1);
-			const float Bias = FMath::FloatSelect(DotResult, 1.0f, -1.0f);
-
-			FQuat BlendedQuat = (R0 * (1.f-Alpha)) + (R1 * (Alpha * Bias));
-			OutAtom.SetRotation( BlendedQuat );
-			OutAtom.NormalizeRotation();
+			const VectorRegister R1 = DecompressSingleTrackRotationRegister(KeyFormat, FormatFlags, TrackData, KeyData1);
 #endif
+
+			// Fast linear quaternion interpolation, along the shortest route
+			Rotation = VectorLerpQuat(R0, R1, VAlpha.Value);
 		}
-		else // (Index0 == Index1)
-		{
-			OutAtom.SetRotation( R0 );
-			OutAtom.NormalizeRotation();
-		}
+
+		FQuat NormalizedRotation;
+		VectorStoreAligned(VectorNormalizeQuaternion(Rotation), &NormalizedRotation);
+		OutAtom.SetRotation(NormalizedRotation);
 	}
 	else
 	{
@@ -582,7 +698,9 @@ void AEFPerTrackCompressionCodec::GetBoneAtomTranslation(
 	int32 Offset,
 	float Time,
 	float RelativePos,
-	bool bLooping)
+	bool bLooping,
+	FAnimKeyLookupCache& KeyLookups,
+	const FPerTrackKeyIndices* KnownKeys)
 {
 	if (Offset != INDEX_NONE)
 	{
@@ -603,17 +721,15 @@ void AEFPerTrackCompressionCodec::GetBoneAtomTranslation(
 		// Alpha is volatile to force the compiler to store it to memory immediately, so it is ready to be loaded into a vector register without a LHS after decompressing a track 
 		volatile float Alpha = 0.0f;
 
-		if (NumKeys > 1)
+		if (KnownKeys != NULL)
 		{
-			if ((FormatFlags & 0x8) == 0)
-			{
-				Alpha = TimeToIndex(Seq, RelativePos, bLooping, NumKeys, Index0, Index1);
-			}
-			else
-			{
-				const uint8* RESTRICT FrameTable = Align(TrackData + FixedBytes + BytesPerKey * NumKeys, 4);
-				Alpha = TimeToIndex(Seq, FrameTable, RelativePos, bLooping, NumKeys, Index0, Index1);
-			}
+			Index0 = KnownKeys->Index0;
+			Index1 = KnownKeys->Index1;
+			Alpha = KnownKeys->Alpha;
+		}
+		else if (NumKeys > 1)
+		{
+			Alpha = GetTrackKeyIndices(Seq, TrackData, NumKeys, FormatFlags, BytesPerKey, FixedBytes, RelativePos, bLooping, KeyLookups, Index0, Index1);
 		}
 
 		// Unpack the first key
@@ -668,7 +784,9 @@ void AEFPerTrackCompressionCodec::GetBoneAtomScale(
 	int32 Offset,
 	float Time,
 	float RelativePos,
-	bool bLooping)
+	bool bLooping,
+	FAnimKeyLookupCache& KeyLookups,
+	const FPerTrackKeyIndices* KnownKeys)
 {
 	if (Offset != INDEX_NONE)
 	{
@@ -689,17 +807,15 @@ void AEFPerTrackCompressionCodec::GetBoneAtomScale(
 		// Alpha is volatile to force the compiler to store it to memory immediately, so it is ready to be loaded into a vector register without a LHS after decompressing a track 
 		volatile float Alpha = 0.0f;
 
-		if (NumKeys > 1)
+		if (KnownKeys != NULL)
 		{
-			if ((FormatFlags & 0x8) == 0)
-			{
-				Alpha = TimeToIndex(Seq, RelativePos, bLooping, NumKeys, Index0, Index1);
-			}
-			else
-			{
-				const uint8* RESTRICT FrameTable = Align(TrackData + FixedBytes + BytesPerKey * NumKeys, 4);
-				Alpha = TimeToIndex(Seq, FrameTable, RelativePos, bLooping, NumKeys, Index0, Index1);
-			}
+			Index0 = KnownKeys->Index0;
+			Index1 = KnownKeys->Index1;
+			Alpha = KnownKeys->Alpha;
+		}
+		else if (NumKeys > 1)
+		{
+			Alpha = GetTrackKeyIndices(Seq, TrackData, NumKeys, FormatFlags, BytesPerKey, FixedBytes, RelativePos, bLooping, KeyLookups, Index0, Index1);
 		}
 
 		// Unpack the first key
@@ -747,3 +863,169 @@ void AEFPerTrackCompressionCodec::GetBoneAtomScale(
 	}
 }
 
+
+
+#if USE_ANIMATION_CODEC_BATCH_SOLVER
+
+/** Marks a component of a pose bone which wasn't requested, INDEX_NONE already means an identity track */
+static const int32 PoseTrackNotRequested = INDEX_NONE - 1;
+
+/** One bone of a pose, with the offsets of the tracks it is decompressed from and the keys found when they were prefetched */
+struct FPerTrackPoseBone
+{
+	int32 AtomIndex;
+	int32 TranslationOffset;
+	int32 RotationOffset;
+	int32 ScaleOffset;
+	FPerTrackKeyIndices TranslationKeys;
+	FPerTrackKeyIndices RotationKeys;
+	FPerTrackKeyIndices ScaleKeys;
+
+	FPerTrackPoseBone(int32 InAtomIndex)
+		: AtomIndex(InAtomIndex)
+		, TranslationOffset(PoseTrackNotRequested)
+		, RotationOffset(PoseTrackNotRequested)
+		, ScaleOffset(PoseTrackNotRequested)
+	{}
+};
+
+/** Prefetches the header of a track, so its keys can be found without a stall */
+static FORCEINLINE void PrefetchTrackHeader(const uint8* ByteStream, int32 Offset)
+{
+	if (Offset >= 0)
+	{
+		FPlatformMisc::Prefetch(ByteStream + Offset);
+	}
+}
+
+/**
+ * Decompress all requested rotation, translation and scale components from an Animation Sequence in one pass,
+ * sharing key lookups between tracks and prefetching the keys of the bones ahead
+ *
+ * @param	Atoms				The FTransform array to fill in.
+ * @param	RotationPairs		Array of bones requesting rotation data
+ * @param	TranslationPairs	Array of bones requesting translation data
+ * @param	ScalePairs			Array of bones requesting scale data
+ * @param	Seq					The animation sequence to use.
+ * @param	Time				Current time to solve for.
+ * @param	bLooping			True when looping the stream in intended.
+ */
+void AEFPerTrackCompressionCodec::GetPoseAtoms(
+	FTransformArray& Atoms,
+	const BoneTrackArray& RotationPairs,
+	const BoneTrackArray& TranslationPairs,
+	const BoneTrackArray& ScalePairs,
+	const UAnimSequence& Seq,
+	float Time,
+	bool bLooping)
+{
+	const float RelativePos = Time / Seq.SequenceLength;
+	const int32* RESTRICT TrackOffsets = Seq.CompressedTrackOffsets.GetTypedData();
+	const uint8* RESTRICT ByteStream = Seq.CompressedByteStream.GetTypedData();
+	FAnimKeyLookupCache KeyLookups;
+
+	// we allow scale key to be empty
+	const int32 NumRotationPairs = RotationPairs.Num();
+	const int32 NumTranslationPairs = TranslationPairs.Num();
+	const int32 NumScalePairs = Seq.CompressedScaleOffsets.IsValid() ? ScalePairs.Num() : 0;
+
+	// Gather the tracks of each bone first.  The pairs are built in track order, so the translations and scales
+	// line up with the rotations, anything which doesn't gets a bone of its own at the end.
+	TArray<FPerTrackPoseBone, TInlineAllocator<256> > Bones;
+	Bones.Reserve(NumRotationPairs);
+
+	int32 TranslationPairIndex = 0;
+	int32 ScalePairIndex = 0;
+	for (int32 PairIndex = 0; PairIndex < NumRotationPairs; ++PairIndex)
+	{
+		const BoneTrackPair& Pair = RotationPairs[PairIndex];
+		FPerTrackPoseBone& Bone = Bones[Bones.Add(FPerTrackPoseBone(Pair.AtomIndex))];
+		Bone.RotationOffset = TrackOffsets[(Pair.TrackIndex * 2) + 1];
+
+		if (TranslationPairIndex < NumTranslationPairs && TranslationPairs[TranslationPairIndex].AtomIndex == Pair.AtomIndex && TranslationPairs[TranslationPairIndex].TrackIndex == Pair.TrackIndex)
+		{
+			Bone.TranslationOffset = TrackOffsets[Pair.TrackIndex * 2];
+			++TranslationPairIndex;
+		}
+
+		if (ScalePairIndex < NumScalePairs && ScalePairs[ScalePairIndex].AtomIndex == Pair.AtomIndex && ScalePairs[ScalePairIndex].TrackIndex == Pair.TrackIndex)
+		{
+			Bone.ScaleOffset = Seq.CompressedScaleOffsets.GetOffsetData(Pair.TrackIndex, 0);
+			++ScalePairIndex;
+		}
+	}
+
+	for (; TranslationPairIndex < NumTranslationPairs; ++TranslationPairIndex)
+	{
+		const BoneTrackPair& Pair = TranslationPairs[TranslationPairIndex];
+		FPerTrackPoseBone& Bone = Bones[Bones.Add(FPerTrackPoseBone(Pair.AtomIndex))];
+		Bone.TranslationOffset = TrackOffsets[Pair.TrackIndex * 2];
+	}
+
+	for (; ScalePairIndex < NumScalePairs; ++ScalePairIndex)
+	{
+		const BoneTrackPair& Pair = ScalePairs[ScalePairIndex];
+		FPerTrackPoseBone& Bone = Bones[Bones.Add(FPerTrackPoseBone(Pair.AtomIndex))];
+		Bone.ScaleOffset = Seq.CompressedScaleOffsets.GetOffsetData(Pair.TrackIndex, 0);
+	}
+
+	// The tracks of a pose are scattered through the byte stream, so rather than stalling on each one in turn, the keys are
+	// prefetched a few bones ahead of the one being decompressed, and the headers needed to find them further ahead still
+	const int32 KeyPrefetchDistance = 4;
+	const int32 HeaderPrefetchDistance = KeyPrefetchDistance * 2;
+	const int32 NumBones = Bones.Num();
+
+	for (int32 BoneIndex = -HeaderPrefetchDistance; BoneIndex < NumBones; ++BoneIndex)
+	{
+		const int32 HeaderBoneIndex = BoneIndex + HeaderPrefetchDistance;
+		if (HeaderBoneIndex < NumBones)
+		{
+			const FPerTrackPoseBone& HeaderBone = Bones[HeaderBoneIndex];
+			PrefetchTrackHeader(ByteStream, HeaderBone.TranslationOffset);
+			PrefetchTrackHeader(ByteStream, HeaderBone.RotationOffset);
+			PrefetchTrackHeader(ByteStream, HeaderBone.ScaleOffset);
+		}
+
+		const int32 KeyBoneIndex = BoneIndex + KeyPrefetchDistance;
+		if (KeyBoneIndex >= 0 && KeyBoneIndex < NumBones)
+		{
+			FPerTrackPoseBone& KeyBone = Bones[KeyBoneIndex];
+			if (KeyBone.TranslationOffset != PoseTrackNotRequested)
+			{
+				PrefetchTrackKeys(Seq, KeyBone.TranslationOffset, RelativePos, bLooping, KeyLookups, KeyBone.TranslationKeys);
+			}
+			if (KeyBone.RotationOffset != PoseTrackNotRequested)
+			{
+				PrefetchTrackKeys(Seq, KeyBone.RotationOffset, RelativePos, bLooping, KeyLookups, KeyBone.RotationKeys);
+			}
+			if (KeyBone.ScaleOffset != PoseTrackNotRequested)
+			{
+				PrefetchTrackKeys(Seq, KeyBone.ScaleOffset, RelativePos, bLooping, KeyLookups, KeyBone.ScaleKeys);
+			}
+		}
+
+		if (BoneIndex < 0)
+		{
+			continue;
+		}
+
+		// Every bone had its keys prefetched, and found, before it is decompressed
+		const FPerTrackPoseBone& Bone = Bones[BoneIndex];
+		FTransform& BoneAtom = Atoms[Bone.AtomIndex];
+
+		if (Bone.TranslationOffset != PoseTrackNotRequested)
+		{
+			GetBoneAtomTranslation(BoneAtom, Seq, Bone.TranslationOffset, Time, RelativePos, bLooping, KeyLookups, &Bone.TranslationKeys);
+		}
+		if (Bone.RotationOffset != PoseTrackNotRequested)
+		{
+			GetBoneAtomRotation(BoneAtom, Seq, Bone.RotationOffset, Time, RelativePos, bLooping, KeyLookups, &Bone.RotationKeys);
+		}
+		if (Bone.ScaleOffset != PoseTrackNotRequested)
+		{
+			GetBoneAtomScale(BoneAtom, Seq, Bone.ScaleOffset, Time, RelativePos, bLooping, KeyLookups, &Bone.ScaleKeys);
+		}
+	}
+}
+
+#endif // USE_ANIMATION_CODEC_BATCH_SOLVER
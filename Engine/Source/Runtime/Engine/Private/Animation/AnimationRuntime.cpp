@@ -57,40 +57,17 @@ void FAnimationRuntime::BlendPosesTogether(int32 NumPoses, const FTransformArray
 	{
 		// debug purpose for now, but this can cause 0 bone transform, so we'd like to catch it 
 		float WeightSum=0.f;
+		TArray<const FTransform*, TInlineAllocator<8> > SourceAtoms;
 		for (int32 i = 0; i < NumPoses; ++i)
 		{
-			const ScalarRegister VBlendWeight(SourceWeights[i]);
-			const FTransformArrayA2& SourceAtoms = *SourcePoses[i];
-
 			WeightSum += SourceWeights[i];
-
-			if (i == 0)
-			{
-				// First pose will just overwrite the destination
-				for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
-				{
-					const int32 BoneIndex = RequiredBoneIndices[j];
-					ResultAtoms[BoneIndex] = SourceAtoms[BoneIndex] * VBlendWeight;
-				}
-			}
-			else
-			{
-				// Subsequent poses need to be blended in
-				for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
-				{
-					const int32 BoneIndex = RequiredBoneIndices[j];
-					ResultAtoms[BoneIndex].AccumulateWithShortestRotation(SourceAtoms[BoneIndex], VBlendWeight);
-				}
-			}
+			SourceAtoms.Add(SourcePoses[i]->GetTypedData());
 		}
 
 		ensure (WeightSum != 0.f);
 
 		// Ensure that all of the resulting rotations are normalized
-		if( NumPoses > 1 )
-		{
-			FAnimationRuntime::NormalizeRotations(RequiredBones, ResultAtoms);
-		}
+		FTransform::BlendIndexed(ResultAtoms.GetTypedData(), SourceAtoms.GetTypedData(), NumPoses, SourceWeights, false, RequiredBoneIndices.GetTypedData(), RequiredBoneIndices.Num(), NumPoses > 1);
 	}
 }
 
@@ -111,36 +88,14 @@ void FAnimationRuntime::BlendPosesTogether(int32 NumPoses, const TArray<FTransfo
 
 
 	const TArray<FBoneIndexType> & RequiredBoneIndices = RequiredBones.GetBoneIndicesArray();
+	TArray<const FTransform*, TInlineAllocator<8> > SourceAtoms;
 	for (int32 i = 0; i < NumPoses; ++i)
 	{
-		const ScalarRegister VBlendWeight(SourceWeights[i]);
-		const FTransformArrayA2& SourceAtoms = SourcePoses[i];
-
-		if (i == 0)
-		{
-			// First pose will just overwrite the destination
-			for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
-			{
-				const int32 BoneIndex = RequiredBoneIndices[j];
-				ResultAtoms[BoneIndex] = SourceAtoms[BoneIndex] * VBlendWeight;
-			}
-		}
-		else
-		{
-			// Subsequent poses need to be blended in
-			for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
-			{
-				const int32 BoneIndex = RequiredBoneIndices[j];
-				ResultAtoms[BoneIndex].AccumulateWithShortestRotation(SourceAtoms[BoneIndex], VBlendWeight);
-			}
-		}
+		SourceAtoms.Add(SourcePoses[i].GetTypedData());
 	}
 
 	// Ensure that all of the resulting rotations are normalized
-	if( NumPoses > 1 )
-	{
-		FAnimationRuntime::NormalizeRotations(RequiredBones, ResultAtoms);
-	}
+	FTransform::BlendIndexed(ResultAtoms.GetTypedData(), SourceAtoms.GetTypedData(), NumPoses, SourceWeights.GetTypedData(), false, RequiredBoneIndices.GetTypedData(), RequiredBoneIndices.Num(), NumPoses > 1);
 }
 
 /**
@@ -159,63 +114,35 @@ void FAnimationRuntime::BlendPosesTogetherPerBone(int32 NumPoses, const TArray<F
 	check(NumPoses > 0);
 
 	const TArray<FBoneIndexType> & RequiredBoneIndices = RequiredBones.GetBoneIndicesArray();
+	TArray<const FTransform*, TInlineAllocator<8> > SourceAtoms;
 	for (int32 i = 0; i < NumPoses; ++i)
 	{
-		const ScalarRegister VBlendWeight(BlendSampleDataCache[i].GetWeight());
-		TArray<ScalarRegister> PerBoneBlends;
-		for (int32 j=0; j<BlendSampleDataCache[i].PerBoneBlendData.Num(); ++j)
-		{
-			PerBoneBlends.Add(ScalarRegister(FMath::Clamp<float>(BlendSampleDataCache[i].PerBoneBlendData[j], 0.f, 1.f)));
-		}
-
-		const FTransformArrayA2& SourceAtoms = SourcePoses[i];
+		SourceAtoms.Add(SourcePoses[i].GetTypedData());
+	}
 
-		if (i == 0)
+	// The weights of all poses for each bone in turn, looking up the bone's per bone interpolation index only once
+	TArray<float> BoneWeights;
+	BoneWeights.AddUninitialized(RequiredBoneIndices.Num() * NumPoses);
+	float* BoneWeight = BoneWeights.GetTypedData();
+	for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
+	{
+		const int32 PerBoneIndex = BlendSpace->GetPerBoneInterpolationIndex(RequiredBoneIndices[j], RequiredBones);
+		for (int32 i = 0; i < NumPoses; ++i, ++BoneWeight)
 		{
-			// First pose will just overwrite the destination
-			for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
+			const FBlendSampleData& BlendSampleData = BlendSampleDataCache[i];
+			if (BlendSampleData.PerBoneBlendData.IsValidIndex(PerBoneIndex))
 			{
-				const int32 BoneIndex = RequiredBoneIndices[j];
-				int32 PerBoneIndex = BlendSpace->GetPerBoneInterpolationIndex(BoneIndex, RequiredBones);
-				if ( PerBoneIndex == INDEX_NONE )
-				{
-					ResultAtoms[BoneIndex] = SourceAtoms[BoneIndex] * VBlendWeight;
-				}
-				else if (!BlendSampleDataCache[i].PerBoneBlendData.IsValidIndex(PerBoneIndex))
-				{
-					ResultAtoms[BoneIndex] = SourceAtoms[BoneIndex] * VBlendWeight;
-				}
-				else
-				{
-					ResultAtoms[BoneIndex] = SourceAtoms[BoneIndex] * PerBoneBlends[PerBoneIndex];
-				}
+				*BoneWeight = FMath::Clamp<float>(BlendSampleData.PerBoneBlendData[PerBoneIndex], 0.f, 1.f);
 			}
-		}
-		else
-		{
-			// Subsequent poses need to be blended in
-			for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
+			else
 			{
-				const int32 BoneIndex = RequiredBoneIndices[j];
-				int32 PerBoneIndex = BlendSpace->GetPerBoneInterpolationIndex(BoneIndex, RequiredBones);
-				if ( PerBoneIndex == INDEX_NONE )
-				{
-					ResultAtoms[BoneIndex].AccumulateWithShortestRotation(SourceAtoms[BoneIndex], VBlendWeight);
-				}
-				else if (!BlendSampleDataCache[i].PerBoneBlendData.IsValidIndex(PerBoneIndex))
-				{
-					ResultAtoms[BoneIndex].AccumulateWithShortestRotation(SourceAtoms[BoneIndex], VBlendWeight);
-				}
-				else
-				{
-					ResultAtoms[BoneIndex].AccumulateWithShortestRotation(SourceAtoms[BoneIndex], PerBoneBlends[PerBoneIndex]);
-				}
+				*BoneWeight = BlendSampleData.GetWeight();
 			}
 		}
 	}
 
 	// Ensure that all of the resulting rotations are normalized
-	FAnimationRuntime::NormalizeRotations(RequiredBones, ResultAtoms);
+	FTransform::BlendIndexed(ResultAtoms.GetTypedData(), SourceAtoms.GetTypedData(), NumPoses, BoneWeights.GetTypedData(), true, RequiredBoneIndices.GetTypedData(), RequiredBoneIndices.Num(), true);
 }
 
 void FAnimationRuntime::BlendPosesTogetherPerBoneInMeshSpace(int32 NumPoses, TArray<FTransformArrayA2>& SourcePoses, const UBlendSpaceBase * BlendSpace, const TArray<FBlendSampleData>& BlendSampleDataCache, const FBoneContainer & RequiredBones, /*out*/ FTransformArrayA2& ResultAtoms)
@@ -274,14 +201,11 @@ void FAnimationRuntime::BlendPosesTogetherPerBoneInMeshSpace(int32 NumPoses, TAr
  */
 void FAnimationRuntime::BlendPosesAccumulate(const FTransformArrayA2& BlendPoses, const float BlendWeight, const FBoneContainer & RequiredBones, /*inout*/ FTransformArrayA2& ResultAtoms)
 {
-	const ScalarRegister VBlendWeight(BlendWeight);
 	const TArray<FBoneIndexType> & RequiredBoneIndices = RequiredBones.GetBoneIndicesArray();
-	// Subsequent poses need to be blended in
-	for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
-	{
-		const int32 BoneIndex = RequiredBoneIndices[j];
-		ResultAtoms[BoneIndex].AccumulateWithShortestRotation(BlendPoses[BoneIndex], VBlendWeight);
-	}
+	// Blend into the result with its current transforms at full weight, which leaves them as they are
+	const FTransform* SourceAtoms[2] = { ResultAtoms.GetTypedData(), BlendPoses.GetTypedData() };
+	const float SourceWeights[2] = { 1.f, BlendWeight };
+	FTransform::BlendIndexed(ResultAtoms.GetTypedData(), SourceAtoms, 2, SourceWeights, false, RequiredBoneIndices.GetTypedData(), RequiredBoneIndices.Num(), false);
 }
 
 void FAnimationRuntime::LerpBoneTransforms(TArray<FTransform> & A, const TArray<FTransform> & B, float Alpha, const TArray<FBoneIndexType> & RequiredBonesArray)
@@ -314,19 +238,9 @@ void FAnimationRuntime::LerpBoneTransforms(TArray<FTransform> & A, const TArray<
 
 void FAnimationRuntime::BlendAdditivePose(const FTransformArrayA2& SourcePoses, const FTransformArrayA2& AdditiveBlendPoses, const float BlendWeight, const FBoneContainer & RequiredBones, /*out*/ FTransformArrayA2& ResultAtoms)
 {
-	const ScalarRegister VBlendWeight(BlendWeight);
-	// Subsequent poses need to be blended in
-	const TArray<FBoneIndexType> & RequiredBoneIndices = RequiredBones.GetBoneIndicesArray();
-	for (int32 j = 0; j < RequiredBoneIndices.Num(); ++j)
-	{
-		const int32 BoneIndex = RequiredBoneIndices[j];
-		FTransform Additive = AdditiveBlendPoses[BoneIndex];
-		ResultAtoms[BoneIndex] = SourcePoses[BoneIndex];
-		FTransform::BlendFromIdentityAndAccumulate(ResultAtoms[BoneIndex], Additive, VBlendWeight);
-	}
-
 	// Ensure that all of the resulting rotations are normalized
-	FAnimationRuntime::NormalizeRotations(RequiredBones, ResultAtoms);
+	const TArray<FBoneIndexType> & RequiredBoneIndices = RequiredBones.GetBoneIndicesArray();
+	FTransform::BlendFromIdentityAndAccumulateIndexed(ResultAtoms.GetTypedData(), SourcePoses.GetTypedData(), AdditiveBlendPoses.GetTypedData(), BlendWeight, RequiredBoneIndices.GetTypedData(), RequiredBoneIndices.Num());
 }
 
 void FAnimationRuntime::CombineWithAdditiveAnimations(int32 NumAdditivePoses, const FTransformArrayA2** SourceAdditivePoses, const float* SourceAdditiveWeights, const FBoneContainer & RequiredBones, /*inout*/ FTransformArrayA2& Atoms)
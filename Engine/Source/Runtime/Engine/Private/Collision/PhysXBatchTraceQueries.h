@@ -0,0 +1,61 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_PHYSX
+
+#include "../PhysicsEngine/PhysXSupport.h"
+
+/**
+ * Batch queries used by the UWorld batch traces on one PhysX scene, one per worker slot.
+ * Creating a batch query allocates and changes the scene, so the queries are created on the game thread before a batch
+ * is split across the workers, and kept for the following batches. Each worker only uses the query of its own slot.
+ */
+class FPhysXBatchTraceQueries
+{
+public:
+
+	/** A batch query and the filter settings of the traces it is running. */
+	struct FSlot
+	{
+		PxBatchQuery*	PBatchQuery;
+		/** Actors ignored by the traces, read by the filter shader, whose constant block points to this slot. */
+		const uint32*	IgnoreActors;
+		int32			NumIgnoreActors;
+
+		FSlot()
+			: PBatchQuery(NULL)
+			, IgnoreActors(NULL)
+			, NumIgnoreActors(0)
+		{
+		}
+	};
+
+	FPhysXBatchTraceQueries( PxScene* PhysXScene );
+	~FPhysXBatchTraceQueries();
+
+	/**
+	 * Creates the queries of the slots that don't have one yet, game thread only
+	 * @param NumSlots - Number of slots the next batch is split into.
+	 */
+	void AllocateSlots( int32 NumSlots );
+
+	FSlot& GetSlot( int32 SlotIndex )
+	{
+		return Slots[SlotIndex];
+	}
+
+	PxScene* GetScene() const
+	{
+		return Scene;
+	}
+
+private:
+
+	PxScene*				Scene;
+
+	/** Slots are allocated one by one, so the filter shaders can point to them. */
+	TIndirectArray<FSlot>	Slots;
+};
+
+#endif // WITH_PHYSX
@@ -0,0 +1,409 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	WorldCollisionBatch.cpp: UWorld batched collision implementation
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Collision.h"
+#include "ParallelFor.h"
+
+#if WITH_PHYSX
+	#include "../PhysicsEngine/PhysXSupport.h"
+	#include "PhysXCollision.h"
+	#include "CollisionConversions.h"
+	#include "PhysXBatchTraceQueries.h"
+#endif
+
+/**
+ * Batch traces
+ * Every trace of a batch shares its channel, shape and parameters, so the batch can be run as PhysX batched scene queries with one filter shader.
+ * The traces are split into one range per worker so that each range costs about the same, and each range is run through the batch query of its own slot.
+ * The batch queries are created on the game thread and kept by the physics scene, the workers only execute them.
+ * Results are written straight into the caller's hit array, the only memory used per trace is the fixed size result buffer on the stack of each range.
+ */
+
+static int32 GBatchTraceParallel = 1;
+static FAutoConsoleVariableRef CVarBatchTraceParallel(
+	TEXT("p.BatchTraceParallel"),
+	GBatchTraceParallel,
+	TEXT("Whether to split batch traces across the task graph worker threads.\n")
+	TEXT(" 0: run on the calling thread\n")
+	TEXT(" 1: run on the worker threads (default)")
+	);
+
+/** Clears the results of a batch, so traces without a blocking hit are reported as such. */
+static void InitBatchTraceHits(const FBatchTraceQuery* Queries, int32 NumQueries, FHitResult* OutHits)
+{
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+	{
+		OutHits[QueryIndex] = FHitResult();
+		OutHits[QueryIndex].TraceStart = Queries[QueryIndex].Start;
+		OutHits[QueryIndex].TraceEnd = Queries[QueryIndex].End;
+	}
+}
+
+#if WITH_PHYSX
+
+namespace
+{
+	/** Number of traces handed to PhysX per execute of a batch query, which is the size of the result buffers on the stack. */
+	const int32 BatchTraceQueriesPerExecute = 64;
+
+	/** Fewest traces worth running on a worker of their own. */
+	const int32 BatchTraceMinQueriesPerTask = 128;
+
+	/** Most ranges a batch is split into. */
+	const int32 BatchTraceMaxTasks = 32;
+
+	/** Cost of a trace regardless of its length, in the same units as the length. Long traces cross more of the scene and cost more. */
+	const float BatchTraceQueryBaseCost = 512.0f;
+
+	FORCEINLINE float GetBatchTraceQueryCost(const FBatchTraceQuery& Query, float ShapeRadius)
+	{
+		return BatchTraceQueryBaseCost + (Query.End - Query.Start).Size() + ShapeRadius;
+	}
+
+	/**
+	 * Everything the traces of a batch share.
+	 * Initial overlaps are reported like GeomSweepSingle does, which doesn't post filter them either.
+	 */
+	struct FBatchTraceContext
+	{
+		const FBatchTraceQuery* Queries;
+		FHitResult* OutHits;
+		const PxGeometry* PGeom;
+		PxQuat PGeomRot;
+		PxFilterData PFilter;
+		PxSceneQueryFilterData PQueryFilterData;
+		FPhysXBatchTraceQueries* SyncQueries;
+		FPhysXBatchTraceQueries* AsyncQueries;
+		bool bReturnFaceIndex;
+		bool bReturnPhysicalMaterial;
+	};
+
+	/** Same as FPxQueryFilterCallback::preFilter for single queries. The constant block is a pointer to the slot running the query, which holds the ignored actors. */
+	PxQueryHitType::Enum BatchTracePreFilter(PxFilterData QueryFilter, PxFilterData ShapeFilter, const void* ConstantBlock, PxU32 ConstantBlockSize, PxHitFlags& HitFlags)
+	{
+		checkSlow(ConstantBlockSize == sizeof(FPhysXBatchTraceQueries::FSlot*));
+		const FPhysXBatchTraceQueries::FSlot& Slot = **(FPhysXBatchTraceQueries::FSlot* const*)ConstantBlock;
+
+		// See if we are ignoring the actor this shape belongs to (word0 of shape filterdata is actorID)
+		for (int32 Index = 0; Index < Slot.NumIgnoreActors; Index++)
+		{
+			if (Slot.IgnoreActors[Index] == ShapeFilter.word0)
+			{
+				return PxSceneQueryHitType::eNONE;
+			}
+		}
+
+		// Check if the shape is the right complexity for the trace
+		const PxU32 CommonFlags = (ShapeFilter.word3 & 0xFFFFFF) & (QueryFilter.word3 & 0xFFFFFF);
+		if (!(CommonFlags & EPDF_SimpleCollision) && !(CommonFlags & EPDF_ComplexCollision))
+		{
+			return PxSceneQueryHitType::eNONE;
+		}
+
+		// Only the blocking hit is kept for single traces
+		const PxSceneQueryHitType::Enum Result = FPxQueryFilterCallback::CalcQueryHitType(QueryFilter, ShapeFilter);
+		return Result == PxSceneQueryHitType::eBLOCK ? PxSceneQueryHitType::eBLOCK : PxSceneQueryHitType::eNONE;
+	}
+
+	/** Converts a hit of a batch query, unless a closer one was already found in another scene. */
+	template <typename PxHitType>
+	void ConvertBatchTraceHit(const FBatchTraceContext& Context, const PxBatchQueryResult<PxHitType>& PResult)
+	{
+		if (PResult.queryStatus != PxBatchQueryStatus::eSUCCESS || !PResult.hasBlock)
+		{
+			return;
+		}
+
+		const int32 QueryIndex = (int32)(PTRINT)PResult.userData;
+		const FBatchTraceQuery& Query = Context.Queries[QueryIndex];
+		FHitResult& OutHit = Context.OutHits[QueryIndex];
+
+		const float DeltaMag = (Query.End - Query.Start).Size();
+		if (OutHit.bBlockingHit && OutHit.Time * DeltaMag <= PResult.block.distance)
+		{
+			return;
+		}
+
+		const PxTransform PStartTM(U2PVector(Query.Start), Context.PGeomRot);
+		ConvertQueryImpactHit(PResult.block, OutHit, DeltaMag, Context.PFilter, Query.Start, Query.End, Context.PGeom, PStartTM, Context.bReturnFaceIndex, Context.bReturnPhysicalMaterial);
+	}
+
+	/** Runs traces [StartIndex, EndIndex) of a batch against one scene, through the batch query of the given slot. */
+	void RunBatchTraceRange(const FBatchTraceContext& Context, FPhysXBatchTraceQueries::FSlot& Slot, PxScene* PScene, int32 StartIndex, int32 EndIndex)
+	{
+		PxBatchQuery* PBatchQuery = Slot.PBatchQuery;
+		if (!PBatchQuery)
+		{
+			return;
+		}
+
+		PxRaycastQueryResult PRaycastResults[BatchTraceQueriesPerExecute];
+		PxSweepQueryResult PSweepResults[BatchTraceQueriesPerExecute];
+
+		PxBatchQueryMemory PQueryMemory(BatchTraceQueriesPerExecute, BatchTraceQueriesPerExecute, 0);
+		PQueryMemory.userRaycastResultBuffer = PRaycastResults;
+		PQueryMemory.userSweepResultBuffer = PSweepResults;
+		PBatchQuery->setUserMemory(PQueryMemory);
+
+		SCOPED_SCENE_READ_LOCK(PScene);
+
+		const PxSceneQueryFlags POutputFlags = PxSceneQueryFlag::ePOSITION | PxSceneQueryFlag::eNORMAL | PxSceneQueryFlag::eDISTANCE;
+
+		for (int32 ExecuteStartIndex = StartIndex; ExecuteStartIndex < EndIndex; ExecuteStartIndex += BatchTraceQueriesPerExecute)
+		{
+			const int32 ExecuteEndIndex = FMath::Min(ExecuteStartIndex + BatchTraceQueriesPerExecute, EndIndex);
+			int32 NumQueued = 0;
+
+			for (int32 QueryIndex = ExecuteStartIndex; QueryIndex < ExecuteEndIndex; QueryIndex++)
+			{
+				const FBatchTraceQuery& Query = Context.Queries[QueryIndex];
+				const FVector Delta = Query.End - Query.Start;
+				const float DeltaMag = Delta.Size();
+
+				if (DeltaMag > KINDA_SMALL_NUMBER)
+				{
+					const PxVec3 PDir = U2PVector(Delta / DeltaMag);
+					void* UserData = (void*)(PTRINT)QueryIndex;
+
+					if (Context.PGeom)
+					{
+						PBatchQuery->sweep(*Context.PGeom, PxTransform(U2PVector(Query.Start), Context.PGeomRot), PDir, DeltaMag, 0, POutputFlags, Context.PQueryFilterData, UserData);
+					}
+					else
+					{
+						PBatchQuery->raycast(U2PVector(Query.Start), PDir, DeltaMag, 0, POutputFlags, Context.PQueryFilterData, UserData);
+					}
+					NumQueued++;
+				}
+			}
+
+			if (NumQueued == 0)
+			{
+				continue;
+			}
+
+			PBatchQuery->execute();
+
+			for (int32 ResultIndex = 0; ResultIndex < NumQueued; ResultIndex++)
+			{
+				if (Context.PGeom)
+				{
+					ConvertBatchTraceHit(Context, PSweepResults[ResultIndex]);
+				}
+				else
+				{
+					ConvertBatchTraceHit(Context, PRaycastResults[ResultIndex]);
+				}
+			}
+		}
+	}
+
+	/** Runs one cost balanced range of a batch per task. */
+	struct FBatchTraceTaskBody
+	{
+		const FBatchTraceContext& Context;
+		const int32* TaskStartIndices;
+
+		FBatchTraceTaskBody(const FBatchTraceContext& InContext, const int32* InTaskStartIndices)
+			: Context(InContext)
+			, TaskStartIndices(InTaskStartIndices)
+		{
+		}
+
+		void operator()(int32 TaskIndex) const
+		{
+			const int32 StartIndex = TaskStartIndices[TaskIndex];
+			const int32 EndIndex = TaskStartIndices[TaskIndex + 1];
+
+			RunBatchTraceRange(Context, Context.SyncQueries->GetSlot(TaskIndex), Context.SyncQueries->GetScene(), StartIndex, EndIndex);
+
+			// Test async scene if async tests are requested, hits closer than the sync scene's replace them
+			if (Context.AsyncQueries)
+			{
+				RunBatchTraceRange(Context, Context.AsyncQueries->GetSlot(TaskIndex), Context.AsyncQueries->GetScene(), StartIndex, EndIndex);
+			}
+		}
+	};
+
+	/** Sets up the slots of the given number of tasks to run the traces of a batch. */
+	void PrepareBatchTraceSlots(FPhysXBatchTraceQueries* BatchTraceQueries, int32 NumTasks, const FCollisionQueryParams& Params)
+	{
+		BatchTraceQueries->AllocateSlots(NumTasks);
+		for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
+		{
+			FPhysXBatchTraceQueries::FSlot& Slot = BatchTraceQueries->GetSlot(TaskIndex);
+			Slot.IgnoreActors = Params.IgnoreActors.GetTypedData();
+			Slot.NumIgnoreActors = Params.IgnoreActors.Num();
+		}
+	}
+
+	/** Runs a batch of single traces, a NULL geometry makes them line traces. */
+	int32 BatchGeomTraceSingle(const UWorld* World, const PxGeometry* PGeom, const PxQuat& PGeomRot, float ShapeRadius, const FBatchTraceQuery* Queries, int32 NumQueries, FHitResult* OutHits, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, const FCollisionResponseParams& ResponseParams)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Collision_BatchTrace);
+		check(IsInGameThread());
+
+		InitBatchTraceHits(Queries, NumQueries, OutHits);
+
+		if (NumQueries == 0 || World == NULL || World->GetPhysicsScene() == NULL)
+		{
+			return 0;
+		}
+
+		FPhysScene* PhysScene = World->GetPhysicsScene();
+
+		FBatchTraceContext Context;
+		Context.Queries = Queries;
+		Context.OutHits = OutHits;
+		Context.PGeom = PGeom;
+		Context.PGeomRot = PGeomRot;
+		Context.PFilter = CreateQueryFilterData(TraceChannel, Params.bTraceComplex, ResponseParams.CollisionResponse, FCollisionObjectQueryParams::DefaultObjectQueryParam, false);
+		Context.PQueryFilterData = PxSceneQueryFilterData(Context.PFilter, PxSceneQueryFilterFlag::eSTATIC | PxSceneQueryFilterFlag::eDYNAMIC | PxSceneQueryFilterFlag::ePREFILTER);
+		Context.SyncQueries = PhysScene->GetBatchTraceQueries(PST_Sync);
+		Context.AsyncQueries = Params.bTraceAsyncScene && PhysScene->HasAsyncScene() ? PhysScene->GetBatchTraceQueries(PST_Async) : NULL;
+		Context.bReturnFaceIndex = PGeom == NULL && Params.bReturnFaceIndex;
+		Context.bReturnPhysicalMaterial = Params.bReturnPhysicalMaterial;
+
+		// Split the batch into ranges of about the same cost, one per worker
+		const int32 MaxTasks = GBatchTraceParallel ? FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, BatchTraceMaxTasks) : 1;
+		const int32 NumTasks = FMath::Clamp(NumQueries / BatchTraceMinQueriesPerTask, 1, MaxTasks);
+
+		int32 TaskStartIndices[BatchTraceMaxTasks + 1];
+		TaskStartIndices[0] = 0;
+
+		if (NumTasks > 1)
+		{
+			float TotalCost = 0.0f;
+			for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+			{
+				TotalCost += GetBatchTraceQueryCost(Queries[QueryIndex], ShapeRadius);
+			}
+
+			const float CostPerTask = TotalCost / NumTasks;
+			float Cost = 0.0f;
+			int32 TaskIndex = 1;
+			for (int32 QueryIndex = 0; QueryIndex < NumQueries && TaskIndex < NumTasks; QueryIndex++)
+			{
+				Cost += GetBatchTraceQueryCost(Queries[QueryIndex], ShapeRadius);
+				if (Cost >= CostPerTask * TaskIndex)
+				{
+					TaskStartIndices[TaskIndex++] = QueryIndex + 1;
+				}
+			}
+			while (TaskIndex < NumTasks)
+			{
+				TaskStartIndices[TaskIndex++] = NumQueries;
+			}
+		}
+		TaskStartIndices[NumTasks] = NumQueries;
+
+		PrepareBatchTraceSlots(Context.SyncQueries, NumTasks, Params);
+		if (Context.AsyncQueries)
+		{
+			PrepareBatchTraceSlots(Context.AsyncQueries, NumTasks, Params);
+		}
+
+		ParallelFor(NumTasks, FBatchTraceTaskBody(Context, TaskStartIndices), 1, NumTasks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+		int32 NumBlockingHits = 0;
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+		{
+			NumBlockingHits += OutHits[QueryIndex].bBlockingHit ? 1 : 0;
+		}
+		return NumBlockingHits;
+	}
+}
+
+FPhysXBatchTraceQueries::FPhysXBatchTraceQueries( PxScene* PhysXScene )
+	: Scene(PhysXScene)
+{
+}
+
+FPhysXBatchTraceQueries::~FPhysXBatchTraceQueries()
+{
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); SlotIndex++)
+	{
+		if (Slots[SlotIndex].PBatchQuery)
+		{
+			Slots[SlotIndex].PBatchQuery->release();
+		}
+	}
+}
+
+void FPhysXBatchTraceQueries::AllocateSlots( int32 NumSlots )
+{
+	check(IsInGameThread());
+
+	if (Slots.Num() >= NumSlots)
+	{
+		return;
+	}
+
+	SCOPED_SCENE_WRITE_LOCK(Scene);
+
+	while (Slots.Num() < NumSlots)
+	{
+		FSlot* Slot = new FSlot();
+		Slots.Add(Slot);
+
+		// Result buffers are set before every use, from the stack of the worker running the slot
+		PxBatchQueryDesc PDesc(BatchTraceQueriesPerExecute, BatchTraceQueriesPerExecute, 0);
+		PDesc.filterShaderData = &Slot;
+		PDesc.filterShaderDataSize = sizeof(FSlot*);
+		PDesc.preFilterShader = BatchTracePreFilter;
+
+		Slot->PBatchQuery = Scene->createBatchQuery(PDesc);
+	}
+}
+
+#endif // WITH_PHYSX
+
+int32 UWorld::BatchLineTraceSingle(const FBatchTraceQuery* Queries, int32 NumQueries, FHitResult* OutHits, ECollisionChannel TraceChannel, const struct FCollisionQueryParams& Params, const struct FCollisionResponseParams& ResponseParam) const
+{
+#if WITH_PHYSX
+	return BatchGeomTraceSingle(this, NULL, PxQuat::createIdentity(), 0.0f, Queries, NumQueries, OutHits, TraceChannel, Params, ResponseParam);
+#else
+	InitBatchTraceHits(Queries, NumQueries, OutHits);
+	return 0;
+#endif // WITH_PHYSX
+}
+
+int32 UWorld::BatchSweepSingle(const FBatchTraceQuery* Queries, int32 NumQueries, FHitResult* OutHits, const FQuat& Rot, ECollisionChannel TraceChannel, const struct FCollisionShape& CollisionShape, const struct FCollisionQueryParams& Params, const struct FCollisionResponseParams& ResponseParam) const
+{
+	if (CollisionShape.IsNearlyZero())
+	{
+		// if extent is 0, we'll just do linetrace instead
+		return BatchLineTraceSingle(Queries, NumQueries, OutHits, TraceChannel, Params, ResponseParam);
+	}
+
+#if WITH_PHYSX
+	switch (CollisionShape.ShapeType)
+	{
+	case ECollisionShape::Box:
+		{
+			const PxBoxGeometry PBoxGeom( U2PVector(CollisionShape.GetBox()) );
+			return BatchGeomTraceSingle(this, &PBoxGeom, U2PQuat(Rot), CollisionShape.GetBox().Size(), Queries, NumQueries, OutHits, TraceChannel, Params, ResponseParam);
+		}
+	case ECollisionShape::Sphere:
+		{
+			const PxSphereGeometry PSphereGeom( CollisionShape.GetSphereRadius() );
+			return BatchGeomTraceSingle(this, &PSphereGeom, PxQuat::createIdentity(), CollisionShape.GetSphereRadius(), Queries, NumQueries, OutHits, TraceChannel, Params, ResponseParam);
+		}
+	case ECollisionShape::Capsule:
+		{
+			const PxCapsuleGeometry PCapsuleGeom( CollisionShape.GetCapsuleRadius(), CollisionShape.GetCapsuleAxisHalfLength() );
+			return BatchGeomTraceSingle(this, &PCapsuleGeom, ConvertToPhysXCapsuleRot(Rot), CollisionShape.GetCapsuleHalfHeight(), Queries, NumQueries, OutHits, TraceChannel, Params, ResponseParam);
+		}
+	default:
+		// invalid shape
+		ensure(false);
+	}
+#endif // WITH_PHYSX
+
+	InitBatchTraceHits(Queries, NumQueries, OutHits);
+	return 0;
+}
@@ -0,0 +1,113 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	GCBenchmarkCommandlet.cpp: Commandlet measuring GC reachability analysis
+	on synthetic object graphs.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGCBenchmark, Log, All);
+
+UGCBenchmarkObject::UGCBenchmarkObject(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+{
+}
+
+UGCBenchmarkCommandlet::UGCBenchmarkCommandlet(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+{
+	IsClient = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGCBenchmarkCommandlet::Main( const FString& Params )
+{
+	const TCHAR* Parms = *Params;
+
+	FString Shape = TEXT("Tree");
+	int32 NumObjects = 200000;
+	int32 FanOut = 4;
+	int32 NumIterations = 10;
+	int32 MaxThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	FParse::Value(Parms, TEXT("SHAPE="), Shape);
+	FParse::Value(Parms, TEXT("OBJECTS="), NumObjects);
+	FParse::Value(Parms, TEXT("FANOUT="), FanOut);
+	FParse::Value(Parms, TEXT("ITERATIONS="), NumIterations);
+	FParse::Value(Parms, TEXT("MAXTHREADS="), MaxThreads);
+	NumObjects = FMath::Max(NumObjects, 1);
+	FanOut = FMath::Max(FanOut, 1);
+	NumIterations = FMath::Max(NumIterations, 1);
+	MaxThreads = FMath::Max(MaxThreads, 1);
+
+	const bool bChain = Shape == TEXT("Chain");
+	const bool bRandom = Shape == TEXT("Random");
+	if (!bChain && !bRandom && Shape != TEXT("Tree"))
+	{
+		UE_LOG(LogGCBenchmark, Error, TEXT("Unknown graph shape %s, expected Tree, Chain or Random."), *Shape);
+		return 1;
+	}
+
+	// Build the graph. Every node is reachable from the first one, which is the only one in the root set.
+	TArray<UGCBenchmarkObject*> Nodes;
+	Nodes.Empty(NumObjects);
+	FRandomStream RandomStream(0x5eed);
+	for (int32 NodeIndex = 0; NodeIndex < NumObjects; NodeIndex++)
+	{
+		UGCBenchmarkObject* Node = NewObject<UGCBenchmarkObject>(GetTransientPackage());
+		if (NodeIndex > 0)
+		{
+			const int32 ParentIndex = bChain ? NodeIndex - 1 : (bRandom ? RandomStream.RandHelper(NodeIndex) : (NodeIndex - 1) / FanOut);
+			Nodes[ParentIndex]->References.Add(Node);
+		}
+		Nodes.Add(Node);
+	}
+	Nodes[0]->AddToRoot();
+	if (bRandom)
+	{
+		for (int32 NodeIndex = 0; NodeIndex < NumObjects; NodeIndex++)
+		{
+			for (int32 ReferenceIndex = 1; ReferenceIndex < FanOut; ReferenceIndex++)
+			{
+				Nodes[NodeIndex]->References.Add(Nodes[RandomStream.RandHelper(NumObjects)]);
+			}
+		}
+	}
+
+	// Collect once to get rid of unrelated garbage and to assemble the token streams.
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	UE_LOG(LogGCBenchmark, Display, TEXT("%s graph of %d objects with a fan out of %d"), *Shape, NumObjects, FanOut);
+
+	IConsoleVariable* MaxParallelGCThreads = IConsoleManager::Get().FindConsoleVariable(TEXT("MaxParallelGCThreads"));
+	check(MaxParallelGCThreads);
+	const int32 PreviousMaxParallelGCThreads = MaxParallelGCThreads->GetInt();
+
+	double SingleThreadTime = 0.0;
+	for (int32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads++)
+	{
+		MaxParallelGCThreads->Set(NumThreads);
+		double TotalTime = 0.0;
+		double BestTime = MAX_dbl;
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			TotalTime += GLastGCReachabilityTime;
+			BestTime = FMath::Min(BestTime, GLastGCReachabilityTime);
+		}
+		const double AverageTime = TotalTime / NumIterations;
+		if (NumThreads == 1)
+		{
+			SingleThreadTime = AverageTime;
+		}
+		UE_LOG(LogGCBenchmark, Display, TEXT("%2d threads: %8.3f ms average, %8.3f ms best, %5.2fx speedup"),
+			NumThreads, AverageTime * 1000.0, BestTime * 1000.0, SingleThreadTime / AverageTime);
+	}
+
+	MaxParallelGCThreads->Set(PreviousMaxParallelGCThreads);
+	Nodes[0]->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return 0;
+}
@@ -0,0 +1,276 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	SocketStressCommandlet.cpp: Commandlet measuring single and batched UDP
+	receives and sends on loopback sockets.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSocketStress, Log, All);
+
+/** Max size of the stress datagrams, same as the net driver packets */
+#define SOCKET_STRESS_MAX_PACKET (576)
+
+/** Datagrams per RecvFromMulti and SendToMulti call, each call is a single system call when the socket batches natively */
+#define SOCKET_STRESS_BATCH (64)
+
+/** Results of one run of the stress test */
+struct FSocketStressResult
+{
+	FSocketStressResult()
+		: ServerSeconds(0.0)
+		, SentByClients(0)
+		, ReceivedByServer(0)
+		, ReceivedByClients(0)
+		, ServerSocketCalls(0)
+	{
+	}
+
+	/** Time the server spent receiving and replying */
+	double ServerSeconds;
+	int64 SentByClients;
+	int64 ReceivedByServer;
+	int64 ReceivedByClients;
+	/** System calls made on the server socket */
+	int64 ServerSocketCalls;
+};
+
+/** Reads everything pending on a client socket, returns the number of datagrams read */
+static int32 DrainClientSocket(FSocket* Socket, FInternetAddr& FromAddr)
+{
+	uint8 Data[SOCKET_STRESS_MAX_PACKET];
+	int32 NumRead = 0;
+	int32 BytesRead = 0;
+	while (Socket->RecvFrom(Data, sizeof(Data), BytesRead, FromAddr))
+	{
+		NumRead++;
+	}
+	return NumRead;
+}
+
+/** Runs the stress test once, with the server using either the single or the batched socket calls */
+static FSocketStressResult RunSocketStress(ISocketSubsystem* SocketSubsystem, FSocket* ServerSocket, const TArray<FSocket*>& ClientSockets, const FInternetAddr& ServerAddr,
+	int32 NumTicks, int32 NumPackets, int32 PacketSize, bool bBatched)
+{
+	FSocketStressResult Result;
+
+	const bool bNative = ServerSocket->HasNativeDatagramBatching();
+	uint8 Payload[SOCKET_STRESS_MAX_PACKET];
+	FMemory::Memset(Payload, 0x5a, sizeof(Payload));
+
+	// Server buffers, large enough to hold everything sent in a tick
+	const int32 MaxPerTick = ClientSockets.Num() * NumPackets;
+	TArray<uint8> ServerData;
+	ServerData.AddUninitialized(MaxPerTick * SOCKET_STRESS_MAX_PACKET);
+	TArray< TSharedRef<FInternetAddr> > ServerAddrs;
+	TArray<FSocketDatagram> Datagrams;
+	Datagrams.AddZeroed(MaxPerTick);
+	for (int32 Index = 0; Index < MaxPerTick; Index++)
+	{
+		ServerAddrs.Add(SocketSubsystem->CreateInternetAddr());
+		Datagrams[Index].Data = ServerData.GetTypedData() + Index * SOCKET_STRESS_MAX_PACKET;
+		Datagrams[Index].Address = &ServerAddrs[Index].Get();
+	}
+	TSharedRef<FInternetAddr> ClientFromAddr = SocketSubsystem->CreateInternetAddr();
+
+	for (int32 Tick = 0; Tick < NumTicks; Tick++)
+	{
+		for (int32 ClientIndex = 0; ClientIndex < ClientSockets.Num(); ClientIndex++)
+		{
+			for (int32 PacketIndex = 0; PacketIndex < NumPackets; PacketIndex++)
+			{
+				int32 BytesSent = 0;
+				if (ClientSockets[ClientIndex]->SendTo(Payload, PacketSize, BytesSent, ServerAddr))
+				{
+					Result.SentByClients++;
+				}
+			}
+		}
+
+		for (int32 Index = 0; Index < MaxPerTick; Index++)
+		{
+			Datagrams[Index].Size = SOCKET_STRESS_MAX_PACKET;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Receive everything the clients sent
+		int32 NumReceived = 0;
+		while (NumReceived < MaxPerTick)
+		{
+			int32 NumRead = 0;
+			if (bBatched)
+			{
+				const int32 NumToRead = FMath::Min(MaxPerTick - NumReceived, SOCKET_STRESS_BATCH);
+				NumRead = ServerSocket->RecvFromMulti(Datagrams.GetTypedData() + NumReceived, NumToRead);
+				Result.ServerSocketCalls++;
+			}
+			else
+			{
+				FSocketDatagram& Datagram = Datagrams[NumReceived];
+				NumRead = ServerSocket->RecvFrom(Datagram.Data, Datagram.Size, Datagram.BytesTransferred, *Datagram.Address) ? 1 : -1;
+				Result.ServerSocketCalls++;
+			}
+
+			if (NumRead <= 0)
+			{
+				break;
+			}
+			NumReceived += NumRead;
+		}
+		Result.ReceivedByServer += NumReceived;
+
+		// Echo every datagram back to its sender
+		for (int32 Index = 0; Index < NumReceived; Index++)
+		{
+			Datagrams[Index].Size = Datagrams[Index].BytesTransferred;
+		}
+		if (bBatched)
+		{
+			for (int32 First = 0; First < NumReceived; First += SOCKET_STRESS_BATCH)
+			{
+				const int32 NumToSend = FMath::Min(NumReceived - First, SOCKET_STRESS_BATCH);
+				ServerSocket->SendToMulti(Datagrams.GetTypedData() + First, NumToSend);
+				Result.ServerSocketCalls += bNative ? 1 : NumToSend;
+			}
+		}
+		else
+		{
+			for (int32 Index = 0; Index < NumReceived; Index++)
+			{
+				ServerSocket->SendTo(Datagrams[Index].Data, Datagrams[Index].Size, Datagrams[Index].BytesTransferred, *Datagrams[Index].Address);
+				Result.ServerSocketCalls++;
+			}
+		}
+
+		Result.ServerSeconds += FPlatformTime::Seconds() - StartTime;
+
+		for (int32 ClientIndex = 0; ClientIndex < ClientSockets.Num(); ClientIndex++)
+		{
+			Result.ReceivedByClients += DrainClientSocket(ClientSockets[ClientIndex], *ClientFromAddr);
+		}
+	}
+
+	return Result;
+}
+
+/** Creates a non blocking UDP socket bound to a free loopback port */
+static FSocket* CreateStressSocket(ISocketSubsystem* SocketSubsystem, const TCHAR* Description, int32 BufferSize)
+{
+	FSocket* Socket = SocketSubsystem->CreateSocket(NAME_DGram, Description);
+	if (Socket == NULL)
+	{
+		return NULL;
+	}
+
+	TSharedRef<FInternetAddr> BindAddr = SocketSubsystem->CreateInternetAddr(0x7f000001, 0);
+	int32 NewSize = 0;
+	Socket->SetReceiveBufferSize(BufferSize, NewSize);
+	Socket->SetSendBufferSize(BufferSize, NewSize);
+	if (!Socket->Bind(*BindAddr) || !Socket->SetNonBlocking())
+	{
+		SocketSubsystem->DestroySocket(Socket);
+		return NULL;
+	}
+	return Socket;
+}
+
+USocketStressCommandlet::USocketStressCommandlet(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+{
+	IsClient = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USocketStressCommandlet::Main( const FString& Params )
+{
+	const TCHAR* Parms = *Params;
+
+	int32 NumClients = 64;
+	int32 NumTicks = 300;
+	int32 NumPackets = 4;
+	int32 PacketSize = 128;
+	FParse::Value(Parms, TEXT("CLIENTS="), NumClients);
+	FParse::Value(Parms, TEXT("TICKS="), NumTicks);
+	FParse::Value(Parms, TEXT("PACKETS="), NumPackets);
+	FParse::Value(Parms, TEXT("SIZE="), PacketSize);
+	NumClients = FMath::Max(NumClients, 1);
+	NumTicks = FMath::Max(NumTicks, 1);
+	NumPackets = FMath::Max(NumPackets, 1);
+	PacketSize = FMath::Clamp(PacketSize, 1, SOCKET_STRESS_MAX_PACKET);
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get();
+	if (SocketSubsystem == NULL)
+	{
+		UE_LOG(LogSocketStress, Error, TEXT("Unable to find socket subsystem."));
+		return 1;
+	}
+
+	// The server has to buffer a whole tick worth of datagrams
+	const int32 ServerBufferSize = FMath::Max(NumClients * NumPackets * (PacketSize + 64) * 2, 0x20000);
+	FSocket* ServerSocket = CreateStressSocket(SocketSubsystem, TEXT("SocketStress Server"), ServerBufferSize);
+	TArray<FSocket*> ClientSockets;
+	bool bSocketsCreated = ServerSocket != NULL;
+	for (int32 ClientIndex = 0; ClientIndex < NumClients && bSocketsCreated; ClientIndex++)
+	{
+		FSocket* ClientSocket = CreateStressSocket(SocketSubsystem, TEXT("SocketStress Client"), 0x8000);
+		bSocketsCreated = ClientSocket != NULL;
+		if (ClientSocket != NULL)
+		{
+			ClientSockets.Add(ClientSocket);
+		}
+	}
+
+	int32 ReturnCode = 0;
+	if (!bSocketsCreated)
+	{
+		UE_LOG(LogSocketStress, Error, TEXT("Unable to create the loopback sockets (%i)."), (int32)SocketSubsystem->GetLastErrorCode());
+		ReturnCode = 1;
+	}
+	else
+	{
+		TSharedRef<FInternetAddr> ServerAddr = SocketSubsystem->CreateInternetAddr(0x7f000001, 0);
+		ServerAddr->SetPort(ServerSocket->GetPortNo());
+
+		UE_LOG(LogSocketStress, Display, TEXT("%i clients, %i ticks, %i packets of %i bytes per client per tick."), NumClients, NumTicks, NumPackets, PacketSize);
+		if (!ServerSocket->HasNativeDatagramBatching())
+		{
+			UE_LOG(LogSocketStress, Display, TEXT("The %s sockets don't batch datagrams natively, the batched path falls back to a system call per datagram."), SocketSubsystem->GetSocketAPIName());
+		}
+
+		for (int32 Pass = 0; Pass < 2; Pass++)
+		{
+			const bool bBatched = Pass == 1;
+			const FSocketStressResult Result = RunSocketStress(SocketSubsystem, ServerSocket, ClientSockets, *ServerAddr, NumTicks, NumPackets, PacketSize, bBatched);
+
+			const int64 ServerPackets = Result.ReceivedByServer * 2;
+			const double PacketsPerSecond = Result.ServerSeconds > 0.0 ? ServerPackets / Result.ServerSeconds : 0.0;
+			const double Loss = Result.SentByClients > 0 ? 100.0 * (1.0 - double(Result.ReceivedByClients) / double(Result.SentByClients)) : 0.0;
+			UE_LOG(LogSocketStress, Display, TEXT("%s: %.0f packets/s received and sent by the server, %.1f system calls per tick, %.2f ms per tick, %.2f%% lost (%lld sent, %lld received by the server, %lld replies received)."),
+				bBatched ? TEXT("Batched") : TEXT("Single "),
+				PacketsPerSecond,
+				double(Result.ServerSocketCalls) / NumTicks,
+				Result.ServerSeconds * 1000.0 / NumTicks,
+				Loss,
+				Result.SentByClients,
+				Result.ReceivedByServer,
+				Result.ReceivedByClients);
+		}
+	}
+
+	for (int32 ClientIndex = 0; ClientIndex < ClientSockets.Num(); ClientIndex++)
+	{
+		SocketSubsystem->DestroySocket(ClientSockets[ClientIndex]);
+	}
+	if (ServerSocket != NULL)
+	{
+		SocketSubsystem->DestroySocket(ServerSocket);
+	}
+
+	return ReturnCode;
+}
@@ -215,6 +215,9 @@ void FObjectReplicator::StartReplicating( class UActorChannel * InActorChannel )
 		check( !ObjectNetGUID.IsDefault() && ObjectNetGUID.IsValid() );
 	}
 
+	// Movement states sent or received on a previous channel (before going dormant) mean nothing to this one
+	RepState->MovementDelta.Reset();
+
 	// Allocate retirement list.
 	// SetNum now constructs, so this is safe
 	Retirement.SetNum( ObjectClass->ClassReps.Num() );
@@ -0,0 +1,68 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	DemoNetConnection.cpp: Connection used to record and play back replays
+=============================================================================*/
+
+#include "EnginePrivate.h"
+
+UDemoNetConnection::UDemoNetConnection(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+	, bDiscardPackets(false)
+{
+}
+
+void UDemoNetConnection::InitConnection(UNetDriver* InDriver, EConnectionState InState, const FURL& InURL, int32 InConnectionSpeed)
+{
+	Super::InitConnection(InDriver, InState, InURL, InConnectionSpeed);
+
+	URL = InURL;
+
+	StatUpdateTime = Driver->Time;
+	LastReceiveTime = Driver->Time;
+	LastSendTime = Driver->Time;
+	LastTickTime = Driver->Time;
+	LastRecvAckTime = Driver->Time;
+	ConnectTime = Driver->Time;
+
+	// Everything that is sent is recorded, or comes from the recording
+	InternalAck = true;
+
+#if DO_ENABLE_NET_TEST
+	// Simulated lag or loss would end up in the replay
+	PacketSimulationSettings = FPacketSimulationSettings();
+#endif
+
+	InitOut();
+}
+
+FString UDemoNetConnection::LowLevelGetRemoteAddress(bool bAppendPort)
+{
+	return TEXT("UDemoNetConnection");
+}
+
+FString UDemoNetConnection::LowLevelDescribe()
+{
+	return FString::Printf(TEXT("Demo connection %s"), bDiscardPackets ? TEXT("(discarded)") : TEXT(""));
+}
+
+void UDemoNetConnection::LowLevelSend(void* Data, int32 Count)
+{
+	if (bDiscardPackets)
+	{
+		return;
+	}
+
+	// During playback, the packets would go to the server the replay was recorded on, so they are dropped
+	UDemoNetDriver* DemoDriver = CastChecked<UDemoNetDriver>(Driver);
+	if (DemoDriver->IsRecording())
+	{
+		DemoDriver->QueuePacket((const uint8*)Data, Count);
+	}
+}
+
+int32 UDemoNetConnection::IsNetReady(bool Saturate)
+{
+	// Nothing goes over the wire, so the connection is never saturated
+	return 1;
+}
@@ -0,0 +1,634 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	DemoNetDriver.cpp: Net driver that records and plays back replays
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/ReplayStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDemo, Log, All);
+
+DEFINE_STAT(STAT_NetDemoRecordTime);
+DEFINE_STAT(STAT_NetDemoPlaybackTime);
+
+/** Speed of the demo connections, they are never saturated so this only keeps the bandwidth math sane */
+#define DEMO_CONNECTION_SPEED	1000000
+
+UDemoNetDriver::UDemoNetDriver(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+	, CheckpointInterval(30.0f)
+	, MaxRecordHz(8.0f)
+	, WriteBufferSize(64 * 1024)
+	, DemoCurrentTime(0.0f)
+	, DemoTotalTime(0.0f)
+	, PlaybackSpeed(1.0f)
+	, Writer(NULL)
+	, Reader(NULL)
+	, LastRecordTime(0.0f)
+	, LastCheckpointTime(0.0f)
+{
+}
+
+FString UDemoNetDriver::GetDemoFilename(const FString& DemoName)
+{
+	return FPaths::Combine(*FPaths::GameSavedDir(), TEXT("Demos"), *(DemoName + TEXT(".replay")));
+}
+
+bool UDemoNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error)
+{
+	// The connection class isn't configurable, the driver relies on it
+	NetConnectionClass = UDemoNetConnection::StaticClass();
+
+	if (!Super::InitBase(bInitAsClient, InNotify, URL, bReuseAddressAndPort, Error))
+	{
+		return false;
+	}
+
+	DemoCurrentTime = 0.0f;
+	DemoTotalTime = 0.0f;
+	PlaybackSpeed = 1.0f;
+	return true;
+}
+
+bool UDemoNetDriver::InitListen(FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error)
+{
+	check(World != NULL);
+
+	if (!InitBase(false, InNotify, ListenURL, bReuseAddressAndPort, Error))
+	{
+		return false;
+	}
+
+	DemoFilename = GetDemoFilename(ListenURL.Map);
+
+	FReplayHeader Header;
+	Header.MapName = World->GetOutermost()->GetName();
+
+	Writer = FReplayStreamWriter::Create(DemoFilename, Header, WriteBufferSize);
+	if (Writer == NULL)
+	{
+		Error = FString::Printf(TEXT("Couldn't create replay %s"), *DemoFilename);
+		return false;
+	}
+
+	LastRecordTime = -BIG_NUMBER;
+	LastCheckpointTime = 0.0f;
+
+	CreateRecordConnection();
+
+	UE_LOG(LogDemo, Log, TEXT("Recording replay %s"), *DemoFilename);
+	return true;
+}
+
+bool UDemoNetDriver::InitConnect(FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error)
+{
+	check(World != NULL);
+
+	if (!InitBase(true, InNotify, ConnectURL, false, Error))
+	{
+		return false;
+	}
+
+	DemoFilename = GetDemoFilename(ConnectURL.GetOption(TEXT("DemoPlay="), *ConnectURL.Map));
+
+	Reader = FReplayStreamReader::Open(DemoFilename, Error);
+	if (Reader == NULL)
+	{
+		return false;
+	}
+
+	DemoTotalTime = Reader->GetTotalTime();
+
+	CreatePlaybackConnection();
+
+	UE_LOG(LogDemo, Log, TEXT("Playing replay %s"), *DemoFilename);
+	return true;
+}
+
+void UDemoNetDriver::LowLevelDestroy()
+{
+	if (Writer != NULL)
+	{
+		// Shutdown closed the recording connection, what it sent while closing doesn't belong in the replay
+		FramePackets.Reset();
+
+		Writer->WriteChunk(EReplayChunk::End, DemoCurrentTime, FramePackets);
+
+		UE_LOG(LogDemo, Log, TEXT("Recorded %.1f seconds into %s, %lld bytes"), DemoCurrentTime, *DemoFilename, Writer->GetTotalBytes());
+
+		// Waits for the writer thread to write everything
+		delete Writer;
+		Writer = NULL;
+	}
+
+	if (Reader != NULL)
+	{
+		delete Reader;
+		Reader = NULL;
+	}
+
+	Super::LowLevelDestroy();
+}
+
+FString UDemoNetDriver::LowLevelGetNetworkNumber()
+{
+	return FString();
+}
+
+UDemoNetConnection* UDemoNetDriver::CreateRecordConnection()
+{
+	UDemoNetConnection* Connection = ConstructObject<UDemoNetConnection>(NetConnectionClass);
+	Connection->InitConnection(this, USOCK_Open, FURL(), DEMO_CONNECTION_SPEED);
+
+	// The replay is played back on the same map, with the levels that are visible while recording
+	Connection->ClientWorldPackageName = World->GetOutermost()->GetFName();
+
+	// Startup actors destroyed before this connection existed still need to be destroyed during playback
+	for (auto It = DestroyedStartupOrDormantActors.CreateConstIterator(); It; ++It)
+	{
+		if (It.Key().IsStatic())
+		{
+			Connection->DestroyedStartupOrDormantActors.Add(It.Key());
+		}
+	}
+
+	ClientConnections.Add(Connection);
+	return Connection;
+}
+
+void UDemoNetDriver::QueuePacket(const uint8* Data, int32 Count)
+{
+	const int32 Offset = FramePackets.AddUninitialized(sizeof(int32) + Count);
+	FMemory::Memcpy(FramePackets.GetTypedData() + Offset, &Count, sizeof(int32));
+	FMemory::Memcpy(FramePackets.GetTypedData() + Offset + sizeof(int32), Data, Count);
+}
+
+void UDemoNetDriver::WriteFrame()
+{
+	if (FramePackets.Num() > 0)
+	{
+		Writer->WriteChunk(EReplayChunk::Frame, DemoCurrentTime, FramePackets);
+		FramePackets.Reset();
+	}
+}
+
+void UDemoNetDriver::SaveCheckpoint()
+{
+	UNetConnection* RecordConnection = ClientConnections[0];
+
+	// TickFlush wrote the frame of the recording connection, everything queued from here on belongs to the snapshot
+	check(FramePackets.Num() == 0);
+
+	UDemoNetConnection* CheckpointConnection = CreateRecordConnection();
+	CheckpointConnection->ClientVisibleLevelNames = RecordConnection->ClientVisibleLevelNames;
+
+	// Open the channels on the indices the recording connection uses, so its frames following the checkpoint find
+	// them during playback
+	for (auto It = RecordConnection->ActorChannels.CreateConstIterator(); It; ++It)
+	{
+		AActor* Actor = It.Key().Get();
+		UActorChannel* RecordChannel = It.Value();
+		if (Actor == NULL || RecordChannel == NULL || RecordChannel->Closing)
+		{
+			continue;
+		}
+
+		UActorChannel* Channel = (UActorChannel*)CheckpointConnection->CreateChannel(CHTYPE_Actor, 1, RecordChannel->ChIndex);
+		if (Channel != NULL)
+		{
+			Channel->SetChannelActor(Actor);
+			Channel->ReplicateActor();
+		}
+	}
+
+	// The startup actors destroyed so far, on the channels left over
+	for (auto It = CheckpointConnection->DestroyedStartupOrDormantActors.CreateConstIterator(); It; ++It)
+	{
+		UActorChannel* Channel = (UActorChannel*)CheckpointConnection->CreateChannel(CHTYPE_Actor, 1);
+		if (Channel != NULL)
+		{
+			Channel->SetChannelActorForDestroy(&DestroyedStartupOrDormantActors.FindChecked(*It));
+		}
+	}
+
+	CheckpointConnection->FlushNet();
+
+	TArray<uint8> Snapshot;
+	FMemoryWriter Ar(Snapshot);
+
+	// Playback continues with the next packet of the recording connection, and the next reliable bunch on each channel
+	int32 PacketId = RecordConnection->OutPacketId;
+	Ar << PacketId;
+
+	int32 NumSequences = 0;
+	for (int32 ChIndex = 0; ChIndex < UNetConnection::MAX_CHANNELS; ChIndex++)
+	{
+		if (RecordConnection->OutReliable[ChIndex] != 0)
+		{
+			NumSequences++;
+		}
+	}
+	Ar << NumSequences;
+	for (int32 ChIndex = 0; ChIndex < UNetConnection::MAX_CHANNELS; ChIndex++)
+	{
+		if (RecordConnection->OutReliable[ChIndex] != 0)
+		{
+			Ar << ChIndex << RecordConnection->OutReliable[ChIndex];
+		}
+	}
+
+	// The recording connection only sends the path of a static object the first time it references it,
+	// the frames following the checkpoint may reference objects that aren't part of the snapshot
+	UNetGUIDCache* GuidCache = MasterMap->GetNetGUIDCache();
+	int32 NumGUIDs = 0;
+	for (auto It = GuidCache->ObjectLookup.CreateConstIterator(); It; ++It)
+	{
+		if (It.Key().IsStatic() && !It.Key().IsDefault())
+		{
+			NumGUIDs++;
+		}
+	}
+	Ar << NumGUIDs;
+	for (auto It = GuidCache->ObjectLookup.CreateConstIterator(); It; ++It)
+	{
+		if (It.Key().IsStatic() && !It.Key().IsDefault())
+		{
+			FNetworkGUID NetGUID = It.Key();
+			FString Path = It.Value().FullPath;
+			GEngine->NetworkRemapPath(World, Path, false);
+			Ar << NetGUID << Path;
+		}
+	}
+
+	Ar << FramePackets;
+	FramePackets.Reset();
+
+	// Closing the channels sends more packets, which don't belong anywhere
+	CheckpointConnection->bDiscardPackets = true;
+	CheckpointConnection->CleanUp();
+
+	Writer->WriteChunk(EReplayChunk::Checkpoint, DemoCurrentTime, Snapshot);
+	LastCheckpointTime = DemoCurrentTime;
+}
+
+int32 UDemoNetDriver::ServerReplicateActors(float DeltaSeconds)
+{
+	if (!IsRecording() || ClientConnections.Num() == 0 || World == NULL)
+	{
+		return 0;
+	}
+
+	if (MaxRecordHz > 0.0f && DemoCurrentTime - LastRecordTime < 1.0f / MaxRecordHz)
+	{
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_NetDemoRecordTime);
+
+	LastRecordTime = DemoCurrentTime;
+
+	// Bump the ReplicationFrame value to invalidate any properties marked as "unchanged" for this frame.
+	ReplicationFrame++;
+
+	UNetConnection* Connection = ClientConnections[0];
+
+	// Record every level that is visible, the replay is played back without streaming levels in and out
+	for (int32 LevelIdx = 0; LevelIdx < World->GetNumLevels(); LevelIdx++)
+	{
+		Connection->ClientVisibleLevelNames.AddUnique(World->GetLevel(LevelIdx)->GetOutermost()->GetFName());
+	}
+
+	// Send the startup actors destroyed since the last update
+	for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
+	{
+		FActorDestructionInfo& DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
+		UActorChannel* Channel = (UActorChannel*)Connection->CreateChannel(CHTYPE_Actor, 1);
+		if (Channel != NULL)
+		{
+			Channel->SetChannelActorForDestroy(&DInfo);
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<AActor*> RecordActors;
+	RecordActors.Empty(World->NetworkActors.Num() + 1);
+
+	AWorldSettings* WorldSettings = World->GetWorldSettings();
+	if (WorldSettings != NULL && WorldSettings->GetRemoteRole() != ROLE_None && WorldSettings->NetDriverName == NAME_GameNetDriver)
+	{
+		RecordActors.Add(WorldSettings);
+	}
+
+	// The game net driver prunes NetworkActors, actors are only skipped here
+	for (int32 i = 0; i < World->NetworkActors.Num(); i++)
+	{
+		AActor* Actor = World->NetworkActors[i];
+
+		if (Actor->IsPendingKill() || Actor->GetRemoteRole() == ROLE_None || Actor->NetDriverName != NAME_GameNetDriver)
+		{
+			continue;
+		}
+
+		// Owner only actors, like player controllers, are private to the player they belong to
+		if (Actor->bOnlyRelevantToOwner)
+		{
+			continue;
+		}
+
+		// Playback loads the map, so it already has the startup actors that never replicated
+		if (Actor->NetDormancy == DORM_Initial && Actor->IsNetStartupActor())
+		{
+			continue;
+		}
+
+		if (Actor->bNetTemporary && Connection->SentTemporaries.Contains(Actor))
+		{
+			continue;
+		}
+
+		RecordActors.Add(Actor);
+	}
+
+	int32 Updated = 0;
+
+	for (int32 i = 0; i < RecordActors.Num(); i++)
+	{
+		AActor* Actor = RecordActors[i];
+		UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+
+		if (Channel == NULL)
+		{
+			if (Actor->bTearOff || !IsLevelInitializedForActor(Actor, Connection))
+			{
+				continue;
+			}
+
+			if (!Connection->PackageMap->SupportsObject(Actor->GetClass()) ||
+				!Connection->PackageMap->SupportsObject(Actor->IsNetStartupActor() ? Actor : Actor->GetArchetype()))
+			{
+				continue;
+			}
+
+			Channel = (UActorChannel*)Connection->CreateChannel(CHTYPE_Actor, 1);
+			if (Channel == NULL)
+			{
+				continue;
+			}
+			Channel->SetChannelActor(Actor);
+		}
+		else if (Actor->NetUpdateFrequency > 0.0f && Time - Channel->LastUpdateTime < 1.0f / Actor->NetUpdateFrequency)
+		{
+			continue;
+		}
+
+		Actor->PreReplication(*FindOrCreateRepChangedPropertyTracker(Actor).Get());
+
+		if (Channel->ReplicateActor())
+		{
+			Updated++;
+		}
+	}
+
+	return Updated;
+}
+
+void UDemoNetDriver::ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject)
+{
+	// Only multicast functions are recorded, the others are private to a player.
+	// During playback there is no server to call functions on.
+	if (IsRecording() && ClientConnections.Num() > 0 && (Function->FunctionFlags & FUNC_NetMulticast))
+	{
+		InternalProcessRemoteFunction(Actor, SubObject, ClientConnections[0], Function, Parameters, OutParms, Stack, true);
+	}
+}
+
+void UDemoNetDriver::TickDispatch(float DeltaSeconds)
+{
+	Super::TickDispatch(DeltaSeconds);
+
+	if (IsRecording())
+	{
+		DemoCurrentTime += DeltaSeconds;
+	}
+	else if (IsPlaying())
+	{
+		DemoCurrentTime = FMath::Min(DemoCurrentTime + DeltaSeconds * PlaybackSpeed, DemoTotalTime);
+		TickDemoPlayback();
+	}
+}
+
+void UDemoNetDriver::TickFlush(float DeltaSeconds)
+{
+	// Replicates into the recording connection, and ticks it
+	Super::TickFlush(DeltaSeconds);
+
+	if (IsRecording() && ClientConnections.Num() > 0)
+	{
+		ClientConnections[0]->FlushNet();
+		WriteFrame();
+
+		if (CheckpointInterval > 0.0f && DemoCurrentTime - LastCheckpointTime >= CheckpointInterval)
+		{
+			SaveCheckpoint();
+		}
+
+		// Let the writer thread work on what was recorded this frame, instead of it piling up on the game thread
+		Writer->Flush();
+	}
+}
+
+void UDemoNetDriver::CreatePlaybackConnection()
+{
+	check(ServerConnection == NULL);
+
+	UDemoNetConnection* Connection = ConstructObject<UDemoNetConnection>(NetConnectionClass);
+	Connection->InitConnection(this, USOCK_Open, FURL(), DEMO_CONNECTION_SPEED);
+	ServerConnection = Connection;
+
+	// The recording connection never opens the control channel, but bunches on other channels are refused until it exists
+	Connection->CreateChannel(CHTYPE_Control, true, 0);
+}
+
+void UDemoNetDriver::CleanUpPlaybackConnection()
+{
+	if (ServerConnection == NULL)
+	{
+		return;
+	}
+
+	// Startup actors stay in the world whatever happens, only dynamic ones are destroyed
+	TArray<AActor*> DynamicActors;
+	for (auto It = ServerConnection->ActorChannels.CreateConstIterator(); It; ++It)
+	{
+		AActor* Actor = It.Key().Get();
+		if (Actor != NULL && !Actor->IsNetStartupActor())
+		{
+			DynamicActors.Add(Actor);
+		}
+	}
+
+	// UNetConnection::CleanUp unhooks the connection from the driver before closing its channels,
+	// so the channels leave their actors in the world
+	ServerConnection->CleanUp();
+	check(ServerConnection == NULL);
+
+	for (int32 i = 0; i < DynamicActors.Num(); i++)
+	{
+		if (!DynamicActors[i]->IsPendingKill())
+		{
+			DynamicActors[i]->Destroy(true);
+		}
+	}
+}
+
+bool UDemoNetDriver::LoadCheckpoint(const TArray<uint8>& Snapshot)
+{
+	check(ServerConnection != NULL);
+
+	FMemoryReader Ar(Snapshot);
+
+	int32 PacketId;
+	int32 NumSequences;
+	Ar << PacketId << NumSequences;
+	if (Ar.IsError() || NumSequences < 0 || NumSequences > UNetConnection::MAX_CHANNELS)
+	{
+		return false;
+	}
+
+	TArray<int32> Sequences;
+	Sequences.AddZeroed(UNetConnection::MAX_CHANNELS);
+	for (int32 i = 0; i < NumSequences; i++)
+	{
+		int32 ChIndex;
+		int32 Sequence;
+		Ar << ChIndex << Sequence;
+		if (Ar.IsError() || ChIndex < 0 || ChIndex >= UNetConnection::MAX_CHANNELS)
+		{
+			return false;
+		}
+		Sequences[ChIndex] = Sequence;
+	}
+
+	// Static objects this driver hasn't seen yet, they may have been referenced before the checkpoint
+	UNetGUIDCache* GuidCache = MasterMap->GetNetGUIDCache();
+	int32 NumGUIDs;
+	Ar << NumGUIDs;
+	for (int32 i = 0; i < NumGUIDs && !Ar.IsError(); i++)
+	{
+		FNetworkGUID NetGUID;
+		FString Path;
+		Ar << NetGUID << Path;
+		if (!Ar.IsError() && !GuidCache->ObjectLookup.Contains(NetGUID))
+		{
+			GEngine->NetworkRemapPath(World, Path, true);
+			ServerConnection->PackageMap->NetGUIDAssign(NetGUID, Path, NULL);
+		}
+	}
+
+	TArray<uint8> Packets;
+	Ar << Packets;
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+	// The snapshot is sent by a connection of its own, which starts at the first packet and sequence like this one
+	PlayFrame(Packets);
+
+	if (ServerConnection == NULL || ServerConnection->State == USOCK_Closed)
+	{
+		return false;
+	}
+
+	// Pick up where the recording connection was
+	ServerConnection->InPacketId = PacketId - 1;
+	FMemory::Memcpy(ServerConnection->InReliable, Sequences.GetTypedData(), sizeof(ServerConnection->InReliable));
+	return true;
+}
+
+void UDemoNetDriver::PlayFrame(const TArray<uint8>& Payload)
+{
+	int32 Offset = 0;
+	while (Offset + (int32)sizeof(int32) <= Payload.Num() && ServerConnection != NULL && ServerConnection->State != USOCK_Closed)
+	{
+		int32 PacketSize;
+		FMemory::Memcpy(&PacketSize, Payload.GetTypedData() + Offset, sizeof(int32));
+		Offset += sizeof(int32);
+
+		if (PacketSize < 0 || Offset + PacketSize > Payload.Num())
+		{
+			UE_LOG(LogDemo, Warning, TEXT("Corrupted frame in replay %s"), *DemoFilename);
+			break;
+		}
+
+		ServerConnection->ReceivedRawPacket((void*)(Payload.GetTypedData() + Offset), PacketSize);
+		Offset += PacketSize;
+	}
+}
+
+void UDemoNetDriver::TickDemoPlayback()
+{
+	SCOPE_CYCLE_COUNTER(STAT_NetDemoPlaybackTime);
+
+	EReplayChunk::Type ChunkType;
+	float ChunkTime;
+
+	while (Reader->PeekChunk(ChunkType, ChunkTime) && ChunkTime <= DemoCurrentTime)
+	{
+		// Snapshots are only read by GotoTime, the frames already brought the world to the same state
+		if (ChunkType != EReplayChunk::Frame)
+		{
+			if (!Reader->SkipChunk())
+			{
+				break;
+			}
+			continue;
+		}
+
+		if (!Reader->ReadChunk(ChunkType, ChunkTime, PlaybackPayload))
+		{
+			break;
+		}
+
+		PlayFrame(PlaybackPayload);
+	}
+}
+
+void UDemoNetDriver::SetPlaybackSpeed(float InPlaybackSpeed)
+{
+	PlaybackSpeed = FMath::Max(InPlaybackSpeed, 0.0f);
+}
+
+void UDemoNetDriver::GotoTime(float SeekTime)
+{
+	if (!IsPlaying())
+	{
+		return;
+	}
+
+	const float TargetTime = FMath::Clamp(SeekTime, 0.0f, DemoTotalTime);
+	const int32 CheckpointIndex = Reader->FindCheckpoint(TargetTime);
+
+	UE_LOG(LogDemo, Log, TEXT("Jumping to %.2f from the checkpoint at %.2f"), TargetTime, Reader->GetCheckpoints()[CheckpointIndex].Time);
+
+	// Dynamic actors are spawned again by the snapshot.
+	// Startup actors are kept, the snapshot replicates their state again.
+	// The ones destroyed since the checkpoint are gone for good though, since only loading the map again brings them back.
+	CleanUpPlaybackConnection();
+	CreatePlaybackConnection();
+
+	if (!Reader->SeekToCheckpoint(CheckpointIndex, PlaybackPayload) || (PlaybackPayload.Num() > 0 && !LoadCheckpoint(PlaybackPayload)))
+	{
+		UE_LOG(LogDemo, Warning, TEXT("Corrupted checkpoint at %.2f in replay %s, playing from the start"), Reader->GetCheckpoints()[CheckpointIndex].Time, *DemoFilename);
+
+		CleanUpPlaybackConnection();
+		CreatePlaybackConnection();
+		Reader->SeekToCheckpoint(0, PlaybackPayload);
+	}
+
+	DemoCurrentTime = TargetTime;
+
+	TickDemoPlayback();
+}
@@ -20,6 +20,12 @@ public:
 		FoliageNormalizedRotationAxisAndAngle(0,0,1,0)
 	{}
 
+	/** The foliage is bent by the vertex shader, so it can't occlude with the undeformed occluder mesh. */
+	virtual const FOccluderMeshData* GetOccluderMeshData() const OVERRIDE
+	{
+		return NULL;
+	}
+
 	/** Accessor used by the rendering thread when setting foliage parameters for rendering. */
 	virtual void GetFoliageParameters(FVector& OutFoliageImpluseDirection, FVector4& OutFoliageNormalizedRotationAxisAndAngle) const
 	{
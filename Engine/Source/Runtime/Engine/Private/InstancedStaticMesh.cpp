@@ -919,6 +919,12 @@ public:
 		return PerInstanceSMData[ InInstanceIndex ].InstanceToWorld;
 	}
 
+	/** The occluder mesh is in the space of a single instance, not of the whole component. */
+	virtual const FOccluderMeshData* GetOccluderMeshData() const OVERRIDE
+	{
+		return NULL;
+	}
+
 	/**
 	 * Creates the hit proxies are used when DrawDynamicElements is called.
 	 * Called in the game thread.
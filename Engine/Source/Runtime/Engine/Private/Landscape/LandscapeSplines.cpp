@@ -2031,6 +2031,12 @@ public:
 
 	void ReleaseResources();
 
+	/** The vertex factory bends the mesh along the spline, the occluder mesh would be left undeformed. */
+	virtual const FOccluderMeshData* GetOccluderMeshData() const OVERRIDE
+	{
+		return NULL;
+	}
+
 	/** Sets up a shadow FMeshBatch for a specific LOD. */
 	virtual bool GetShadowMeshElement(int32 LODIndex, uint8 InDepthPriorityGroup, FMeshBatch& OutMeshElement) const OVERRIDE
 	{
@@ -533,6 +533,10 @@ bool UWorld::DestroyActor( AActor* ThisActor, bool bNetForce, bool bShouldModify
 	{
 		NetDriver->NotifyActorDestroyed( ThisActor );
 	}
+	if( DemoNetDriver && DemoNetDriver != NetDriver && DemoNetDriver->IsRecording() )
+	{
+		DemoNetDriver->NotifyActorDestroyed( ThisActor );
+	}
 
 	// Remove the actor from the actor list.
 	RemoveActor( ThisActor, bShouldModifyLevel );
@@ -48,6 +48,13 @@ DEFINE_STAT(STAT_SpawnActorTime);
 DEFINE_STAT(STAT_GCSweepTime);
 DEFINE_STAT(STAT_GCMarkTime);
 
+static TAutoConsoleVariable<float> CVarIncrementalGCTimeLimit(
+	TEXT("gc.IncrementalReachabilityTimeLimit"),
+	0.0f,
+	TEXT("Time budget in seconds per frame for the reachability analysis of garbage collection.\n")
+	TEXT("0 performs the whole analysis in a single frame, which is the default. Only set this if all native code\n")
+	TEXT("storing object references between frames calls GCWriteBarrier."));
+
 DEFINE_STAT(STAT_TeleportToTime);
 DEFINE_STAT(STAT_MoveComponentTime);
 
@@ -74,6 +81,7 @@ DEFINE_STAT(STAT_NetServerRepActorsTime);
 DEFINE_STAT(STAT_NetConsiderActorsTime);
 DEFINE_STAT(STAT_NetInitialDormantCheckTime);
 DEFINE_STAT(STAT_NetPrioritizeActorsTime);
+DEFINE_STAT(STAT_NetCompareSharedPropertiesTime);
 DEFINE_STAT(STAT_NetReplicateActorsTime);
 DEFINE_STAT(STAT_NetReplicateDynamicPropTime);
 DEFINE_STAT(STAT_NetSkippedDynamicProps);
@@ -1310,6 +1318,15 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 		{
 			bShouldDelayGarbageCollect = false;
 		}
+		// Continue an incremental reachability analysis started in an earlier frame.
+		else if( IsIncrementalReachabilityAnalysisPending() )
+		{
+			SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
+			if( IncrementalCollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, CVarIncrementalGCTimeLimit.GetValueOnGameThread() ) )
+			{
+				CleanupActors();
+			}
+		}
 		// Perform incremental purge update if it's pending or in progress.
 		else if( !IsIncrementalPurgePending() 
 		// Purge reference to pending kill objects every now and so often.
@@ -1397,10 +1414,17 @@ void UWorld::PerformGarbageCollectionAndCleanupActors()
 	// to block on loading the remaining data.
 	if( !IsAsyncLoading() )
 	{
-		// Perform housekeeping.
-		CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, false );
-
-		CleanupActors();
+		// Perform housekeeping, spread over several frames if there is a time budget for it.
+		const float IncrementalTimeLimit = CVarIncrementalGCTimeLimit.GetValueOnGameThread();
+		if( IncrementalTimeLimit <= 0.0f )
+		{
+			CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, false );
+			CleanupActors();
+		}
+		else if( IncrementalCollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, IncrementalTimeLimit ) )
+		{
+			CleanupActors();
+		}
 
 		// Reset counter.
 		TimeSinceLastPendingKillPurge = 0;
@@ -1292,6 +1292,7 @@ void UNetConnection::Tick()
 	if( InternalAck )
 	{
 		LastReceiveTime = Driver->Time;
+		OutAckPacketId = OutPacketId - 1;
 		for( int32 i=OpenChannels.Num()-1; i>=0; i-- )
 		{
 			UChannel* It = OpenChannels[i];
@@ -0,0 +1,189 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetRelevancyPolicy.cpp: Spatial grid used to narrow down the actors considered per connection
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/NetRelevancyPolicy.h"
+
+DEFINE_STAT(STAT_NetRelevancyGridBuildTime);
+DEFINE_STAT(STAT_NetRelevancyGridGatherTime);
+DEFINE_STAT(STAT_NumRelevancyGridActors);
+DEFINE_STAT(STAT_NumRelevancyGridCells);
+DEFINE_STAT(STAT_NumAlwaysConsideredActors);
+DEFINE_STAT(STAT_NumGatheredActors);
+
+FSpatialGridRelevancyPolicy::FSpatialGridRelevancyPolicy( float InCellSize, int32 InMaxCellsPerActor ) :
+	CellSize( FMath::Max( InCellSize, 1.0f ) ),
+	MaxCellsPerActor( FMath::Max( InMaxCellsPerActor, 1 ) ),
+	GatherTag( 0 )
+{
+}
+
+FIntPoint FSpatialGridRelevancyPolicy::GetCell( const FVector & Location ) const
+{
+	return FIntPoint( FMath::Floor( Location.X / CellSize ), FMath::Floor( Location.Y / CellSize ) );
+}
+
+void FSpatialGridRelevancyPolicy::PrepareForReplication( UWorld * World, AActor ** ConsiderList, int32 ConsiderListSize )
+{
+	SCOPE_CYCLE_COUNTER( STAT_NetRelevancyGridBuildTime );
+
+	ConsideredActors.Reset();
+	ConsideredActors.Append( ConsiderList, ConsiderListSize );
+	GatheredTags.Reset();
+	GatheredTags.AddZeroed( ConsiderListSize );
+	ConsideredActorIndices.Empty( ConsiderListSize );
+	ActorCells.Reset();
+	ActorCells.AddUninitialized( ConsiderListSize );
+	AlwaysConsideredActors.Reset();
+	GatherTag = 0;
+
+	// Keep the cell arrays around, most cells will be filled again this frame
+	for ( auto It = Cells.CreateIterator(); It; ++It )
+	{
+		It.Value().Reset();
+	}
+
+	int32 NumGridActors = 0;
+
+	for ( int32 i = 0; i < ConsiderListSize; i++ )
+	{
+		AActor * Actor = ConsiderList[i];
+
+		ConsideredActorIndices.Add( Actor, i );
+
+		// Only actors whose relevancy depends on distance alone are bucketed, anything else could be relevant from anywhere
+		if ( !Actor->UsesDistanceBasedNetRelevancy() )
+		{
+			AlwaysConsideredActors.Add( i );
+			continue;
+		}
+
+		// The grid is 2D, so the actor goes in every cell overlapped by the bounding square of its cull distance
+		const float		CullDistance	= FMath::Sqrt( Actor->NetCullDistanceSquared );
+		const FVector	Location		= Actor->GetActorLocation();
+		const FIntPoint MinCell			= GetCell( Location - FVector( CullDistance, CullDistance, 0.0f ) );
+		const FIntPoint MaxCell			= GetCell( Location + FVector( CullDistance, CullDistance, 0.0f ) );
+
+		if ( (int64)( MaxCell.X - MinCell.X + 1 ) * ( MaxCell.Y - MinCell.Y + 1 ) > MaxCellsPerActor )
+		{
+			AlwaysConsideredActors.Add( i );
+			continue;
+		}
+
+		ActorCells[i] = GetCell( Location );
+
+		for ( int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++ )
+		{
+			for ( int32 X = MinCell.X; X <= MaxCell.X; X++ )
+			{
+				Cells.FindOrAdd( FIntPoint( X, Y ) ).Add( i );
+			}
+		}
+
+		NumGridActors++;
+	}
+
+	// Forget about the cells nothing is in anymore
+	for ( auto It = Cells.CreateIterator(); It; ++It )
+	{
+		if ( It.Value().Num() == 0 )
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT( STAT_NumRelevancyGridActors, NumGridActors );
+	SET_DWORD_STAT( STAT_NumRelevancyGridCells, Cells.Num() );
+	SET_DWORD_STAT( STAT_NumAlwaysConsideredActors, AlwaysConsideredActors.Num() );
+	SET_DWORD_STAT( STAT_NumGatheredActors, 0 );
+}
+
+FORCEINLINE void FSpatialGridRelevancyPolicy::GatherActor( int32 ActorIndex, const TArray< FIntPoint > * ViewerCells, const TSet< const AActor * > * DormantActors, TArray< AActor * > & OutActors, TArray< float > & OutPriorityScales )
+{
+	if ( GatheredTags[ActorIndex] == GatherTag )
+	{
+		return;
+	}
+
+	GatheredTags[ActorIndex] = GatherTag;
+
+	AActor * Actor = ConsideredActors[ActorIndex];
+
+	if ( DormantActors != NULL && DormantActors->Contains( Actor ) )
+	{
+		return;
+	}
+
+	float PriorityScale = 1.0f;
+
+	if ( ViewerCells != NULL )
+	{
+		// Grid actors lose priority with the number of cells between them and the nearest viewer
+		const FIntPoint & ActorCell = ActorCells[ActorIndex];
+		int32 CellDistance = MAX_int32;
+
+		for ( int32 i = 0; i < ViewerCells->Num(); i++ )
+		{
+			const FIntPoint & ViewerCell = (*ViewerCells)[i];
+			CellDistance = FMath::Min( CellDistance, FMath::Max( FMath::Abs( ViewerCell.X - ActorCell.X ), FMath::Abs( ViewerCell.Y - ActorCell.Y ) ) );
+		}
+
+		PriorityScale = 1.0f / ( CellDistance + 1 );
+	}
+
+	OutActors.Add( Actor );
+	OutPriorityScales.Add( PriorityScale );
+}
+
+void FSpatialGridRelevancyPolicy::GatherActorsForConnection( UNetConnection * Connection, const TArray< FNetViewer > & Viewers, bool bSkipDormantActors, TArray< AActor * > & OutActors, TArray< float > & OutPriorityScales )
+{
+	SCOPE_CYCLE_COUNTER( STAT_NetRelevancyGridGatherTime );
+
+	OutActors.Reset();
+	OutPriorityScales.Reset();
+	GatherTag++;
+
+	const TSet< const AActor * > * DormantActors = bSkipDormantActors ? &Connection->DormantActors : NULL;
+
+	for ( int32 i = 0; i < AlwaysConsideredActors.Num(); i++ )
+	{
+		GatherActor( AlwaysConsideredActors[i], NULL, DormantActors, OutActors, OutPriorityScales );
+	}
+
+	TArray< FIntPoint > ViewerCells;
+	for ( int32 i = 0; i < Viewers.Num(); i++ )
+	{
+		ViewerCells.Add( GetCell( Viewers[i].ViewLocation ) );
+	}
+
+	// Every grid actor that could be within cull distance of a viewer covers the cell the viewer is in
+	for ( int32 i = 0; i < ViewerCells.Num(); i++ )
+	{
+		const TArray< int32 > * Cell = Cells.Find( ViewerCells[i] );
+
+		if ( Cell != NULL )
+		{
+			for ( int32 j = 0; j < Cell->Num(); j++ )
+			{
+				GatherActor( (*Cell)[j], &ViewerCells, DormantActors, OutActors, OutPriorityScales );
+			}
+		}
+	}
+
+	// Actors with an open channel need to be considered too, so the channel can be updated, or closed once it timed out.
+	// The actors considered for every connection were gathered above, so any actor left is in the grid.
+	for ( auto It = Connection->ActorChannels.CreateConstIterator(); It; ++It )
+	{
+		const int32 * ActorIndex = ConsideredActorIndices.Find( It.Key().Get() );
+
+		if ( ActorIndex != NULL )
+		{
+			GatherActor( *ActorIndex, &ViewerCells, DormantActors, OutActors, OutPriorityScales );
+		}
+	}
+
+	INC_DWORD_STAT_BY( STAT_NumGatheredActors, OutActors.Num() );
+}
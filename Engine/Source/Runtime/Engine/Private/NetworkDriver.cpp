@@ -7,6 +7,8 @@
 #include "EnginePrivate.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/NetworkProfiler.h"
+#include "Net/NetRelevancyPolicy.h"
+#include "ParallelFor.h"
 #include "NavigationPathBuilder.h"
 #include "Online.h"
 
@@ -58,6 +60,8 @@ UNetDriver::UNetDriver(const class FPostConstructInitializeProperties& PCIP)
 ,	MaxInternetClientRate(10000)
 , 	MaxClientRate(15000)
 ,	RequireEngineVersionMatch(true)
+,	bUseSpatialGridRelevancy(false)
+,	SpatialGridCellSize(10000.f)
 ,	ClientConnections()
 ,	Time( 0.f )
 ,	InBytes(0)
@@ -95,6 +99,11 @@ void UNetDriver::PostInitProperties()
 
 		MasterMap          = new UPackageMap(FPostConstructInitializeProperties(), FNetObjectIsDynamic::CreateUObject(this, &UNetDriver::NetObjectIsDynamic));
 		ProfileStats	   = FParse::Param(FCommandLine::Get(),TEXT("profilestats"));
+
+		if ( bUseSpatialGridRelevancy )
+		{
+			RelevancyPolicy = MakeShareable( new FSpatialGridRelevancyPolicy( SpatialGridCellSize ) );
+		}
 	}
 	// By default we're the game net driver and any child ones must override this
 	NetDriverName = NAME_GameNetDriver;
@@ -1601,7 +1610,7 @@ FNetViewer::FNetViewer(UNetConnection* InConnection, float DeltaSeconds) :
 	}
 }
 
-FActorPriority::FActorPriority(UNetConnection* InConnection, UActorChannel* InChannel, AActor* InActor, const TArray<struct FNetViewer>& Viewers, bool bLowBandwidth)
+FActorPriority::FActorPriority(UNetConnection* InConnection, UActorChannel* InChannel, AActor* InActor, const TArray<struct FNetViewer>& Viewers, bool bLowBandwidth, float PriorityScale)
 	: Actor(InActor), Channel(InChannel), DestructionInfo(NULL)
 {	
 	float Time  = Channel ? (InConnection->Driver->Time - Channel->LastUpdateTime) : InConnection->Driver->SpawnPrioritySeconds;
@@ -1609,7 +1618,7 @@ FActorPriority::FActorPriority(UNetConnection* InConnection, UActorChannel* InCh
 	Priority = 0;
 	for (int32 i = 0; i < Viewers.Num(); i++)
 	{
-		Priority = FMath::Max<int32>(Priority, FMath::Round(65536.0f * Actor->GetNetPriority(Viewers[i].ViewLocation, Viewers[i].ViewDir, Viewers[i].InViewer, InChannel, Time, bLowBandwidth)));
+		Priority = FMath::Max<int32>(Priority, FMath::Round(65536.0f * PriorityScale * Actor->GetNetPriority(Viewers[i].ViewLocation, Viewers[i].ViewDir, Viewers[i].InViewer, InChannel, Time, bLowBandwidth)));
 	}
 }
 
@@ -1651,6 +1660,255 @@ static FAutoConsoleVariableRef CVarNetRemoteRoleOnCloseTest(
 	);
 
 
+int32 GNetParallelReplication = 0;
+
+static FAutoConsoleVariableRef CVarNetParallelReplication(
+	TEXT("net.ParallelReplication"),
+	GNetParallelReplication,
+	TEXT("If true, the actors are prioritized for each connection and their properties compared on worker threads. ")
+	TEXT("Channels and packets are still written on the game thread, one connection after the other. ")
+	TEXT("AActor::IsNetRelevantFor, GetNetDormancy and GetNetPriority are then called from worker threads, so their overrides must be thread safe."),
+	ECVF_Default
+	);
+
+/** State of one connection in ServerReplicateActors, filled in on the game thread and prioritized on any thread */
+struct FNetConnectionReplicationJob
+{
+	FNetConnectionReplicationJob(UNetConnection* InConnection)
+		: Connection(InConnection)
+		, ConsiderList(NULL)
+		, ConsiderListSize(0)
+		, PriorityScales(NULL)
+		, PriorityList(NULL)
+		, PriorityActors(NULL)
+		, ConsiderCount(0)
+		, DeletedCount(0)
+		, NetRelevantCount(0)
+		, PruneActors(0.f)
+		, bLowNetBandwidth(false)
+		, bDormancyEnabled(true)
+		, bValidateDormancy(false)
+	{
+	}
+
+	UNetConnection*			Connection;
+	/** Viewers of the connection and its children */
+	TArray<FNetViewer>		Viewers;
+	/** Actors this connection considers, either the shared consider list or GatheredActors */
+	AActor**				ConsiderList;
+	int32					ConsiderListSize;
+	/** Actors picked by the relevancy policy for this connection */
+	TArray<AActor*>			GatheredActors;
+	/** Priority scale the relevancy policy gave each of the GatheredActors, NULL when the shared consider list is used */
+	TArray<float>			GatheredPriorityScales;
+	const float*			PriorityScales;
+	/** Actors that must not be prioritized (sent temporaries), owned actors are added as they are prioritized */
+	TSet<const AActor*>		SkippedActors;
+	/** Channels that should start becoming dormant, applied on the game thread once all connections are prioritized */
+	TArray<UActorChannel*>	ChannelsToStartDormancy;
+	/** Dormant actors whose properties should be validated against their dormant state on the game thread */
+	TArray<AActor*>			DormantActorsToValidate;
+	FActorPriority*			PriorityList;
+	FActorPriority**		PriorityActors;
+	int32					ConsiderCount;
+	int32					DeletedCount;
+	int32					NetRelevantCount;
+	float					PruneActors;
+	bool					bLowNetBandwidth;
+	bool					bDormancyEnabled;
+	bool					bValidateDormancy;
+};
+
+/** Builds the sorted priority list of each connection */
+struct FPrioritizeConnectionBody
+{
+	FPrioritizeConnectionBody(UNetDriver* InNetDriver, TArray<FNetConnectionReplicationJob>& InJobs)
+		: NetDriver(InNetDriver)
+		, Jobs(InJobs)
+	{
+	}
+	void operator()(int32 Index) const
+	{
+		NetDriver->ServerReplicateActors_PrioritizeActors(Jobs[Index]);
+	}
+	UNetDriver* NetDriver;
+	TArray<FNetConnectionReplicationJob>& Jobs;
+};
+
+/** Compares the properties of each actor against the shadow state shared by all connections */
+struct FCompareSharedPropertiesBody
+{
+	FCompareSharedPropertiesBody(const TArray<FRepChangedPropertyTracker*>& InTrackers, const TArray<AActor*>& InActors, uint32 InReplicationFrame)
+		: Trackers(InTrackers)
+		, Actors(InActors)
+		, ReplicationFrame(InReplicationFrame)
+	{
+	}
+	void operator()(int32 Index) const
+	{
+		FRepChangedPropertyTracker* Tracker = Trackers[Index];
+		Tracker->ChangelistState.RepLayout->UpdateChangelistState(Tracker, (const uint8*)Actors[Index], ReplicationFrame);
+	}
+	const TArray<FRepChangedPropertyTracker*>& Trackers;
+	const TArray<AActor*>& Actors;
+	uint32 ReplicationFrame;
+};
+
+void UNetDriver::ServerReplicateActors_PrioritizeActors(FNetConnectionReplicationJob& Job)
+{
+	UNetConnection* Connection = Job.Connection;
+	const TArray<FNetViewer>& ConnectionViewers = Job.Viewers;
+	FActorPriority* PriorityList = Job.PriorityList;
+	FActorPriority** PriorityActors = Job.PriorityActors;
+	int32 ConsiderCount = 0;
+	int32 DeletedCount = 0;
+
+	CLOCK_CYCLES(Job.PruneActors);
+
+	// Get list of visible/relevant actors.
+	for( int32 j=0; j<Job.ConsiderListSize; j++ )
+	{
+		AActor* Actor = Job.ConsiderList[j];
+		UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+
+		// Skip Actor if dormant
+		if ( Job.bDormancyEnabled )
+		{
+			// If actor is already dormant on this channel, then skip replication entirely
+			if ( Connection->DormantActors.Contains( Actor ) )
+			{
+				// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
+				if ( Job.bValidateDormancy )
+				{
+					Job.DormantActorsToValidate.Add( Actor );
+				}
+
+				continue;
+			}
+
+			// If actor might need to go dormant on this channel, then check
+			if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
+			{
+				bool ShouldGoDormant = true;
+				if (Actor->NetDormancy == DORM_DormantPartial)
+				{
+					float Time  = Channel ? (Connection->Driver->Time - Channel->LastUpdateTime) : Connection->Driver->SpawnPrioritySeconds;
+					for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
+					{
+						if (!Actor->GetNetDormancy(ConnectionViewers[viewerIdx].ViewLocation, ConnectionViewers[viewerIdx].ViewDir, ConnectionViewers[viewerIdx].InViewer, Channel, Time, Job.bLowNetBandwidth))
+						{
+							ShouldGoDormant = false;
+							break;
+						}
+					}
+				}
+
+				if (ShouldGoDormant)
+				{
+					// Channel is marked to go dormant once all properties have been replicated (but is not dormant yet)
+					// This changes the channel, so it is done on the game thread after the prioritization
+					Job.ChannelsToStartDormancy.Add( Channel );
+				}
+			}
+		}
+
+
+		// Skip actor if not relevant and theres no channel already.
+		// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
+		// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
+		// prioritized actors low.
+		if (!Channel)
+		{
+			if ( !IsLevelInitializedForActor(Actor, Connection) )
+			{
+				// If the level this actor belongs to isn't loaded on client, don't bother sending
+				continue;
+			}
+			bool Relevant = false;
+			for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
+			{
+				if(Actor->IsNetRelevantFor(ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].Viewer, ConnectionViewers[viewerIdx].ViewLocation))
+				{
+					Relevant = true;
+					break;
+				}
+			}
+			if (!Relevant)
+			{
+				continue;
+			}
+		}
+
+		if( Job.SkippedActors.Num() == 0 || !Job.SkippedActors.Contains(Actor) ) // Do not consider actor for this connection if this connection already sent it as a temporary
+		{
+			UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
+			const float PriorityScale = Job.PriorityScales ? Job.PriorityScales[j] : 1.0f;
+			PriorityList  [ConsiderCount] = FActorPriority(Connection, Channel, Actor, ConnectionViewers, Job.bLowNetBandwidth, PriorityScale);
+			PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
+			ConsiderCount++;
+
+			if (DebugRelevantActors)
+			{
+				LastPrioritizedActors.Add(Actor);
+			}
+		}
+	}
+
+	// Add in deleted actors
+	for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
+	{
+		FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
+		PriorityList  [ConsiderCount] = FActorPriority(Connection, &DInfo, ConnectionViewers);
+		PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
+		ConsiderCount++;
+		DeletedCount++;
+	}
+
+	UNetConnection* NextConnection = Connection;
+	int32 ChildIndex = 0;
+	while (NextConnection != NULL)
+	{
+		for (int32 j = 0; j < NextConnection->OwnedConsiderListSize; j++)
+		{
+			AActor* Actor = NextConnection->OwnedConsiderList[j];
+			UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
+			bool bAlreadySkipped = false;
+			Job.SkippedActors.Add(Actor, &bAlreadySkipped);
+			if (!bAlreadySkipped)
+			{
+				UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+				PriorityList  [ConsiderCount] = FActorPriority(NextConnection, Channel, Actor, ConnectionViewers, Job.bLowNetBandwidth);
+				PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
+				ConsiderCount++;
+
+				if (DebugRelevantActors)
+				{
+					LastPrioritizedActors.Add(Actor);
+				}
+			}
+		}
+		NextConnection->OwnedConsiderList = NULL;
+		NextConnection->OwnedConsiderListSize = 0;
+
+		NextConnection = (ChildIndex < Connection->Children.Num()) ? Connection->Children[ChildIndex++] : NULL;
+	}
+
+	// Sort by priority
+	struct FCompareFActorPriority
+	{
+		FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
+		{
+			return B.Priority < A.Priority;
+		}
+	};
+	Sort( PriorityActors, ConsiderCount, FCompareFActorPriority() );
+
+	UNCLOCK_CYCLES(Job.PruneActors);
+
+	Job.ConsiderCount = ConsiderCount;
+	Job.DeletedCount = DeletedCount;
+}
+
 int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NetServerRepActorsTime);
@@ -1872,9 +2130,12 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 				// if this actor relevant to any client
 				if ( !Actor->bOnlyRelevantToOwner ) 
 				{
-					// add it to the list to consider below
-					ConsiderList[ConsiderListSize] = Actor;
-					ConsiderListSize++;
+					// add it to the list to consider below, unless it is the WorldSettings that were added up front
+					if ( Actor != WorldSettings || ConsiderListSize == 0 || ConsiderList[0] != WorldSettings )
+					{
+						ConsiderList[ConsiderListSize] = Actor;
+						ConsiderListSize++;
+					}
 
 					bWasConsidered = true;
 				}
@@ -1950,12 +2211,28 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 	SET_DWORD_STAT(STAT_NumInitiallyDormantActors,NumInitiallyDormant);
 	SET_DWORD_STAT(STAT_NumConsideredActors,ConsiderListSize);
 
+	if ( RelevancyPolicy.IsValid() )
+	{
+		RelevancyPolicy->PrepareForReplication( World, ConsiderList, ConsiderListSize );
+	}
+
+	// Dormancy settings are read up front, so the prioritization below can run off the game thread
+	static const auto DormancyEnableCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyEnable"));
+	static const auto DormancyValidateCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyValidate"));
+	const bool bDormancyEnabled = !DormancyEnableCVar || DormancyEnableCVar->GetValueOnGameThread() == 1;
+	// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
+	const bool bValidateDormancy = DormancyValidateCVar && DormancyValidateCVar->GetValueOnGameThread() == 2;
+
+	// The debug lists are shared by all connections, so keep everything on the game thread while they are being filled
+	const bool bParallelReplication = GNetParallelReplication != 0 && !DebugRelevantActors;
+
+	TArray<FNetConnectionReplicationJob> ConnectionJobs;
+	ConnectionJobs.Empty(NumClientsToTick);
+
 	for( int32 i=0; i < ClientConnections.Num(); i++ )
 	{
 		UNetConnection* Connection = ClientConnections[i];
 		check(Connection);
-		int32 ActorUpdatesThisConnection = 0;
-		int32 ActorUpdatesThisConnectionSent = 0;
 
 		// if this client shouldn't be ticked this frame
 		if (i >= NumClientsToTick)
@@ -1995,222 +2272,157 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 		}
 		else if (Connection->Viewer)
 		{
-			int32 j;
-			int32 ConsiderCount	= 0;
-			int32 DeletedCount = 0;
-			
-			int32 NetRelevantCount = 0;
-			FActorPriority* PriorityList = NULL;
-			FActorPriority** PriorityActors = NULL;
+			// Set up everything that touches game state on the game thread, the prioritization only reads it
+			FNetConnectionReplicationJob& Job = *new(ConnectionJobs) FNetConnectionReplicationJob(Connection);
 
-			TArray<FNetViewer>& ConnectionViewers = WorldSettings->ReplicationViewers;
-
-			float PruneActors = 0.f;
-			CLOCK_CYCLES(PruneActors);
-			FMemMark RelevantActorMark(FMemStack::Get());
-
-			// Prioritize actors for this connection
+			// send ClientAdjustment if necessary
+			// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
+			if (Connection->PlayerController)
 			{
-				SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
+				Connection->PlayerController->SendClientAdjustment();
+			}
 
-				// send ClientAdjustment if necessary
-				// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
-				if (Connection->PlayerController)
-				{
-					Connection->PlayerController->SendClientAdjustment();
-				}
-				
-				for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+			for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+			{
+				if (Connection->Children[ChildIdx]->PlayerController != NULL)
 				{
-					if (Connection->Children[ChildIdx]->PlayerController != NULL)
-					{
-						Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
-					}
+					Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
 				}
+			}
 
-				// Get list of visible/relevant actors.
-				
-				NetTag++;
-				Connection->TickCount++;
+			Connection->TickCount++;
 
-				// Set up to skip all sent temporary actors
-				for( j=0; j<Connection->SentTemporaries.Num(); j++ )
-				{
-					Connection->SentTemporaries[j]->NetTag = NetTag;
-				}
+			// Set up to skip all sent temporary actors
+			for( int32 j=0; j<Connection->SentTemporaries.Num(); j++ )
+			{
+				Job.SkippedActors.Add(Connection->SentTemporaries[j]);
+			}
 
-				// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
-				ConnectionViewers.Reset();
-				new(ConnectionViewers) FNetViewer(Connection, DeltaSeconds);
-				for (j = 0; j < Connection->Children.Num(); j++)
+			new(Job.Viewers) FNetViewer(Connection, DeltaSeconds);
+			for (int32 j = 0; j < Connection->Children.Num(); j++)
+			{
+				if (Connection->Children[j]->Viewer != NULL)
 				{
-					if (Connection->Children[j]->Viewer != NULL)
-					{
-						new(ConnectionViewers) FNetViewer(Connection->Children[j], DeltaSeconds);
-					}
+					new(Job.Viewers) FNetViewer(Connection->Children[j], DeltaSeconds);
 				}
+			}
 
-				// Make list of all actors to consider.
-				check(World == Connection->OwningActor->GetWorld());
-				
-				NetRelevantCount = World->GetNetRelevantActorCount() + DestroyedStartupOrDormantActors.Num();
-				PriorityList = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority;
-				PriorityActors = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority*;
-
-				// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
-				//@note - if the server is currently CPU saturated then do not sort until framerate improves
-				check(World == Connection->Viewer->GetWorld());
-				AGameMode const* const GameMode = World->GetAuthGameMode();
-				bool bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
+			// Make list of all actors to consider.
+			check(World == Connection->OwningActor->GetWorld());
 
-				for( j=0; j<ConsiderListSize; j++ )
-				{
-					AActor* Actor = ConsiderList[j];
-					UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+			Job.NetRelevantCount = World->GetNetRelevantActorCount() + DestroyedStartupOrDormantActors.Num();
 
-					// Skip Actor if dormant
-					static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyEnable"));
-					if ( !CVar || CVar->GetValueOnGameThread() == 1 )
-					{
-						// If actor is already dormant on this channel, then skip replication entirely
-						if ( Connection->DormantActors.Contains( Actor ) )
-						{
-							// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
-							// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
-							static const auto ValidateCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyValidate"));
-							if ( ValidateCVar && ValidateCVar->GetValueOnGameThread() == 2 )
-							{
-								TSharedRef< FObjectReplicator > * Replicator = Connection->DormantReplicatorMap.Find( Actor );
+			// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
+			//@note - if the server is currently CPU saturated then do not sort until framerate improves
+			check(World == Connection->Viewer->GetWorld());
+			AGameMode const* const GameMode = World->GetAuthGameMode();
+			Job.bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
+			Job.bDormancyEnabled = bDormancyEnabled;
+			Job.bValidateDormancy = bValidateDormancy;
 
-								if ( Replicator != NULL )
-								{
-									Replicator->Get().ValidateAgainstState( Actor );
-								}
-							}
-
-							continue;
-						}
+			// let the relevancy policy narrow down the actors this connection needs to look at
+			if ( RelevancyPolicy.IsValid() )
+			{
+				// Dormant actors are skipped by the prioritization anyway, unless their properties are validated
+				RelevancyPolicy->GatherActorsForConnection( Connection, Job.Viewers, bDormancyEnabled && !bValidateDormancy, Job.GatheredActors, Job.GatheredPriorityScales );
+				Job.ConsiderList = Job.GatheredActors.GetTypedData();
+				Job.ConsiderListSize = Job.GatheredActors.Num();
+				Job.PriorityScales = Job.GatheredPriorityScales.GetTypedData();
+			}
+			else
+			{
+				Job.ConsiderList = ConsiderList;
+				Job.ConsiderListSize = ConsiderListSize;
+			}
 
-						// If actor might need to go dormant on this channel, then check
-						if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
-						{
-							bool ShouldGoDormant = true;
-							if (Actor->NetDormancy == DORM_DormantPartial)
-							{
-								float Time  = Channel ? (Connection->Driver->Time - Channel->LastUpdateTime) : Connection->Driver->SpawnPrioritySeconds;
-								for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
-								{
-									if (!Actor->GetNetDormancy(ConnectionViewers[viewerIdx].ViewLocation, ConnectionViewers[viewerIdx].ViewDir, ConnectionViewers[viewerIdx].InViewer, Channel, Time, bLowNetBandwidth))
-									{
-										ShouldGoDormant = false;
-										break;
-									}
-								}
-							}
+			// The priority lists of all connections stay around until every connection is replicated, so only allocate what this connection can fill
+			int32 MaxPrioritized = Job.ConsiderListSize + Connection->DestroyedStartupOrDormantActors.Num() + Connection->OwnedConsiderListSize;
+			for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+			{
+				MaxPrioritized += Connection->Children[ChildIdx]->OwnedConsiderListSize;
+			}
+			Job.PriorityList = new(FMemStack::Get(),MaxPrioritized+2)FActorPriority;
+			Job.PriorityActors = new(FMemStack::Get(),MaxPrioritized+2)FActorPriority*;
+		}
+	}
 
-							if (ShouldGoDormant)
-							{
-								// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
-								Channel->StartBecomingDormant();
-							}
-						}
-					}
+	// Prioritize actors for all connections, the connections are independent so they can be handled on worker threads
+	{
+		SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
+		ParallelFor(ConnectionJobs.Num(), FPrioritizeConnectionBody(this, ConnectionJobs), 1, bParallelReplication ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	}
 
+	// Apply the dormancy changes found while prioritizing, before any actor is replicated
+	for (int32 JobIdx = 0; JobIdx < ConnectionJobs.Num(); JobIdx++)
+	{
+		FNetConnectionReplicationJob& Job = ConnectionJobs[JobIdx];
 
-					// Skip actor if not relevant and theres no channel already.
-					// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
-					// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
-					// prioritized actors low.
-					if (!Channel)
-					{
-						if ( !IsLevelInitializedForActor(Actor, Connection) )
-						{
-							// If the level this actor belongs to isn't loaded on client, don't bother sending
-							continue;
-						}
-						bool Relevant = false;
-						for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
-						{
-							if(Actor->IsNetRelevantFor(ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].Viewer, ConnectionViewers[viewerIdx].ViewLocation))
-							{
-								Relevant = true;
-								break;
-							}
-						}
-						if (!Relevant)
-						{
-							continue;
-						}
-					}
+		for (int32 j = 0; j < Job.DormantActorsToValidate.Num(); j++)
+		{
+			TSharedRef< FObjectReplicator > * Replicator = Job.Connection->DormantReplicatorMap.Find( Job.DormantActorsToValidate[j] );
 
-					if( Actor->NetTag!=NetTag ) // Do not consider actor for this connection if this connection has it marked dormant
-					{
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
-						Actor->NetTag                 = NetTag;
-						PriorityList  [ConsiderCount] = FActorPriority(Connection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-						PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-						ConsiderCount++;
+			if ( Replicator != NULL )
+			{
+				Replicator->Get().ValidateAgainstState( Job.DormantActorsToValidate[j] );
+			}
+		}
 
-						if (DebugRelevantActors)
-						{
-							LastPrioritizedActors.Add(Actor);
-						}
-					}
-				}
+		for (int32 j = 0; j < Job.ChannelsToStartDormancy.Num(); j++)
+		{
+			Job.ChannelsToStartDormancy[j]->StartBecomingDormant();
+		}
+	}
 
-				// Add in deleted actors
-				for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
-				{
-					FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
-					PriorityList  [ConsiderCount] = FActorPriority(Connection, &DInfo, ConnectionViewers);
-					PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-					ConsiderCount++;
-					DeletedCount++;
-				}
+	// Compare the properties of the prioritized actors against their shared shadow state on worker threads.
+	// ReplicateActor then only needs to pick up the shared change lists for each connection.
+	if ( bParallelReplication )
+	{
+		SCOPE_CYCLE_COUNTER(STAT_NetCompareSharedPropertiesTime);
 
-				UNetConnection* NextConnection = Connection;
-				int32 ChildIndex = 0;
-				while (NextConnection != NULL)
+		NetTag++;
+		TArray<FRepChangedPropertyTracker*> CompareTrackers;
+		TArray<AActor*> CompareActors;
+		for (int32 JobIdx = 0; JobIdx < ConnectionJobs.Num(); JobIdx++)
+		{
+			const FNetConnectionReplicationJob& Job = ConnectionJobs[JobIdx];
+			for (int32 j = 0; j < Job.ConsiderCount; j++)
+			{
+				AActor* Actor = Job.PriorityList[j].Actor;
+				if (Actor != NULL && Actor->NetTag != NetTag)
 				{
-					for (int32 j = 0; j < NextConnection->OwnedConsiderListSize; j++)
+					Actor->NetTag = NetTag;
+					TSharedPtr<FRepChangedPropertyTracker>* Tracker = RepChangedPropertyTrackerMap.Find(Actor);
+					if (Tracker != NULL && Tracker->IsValid() && (*Tracker)->ChangelistState.RepLayout.IsValid())
 					{
-						AActor* Actor = NextConnection->OwnedConsiderList[j];
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
-						if (Actor->NetTag != NetTag)
-						{
-							UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
-							Actor->NetTag                 = NetTag;
-							PriorityList  [ConsiderCount] = FActorPriority(NextConnection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-							PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-							ConsiderCount++;
-
-							if (DebugRelevantActors)
-							{
-								LastPrioritizedActors.Add(Actor);
-							}
-						}
+						CompareTrackers.Add(Tracker->Get());
+						CompareActors.Add(Actor);
 					}
-					NextConnection->OwnedConsiderList = NULL;
-					NextConnection->OwnedConsiderListSize = 0;
-
-					NextConnection = (ChildIndex < Connection->Children.Num()) ? Connection->Children[ChildIndex++] : NULL;
 				}
+			}
+		}
 
-				SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
-				SET_DWORD_STAT(STAT_NumRelevantDeletedActors,DeletedCount);
+		ParallelFor(CompareActors.Num(), FCompareSharedPropertiesBody(CompareTrackers, CompareActors, ReplicationFrame), 8);
+	}
 
-				// Sort by priority
-				struct FCompareFActorPriority
-				{
-					FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
-					{
-						return B.Priority < A.Priority;
-					}
-				};
-				Sort( PriorityActors, ConsiderCount, FCompareFActorPriority() );
+	// Replicate the prioritized actors on the game thread, one connection after the other, so channel and packet writes stay in order
+	for (int32 JobIdx = 0; JobIdx < ConnectionJobs.Num(); JobIdx++)
+	{
+		FNetConnectionReplicationJob& Job = ConnectionJobs[JobIdx];
+		UNetConnection* Connection = Job.Connection;
+		FActorPriority** PriorityActors = Job.PriorityActors;
+		const int32 ConsiderCount = Job.ConsiderCount;
+		int32 ActorUpdatesThisConnection = 0;
+		int32 ActorUpdatesThisConnectionSent = 0;
+		int32 j;
+
+		SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
+		SET_DWORD_STAT(STAT_NumRelevantDeletedActors,Job.DeletedCount);
 
-			} // END PRIORITIZE
+		// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
+		TArray<FNetViewer>& ConnectionViewers = WorldSettings->ReplicationViewers;
+		ConnectionViewers = Job.Viewers;
 
+		{
 			// Update all relevant actors in sorted order.
 			bool bNewSaturated = !Connection->IsNetReady(0);
 			if (bNewSaturated)
@@ -2419,9 +2631,8 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 					}
 				}
 			}
-			RelevantActorMark.Pop();
-			UE_LOG(LogNetTraffic, Log, TEXT("Potential %04i ConsiderList %03i ConsiderCount %03i Prune=%01.4f "),NetRelevantCount, 
-						ConsiderListSize, ConsiderCount, FPlatformTime::ToMilliseconds(PruneActors) );
+			UE_LOG(LogNetTraffic, Log, TEXT("Potential %04i ConsiderList %03i ConsiderCount %03i Prune=%01.4f "),Job.NetRelevantCount, 
+						Job.ConsiderListSize, ConsiderCount, FPlatformTime::ToMilliseconds(Job.PruneActors) );
 
 			SET_DWORD_STAT(STAT_NumReplicatedActorAttempts,ActorUpdatesThisConnection);
 			SET_DWORD_STAT(STAT_NumReplicatedActors,ActorUpdatesThisConnectionSent);
@@ -2883,7 +3094,9 @@ TSharedPtr<FRepChangedPropertyTracker> UNetDriver::FindOrCreateRepChangedPropert
 	{
 		FRepChangedPropertyTracker * Tracker = new FRepChangedPropertyTracker();
 
-		GetObjectClassRepLayout( Obj->GetClass() )->InitChangedTracker( Tracker );
+		TSharedPtr<FRepLayout> RepLayout = GetObjectClassRepLayout( Obj->GetClass() );
+		RepLayout->InitChangedTracker( Tracker );
+		Tracker->ChangelistState.RepLayout = RepLayout;
 
 		GlobalPropertyTrackerPtr = &RepChangedPropertyTrackerMap.Add( Obj, TSharedPtr<FRepChangedPropertyTracker>( Tracker ) );
 	}
@@ -2891,6 +3104,11 @@ TSharedPtr<FRepChangedPropertyTracker> UNetDriver::FindOrCreateRepChangedPropert
 	return *GlobalPropertyTrackerPtr;
 }
 
+void UNetDriver::SetRelevancyPolicy( TSharedPtr< INetRelevancyPolicy > InRelevancyPolicy )
+{
+	RelevancyPolicy = InRelevancyPolicy;
+}
+
 TSharedPtr<FRepLayout> UNetDriver::GetObjectClassRepLayout( UClass * Class )
 {
 	TSharedPtr<FRepLayout> * RepLayoutPtr = RepLayoutMap.Find( Class );
@@ -948,6 +948,18 @@ bool APawn::IsNetRelevantFor(APlayerController* RealViewer, AActor* Viewer, cons
 	return ((SrcLocation - GetActorLocation()).SizeSquared() < NetCullDistanceSquared);
 }
 
+bool APawn::UsesDistanceBasedNetRelevancy() const
+{
+	if ( !Super::UsesDistanceBasedNetRelevancy() || Cast<APlayerController>(Controller) != NULL )
+	{
+		return false;
+	}
+
+	// Pawns based on a skeletal mesh are relevant whenever the owner of the mesh is
+	UPrimitiveComponent* MovementBase = GetMovementBase();
+	return !( MovementBase && MovementBase->GetOwner() && GetMovementComponent() && Cast<const USkeletalMeshComponent>(MovementBase) );
+}
+
 void APawn::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
 {
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
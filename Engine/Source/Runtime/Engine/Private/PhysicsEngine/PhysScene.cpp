@@ -6,6 +6,7 @@
 #if WITH_PHYSX
 	#include "PhysXSupport.h"
 	#include "../Vehicles/PhysXVehicleManager.h"
+	#include "../Collision/PhysXBatchTraceQueries.h"
 #endif
 
 #include "PhysSubstepTasks.h"	//needed even if not substepping, contains common utility class for PhysX
@@ -17,6 +18,17 @@
 static int32 PhysXSceneCount = 1;
 static const int PhysXSlowRebuildRate = 10;
 
+static int32 GFrameLagSyncScene = 0;
+static FAutoConsoleVariableRef CVarFrameLagSyncScene(
+	TEXT("p.FrameLagSyncScene"),
+	GFrameLagSyncScene,
+	TEXT("Whether the sync scene simulates across the whole frame instead of being waited for in TG_EndPhysics.\n")
+	TEXT("Components are moved to the previous frame's results in TG_StartPhysics, and forces, torques and kinematic targets are applied a frame late.\n")
+	TEXT("Set it before the world is created to also let dedicated servers simulate on the worker threads.\n")
+	TEXT(" 0: simulate and wait within the frame (default)\n")
+	TEXT(" 1: simulate across the frame, for servers where same frame physics results do not matter")
+	);
+
 FORCEINLINE EPhysicsSceneType SceneType(const FBodyInstance * BodyInstance)
 {
 #if WITH_PHYSX
@@ -28,12 +40,21 @@ FORCEINLINE EPhysicsSceneType SceneType(const FBodyInstance * BodyInstance)
 	return PST_Sync;
 }
 
+/**
+ * Return true if we should lag the sync scene a frame
+**/
+FORCEINLINE static bool FrameLagSync()
+{
+	return GFrameLagSyncScene != 0;
+}
+
 /**
  * Return true if we should be running in single threaded mode, ala dedicated server
+ * A dedicated server lagging the sync scene uses the worker threads, otherwise the simulation could not overlap the frame
 **/
 FORCEINLINE static bool PhysSingleThreadedMode()
 {
-	if (IsRunningDedicatedServer() || FPlatformMisc::NumberOfCores() < 3 || !FPlatformProcess::SupportsMultithreading())
+	if ((IsRunningDedicatedServer() && !FrameLagSync()) || FPlatformMisc::NumberOfCores() < 3 || !FPlatformProcess::SupportsMultithreading())
 	{
 		return true;
 	}
@@ -58,8 +79,15 @@ FPhysScene::FPhysScene()
 {
 	LineBatcher = NULL;
 	OwningWorld = NULL;
+	bSyncSceneFrameLagged = false;
+	SyncSceneStepTime = 0.f;
+#if WITH_PHYSX
+	NewestBodySnapshot = 0;
+	NumBodySnapshots = 0;
+#endif
 #if WITH_PHYSX
 	VehicleManager = NULL;
+	FMemory::Memzero(BatchTraceQueries, sizeof(BatchTraceQueries));
 	PhysxUserData = FPhysxUserData(this);
 
 	// Create dispatcher for tasks
@@ -160,6 +188,12 @@ bool UseSyncTime(uint32 SceneType)
 
 }
 
+bool FPhysScene::ShouldDeferBodyCommand(FBodyInstance* BodyInstance) const
+{
+	// Deferred for the whole frame, even once the scene is done, so commands are applied in the order they were issued
+	return bSyncSceneFrameLagged && SceneType(BodyInstance) == PST_Sync;
+}
+
 void FPhysScene::SetKinematicTarget(FBodyInstance * BodyInstance, const FTransform & TargetTransform)
 {
 	TargetTransform.DiagnosticCheckNaN_All();
@@ -175,6 +209,11 @@ void FPhysScene::SetKinematicTarget(FBodyInstance * BodyInstance, const FTransfo
 		}
 		else
 #endif
+		if (ShouldDeferBodyCommand(BodyInstance))
+		{
+			DeferredBodyCommandQueue.Add(FPendingBodyCommand(BodyInstance, FPendingBodyCommand::KinematicTarget, FVector::ZeroVector, TargetTransform));
+		}
+		else
 		{
 			const PxTransform PNewPose = U2PTransform(TargetTransform);
 			check(PNewPose.isValid());
@@ -200,6 +239,11 @@ void FPhysScene::AddForce(FBodyInstance * BodyInstance, const FVector & Force)
 		}
 		else
 #endif
+		if (ShouldDeferBodyCommand(BodyInstance))
+		{
+			DeferredBodyCommandQueue.Add(FPendingBodyCommand(BodyInstance, FPendingBodyCommand::Force, Force));
+		}
+		else
 		{
 			SCOPED_SCENE_WRITE_LOCK(PRigidDynamic->getScene());
 			PRigidDynamic->addForce(U2PVector(Force), PxForceMode::eFORCE, true);
@@ -222,6 +266,11 @@ void FPhysScene::AddForceAtPosition(FBodyInstance * BodyInstance, const FVector
 		}
 		else
 #endif
+		if (ShouldDeferBodyCommand(BodyInstance))
+		{
+			DeferredBodyCommandQueue.Add(FPendingBodyCommand(BodyInstance, FPendingBodyCommand::ForceAtPosition, Force, FTransform(Position)));
+		}
+		else
 		{
 			SCOPED_SCENE_WRITE_LOCK(PRigidDynamic->getScene());
 			PxRigidBodyExt::addForceAtPos(*PRigidDynamic, U2PVector(Force), U2PVector(Position), PxForceMode::eFORCE, true);
@@ -244,6 +293,11 @@ void FPhysScene::AddTorque(FBodyInstance * BodyInstance, const FVector & Torque)
 		}
 		else
 #endif
+		if (ShouldDeferBodyCommand(BodyInstance))
+		{
+			DeferredBodyCommandQueue.Add(FPendingBodyCommand(BodyInstance, FPendingBodyCommand::Torque, Torque));
+		}
+		else
 		{
 			SCOPED_SCENE_WRITE_LOCK(PRigidDynamic->getScene());
 			PRigidDynamic->addTorque(U2PVector(Torque), PxForceMode::eFORCE, true);
@@ -254,6 +308,20 @@ void FPhysScene::AddTorque(FBodyInstance * BodyInstance, const FVector & Torque)
 
 void FPhysScene::TermBody(FBodyInstance * BodyInstance)
 {
+	// Drop any commands still waiting for the sync scene, keeping the order of the rest
+	for (int32 CommandIndex = DeferredBodyCommandQueue.Num() - 1; CommandIndex >= 0; --CommandIndex)
+	{
+		if (DeferredBodyCommandQueue[CommandIndex].BodyInstance == BodyInstance)
+		{
+			DeferredBodyCommandQueue.RemoveAt(CommandIndex);
+		}
+	}
+
+#if WITH_PHYSX
+	// A rewound body can't be restored once its actor is released
+	RewoundBodies.Remove(BodyInstance);
+#endif
+
 #if WITH_SUBSTEPPING
 	if (PxRigidDynamic * PRigidDynamic = BodyInstance->GetPxRigidDynamic())
 	{
@@ -340,6 +408,64 @@ void FPhysScene::FlushDeferredCollisionDisableTableQueue()
 	DeferredCollisionDisableTableQueue.Empty();
 }
 
+void FPhysScene::FlushDeferredBodyCommands()
+{
+	check(IsInGameThread());
+	TArray<FPendingBodyCommand>& Commands = DeferredBodyCommandQueue;
+
+#if WITH_PHYSX
+	if (Commands.Num())
+	{
+		// Only bodies of the sync scene are deferred, so one lock covers all of them
+		PxScene* PScene = GetPhysXScene(PST_Sync);
+		SCOPED_SCENE_WRITE_LOCK(PScene);
+
+		for (int32 CommandIndex = 0; CommandIndex < Commands.Num(); ++CommandIndex)
+		{
+			const FPendingBodyCommand& Command = Commands[CommandIndex];
+			PxRigidDynamic* PRigidDynamic = Command.BodyInstance->GetPxRigidDynamic();
+			if (PRigidDynamic == NULL)
+			{
+				continue;
+			}
+
+			switch (Command.Type)
+			{
+			case FPendingBodyCommand::Force:
+				PRigidDynamic->addForce(U2PVector(Command.Vector), PxForceMode::eFORCE, true);
+				break;
+			case FPendingBodyCommand::ForceAtPosition:
+				PxRigidBodyExt::addForceAtPos(*PRigidDynamic, U2PVector(Command.Vector), U2PVector(Command.Transform.GetLocation()), PxForceMode::eFORCE, true);
+				break;
+			case FPendingBodyCommand::Torque:
+				PRigidDynamic->addTorque(U2PVector(Command.Vector), PxForceMode::eFORCE, true);
+				break;
+			case FPendingBodyCommand::KinematicTarget:
+				PRigidDynamic->setKinematicTarget(U2PTransform(Command.Transform));
+				break;
+			}
+		}
+	}
+#endif
+
+	Commands.Reset();
+}
+
+void FPhysScene::FinishFrameLaggedSyncScene()
+{
+	if (FrameLaggedPhysicsSubsceneCompletion[PST_Sync].GetReference())
+	{
+		// The results are fetched by a game thread task, so this also runs ProcessPhysScene if the scene is done
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(FrameLaggedPhysicsSubsceneCompletion[PST_Sync], ENamedThreads::GameThread);
+		FrameLaggedPhysicsSubsceneCompletion[PST_Sync] = NULL;
+
+		// Active transforms can't be read while the scene simulates, so the components are moved here rather than in EndFrame
+		SyncComponentsToBodies(PST_Sync);
+	}
+
+	FlushDeferredBodyCommands();
+}
+
 /** Exposes ticking of physics-engine scene outside Engine. */
 void FPhysScene::TickPhysScene(uint32 SceneType, FGraphEventRef& InOutCompletionEvent)
 {
@@ -522,6 +648,11 @@ void FPhysScene::ProcessPhysScene(uint32 SceneType)
 	{
 		UE_LOG(LogPhysics, Log, TEXT("PHYSX FETCHRESULTS ERROR: %d"), OutErrorCode);
 	}
+
+	if (SceneType == PST_Sync)
+	{
+		RecordBodySnapshot(SyncSceneStepTime);
+	}
 #endif // WITH_PHYSX
 
 	// Reset execution flag
@@ -677,9 +808,19 @@ void FPhysScene::StartFrame()
 {
 	FGraphEventArray FinishPrerequisites;
 
+	// Bodies must not be simulated from a rewound state
+	RestoreRewoundBodies();
+
 	//Update the collision disable table before ticking
 	FlushDeferredCollisionDisableTableQueue();
 
+	// Collect the sync scene started last frame before stepping it again
+	FinishFrameLaggedSyncScene();
+	bSyncSceneFrameLagged = FrameLagSync();
+
+	// The step started below ends at the current world time, which is what its snapshot is recorded as
+	SyncSceneStepTime = OwningWorld ? OwningWorld->GetTimeSeconds() : 0.f;
+
 	// Run the sync scene
 	 TickPhysScene(PST_Sync, PhysicsSubsceneCompletion[PST_Sync]);
 	 {
@@ -695,7 +836,16 @@ void FPhysScene::StartFrame()
 		 if (PhysicsSubsceneCompletion[PST_Sync].GetReference())
 		 {
 			 MainScenePrerequisites.Add(PhysicsSubsceneCompletion[PST_Sync]);
-			 new (FinishPrerequisites) FGraphEventRef(FDelegateGraphTask::CreateAndDispatchWhenReady(FDelegateGraphTask::FDelegate::CreateRaw(this, &FPhysScene::SceneCompletionTask, PST_Sync), TEXT("ProcessPhysScene_Sync"), &MainScenePrerequisites, ENamedThreads::GameThread, ENamedThreads::GameThread));
+			 FGraphEventRef SyncSceneCompletion = FDelegateGraphTask::CreateAndDispatchWhenReady(FDelegateGraphTask::FDelegate::CreateRaw(this, &FPhysScene::SceneCompletionTask, PST_Sync), TEXT("ProcessPhysScene_Sync"), &MainScenePrerequisites, ENamedThreads::GameThread, ENamedThreads::GameThread);
+			 if (bSyncSceneFrameLagged)
+			 {
+				 // Nothing waits for the sync scene this frame, it is collected by the next StartFrame
+				 FrameLaggedPhysicsSubsceneCompletion[PST_Sync] = SyncSceneCompletion;
+			 }
+			 else
+			 {
+				 FinishPrerequisites.Add(SyncSceneCompletion);
+			 }
 		 }
 	 }
 
@@ -735,7 +885,11 @@ void FPhysScene::EndFrame(ULineBatchComponent* InLineBatcher)
 		SyncComponentsToBodies(PST_Async);
 	}
 
-	SyncComponentsToBodies(PST_Sync);
+	// A frame lagged sync scene is still simulating, its components were moved to last frame's results in StartFrame
+	if (!bSyncSceneFrameLagged)
+	{
+		SyncComponentsToBodies(PST_Sync);
+	}
 
 	// Perform any collision notification events
 	DispatchPhysNotifications();
@@ -744,7 +898,10 @@ void FPhysScene::EndFrame(ULineBatchComponent* InLineBatcher)
 	// Handle debug rendering
 	if (InLineBatcher)
 	{
-		AddDebugLines(PST_Sync, InLineBatcher);
+		if (!bSyncSceneFrameLagged)
+		{
+			AddDebugLines(PST_Sync, InLineBatcher);
+		}
 
 		if (bAsyncSceneEnabled)
 		{
@@ -800,6 +957,18 @@ FPhysXVehicleManager* FPhysScene::GetVehicleManager()
 	return VehicleManager;
 }
 
+FPhysXBatchTraceQueries* FPhysScene::GetBatchTraceQueries(uint32 SceneType)
+{
+	check(SceneType < NumPhysScenes);
+	check(IsInGameThread());
+
+	if (BatchTraceQueries[SceneType] == NULL)
+	{
+		BatchTraceQueries[SceneType] = new FPhysXBatchTraceQueries(GetPhysXScene(SceneType));
+	}
+	return BatchTraceQueries[SceneType];
+}
+
 #if WITH_APEX
 NxApexScene* FPhysScene::GetApexScene(uint32 SceneType)
 {
@@ -1062,6 +1231,9 @@ void FPhysScene::TermPhysScene(uint32 SceneType)
 			VehicleManager = NULL;
 		}
 
+		delete BatchTraceQueries[SceneType];
+		BatchTraceQueries[SceneType] = NULL;
+
 #if WITH_SUBSTEPPING
 		delete PhysSubSteppers[SceneType];
 		PhysSubSteppers[SceneType] = NULL;
@@ -0,0 +1,283 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	PhysSceneSnapshot.cpp: Body state history and rewinding for FPhysScene
+=============================================================================*/
+
+#include "EnginePrivate.h"
+
+#if WITH_PHYSX
+	#include "PhysXSupport.h"
+#endif
+
+/**
+ * Body snapshots
+ * After each step of the sync scene the pose and velocities of all its dynamic bodies are copied into a ring buffer, as parallel arrays sorted by actor.
+ * Rewinding a set of bodies looks each one up in the two snapshots around the requested time, saves its current state and moves it to the interpolated one.
+ * This lets lag compensation validate hits against where bodies were, instead of re-tracing against where they are now.
+ */
+
+static int32 GPhysicsSnapshotHistory = 0;
+static FAutoConsoleVariableRef CVarPhysicsSnapshotHistory(
+	TEXT("p.PhysicsSnapshotHistory"),
+	GPhysicsSnapshotHistory,
+	TEXT("Number of sync scene steps whose body states are kept for FPhysScene::RewindBodies.\n")
+	TEXT(" 0: keep no history (default)")
+	);
+
+DECLARE_CYCLE_STAT(TEXT("Phys Record Snapshot"), STAT_PhysicsRecordSnapshot, STATGROUP_Physics);
+DECLARE_CYCLE_STAT(TEXT("Phys Rewind Bodies"), STAT_PhysicsRewindBodies, STATGROUP_Physics);
+
+#if WITH_PHYSX
+
+/** Orders actors by address, Sort passes the pointed to actors */
+struct FCompareActorAddress
+{
+	FORCEINLINE bool operator()(const PxRigidDynamic& A, const PxRigidDynamic& B) const
+	{
+		return &A < &B;
+	}
+};
+
+/** Moves a body to a state, without waking it so the simulation is left as it was */
+static void SetBodyState(PxRigidDynamic* PRigidDynamic, const FVector& Position, const FQuat& Rotation, const FVector& LinearVelocity, const FVector& AngularVelocity)
+{
+	PRigidDynamic->setGlobalPose(PxTransform(U2PVector(Position), U2PQuat(Rotation)), false);
+
+	// Kinematic bodies have no velocity of their own
+	if (IsRigidDynamicNonKinematic(PRigidDynamic))
+	{
+		PRigidDynamic->setLinearVelocity(U2PVector(LinearVelocity), false);
+		PRigidDynamic->setAngularVelocity(U2PVector(AngularVelocity), false);
+	}
+}
+
+void FPhysScene::FBodySnapshot::Reset()
+{
+	Actors.Reset();
+	BodyInstances.Reset();
+	Positions.Reset();
+	Rotations.Reset();
+	LinearVelocities.Reset();
+	AngularVelocities.Reset();
+}
+
+void FPhysScene::FBodySnapshot::Add(PxRigidDynamic* Actor, FBodyInstance* BodyInstance, const FVector& Position, const FQuat& Rotation, const FVector& LinearVelocity, const FVector& AngularVelocity)
+{
+	Actors.Add(Actor);
+	BodyInstances.Add(BodyInstance);
+	Positions.Add(Position);
+	Rotations.Add(Rotation);
+	LinearVelocities.Add(LinearVelocity);
+	AngularVelocities.Add(AngularVelocity);
+}
+
+void FPhysScene::FBodySnapshot::Remove(FBodyInstance* BodyInstance)
+{
+	for (int32 Index = BodyInstances.Num() - 1; Index >= 0; --Index)
+	{
+		if (BodyInstances[Index] == BodyInstance)
+		{
+			Actors.RemoveAt(Index);
+			BodyInstances.RemoveAt(Index);
+			Positions.RemoveAt(Index);
+			Rotations.RemoveAt(Index);
+			LinearVelocities.RemoveAt(Index);
+			AngularVelocities.RemoveAt(Index);
+		}
+	}
+}
+
+int32 FPhysScene::FBodySnapshot::Find(PxRigidDynamic* Actor, FBodyInstance* BodyInstance) const
+{
+	// Binary search for the first actor not below the one we want
+	int32 Min = 0;
+	int32 Max = Actors.Num();
+	while (Min < Max)
+	{
+		const int32 Mid = (Min + Max) / 2;
+		if (Actors[Mid] < Actor)
+		{
+			Min = Mid + 1;
+		}
+		else
+		{
+			Max = Mid;
+		}
+	}
+
+	if (Min < Actors.Num() && Actors[Min] == Actor && BodyInstances[Min] == BodyInstance)
+	{
+		return Min;
+	}
+	return INDEX_NONE;
+}
+
+#endif // WITH_PHYSX
+
+void FPhysScene::RecordBodySnapshot(float Time)
+{
+#if WITH_PHYSX
+	const int32 HistoryLength = FMath::Max(GPhysicsSnapshotHistory, 0);
+	if (BodySnapshots.Num() != HistoryLength)
+	{
+		// The history restarts when its length changes, which also frees it when it is turned off
+		BodySnapshots.Empty(HistoryLength);
+		BodySnapshots.AddZeroed(HistoryLength);
+		NewestBodySnapshot = 0;
+		NumBodySnapshots = 0;
+		BodySnapshotActorBuffer.Empty();
+	}
+
+	if (HistoryLength == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PhysicsRecordSnapshot);
+
+	NewestBodySnapshot = (NewestBodySnapshot + 1) % HistoryLength;
+	NumBodySnapshots = FMath::Min(NumBodySnapshots + 1, HistoryLength);
+
+	FBodySnapshot& Snapshot = BodySnapshots[NewestBodySnapshot];
+	Snapshot.Time = Time;
+
+	PxScene* PScene = GetPhysXScene(PST_Sync);
+	SCOPED_SCENE_READ_LOCK(PScene);
+
+	TArray<PxActor*>& PActors = BodySnapshotActorBuffer;
+	const int32 NumSceneActors = PScene->getNbActors(PxActorTypeSelectionFlag::eRIGID_DYNAMIC);
+	PActors.Reset(NumSceneActors);
+	PActors.AddUninitialized(NumSceneActors);
+	PScene->getActors(PxActorTypeSelectionFlag::eRIGID_DYNAMIC, PActors.GetTypedData(), PActors.Num());
+
+	const int32 NumActors = PActors.Num();
+	Snapshot.Actors.Reset(NumActors);
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		Snapshot.Actors.Add(PActors[ActorIndex]->isRigidDynamic());
+	}
+	Snapshot.Actors.Sort(FCompareActorAddress());
+
+	Snapshot.BodyInstances.Reset(NumActors);
+	Snapshot.Positions.Reset(NumActors);
+	Snapshot.Rotations.Reset(NumActors);
+	Snapshot.LinearVelocities.Reset(NumActors);
+	Snapshot.AngularVelocities.Reset(NumActors);
+	Snapshot.BodyInstances.AddUninitialized(NumActors);
+	Snapshot.Positions.AddUninitialized(NumActors);
+	Snapshot.Rotations.AddUninitialized(NumActors);
+	Snapshot.LinearVelocities.AddUninitialized(NumActors);
+	Snapshot.AngularVelocities.AddUninitialized(NumActors);
+
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		PxRigidDynamic* PRigidDynamic = Snapshot.Actors[ActorIndex];
+		const PxTransform PPose = PRigidDynamic->getGlobalPose();
+
+		Snapshot.BodyInstances[ActorIndex] = FPhysxUserData::Get<FBodyInstance>(PRigidDynamic->userData);
+		Snapshot.Positions[ActorIndex] = P2UVector(PPose.p);
+		Snapshot.Rotations[ActorIndex] = P2UQuat(PPose.q);
+		Snapshot.LinearVelocities[ActorIndex] = P2UVector(PRigidDynamic->getLinearVelocity());
+		Snapshot.AngularVelocities[ActorIndex] = P2UVector(PRigidDynamic->getAngularVelocity());
+	}
+#endif
+}
+
+int32 FPhysScene::RewindBodies(FBodyInstance* const* Bodies, int32 NumBodies, float Time)
+{
+	int32 NumRewound = 0;
+
+#if WITH_PHYSX
+	SCOPE_CYCLE_COUNTER(STAT_PhysicsRewindBodies);
+
+	// Rewinds don't stack, each one starts from the current state
+	RestoreRewoundBodies();
+
+	if (bPhysXSceneExecuting[PST_Sync])
+	{
+		UE_LOG(LogPhysics, Warning, TEXT("RewindBodies: The sync scene is simulating, bodies can't be moved for scene queries - aborting."));
+		return 0;
+	}
+
+	// Find the snapshots on either side of the time, walking back from the newest
+	const FBodySnapshot* Older = NULL;
+	const FBodySnapshot* Newer = NULL;
+	for (int32 Age = 0; Age < NumBodySnapshots; ++Age)
+	{
+		const FBodySnapshot& Snapshot = BodySnapshots[(NewestBodySnapshot - Age + BodySnapshots.Num()) % BodySnapshots.Num()];
+		if (Snapshot.Time <= Time)
+		{
+			Older = &Snapshot;
+			break;
+		}
+		Newer = &Snapshot;
+	}
+
+	if (Older == NULL)
+	{
+		// Further back than the history goes
+		return 0;
+	}
+
+	const float Alpha = Newer ? (Time - Older->Time) / (Newer->Time - Older->Time) : 0.f;
+
+	PxScene* PScene = GetPhysXScene(PST_Sync);
+	SCOPED_SCENE_WRITE_LOCK(PScene);
+
+	for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+	{
+		FBodyInstance* BodyInstance = Bodies[BodyIndex];
+		PxRigidDynamic* PRigidDynamic = BodyInstance ? BodyInstance->GetPxRigidDynamic() : NULL;
+		const int32 OlderIndex = PRigidDynamic ? Older->Find(PRigidDynamic, BodyInstance) : INDEX_NONE;
+		if (OlderIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FVector Position = Older->Positions[OlderIndex];
+		FQuat Rotation = Older->Rotations[OlderIndex];
+		FVector LinearVelocity = Older->LinearVelocities[OlderIndex];
+		FVector AngularVelocity = Older->AngularVelocities[OlderIndex];
+
+		// A body missing from the newer snapshot keeps its older state
+		const int32 NewerIndex = Newer ? Newer->Find(PRigidDynamic, BodyInstance) : INDEX_NONE;
+		if (NewerIndex != INDEX_NONE)
+		{
+			Position = FMath::Lerp(Position, Newer->Positions[NewerIndex], Alpha);
+			Rotation = FQuat::Slerp(Rotation, Newer->Rotations[NewerIndex], Alpha);
+			LinearVelocity = FMath::Lerp(LinearVelocity, Newer->LinearVelocities[NewerIndex], Alpha);
+			AngularVelocity = FMath::Lerp(AngularVelocity, Newer->AngularVelocities[NewerIndex], Alpha);
+		}
+
+		const PxTransform PCurrentPose = PRigidDynamic->getGlobalPose();
+		RewoundBodies.Add(PRigidDynamic, BodyInstance, P2UVector(PCurrentPose.p), P2UQuat(PCurrentPose.q), P2UVector(PRigidDynamic->getLinearVelocity()), P2UVector(PRigidDynamic->getAngularVelocity()));
+
+		SetBodyState(PRigidDynamic, Position, Rotation, LinearVelocity, AngularVelocity);
+		++NumRewound;
+	}
+#endif
+
+	return NumRewound;
+}
+
+void FPhysScene::RestoreRewoundBodies()
+{
+#if WITH_PHYSX
+	if (RewoundBodies.Actors.Num() == 0)
+	{
+		return;
+	}
+
+	PxScene* PScene = GetPhysXScene(PST_Sync);
+	SCOPED_SCENE_WRITE_LOCK(PScene);
+
+	// Backwards, so a body passed to RewindBodies twice ends up in the state saved before its first move
+	for (int32 BodyIndex = RewoundBodies.Actors.Num() - 1; BodyIndex >= 0; --BodyIndex)
+	{
+		SetBodyState(RewoundBodies.Actors[BodyIndex], RewoundBodies.Positions[BodyIndex], RewoundBodies.Rotations[BodyIndex], RewoundBodies.LinearVelocities[BodyIndex], RewoundBodies.AngularVelocities[BodyIndex]);
+	}
+
+	RewoundBodies.Reset();
+#endif
+}
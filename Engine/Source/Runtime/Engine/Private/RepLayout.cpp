@@ -9,8 +9,6 @@
 #include "Net/DataReplication.h"
 #include "Net/NetworkProfiler.h"
 
-static TAutoConsoleVariable<int32> CVarAllowPropertySkipping( TEXT( "net.AllowPropertySkipping" ), 1, TEXT( "Allow skipping of properties that haven't changed for other clients" ) );
-
 static TAutoConsoleVariable<int32> CVarDoPropertyChecksum( TEXT( "net.DoPropertyChecksum" ), 0, TEXT( "" ) );
 
 FAutoConsoleVariable CVarDoReplicationContextString( TEXT( "net.ContextDebug" ), 0, TEXT( "" ) );
@@ -348,127 +346,6 @@ bool FRepLayout::CompareProperties(
 	return PropertyChanged;
 }
 
-void FRepLayout::LogChangeListMismatches( 
-	const uint8 * 						Data, 
-	UActorChannel *						OwningChannel, 
-	const TArray< uint16 > &			PropertyList,
-	FRepState *							RepState1, 
-	FRepState * 						RepState2, 
-	const TArray< FRepChangedParent > & ChangedParents1,
-	const TArray< FRepChangedParent > & ChangedParents2 ) const
-{
-	FRepChangedPropertyTracker *	ChangeTracker	= RepState1->RepChangedPropertyTracker.Get();
-	UObject *						Object			= (UObject*)Data;
-	const UNetDriver *				NetDriver		= OwningChannel->Connection->Driver;
-
-	UE_LOG( LogNet, Warning, TEXT( "LogChangeListMismatches: %s" ), *Object->GetName() );
-
-	UE_LOG( LogNet, Warning, TEXT( "  %i, %i, %i, %i" ), NetDriver->ReplicationFrame, ChangeTracker->LastReplicationFrame, ChangeTracker->LastReplicationGroupFrame, RepState1->LastReplicationFrame );
-
-	for ( int32 i = 0; i < PropertyList.Num(); i++ )
-	{
-		const int32 Index		= PropertyList[i];
-		const int32 Changed1	= ChangedParents1[Index].Changed.Num();
-		const int32 Changed2	= ChangedParents2[Index].Changed.Num();
-
-		if ( Changed1 || Changed2 )
-		{
-			FString Changed1Str = Changed1 ? TEXT( "TRUE" ) : TEXT( "FALSE" );
-			FString Changed2Str = Changed2 ? TEXT( "TRUE" ) : TEXT( "FALSE" );
-			FString ExtraStr	= Changed1 != Changed2 ? TEXT( "<--- MISMATCH!" ) : TEXT( "<--- SAME" );
-
-			UE_LOG( LogNet, Warning, TEXT( "    Property changed: %s (%s / %s) %s" ), *Parents[Index].Property->GetName(), *Changed1Str, *Changed2Str, *ExtraStr );
-
-			FString StringValue1;
-			FString StringValue2;
-			FString StringValue3;
-
-			Parents[Index].Property->ExportText_InContainer( Parents[Index].ArrayIndex, StringValue1, Data, NULL, NULL, PPF_DebugDump );
-			Parents[Index].Property->ExportText_InContainer( Parents[Index].ArrayIndex, StringValue2, RepState1->StaticBuffer.GetTypedData(), NULL, NULL, PPF_DebugDump );
-			Parents[Index].Property->ExportText_InContainer( Parents[Index].ArrayIndex, StringValue3, RepState2->StaticBuffer.GetTypedData(), NULL, NULL, PPF_DebugDump );
-
-			UE_LOG( LogNet, Warning, TEXT( "      Values: %s, %s, %s" ), *StringValue1, *StringValue2, *StringValue3 );
-		}
-	}
-}
-
-static bool ChangedParentsHasChanged( const TArray< uint16 > & PropertyList, const TArray< FRepChangedParent > & ChangedParents )
-{
-	for ( int32 i = 0; i < PropertyList.Num(); i++ )
-	{
-		if ( ChangedParents[PropertyList[i]].Changed.Num() )
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-void FRepLayout::SanityCheckShadowStateAgainstChangeList( 
-	FRepState *							RepState, 
-	const uint8 *						Data, 
-	UActorChannel *						OwningChannel, 
-	const TArray< uint16 > &			PropertyList,
-	FRepState *							OtherRepState,
-	const TArray< FRepChangedParent > & OtherChangedParents ) const
-{
-	const uint8 *	CompareData	= RepState->StaticBuffer.GetTypedData();
-	UObject *		Object		= (UObject*)Data;
-
-	TArray< FRepChangedParent > LocalChangedParents;
-	LocalChangedParents.SetNum( OtherChangedParents.Num() );
-
-	// Do an actual check to see which properties are different from our internal shadow state, and make sure the passed in change list matches
-	const bool Result = CompareProperties( RepState, CompareData, Data, LocalChangedParents, PropertyList );
-
-	if ( Result != ChangedParentsHasChanged( PropertyList, OtherChangedParents ) )
-	{
-		LogChangeListMismatches( Data, OwningChannel, PropertyList, RepState, OtherRepState, LocalChangedParents, OtherChangedParents );
-		UE_LOG( LogNet, Fatal, TEXT( "ReplicateProperties: Compare result mismatch: %s" ), *Object->GetName() );
-	}
-
-	for ( int32 i = 0; i < PropertyList.Num(); i++ )
-	{
-		const int32 Index = PropertyList[i];
-
-		if ( OtherChangedParents[Index].Changed.Num() != LocalChangedParents[Index].Changed.Num() )
-		{
-			LogChangeListMismatches( Data, OwningChannel, PropertyList, RepState, OtherRepState, LocalChangedParents, OtherChangedParents );
-			UE_LOG( LogNet, Fatal, TEXT( "ReplicateProperties: Compare count mismatch: %s" ), *Object->GetName() );
-		}
-
-		for ( int32 j = 0; j < OtherChangedParents[Index].Changed.Num(); j++ )
-		{
-			if ( OtherChangedParents[Index].Changed[j] != LocalChangedParents[Index].Changed[j] )
-			{
-				LogChangeListMismatches( Data, OwningChannel, PropertyList, RepState, OtherRepState, LocalChangedParents, OtherChangedParents );
-				UE_LOG( LogNet, Fatal, TEXT( "ReplicateProperties: Compare changelist value mismatch: %s" ), *Object->GetName() );
-			}
-		}
-	}
-}
-
-bool FRepLayout::GenerateChangelist( FRepState * RepState, const uint8 * Data, TArray< FRepChangedParent > & OutChangedParents ) const
-{
-	OutChangedParents.Empty();
-
-	OutChangedParents.SetNum( Parents.Num() );
-
-	return CompareProperties( RepState, RepState->StaticBuffer.GetTypedData(), Data, OutChangedParents, UnconditionalLifetime );
-}
-
-void FRepLayout::ValidateChangelist(
-	FRepState *							RepState, 
-	const uint8 * 						Data, 
-	UActorChannel *						OwningChannel,
-	FRepState *							OtherRepState,
-	const TArray< FRepChangedParent > &	OtherChangedParents ) const
-{
-	SanityCheckShadowStateAgainstChangeList( RepState, Data, OwningChannel, UnconditionalLifetime, OtherRepState, OtherChangedParents );
-}
-
-
 bool FRepLayout::ReplicateProperties( 
 	FRepState * RESTRICT		RepState, 
 	const uint8 * RESTRICT		Data, 
@@ -483,10 +360,8 @@ bool FRepLayout::ReplicateProperties(
 
 	check( ObjectClass == Owner );
 
-	UObject *						Object			= (UObject*)Data;
 	const UNetDriver *				NetDriver		= OwningChannel->Connection->Driver;
 	FRepChangedPropertyTracker *	ChangeTracker	= RepState->RepChangedPropertyTracker.Get();
-	const uint8 *					CompareData		= RepState->StaticBuffer.GetTypedData();
 
 	// Rebuild conditional properties if needed
 	if ( RepState->RepFlags.Value != RepFlags.Value || RepState->ActiveStatusChanged != ChangeTracker->ActiveStatusChanged )
@@ -497,7 +372,11 @@ bool FRepLayout::ReplicateProperties(
 		RepState->ActiveStatusChanged	= ChangeTracker->ActiveStatusChanged;
 	}
 
-	bool PropertyChanged = false;
+	// Compare the properties against the shared shadow state
+	// This only happens for the first connection that replicates this object each frame, the others reuse the resulting change list
+	UpdateChangelistState( ChangeTracker, Data, NetDriver->ReplicationFrame );
+
+	TArray< uint16 > ConnectionChanged;
 
 #ifdef ENABLE_SUPER_CHECKSUMS
 	const bool bIsAllAcked = AllAcked( RepState );
@@ -505,69 +384,11 @@ bool FRepLayout::ReplicateProperties(
 	if ( bIsAllAcked || !RepState->OpenAckedCalled )
 #endif
 	{
-		const int32	AllowSkipping = CVarAllowPropertySkipping.GetValueOnGameThread();
-		
-		const bool bCanSkip =	AllowSkipping > 0 && 
-								RepState->LastReplicationFrame != 0 &&
-								ChangeTracker->LastReplicationFrame == NetDriver->ReplicationFrame &&
-								ChangeTracker->LastReplicationGroupFrame == RepState->LastReplicationFrame;
-
-		if ( bCanSkip )
-		{
-			INC_DWORD_STAT_BY( STAT_NetSkippedDynamicProps, UnconditionalLifetime.Num() );
-
-			if ( AllowSkipping == 2 )
-			{
-				// Sanity check results
-				check( ChangeTracker->UnconditionalPropChanged == ChangedParentsHasChanged( UnconditionalLifetime, ChangeTracker->Parents ) );
-
-				SanityCheckShadowStateAgainstChangeList( RepState, Data, OwningChannel, UnconditionalLifetime, ChangeTracker->LastRepState, ChangeTracker->Parents );
-			}
-		}
-		else
-		{
-			// FRepState group changed, force this group to compare again this frame
-			// This happens either once a frame, which is normal, or multiple times a frame 
-			// when multiple connections of the same actor aren't updated at the same time
-			ChangeTracker->LastReplicationFrame			= NetDriver->ReplicationFrame;
-			ChangeTracker->LastReplicationGroupFrame	= RepState->LastReplicationFrame;
-			ChangeTracker->LastRepState					= RepState;
-
-			// Reset changed list if anything changed last time
-			if ( ChangeTracker->UnconditionalPropChanged )
-			{
-				for ( int32 i = UnconditionalLifetime.Num() - 1; i >= 0; i-- )
-				{
-					ChangeTracker->Parents[UnconditionalLifetime[i]].Changed.Empty();
-				}
-			}
-
-			// Loop over all unconditional lifetime properties
-			ChangeTracker->UnconditionalPropChanged = CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, UnconditionalLifetime );
-		}
-
-		// Remember the last frame this FRepState was replicated, so we can note above when the FRepState replication group changes
-		RepState->LastReplicationFrame = NetDriver->ReplicationFrame;
-
-		if ( ChangeTracker->UnconditionalPropChanged )
-		{
-			PropertyChanged	= true;
-		}
-
-		// Loop over all the conditional properties
-		if ( CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, RepState->ConditionalLifetime ) )
-		{
-			PropertyChanged = true;
-		}
-	}
-#ifdef ENABLE_SUPER_CHECKSUMS
-	else
-	{
-		// If we didn't compare this frame, make sure to reset out replication frame
-		// This is to force a compare next time it comes up
-		RepState->LastReplicationFrame = 0;		
+		// Merge the shared change lists we haven't sent yet
+		GatherChangedProperties( RepState, ChangeTracker, Data, ConnectionChanged );
 	}
-#endif
+
+	const bool PropertyChanged = ConnectionChanged.Num() > 0;
 
 	// PreOpenAckHistory are all the properties sent before we got our first open ack
 	const bool bFlushPreOpenAckHistory = RepState->OpenAckedCalled && RepState->PreOpenAckHistory.Num() > 0;
@@ -588,27 +409,8 @@ bool FRepLayout::ReplicateProperties(
 
 		if ( PropertyChanged )
 		{
-			// Initialize the history item change list with the parent change lists
-			// We do it in the order of the parents so that the final change list will be fully sorted
-			for ( int32 i = 0; i < Parents.Num(); i++ )
-			{
-				if ( ChangeTracker->Parents[i].Changed.Num() > 0 )
-				{
-					Changed.Append( ChangeTracker->Parents[i].Changed );
-
-					if ( Parents[i].Flags & PARENT_IsConditional )
-					{
-						// Reset properties that don't share information across connections
-						ChangeTracker->Parents[i].Changed.Empty();
-					}
-				}
-			}
-
-			Changed.Add( 0 );
-
-#ifdef SANITY_CHECK_MERGES
-			SanityCheckChangeList( Data, Changed );
-#endif
+			// Initialize the history item change list with the merged change lists
+			Exchange( Changed, ConnectionChanged );
 		}
 
 		// Update the history, and merge in any nak'd change lists
@@ -647,6 +449,9 @@ bool FRepLayout::ReplicateProperties(
 		SanityCheckChangeList( Data, Changed );
 #endif
 
+		// Movement is delta compressed against the newest state the connection acked
+		RepState->MovementDelta.UpdateAcked( OwningChannel->Connection->OutAckPacketId );
+
 		// For RepLayout properties, we hijack the first non custom property, and use that to identify these properties
 		WritePropertyHeader( (UObject*)Data, ObjectClass, OwningChannel, Parents[FirstNonCustomParent].Property, Writer, 0, LastIndex, bContentBlockWritten );
 
@@ -686,6 +491,202 @@ bool FRepLayout::ReplicateProperties(
 	return false;
 }
 
+void FRepLayout::UpdateChangelistState( FRepChangedPropertyTracker * ChangeTracker, const uint8 * RESTRICT Data, const uint32 ReplicationFrame ) const
+{
+	FRepChangelistState & ChangelistState = ChangeTracker->ChangelistState;
+
+	if ( ChangelistState.LastCompareFrame == ReplicationFrame )
+	{
+		// Another connection already compared the properties this frame
+		INC_DWORD_STAT_BY( STAT_NetSkippedDynamicProps, SharedLifetime.Num() );
+		return;
+	}
+
+	ChangelistState.LastCompareFrame = ReplicationFrame;
+
+	if ( ChangelistState.StaticBuffer.Num() == 0 )
+	{
+		// Start out from the default state, so that the change lists contain everything a new connection needs to receive
+		UClass * ObjectClass = CastChecked< UClass >( Owner );
+
+		ChangelistState.StaticBuffer.AddZeroed( ObjectClass->GetDefaultsCount() );
+
+		ConstructProperties( ChangelistState.StaticBuffer );
+		InitProperties( ChangelistState.StaticBuffer, (uint8*)ObjectClass->GetDefaultObject() );
+	}
+
+	uint8 * StoredData = ChangelistState.StaticBuffer.GetTypedData();
+
+	if ( !CompareProperties( NULL, StoredData, Data, ChangeTracker->Parents, SharedLifetime ) )
+	{
+		return;
+	}
+
+	// If the history is full, grow it, or once it reached its maximum size, fold the oldest change list into the next one
+	// Connections that are that far behind will then still receive everything that changed
+	if ( ChangelistState.HistoryEnd - ChangelistState.HistoryStart == ChangelistState.ChangeHistory.Num() && ChangelistState.ChangeHistory.Num() < FRepChangelistState::MAX_CHANGE_HISTORY )
+	{
+		ChangelistState.GrowHistory();
+	}
+	else if ( ChangelistState.HistoryEnd - ChangelistState.HistoryStart == ChangelistState.ChangeHistory.Num() )
+	{
+		TArray< uint16 > & OldestChanged	= ChangelistState.GetHistoryItem( ChangelistState.HistoryStart );
+		TArray< uint16 > & NextChanged		= ChangelistState.GetHistoryItem( ChangelistState.HistoryStart + 1 );
+
+		TArray< uint16 > Temp = NextChanged;
+		MergeDirtyList( (void*)Data, OldestChanged, Temp, NextChanged );
+		OldestChanged.Empty();
+
+		ChangelistState.HistoryStart++;
+	}
+
+	TArray< uint16 > & Changed = ChangelistState.GetHistoryItem( ChangelistState.HistoryEnd );
+
+	ChangelistState.HistoryEnd++;
+
+	check( Changed.Num() == 0 );		// Make sure this history item is actually inactive
+
+	// Build the change list in the order of the parents so that it will be fully sorted
+	// Changed parents are also copied to the shadow state, so the next compare only picks up new changes
+	for ( int32 i = 0; i < Parents.Num(); i++ )
+	{
+		TArray< uint16 > & ParentChanged = ChangeTracker->Parents[i].Changed;
+
+		if ( ParentChanged.Num() > 0 )
+		{
+			Changed.Append( ParentChanged );
+			ParentChanged.Empty();
+
+			const PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData, Parents[i].ArrayIndex ) - StoredData;
+			Parents[i].Property->CopySingleValue( StoredData + Offset, Data + Offset );
+		}
+	}
+
+	Changed.Add( 0 );
+
+#ifdef SANITY_CHECK_MERGES
+	SanityCheckChangeList( Data, Changed );
+#endif
+}
+
+void FRepLayout::GatherChangedProperties( FRepState * RepState, FRepChangedPropertyTracker * ChangeTracker, const uint8 * RESTRICT Data, TArray< uint16 > & OutChanged ) const
+{
+	const FRepChangelistState & ChangelistState = ChangeTracker->ChangelistState;
+
+	TArray< uint16 > UnfilteredChanged;
+
+	// Start with the properties that changed while they were inactive, in case they are active now
+	if ( RepState->InactiveChangelist.Num() > 0 )
+	{
+		MergeDirtyList( (void*)Data, RepState->InactiveChangelist, TArray< uint16 >(), UnfilteredChanged );
+		RepState->InactiveChangelist.Empty();
+	}
+
+	// Merge in the shared change lists that are new since we last looked
+	// If we fell behind further than the history goes, the oldest change list has the older ones folded into it
+	for ( int32 i = FMath::Max( RepState->LastChangelistIndex, ChangelistState.HistoryStart ); i < ChangelistState.HistoryEnd; i++ )
+	{
+		const TArray< uint16 > & HistoryChanged = ChangelistState.GetHistoryItem( i );
+
+		check( HistoryChanged.Num() > 0 );
+
+		TArray< uint16 > Temp = UnfilteredChanged;
+		MergeDirtyList( (void*)Data, Temp, HistoryChanged, UnfilteredChanged );
+	}
+
+	RepState->LastChangelistIndex = ChangelistState.HistoryEnd;
+
+	if ( UnfilteredChanged.Num() > 0 )
+	{
+		// Hold on to the changes to properties that don't replicate to this connection right now
+		FilterChangeList( UnfilteredChanged, RepState->InactiveParents, RepState->InactiveChangelist, OutChanged );
+	}
+
+	// Compare the properties that can't be shared against our own shadow state
+	if ( RepState->ConnectionLifetime.Num() > 0 && CompareProperties( RepState, RepState->StaticBuffer.GetTypedData(), Data, ChangeTracker->Parents, RepState->ConnectionLifetime ) )
+	{
+		TArray< uint16 > LocalChanged;
+
+		for ( int32 i = 0; i < Parents.Num(); i++ )
+		{
+			if ( ChangeTracker->Parents[i].Changed.Num() > 0 )
+			{
+				LocalChanged.Append( ChangeTracker->Parents[i].Changed );
+				ChangeTracker->Parents[i].Changed.Empty();
+			}
+		}
+
+		LocalChanged.Add( 0 );
+
+		TArray< uint16 > Temp = OutChanged;
+		MergeDirtyList( (void*)Data, Temp, LocalChanged, OutChanged );
+	}
+
+#ifdef SANITY_CHECK_MERGES
+	if ( OutChanged.Num() > 0 )
+	{
+		SanityCheckChangeList( Data, OutChanged );
+	}
+#endif
+}
+
+void FRepLayout::FilterChangeList( const TArray< uint16 > & Changed, const TBitArray<> & InactiveParents, TArray< uint16 > & OutInactive, TArray< uint16 > & OutActive ) const
+{
+	OutInactive.Empty();
+	OutActive.Empty();
+
+	int32 ChangedIndex = 0;
+	uint16 Handle = 0;
+
+	// Walk the top level commands along with the change list, which is sorted by handle
+	for ( int32 CmdIndex = 0; CmdIndex < Cmds.Num() - 1 && Changed[ChangedIndex] != 0; CmdIndex++ )
+	{
+		const FRepLayoutCmd & Cmd = Cmds[CmdIndex];
+
+		check( Cmd.Type != REPCMD_Return );
+
+		Handle++;
+
+		if ( Changed[ChangedIndex] == Handle )
+		{
+			TArray< uint16 > & Out = InactiveParents[Cmd.ParentIndex] ? OutInactive : OutActive;
+
+			Out.Add( Handle );
+			ChangedIndex++;
+
+			if ( Cmd.Type == REPCMD_DynamicArray )
+			{
+				// Copy the jump offset, the array change list and its terminator
+				const int32 ArrayChangedCount = Changed[ChangedIndex];
+
+				for ( int32 i = 0; i < ArrayChangedCount + 2; i++ )
+				{
+					Out.Add( Changed[ChangedIndex++] );
+				}
+
+				check( Out.Last() == 0 );
+			}
+		}
+
+		if ( Cmd.Type == REPCMD_DynamicArray )
+		{
+			CmdIndex = Cmd.EndCmd - 1;		// Jump past children of this array (-1 for ++ in for loop)
+		}
+	}
+
+	check( Changed[ChangedIndex] == 0 );
+
+	if ( OutInactive.Num() > 0 )
+	{
+		OutInactive.Add( 0 );
+	}
+
+	if ( OutActive.Num() > 0 )
+	{
+		OutActive.Add( 0 );
+	}
+}
+
 void FRepLayout::UpdateChangelistHistory( FRepState * RepState, UClass * ObjectClass, const uint8 * RESTRICT Data, const int32 AckPacketId, TArray< uint16 > * OutMerged ) const
 {
 	check( RepState->HistoryEnd >= RepState->HistoryStart );
@@ -757,6 +758,8 @@ void FRepLayout::OpenAcked( FRepState * RepState ) const
 
 void FRepLayout::PostReplicate( FRepState * RepState, FPacketIdRange & PacketRange, bool bReliable ) const
 {
+	RepState->MovementDelta.PostSend( PacketRange, bReliable, RepState->OpenAckedCalled );
+
 	for ( int32 i = RepState->HistoryStart; i < RepState->HistoryEnd; i++ )
 	{
 		const int32 HistoryIndex = i % FRepState::MAX_CHANGE_HISTORY;
@@ -785,6 +788,8 @@ void FRepLayout::ReceivedNak( FRepState * RepState, int32 NakPacketId ) const
 		return;		// I'm not 100% certain why this happens, the only think I can think of is this is a bNetTemporary?
 	}
 
+	RepState->MovementDelta.ReceivedNak( NakPacketId );
+
 	for ( int32 i = RepState->HistoryStart; i < RepState->HistoryEnd; i++ )
 	{
 		const int32 HistoryIndex = i % FRepState::MAX_CHANGE_HISTORY;
@@ -972,7 +977,17 @@ uint16 FRepLayout::SendProperties_r(
 			
 			// This property changed, so send it
 			WriterState.Writer.PackageMap->ResetUnAckedObject();	// Set this to false so floats, ints, etc don't trigger it
-			bool bMapped = Cmd.Property->NetSerializeItem( WriterState.Writer, WriterState.Writer.PackageMap, (void*)( Data + Cmd.Offset ) );
+
+			bool bMapped = true;
+
+			if ( CmdIndex == MovementCmdIndex )
+			{
+				RepState->MovementDelta.Write( WriterState.Writer, *(const FRepMovement*)( Data + Cmd.Offset ) );
+			}
+			else
+			{
+				bMapped = Cmd.Property->NetSerializeItem( WriterState.Writer, WriterState.Writer.PackageMap, (void*)( Data + Cmd.Offset ) );
+			}
 
 			const int32 NumEndBits = WriterState.Writer.GetNumBits();
 
@@ -1129,6 +1144,21 @@ bool FRepLayout::ReadProperty( FRepReaderState & ReaderState, const FRepLayoutCm
 		return true;
 	}
 
+	if ( bDiscard && CmdIndex == MovementCmdIndex )
+	{
+		// Still decode the movement, later updates can be deltas against it
+		FRepMovement DiscardMovement = *(FRepMovement*)( StoredData + Cmd.Offset );
+
+		if ( !ReaderState.RepState->MovementDelta.Read( ReaderState.Bunch, DiscardMovement ) )
+		{
+			return false;
+		}
+
+		// Read the next property handle
+		ReadNextHandle( ReaderState );
+		return true;
+	}
+
 	if ( bDiscard )
 	{
 		FMemMark Mark( FMemStack::Get() );
@@ -1157,7 +1187,10 @@ bool FRepLayout::ReadProperty( FRepReaderState & ReaderState, const FRepLayoutCm
 		StoreProperty( Cmd, StoredData + Cmd.Offset, Data + SwappedCmd.Offset );
 
 		// Read the property
-		Cmd.Property->NetSerializeItem( ReaderState.Bunch, ReaderState.Bunch.PackageMap, Data + SwappedCmd.Offset );
+		if ( !ReadPropertyValue( ReaderState, Cmd, CmdIndex, Data + SwappedCmd.Offset ) )
+		{
+			return false;
+		}
 
 		// Check to see if this property changed
 		if ( !PropertiesAreIdentical( Cmd, StoredData + Cmd.Offset, Data + SwappedCmd.Offset ) )
@@ -1167,7 +1200,10 @@ bool FRepLayout::ReadProperty( FRepReaderState & ReaderState, const FRepLayoutCm
 	} 
 	else
 	{
-		Cmd.Property->NetSerializeItem( ReaderState.Bunch, ReaderState.Bunch.PackageMap, Data + SwappedCmd.Offset );
+		if ( !ReadPropertyValue( ReaderState, Cmd, CmdIndex, Data + SwappedCmd.Offset ) )
+		{
+			return false;
+		}
 	}
 
 #ifdef ENABLE_PROPERTY_CHECKSUMS
@@ -1186,6 +1222,17 @@ bool FRepLayout::ReadProperty( FRepReaderState & ReaderState, const FRepLayoutCm
 	return true;
 }
 
+bool FRepLayout::ReadPropertyValue( FRepReaderState & ReaderState, const FRepLayoutCmd & Cmd, const int32 CmdIndex, uint8 * RESTRICT Value ) const
+{
+	if ( CmdIndex == MovementCmdIndex )
+	{
+		return ReaderState.RepState->MovementDelta.Read( ReaderState.Bunch, *(FRepMovement*)Value );
+	}
+
+	Cmd.Property->NetSerializeItem( ReaderState.Bunch, ReaderState.Bunch.PackageMap, Value );
+	return true;
+}
+
 bool FRepLayout::ReceiveProperties_AnyArray_r( 
 	FRepReaderState &	ReaderState, 
 	const int32			ArrayNum, 
@@ -2076,6 +2123,23 @@ void FRepLayout::InitFromObjectClass( UClass * InObjectClass )
 	// Make sure it either found both, or didn't find either
 	check( ( RoleIndex == -1 ) == ( RemoteRoleIndex == -1 ) );
 
+	// Find the movement property, which is delta compressed against the last state each connection acked
+	MovementCmdIndex = -1;
+
+	for ( int32 CmdIndex = 0; CmdIndex < Cmds.Num(); CmdIndex++ )
+	{
+		if ( Cmds[CmdIndex].Type == REPCMD_RepMovement )
+		{
+			MovementCmdIndex = CmdIndex;
+			break;
+		}
+
+		if ( Cmds[CmdIndex].Type == REPCMD_DynamicArray )
+		{
+			CmdIndex = Cmds[CmdIndex].EndCmd - 1;		// Movement inside arrays isn't delta compressed (-1 for ++ in for loop)
+		}
+	}
+
 	// This is so the receiving side can swap these as it receives them
 	if ( RoleIndex != -1 )
 	{
@@ -2094,7 +2158,6 @@ void FRepLayout::InitFromObjectClass( UClass * InObjectClass )
 
 	if ( LifetimeProps.Num() > 0 )
 	{
-		UnconditionalLifetime.Empty();
 		ConditionalLifetime.Empty();
 
 		// Fix Lifetime props to have the proper index to the parent
@@ -2120,7 +2183,6 @@ void FRepLayout::InitFromObjectClass( UClass * InObjectClass )
 			if ( LifetimeProps[i].Condition == COND_None )
 			{
 				// These properties are simple, and can benefit from property compare sharing
-				UnconditionalLifetime.AddUnique( LifetimeProps[i].RepIndex );
 				Parents[LifetimeProps[i].RepIndex].Flags &= ~PARENT_IsConditional;
 				continue;
 			}
@@ -2131,6 +2193,17 @@ void FRepLayout::InitFromObjectClass( UClass * InObjectClass )
 		}
 	}
 
+	// Everything but RemoteRole has the same value for all connections, so it can be compared once and shared
+	SharedLifetime.Empty();
+
+	for ( int32 i = 0; i < Parents.Num(); i++ )
+	{
+		if ( ( Parents[i].Flags & PARENT_IsLifetime ) && i != RemoteRoleIndex )
+		{
+			SharedLifetime.Add( i );
+		}
+	}
+
 	Owner = InObjectClass;
 }
 
@@ -2397,21 +2470,23 @@ void FRepLayout::RebuildConditionalProperties( FRepState * RESTRICT	RepState, co
 
 	ConditionMap[COND_Custom]				= true;
 
-	RepState->ConditionalLifetime.Empty();
+	RepState->InactiveParents.Init( false, Parents.Num() );
+	RepState->ConnectionLifetime.Empty();
 
 	for ( int32 i = 0; i < ConditionalLifetime.Num(); i++ )
 	{
-		if ( !ConditionMap[ConditionalLifetime[i].Condition] )
+		const int32 RepIndex = ConditionalLifetime[i].RepIndex;
+
+		if ( !ConditionMap[ConditionalLifetime[i].Condition] || !ChangedTracker.Parents[RepIndex].Active )
 		{
+			RepState->InactiveParents[RepIndex] = true;
 			continue;
 		}
-		
-		if ( !ChangedTracker.Parents[ConditionalLifetime[i].RepIndex].Active )
+
+		if ( RepIndex == RemoteRoleIndex )
 		{
-			continue;
+			RepState->ConnectionLifetime.Add( RepIndex );
 		}
-
-		RepState->ConditionalLifetime.Add( ConditionalLifetime[i].RepIndex );
 	}
 
 	RepState->RepFlags = RepFlags;
@@ -2437,23 +2512,26 @@ void FRepLayout::InitRepState(
 	RepState->StaticBuffer.AddZeroed( InObjectClass->GetDefaultsCount() );
 
 	// Construct the properties
-	ConstructProperties( RepState );
+	ConstructProperties( RepState->StaticBuffer );
 
 	// Init the properties
-	InitProperties( RepState, Src );
+	InitProperties( RepState->StaticBuffer, Src );
 	
 	RepState->RepChangedPropertyTracker = InRepChangedPropertyTracker;
 
 	check( RepState->RepChangedPropertyTracker->Parents.Num() == Parents.Num() );
 
+	// When starting from the default state we need every shared change list, otherwise only the ones from now on
+	RepState->LastChangelistIndex = ( Src == (uint8*)InObjectClass->GetDefaultObject() ) ? 0 : InRepChangedPropertyTracker->ChangelistState.HistoryEnd;
+
 	// Start out the conditional props based on a default RepFlags struct
 	// It will rebuild if it ever changes
 	RebuildConditionalProperties( RepState, *InRepChangedPropertyTracker.Get(), FReplicationFlags() );
 }
 
-void FRepLayout::ConstructProperties( FRepState * RepState ) const
+void FRepLayout::ConstructProperties( TArray< uint8 > & ShadowData ) const
 {
-	uint8 * StoredData = RepState->StaticBuffer.GetTypedData();
+	uint8 * StoredData = ShadowData.GetTypedData();
 
 	// Construct all items
 	for ( int32 i = 0; i < Parents.Num(); i++ )
@@ -2462,16 +2540,16 @@ void FRepLayout::ConstructProperties( FRepState * RepState ) const
 		if ( Parents[i].ArrayIndex == 0 )
 		{
 			PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData ) - StoredData;
-			check( Offset >= 0 && Offset < RepState->StaticBuffer.Num() );
+			check( Offset >= 0 && Offset < ShadowData.Num() );
 
 			Parents[i].Property->InitializeValue( StoredData + Offset );
 		}
 	}
 }
 
-void FRepLayout::InitProperties( FRepState * RepState, uint8 * Src ) const
+void FRepLayout::InitProperties( TArray< uint8 > & ShadowData, uint8 * Src ) const
 {
-	uint8 * StoredData = RepState->StaticBuffer.GetTypedData();
+	uint8 * StoredData = ShadowData.GetTypedData();
 
 	// Init all items
 	for ( int32 i = 0; i < Parents.Num(); i++ )
@@ -2480,16 +2558,16 @@ void FRepLayout::InitProperties( FRepState * RepState, uint8 * Src ) const
 		if ( Parents[i].ArrayIndex == 0 )
 		{
 			PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData ) - StoredData;
-			check( Offset >= 0 && Offset < RepState->StaticBuffer.Num() );
+			check( Offset >= 0 && Offset < ShadowData.Num() );
 
 			Parents[i].Property->CopyCompleteValue( StoredData + Offset, Src + Offset );
 		}
 	}
 }
 
-void FRepLayout::DestructProperties( FRepState * RepState ) const
+void FRepLayout::DestructProperties( TArray< uint8 > & ShadowData ) const
 {
-	uint8 * StoredData = RepState->StaticBuffer.GetTypedData();
+	uint8 * StoredData = ShadowData.GetTypedData();
 
 	// Destruct all items
 	for ( int32 i = 0; i < Parents.Num(); i++ )
@@ -2498,7 +2576,7 @@ void FRepLayout::DestructProperties( FRepState * RepState ) const
 		if ( Parents[i].ArrayIndex == 0 )
 		{
 			PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData ) - StoredData;
-			check( Offset >= 0 && Offset < RepState->StaticBuffer.Num() );
+			check( Offset >= 0 && Offset < ShadowData.Num() );
 
 			Parents[i].Property->DestroyValue( StoredData + Offset );
 		}
@@ -2524,6 +2602,30 @@ FRepState::~FRepState()
 {
 	if (RepLayout.IsValid() && StaticBuffer.Num() > 0)
 	{	
-		RepLayout->DestructProperties( this );
+		RepLayout->DestructProperties( StaticBuffer );
+	}
+}
+
+void FRepChangelistState::GrowHistory()
+{
+	const int32 NewSize = FMath::Min( FMath::Max( ChangeHistory.Num() * 2, MIN_CHANGE_HISTORY ), MAX_CHANGE_HISTORY );
+
+	// Move the change lists in use to where their history index maps to with the new size
+	TArray< TArray< uint16 > > NewHistory;
+	NewHistory.SetNum( NewSize );
+
+	for ( int32 i = HistoryStart; i < HistoryEnd; i++ )
+	{
+		Exchange( NewHistory[i % NewSize], GetHistoryItem( i ) );
+	}
+
+	Exchange( ChangeHistory, NewHistory );
+}
+
+FRepChangelistState::~FRepChangelistState()
+{
+	if (RepLayout.IsValid() && StaticBuffer.Num() > 0)
+	{	
+		RepLayout->DestructProperties( StaticBuffer );
 	}
 }
@@ -0,0 +1,323 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	RepMovementDelta.cpp: Delta compression of FRepMovement
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/RepMovementDelta.h"
+
+/*-----------------------------------------------------------------------------
+	Bit packing.
+-----------------------------------------------------------------------------*/
+
+static FORCEINLINE uint32 ZigZagEncode( const int32 Value )
+{
+	return ( (uint32)Value << 1 ) ^ (uint32)( Value >> 31 );
+}
+
+static FORCEINLINE int32 ZigZagDecode( const uint32 Value )
+{
+	return (int32)( Value >> 1 ) ^ -(int32)( Value & 1 );
+}
+
+/**
+ * Serializes the differences of 3 components, with as many bits per component as the largest one needs
+ * The format is <num of bits per component> <N bits for X> <N bits for Y> <N bits for Z>, small differences take very few bits
+ */
+static void SerializePackedDeltas( FArchive & Ar, int32 * Deltas )
+{
+	uint32 Encoded[3];
+	uint32 Bits = 0;
+
+	if ( Ar.IsSaving() )
+	{
+		uint32 MaxEncoded = 0;
+
+		for ( int32 i = 0; i < 3; i++ )
+		{
+			Encoded[i] = ZigZagEncode( Deltas[i] );
+			MaxEncoded = FMath::Max( MaxEncoded, Encoded[i] );
+		}
+
+		while ( Bits < 31 && ( MaxEncoded >> Bits ) != 0 )
+		{
+			Bits++;
+		}
+	}
+
+	Ar.SerializeInt( Bits, 32 );
+
+	for ( int32 i = 0; i < 3; i++ )
+	{
+		if ( Bits == 0 )
+		{
+			Encoded[i] = 0;
+		}
+		else
+		{
+			Ar.SerializeInt( Encoded[i], 1u << Bits );
+		}
+
+		Deltas[i] = ZigZagDecode( Encoded[i] );
+	}
+}
+
+/** Serializes a vector as differences from a baseline */
+static void SerializeVectorDelta( FArchive & Ar, const int32 * Baseline, int32 * Value )
+{
+	int32 Deltas[3];
+
+	for ( int32 i = 0; i < 3; i++ )
+	{
+		Deltas[i] = Value[i] - Baseline[i];
+	}
+
+	SerializePackedDeltas( Ar, Deltas );
+
+	for ( int32 i = 0; i < 3; i++ )
+	{
+		Value[i] = Baseline[i] + Deltas[i];
+	}
+}
+
+/** Serializes a rotator as differences from a baseline, wrapped around so turning past 0 is a small difference */
+static void SerializeRotatorDelta( FArchive & Ar, const int32 * Baseline, int32 * Value, const int32 NumBits )
+{
+	const int32 Mask = ( 1 << NumBits ) - 1;
+	const int32 Half = 1 << ( NumBits - 1 );
+
+	int32 Deltas[3];
+
+	for ( int32 i = 0; i < 3; i++ )
+	{
+		Deltas[i] = ( ( Value[i] - Baseline[i] + Half ) & Mask ) - Half;
+	}
+
+	SerializePackedDeltas( Ar, Deltas );
+
+	for ( int32 i = 0; i < 3; i++ )
+	{
+		Value[i] = ( Baseline[i] + Deltas[i] ) & Mask;
+	}
+}
+
+/** Serializes a movement state as differences from a baseline, which is all zeroes when there is none */
+static void SerializeMovementDelta( FArchive & Ar, const FRepMovement & Settings, const FQuantizedRepMovement & Baseline, FQuantizedRepMovement & State )
+{
+	Ar.SerializeBits( &State.Flags, 2 );
+
+	SerializeVectorDelta( Ar, Baseline.Location, State.Location );
+	SerializeRotatorDelta( Ar, Baseline.Rotation, State.Rotation, FRepMovement::GetRotationBits( Settings.RotationQuantizationLevel ) );
+	SerializeVectorDelta( Ar, Baseline.LinearVelocity, State.LinearVelocity );
+
+	// Angular velocity is only used for physics
+	if ( State.Flags & ( 1 << 1 ) )
+	{
+		SerializeVectorDelta( Ar, Baseline.AngularVelocity, State.AngularVelocity );
+	}
+	else
+	{
+		FMemory::Memzero( State.AngularVelocity, sizeof( State.AngularVelocity ) );
+	}
+}
+
+/*-----------------------------------------------------------------------------
+	FQuantizedRepMovement.
+-----------------------------------------------------------------------------*/
+
+void FQuantizedRepMovement::Quantize( const FRepMovement & Movement )
+{
+	FRepMovement::QuantizeVector( Movement.Location, Movement.LocationQuantizationLevel, Location );
+	FRepMovement::QuantizeRotator( Movement.Rotation, Movement.RotationQuantizationLevel, Rotation );
+	FRepMovement::QuantizeVector( Movement.LinearVelocity, Movement.VelocityQuantizationLevel, LinearVelocity );
+
+	if ( Movement.bRepPhysics )
+	{
+		FRepMovement::QuantizeVector( Movement.AngularVelocity, Movement.VelocityQuantizationLevel, AngularVelocity );
+	}
+	else
+	{
+		FMemory::Memzero( AngularVelocity, sizeof( AngularVelocity ) );
+	}
+
+	Flags = ( Movement.bSimulatedPhysicSleep << 0 ) | ( Movement.bRepPhysics << 1 );
+}
+
+void FQuantizedRepMovement::Dequantize( FRepMovement & OutMovement ) const
+{
+	OutMovement.bSimulatedPhysicSleep	= ( Flags & ( 1 << 0 ) ) ? 1 : 0;
+	OutMovement.bRepPhysics				= ( Flags & ( 1 << 1 ) ) ? 1 : 0;
+
+	OutMovement.Location		= FRepMovement::DequantizeVector( Location, OutMovement.LocationQuantizationLevel );
+	OutMovement.Rotation		= FRepMovement::DequantizeRotator( Rotation, OutMovement.RotationQuantizationLevel );
+	OutMovement.LinearVelocity	= FRepMovement::DequantizeVector( LinearVelocity, OutMovement.VelocityQuantizationLevel );
+
+	if ( OutMovement.bRepPhysics )
+	{
+		OutMovement.AngularVelocity = FRepMovement::DequantizeVector( AngularVelocity, OutMovement.VelocityQuantizationLevel );
+	}
+}
+
+/*-----------------------------------------------------------------------------
+	FRepMovementDelta.
+-----------------------------------------------------------------------------*/
+
+checkAtCompileTime( FRepMovementDelta::MAX_SEQUENCE % FRepMovementDelta::MAX_HISTORY == 0, RepMovementDelta_SequenceMustWrapWithHistory );
+
+FRepMovementDelta::FRepMovementDelta()
+{
+	Reset();
+}
+
+void FRepMovementDelta::Reset()
+{
+	for ( int32 i = 0; i < MAX_HISTORY; i++ )
+	{
+		History[i] = FRepMovementHistoryItem();
+	}
+
+	NextSequence		= 0;
+	BaselineSequence	= INDEX_NONE;
+}
+
+void FRepMovementDelta::UpdateAcked( const int32 AckPacketId )
+{
+	// Naks for every packet up to AckPacketId have been received by now, so the rest of them arrived
+	for ( int32 Sequence = FMath::Max( BaselineSequence + 1, NextSequence - MAX_HISTORY + 1 ); Sequence < NextSequence; Sequence++ )
+	{
+		const FRepMovementHistoryItem & Item = History[Sequence % MAX_HISTORY];
+
+		if ( Item.Sequence == Sequence && Item.bCanBeBaseline && Item.OutPacketIdRange.First != INDEX_NONE && Item.OutPacketIdRange.Last <= AckPacketId )
+		{
+			BaselineSequence = Sequence;
+		}
+	}
+}
+
+void FRepMovementDelta::Write( FArchive & Ar, const FRepMovement & Movement )
+{
+	check( Ar.IsSaving() );
+
+	// The baseline has to be recent enough that the receiver still has it, and we didn't overwrite it
+	const bool bHasBaseline = BaselineSequence != INDEX_NONE && NextSequence - BaselineSequence < MAX_HISTORY;
+
+	const FQuantizedRepMovement ZeroState;
+	const FQuantizedRepMovement & Baseline = bHasBaseline ? History[BaselineSequence % MAX_HISTORY].State : ZeroState;
+
+	FRepMovementHistoryItem & Item = History[NextSequence % MAX_HISTORY];
+
+	Item.State.Quantize( Movement );
+	Item.Sequence			= NextSequence;
+	Item.OutPacketIdRange	= FPacketIdRange();
+	Item.bCanBeBaseline		= true;
+
+	uint32 WireSequence = NextSequence % MAX_SEQUENCE;
+	Ar.SerializeInt( WireSequence, MAX_SEQUENCE );
+
+	uint8 bWriteBaseline = bHasBaseline ? 1 : 0;
+	Ar.SerializeBits( &bWriteBaseline, 1 );
+
+	if ( bHasBaseline )
+	{
+		uint32 BaselineOffset = NextSequence - BaselineSequence;
+		Ar.SerializeInt( BaselineOffset, MAX_HISTORY );
+	}
+
+	SerializeMovementDelta( Ar, Movement, Baseline, Item.State );
+
+	NextSequence++;
+}
+
+void FRepMovementDelta::PostSend( const FPacketIdRange & PacketRange, const bool bReliable, const bool bOpenAcked )
+{
+	for ( int32 i = 0; i < MAX_HISTORY; i++ )
+	{
+		FRepMovementHistoryItem & Item = History[i];
+
+		if ( Item.Sequence == INDEX_NONE || Item.OutPacketIdRange.First != INDEX_NONE || !Item.bCanBeBaseline )
+		{
+			continue;
+		}
+
+		if ( Item.Sequence != NextSequence - 1 )
+		{
+			// Written into a bunch that was never sent
+			Item.bCanBeBaseline = false;
+			continue;
+		}
+
+		Item.OutPacketIdRange = PacketRange;
+
+		// Reliable bunches can be held back until an earlier one arrives, and unreliable bunches are dropped
+		// until the channel is open, so in both cases the receiver may not have the state when the packet is acked
+		Item.bCanBeBaseline = !bReliable && bOpenAcked;
+	}
+}
+
+void FRepMovementDelta::ReceivedNak( const int32 NakPacketId )
+{
+	for ( int32 i = 0; i < MAX_HISTORY; i++ )
+	{
+		FRepMovementHistoryItem & Item = History[i];
+
+		if ( Item.Sequence > BaselineSequence && Item.OutPacketIdRange.InRange( NakPacketId ) )
+		{
+			Item.bCanBeBaseline = false;
+		}
+	}
+}
+
+bool FRepMovementDelta::Read( FArchive & Ar, FRepMovement & InOutMovement )
+{
+	check( Ar.IsLoading() );
+
+	uint32 WireSequence = 0;
+	Ar.SerializeInt( WireSequence, MAX_SEQUENCE );
+
+	uint8 bHasBaseline = 0;
+	Ar.SerializeBits( &bHasBaseline, 1 );
+
+	FQuantizedRepMovement State;
+	FQuantizedRepMovement Baseline;
+
+	if ( bHasBaseline )
+	{
+		uint32 BaselineOffset = 0;
+		Ar.SerializeInt( BaselineOffset, MAX_HISTORY );
+
+		const int32 BaselineSequence = ( WireSequence - BaselineOffset + MAX_SEQUENCE ) % MAX_SEQUENCE;
+		const FRepMovementHistoryItem & BaselineItem = History[BaselineSequence % MAX_HISTORY];
+
+		if ( BaselineItem.Sequence != BaselineSequence )
+		{
+			UE_LOG( LogNet, Warning, TEXT( "FRepMovementDelta::Read: Missing baseline %i for sequence %u" ), BaselineSequence, WireSequence );
+			Ar.SetError();
+			return false;
+		}
+
+		Baseline = BaselineItem.State;
+	}
+
+	SerializeMovementDelta( Ar, InOutMovement, Baseline, State );
+
+	if ( Ar.IsError() )
+	{
+		return false;
+	}
+
+	State.Dequantize( InOutMovement );
+
+	// Remember the state unless a newer one already took its slot, which happens when a reliable bunch was resent late
+	FRepMovementHistoryItem & Item = History[WireSequence % MAX_HISTORY];
+
+	const bool bSlotIsNewer = Item.Sequence != INDEX_NONE && Item.Sequence != (int32)WireSequence && ( ( Item.Sequence - (int32)WireSequence + MAX_SEQUENCE ) % MAX_SEQUENCE ) < MAX_SEQUENCE / 2;
+
+	if ( !bSlotIsNewer )
+	{
+		Item.State		= State;
+		Item.Sequence	= WireSequence;
+	}
+
+	return true;
+}
@@ -0,0 +1,331 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ReplayStream.cpp: Buffered writer and reader for replays
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/ReplayStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogReplay, Log, All);
+
+/*-----------------------------------------------------------------------------
+	FReplayStreamWriter.
+-----------------------------------------------------------------------------*/
+
+FReplayStreamWriter* FReplayStreamWriter::Create(const FString& Filename, FReplayHeader& Header, int32 InFlushSize)
+{
+	FArchive* FileAr = IFileManager::Get().CreateFileWriter(*Filename, FILEWRITE_AllowRead);
+	if (FileAr == NULL)
+	{
+		UE_LOG(LogReplay, Warning, TEXT("Couldn't create replay %s"), *Filename);
+		return NULL;
+	}
+
+	*FileAr << Header;
+
+	FReplayStreamWriter* Writer = new FReplayStreamWriter(FileAr, InFlushSize);
+	Writer->TotalBytes = FileAr->Tell();
+	Writer->Thread = FRunnableThread::Create(Writer, TEXT("ReplayStreamWriter"), false, false, 0, TPri_BelowNormal);
+	return Writer;
+}
+
+FReplayStreamWriter::FReplayStreamWriter(FArchive* InFileAr, int32 InFlushSize)
+	: FileAr(InFileAr)
+	, Thread(NULL)
+	, WorkEvent(FPlatformProcess::CreateSynchEvent())
+	, FlushSize(FMath::Max(InFlushSize, 1024))
+	, TotalBytes(0)
+	, bStopping(false)
+{
+	GameThreadBuffer.Empty(FlushSize);
+	QueuedBuffer.Empty(FlushSize);
+	WritingBuffer.Empty(FlushSize);
+}
+
+FReplayStreamWriter::~FReplayStreamWriter()
+{
+	Flush();
+
+	if (Thread != NULL)
+	{
+		// Run writes whatever is still queued before it returns
+		Thread->Kill(true);
+		delete Thread;
+		Thread = NULL;
+	}
+	else
+	{
+		// The thread could not be created, write everything from here
+		FileAr->Serialize(QueuedBuffer.GetTypedData(), QueuedBuffer.Num());
+	}
+
+	delete FileAr;
+	FileAr = NULL;
+
+	delete WorkEvent;
+	WorkEvent = NULL;
+}
+
+void FReplayStreamWriter::WriteChunk(EReplayChunk::Type Type, float Time, const TArray<uint8>& Payload)
+{
+	uint8 ChunkType = Type;
+	int32 Size = Payload.Num();
+
+	// The buffer is written as is, in native byte order, which is how the file reader reads the fields back
+	const int32 Offset = GameThreadBuffer.AddUninitialized(REPLAY_CHUNK_HEADER_SIZE + Size);
+	uint8* Dest = GameThreadBuffer.GetTypedData() + Offset;
+	FMemory::Memcpy(Dest, &ChunkType, sizeof(uint8));
+	FMemory::Memcpy(Dest + sizeof(uint8), &Time, sizeof(float));
+	FMemory::Memcpy(Dest + sizeof(uint8) + sizeof(float), &Size, sizeof(int32));
+	FMemory::Memcpy(Dest + REPLAY_CHUNK_HEADER_SIZE, Payload.GetTypedData(), Size);
+
+	TotalBytes += REPLAY_CHUNK_HEADER_SIZE + Size;
+
+	if (GameThreadBuffer.Num() >= FlushSize)
+	{
+		Flush();
+	}
+}
+
+void FReplayStreamWriter::Flush()
+{
+	if (GameThreadBuffer.Num() == 0)
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&QueueCriticalSection);
+		QueuedBuffer.Append(GameThreadBuffer);
+	}
+	GameThreadBuffer.Reset();
+
+	WorkEvent->Trigger();
+}
+
+uint32 FReplayStreamWriter::Run()
+{
+	while (true)
+	{
+		bool bShouldStop;
+		{
+			FScopeLock ScopeLock(&QueueCriticalSection);
+			Exchange(QueuedBuffer, WritingBuffer);
+			bShouldStop = bStopping;
+		}
+
+		if (WritingBuffer.Num() > 0)
+		{
+			FileAr->Serialize(WritingBuffer.GetTypedData(), WritingBuffer.Num());
+			FileAr->Flush();
+			WritingBuffer.Reset();
+		}
+		else if (bShouldStop)
+		{
+			break;
+		}
+		else
+		{
+			WorkEvent->Wait();
+		}
+	}
+
+	return 0;
+}
+
+void FReplayStreamWriter::Stop()
+{
+	{
+		FScopeLock ScopeLock(&QueueCriticalSection);
+		bStopping = true;
+	}
+	WorkEvent->Trigger();
+}
+
+/*-----------------------------------------------------------------------------
+	FReplayStreamReader.
+-----------------------------------------------------------------------------*/
+
+FReplayStreamReader* FReplayStreamReader::Open(const FString& Filename, FString& Error)
+{
+	FArchive* FileAr = IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent);
+	if (FileAr == NULL)
+	{
+		Error = FString::Printf(TEXT("Couldn't open replay %s"), *Filename);
+		return NULL;
+	}
+
+	FReplayStreamReader* Reader = new FReplayStreamReader(FileAr);
+
+	*FileAr << Reader->Header;
+
+	if (FileAr->IsError() || Reader->Header.Magic != FReplayHeader::ReplayMagic)
+	{
+		Error = FString::Printf(TEXT("%s is not a replay"), *Filename);
+	}
+	else if (Reader->Header.Version != FReplayHeader::ReplayVersion)
+	{
+		Error = FString::Printf(TEXT("Replay %s has version %u, expected %u"), *Filename, Reader->Header.Version, (uint32)FReplayHeader::ReplayVersion);
+	}
+	else if (Reader->Header.EngineNetVersion != GEngineNetVersion)
+	{
+		Error = FString::Printf(TEXT("Replay %s was recorded with net version %i, expected %i"), *Filename, Reader->Header.EngineNetVersion, GEngineNetVersion);
+	}
+
+	if (!Error.IsEmpty())
+	{
+		delete Reader;
+		return NULL;
+	}
+
+	// Build the checkpoint index. The start of the replay is a checkpoint too, the recording connection is new there.
+	Reader->FirstChunkOffset = FileAr->Tell();
+	Reader->EndOffset = Reader->FirstChunkOffset;
+	new(Reader->Checkpoints) FReplayCheckpoint(INDEX_NONE, Reader->FirstChunkOffset, 0.0f);
+
+	uint8 Type;
+	float Time;
+	int32 Size;
+	int64 ChunkOffset = FileAr->Tell();
+	while (Reader->ReadChunkHeader(Type, Time, Size))
+	{
+		const int64 ChunkEnd = FileAr->Tell() + Size;
+		if (ChunkEnd > FileAr->TotalSize())
+		{
+			// The recording was cut off in the middle of the chunk
+			break;
+		}
+
+		if (Type == EReplayChunk::Checkpoint)
+		{
+			new(Reader->Checkpoints) FReplayCheckpoint(ChunkOffset, ChunkEnd, Time);
+		}
+
+		Reader->TotalTime = FMath::Max(Reader->TotalTime, Time);
+		Reader->EndOffset = ChunkEnd;
+		FileAr->Seek(ChunkEnd);
+		ChunkOffset = ChunkEnd;
+
+		if (Type == EReplayChunk::End)
+		{
+			break;
+		}
+	}
+
+	UE_LOG(LogReplay, Log, TEXT("Opened replay %s: %.1f seconds, %i checkpoints"), *Filename, Reader->TotalTime, Reader->Checkpoints.Num());
+
+	FileAr->Seek(Reader->FirstChunkOffset);
+	return Reader;
+}
+
+FReplayStreamReader::FReplayStreamReader(FArchive* InFileAr)
+	: FileAr(InFileAr)
+	, FirstChunkOffset(0)
+	, EndOffset(0)
+	, TotalTime(0.0f)
+{
+}
+
+FReplayStreamReader::~FReplayStreamReader()
+{
+	delete FileAr;
+	FileAr = NULL;
+}
+
+int32 FReplayStreamReader::FindCheckpoint(float Time) const
+{
+	int32 Index = 0;
+	while (Index + 1 < Checkpoints.Num() && Checkpoints[Index + 1].Time <= Time)
+	{
+		Index++;
+	}
+	return Index;
+}
+
+bool FReplayStreamReader::SeekToCheckpoint(int32 CheckpointIndex, TArray<uint8>& OutSnapshot)
+{
+	const FReplayCheckpoint& Checkpoint = Checkpoints[CheckpointIndex];
+
+	OutSnapshot.Reset();
+
+	bool bResult = true;
+	if (Checkpoint.ChunkOffset != INDEX_NONE)
+	{
+		EReplayChunk::Type Type;
+		float Time;
+		FileAr->Seek(Checkpoint.ChunkOffset);
+		bResult = ReadChunk(Type, Time, OutSnapshot) && Type == EReplayChunk::Checkpoint;
+	}
+
+	FileAr->Seek(Checkpoint.Offset);
+	return bResult;
+}
+
+bool FReplayStreamReader::ReadChunkHeader(uint8& OutType, float& OutTime, int32& OutSize)
+{
+	if (FileAr->Tell() + (int64)REPLAY_CHUNK_HEADER_SIZE > FileAr->TotalSize())
+	{
+		return false;
+	}
+
+	*FileAr << OutType << OutTime << OutSize;
+
+	return !FileAr->IsError() && OutType < EReplayChunk::Max && OutSize >= 0;
+}
+
+bool FReplayStreamReader::PeekChunk(EReplayChunk::Type& OutType, float& OutTime)
+{
+	const int64 Offset = FileAr->Tell();
+	if (Offset >= EndOffset)
+	{
+		return false;
+	}
+
+	uint8 Type;
+	int32 Size;
+	const bool bResult = ReadChunkHeader(Type, OutTime, Size);
+	OutType = (EReplayChunk::Type)Type;
+	FileAr->Seek(Offset);
+	return bResult;
+}
+
+bool FReplayStreamReader::ReadChunk(EReplayChunk::Type& OutType, float& OutTime, TArray<uint8>& OutPayload)
+{
+	if (FileAr->Tell() >= EndOffset)
+	{
+		return false;
+	}
+
+	uint8 Type;
+	int32 Size;
+	if (!ReadChunkHeader(Type, OutTime, Size))
+	{
+		return false;
+	}
+
+	OutType = (EReplayChunk::Type)Type;
+	OutPayload.Reset();
+	OutPayload.AddUninitialized(Size);
+	FileAr->Serialize(OutPayload.GetTypedData(), Size);
+	return !FileAr->IsError();
+}
+
+bool FReplayStreamReader::SkipChunk()
+{
+	if (FileAr->Tell() >= EndOffset)
+	{
+		return false;
+	}
+
+	uint8 Type;
+	float Time;
+	int32 Size;
+	if (!ReadChunkHeader(Type, Time, Size))
+	{
+		return false;
+	}
+
+	FileAr->Seek(FileAr->Tell() + Size);
+	return true;
+}
@@ -156,6 +156,7 @@ FSceneView::FSceneView(const FSceneViewInitOptions& InitOptions)
 	, bIsViewInfo(false)
 	, bIsSceneCapture(false)
 	, bIsReflectionCapture(false)
+	, bUseHierarchicalCulling(InitOptions.bUseHierarchicalCulling)
 	, RenderingCompositePassContext(0)
 #if WITH_EDITOR
 	, OverrideLODViewOrigin(InitOptions.OverrideLODViewOrigin)
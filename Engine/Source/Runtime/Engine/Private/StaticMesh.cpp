@@ -573,6 +573,26 @@ void FStaticMeshRenderData::Serialize(FArchive& Ar, UStaticMesh* Owner, bool bCo
 	}
 }
 
+void FStaticMeshRenderData::InitOccluderData(int32 LODIndex)
+{
+	OccluderData.Vertices.Empty();
+	OccluderData.Indices.Empty();
+
+	if (LODIndex >= 0 && LODResources.Num() > 0)
+	{
+		const FStaticMeshLODResources& LOD = LODResources[FMath::Min(LODIndex, LODResources.Num() - 1)];
+		const int32 NumVertices = LOD.PositionVertexBuffer.GetNumVertices();
+
+		OccluderData.Vertices.Empty(NumVertices);
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			OccluderData.Vertices.Add(LOD.PositionVertexBuffer.VertexPosition(VertexIndex));
+		}
+
+		LOD.IndexBuffer.GetCopy(OccluderData.Indices);
+	}
+}
+
 void FStaticMeshRenderData::InitResources(UStaticMesh* Owner)
 {
 #if WITH_EDITORONLY_DATA
@@ -1065,6 +1085,7 @@ UStaticMesh::UStaticMesh(const FPostConstructInitializeProperties& PCIP)
 	bAutoComputeLODDistance=true;
 #endif // #if WITH_EDITORONLY_DATA
 	LpvBiasMultiplier = 1.0f;
+	LODForOccluderMesh = -1;
 }
 
 /**
@@ -1074,6 +1095,7 @@ void UStaticMesh::InitResources()
 {
 	if (RenderData)
 	{
+		RenderData->InitOccluderData(LODForOccluderMesh);
 		RenderData->InitResources(this);
 	}
 
@@ -674,6 +674,16 @@ bool FStaticMeshSceneProxy::CanBeOccluded() const
 	return !MaterialRelevance.bDisableDepthTest;
 }
 
+const FOccluderMeshData* FStaticMeshSceneProxy::GetOccluderMeshData() const
+{
+	// Only meshes whose materials are all opaque and unmasked hide everything behind their triangles
+	const bool bSolidMaterials = MaterialRelevance.bOpaque && !MaterialRelevance.bMasked
+		&& !MaterialRelevance.bNormalTranslucency && !MaterialRelevance.bSeparateTranslucency
+		&& !MaterialRelevance.bDistortion && !MaterialRelevance.bDisableDepthTest;
+
+	return bSolidMaterials && RenderData->OccluderData.Indices.Num() > 0 ? &RenderData->OccluderData : NULL;
+}
+
 FPrimitiveViewRelevance FStaticMeshSceneProxy::GetViewRelevance(const FSceneView* View)
 {   
 	checkSlow(IsInRenderingThread());
@@ -0,0 +1,455 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "AutomationTest.h"
+#include "AnimationCompression.h"
+#include "AnimEncoding.h"
+
+#if USE_ANIMATION_CODEC_BATCH_SOLVER
+
+namespace PerTrackPoseDecompressionTest
+{
+	/** Number of frames of the test sequence, few enough for byte frame tables */
+	const int32 NumFrames = 10;
+
+	/** Times to decompress at, in a sequence one second long */
+	static const float TestTimes[] =
+	{
+		0.0f, 0.13f, 0.5f, 0.77f, 0.999f, 1.0f,
+	};
+
+	/** Frame tables of the variable key tracks */
+	static const uint8 RotationFrames[] = { 0, 3, 7, 9 };
+	static const uint8 TranslationFrames[] = { 0, 1, 4, 5, 9 };
+	static const uint8 ScaleFrames[] = { 0, 6, 9 };
+
+	/** Which part of a bone a track holds */
+	enum ETrackComponent
+	{
+		TC_Translation,
+		TC_Rotation,
+		TC_Scale,
+	};
+
+	/** The tracks of one bone, and which of them the pose asks for */
+	struct FTestBone
+	{
+		int32 TranslationOffset;
+		int32 RotationOffset;
+		int32 ScaleOffset;
+		bool bRequestRotation;
+		bool bRequestScale;
+	};
+
+	/** Appends raw data to the byte stream */
+	static void AppendBytes( TArray<uint8>& ByteStream, const void* Data, int32 NumBytes )
+	{
+		ByteStream.Append( (const uint8*)Data, NumBytes );
+	}
+
+	/** Pads the byte stream to four byte alignment, where the next header or frame table goes */
+	static void PadByteStream( TArray<uint8>& ByteStream )
+	{
+		while ( ByteStream.Num() % 4 )
+		{
+			ByteStream.Add( 0 );
+		}
+	}
+
+	/**
+	 * Appends a per-track compressed track
+	 *
+	 * @param	ByteStream	The compressed byte stream to add the track to.
+	 * @param	Format		ACF_Float96NoW, or ACF_Fixed48NoW for rotations.
+	 * @param	FormatFlags	The components stored in each key, X, Y and Z in the lowest three bits.
+	 * @param	Keys		The keys, the X, Y and Z of a rotation with a positive W or a translation or scale.
+	 * @param	Frames		The frame of each key for a variable key track, or NULL for keys spread evenly across the sequence.
+	 * @param	TrackFrames	Remembers the frame table of each track by its offset.
+	 * @return				The offset of the track in the byte stream.
+	 */
+	static int32 AddTrack( TArray<uint8>& ByteStream, int32 Format, int32 FormatFlags, const TArray<FVector>& Keys, const uint8* Frames, TMap<int32, const uint8*>& TrackFrames )
+	{
+		PadByteStream( ByteStream );
+		const int32 Offset = ByteStream.Num();
+
+		const int32 Header = FAnimationCompression_PerTrackUtils::MakeHeader( Keys.Num(), Format, FormatFlags, Frames != NULL );
+		AppendBytes( ByteStream, &Header, sizeof( Header ) );
+
+		for ( int32 KeyIndex = 0; KeyIndex < Keys.Num(); KeyIndex++ )
+		{
+			for ( int32 Component = 0; Component < 3; Component++ )
+			{
+				if ( FormatFlags & ( 1 << Component ) )
+				{
+					if ( Format == ACF_Fixed48NoW )
+					{
+						const uint16 Value = FAnimationCompression_PerTrackUtils::CompressFixed16( Keys[KeyIndex][Component] );
+						AppendBytes( ByteStream, &Value, sizeof( Value ) );
+					}
+					else
+					{
+						AppendBytes( ByteStream, &Keys[KeyIndex][Component], sizeof( float ) );
+					}
+				}
+			}
+		}
+
+		if ( Frames != NULL )
+		{
+			PadByteStream( ByteStream );
+			AppendBytes( ByteStream, Frames, Keys.Num() );
+		}
+
+		TrackFrames.Add( Offset, Frames );
+		return Offset;
+	}
+
+	/** @return NumKeys translation or scale keys, different for every seed */
+	static TArray<FVector> MakeVectorKeys( int32 NumKeys, float Seed, float Base )
+	{
+		TArray<FVector> Keys;
+		for ( int32 KeyIndex = 0; KeyIndex < NumKeys; KeyIndex++ )
+		{
+			Keys.Add( FVector( Base + FMath::Sin( Seed + KeyIndex ), Base + FMath::Cos( Seed * 2.0f + KeyIndex ), Base + 0.1f * KeyIndex * Seed ) );
+		}
+		return Keys;
+	}
+
+	/** @return NumKeys rotation keys, different for every seed, with only the components in FormatFlags and the W that the keys leave out positive */
+	static TArray<FVector> MakeRotationKeys( int32 NumKeys, float Seed, int32 FormatFlags = 7 )
+	{
+		TArray<FVector> Keys;
+		for ( int32 KeyIndex = 0; KeyIndex < NumKeys; KeyIndex++ )
+		{
+			FQuat Rotation = FRotator( 40.0f * Seed + 17.0f * KeyIndex, -25.0f * KeyIndex, 10.0f * Seed ).Quaternion();
+			Rotation.X = ( FormatFlags & 1 ) ? Rotation.X : 0.0f;
+			Rotation.Y = ( FormatFlags & 2 ) ? Rotation.Y : 0.0f;
+			Rotation.Z = ( FormatFlags & 4 ) ? Rotation.Z : 0.0f;
+			Rotation.Normalize();
+			if ( Rotation.W < 0.0f )
+			{
+				Rotation = Rotation * -1.0f;
+			}
+			Keys.Add( FVector( Rotation.X, Rotation.Y, Rotation.Z ) );
+		}
+		return Keys;
+	}
+
+	/** Finds the keys to interpolate for a sequence that doesn't loop, written out rather than through AnimEncoding::TimeToIndex */
+	static float FindReferenceKeys( const uint8* Frames, int32 NumKeys, float RelativePos, int32& Index0, int32& Index1 )
+	{
+		const int32 LastKey = NumKeys - 1;
+		Index0 = 0;
+		Index1 = 0;
+
+		if ( NumKeys < 2 || RelativePos <= 0.0f )
+		{
+			return 0.0f;
+		}
+		if ( RelativePos >= 1.0f )
+		{
+			Index0 = LastKey;
+			Index1 = LastKey;
+			return 0.0f;
+		}
+
+		if ( Frames == NULL )
+		{
+			const float KeyPos = RelativePos * LastKey;
+			Index0 = FMath::Min( FMath::Floor( KeyPos ), LastKey );
+			Index1 = FMath::Min( Index0 + 1, LastKey );
+			return KeyPos - Index0;
+		}
+
+		const float FramePos = RelativePos * ( NumFrames - 1 );
+		const int32 FrameFloor = FMath::Floor( FramePos );
+		while ( Index0 < LastKey && Frames[Index0 + 1] <= FrameFloor )
+		{
+			Index0++;
+		}
+		Index1 = FMath::Min( Index0 + 1, LastKey );
+		return ( FramePos - Frames[Index0] ) / FMath::Max( Frames[Index1] - Frames[Index0], 1 );
+	}
+
+	/** Decompresses one component of a bone with the scalar per-track decompressors, and lerps and normalizes with scalar math */
+	static void DecompressReferenceTrack( const TArray<uint8>& ByteStream, const TMap<int32, const uint8*>& TrackFrames, int32 Offset, ETrackComponent Component, float RelativePos, FTransform& Atom )
+	{
+		if ( Offset == INDEX_NONE )
+		{
+			// Identity tracks, the per-track codec zeroes an identity scale too
+			switch ( Component )
+			{
+			case TC_Translation:	Atom.SetTranslation( FVector::ZeroVector ); break;
+			case TC_Rotation:		Atom.SetRotation( FQuat::Identity ); break;
+			case TC_Scale:			Atom.SetScale3D( FVector::ZeroVector ); break;
+			}
+			return;
+		}
+
+		const uint8* TrackData = ByteStream.GetTypedData() + Offset + 4;
+		const int32 Header = *(const int32*)( ByteStream.GetTypedData() + Offset );
+
+		int32 KeyFormat;
+		int32 NumKeys;
+		int32 FormatFlags;
+		int32 BytesPerKey;
+		int32 FixedBytes;
+		FAnimationCompression_PerTrackUtils::DecomposeHeader( Header, KeyFormat, NumKeys, FormatFlags, BytesPerKey, FixedBytes );
+
+		int32 Index0;
+		int32 Index1;
+		const float Alpha = FindReferenceKeys( TrackFrames.FindRef( Offset ), NumKeys, RelativePos, Index0, Index1 );
+		const uint8* KeyData0 = TrackData + FixedBytes + Index0 * BytesPerKey;
+		const uint8* KeyData1 = TrackData + FixedBytes + Index1 * BytesPerKey;
+
+		if ( Component == TC_Rotation )
+		{
+			FQuat R0;
+			FQuat R1;
+			FAnimationCompression_PerTrackUtils::DecompressRotation( KeyFormat, FormatFlags, R0, TrackData, KeyData0 );
+			FAnimationCompression_PerTrackUtils::DecompressRotation( KeyFormat, FormatFlags, R1, TrackData, KeyData1 );
+
+			// Lerp along the shortest route, then normalize
+			const float Bias = ( R0 | R1 ) >= 0.0f ? 1.0f : -1.0f;
+			FQuat Rotation = ( R0 * ( 1.0f - Alpha ) ) + ( R1 * ( Alpha * Bias ) );
+			Rotation.Normalize();
+			Atom.SetRotation( Rotation );
+		}
+		else
+		{
+			FVector V0;
+			FVector V1;
+			if ( Component == TC_Translation )
+			{
+				FAnimationCompression_PerTrackUtils::DecompressTranslation( KeyFormat, FormatFlags, V0, TrackData, KeyData0 );
+				FAnimationCompression_PerTrackUtils::DecompressTranslation( KeyFormat, FormatFlags, V1, TrackData, KeyData1 );
+				Atom.SetTranslation( FMath::Lerp( V0, V1, Alpha ) );
+			}
+			else
+			{
+				FAnimationCompression_PerTrackUtils::DecompressScale( KeyFormat, FormatFlags, V0, TrackData, KeyData0 );
+				FAnimationCompression_PerTrackUtils::DecompressScale( KeyFormat, FormatFlags, V1, TrackData, KeyData1 );
+				Atom.SetScale3D( FMath::Lerp( V0, V1, Alpha ) );
+			}
+		}
+	}
+
+	/** @return Whether two decompressed bones match, a quaternion and its negation being the same rotation */
+	static bool AtomsMatch( const FTransform& A, const FTransform& B )
+	{
+		return A.GetTranslation().Equals( B.GetTranslation(), KINDA_SMALL_NUMBER )
+			&& FMath::Abs( A.GetRotation() | B.GetRotation() ) >= 1.0f - KINDA_SMALL_NUMBER
+			&& A.GetScale3D().Equals( B.GetScale3D(), KINDA_SMALL_NUMBER );
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPerTrackPoseDecompressionTest, "Engine.Animation PerTrack Pose Decompression", EAutomationTestFlags::ATF_SmokeTest)
+
+bool FPerTrackPoseDecompressionTest::RunTest(const FString& Parameters)
+{
+	using namespace PerTrackPoseDecompressionTest;
+
+	// Tracks mix evenly spaced keys, variable keys with a frame table, single keys and identity tracks,
+	// in both uncompressed and fixed48 rotations, the latter also with components left out of the keys
+	TArray<uint8> ByteStream;
+	TMap<int32, const uint8*> TrackFrames;
+	TArray<FTestBone> Bones;
+
+	// Evenly spaced translation, variable key rotation and scale
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeVectorKeys( NumFrames, 0.5f, 0.0f ), NULL, TrackFrames );
+		Bone.RotationOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeRotationKeys( ARRAY_COUNT( RotationFrames ), 1.0f ), RotationFrames, TrackFrames );
+		Bone.ScaleOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeVectorKeys( ARRAY_COUNT( ScaleFrames ), 1.5f, 1.0f ), ScaleFrames, TrackFrames );
+		Bone.bRequestRotation = Bone.bRequestScale = true;
+		Bones.Add( Bone );
+	}
+
+	// Identity translation and scale, evenly spaced rotation
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = INDEX_NONE;
+		Bone.RotationOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeRotationKeys( NumFrames, 2.0f ), NULL, TrackFrames );
+		Bone.ScaleOffset = INDEX_NONE;
+		Bone.bRequestRotation = Bone.bRequestScale = true;
+		Bones.Add( Bone );
+	}
+
+	// Variable key translation, identity rotation, two evenly spaced scale keys
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeVectorKeys( ARRAY_COUNT( TranslationFrames ), 2.5f, 0.0f ), TranslationFrames, TrackFrames );
+		Bone.RotationOffset = INDEX_NONE;
+		Bone.ScaleOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeVectorKeys( 2, 3.0f, 1.0f ), NULL, TrackFrames );
+		Bone.bRequestRotation = Bone.bRequestScale = true;
+		Bones.Add( Bone );
+	}
+
+	// Single key translation and rotation, only its translation is requested
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeVectorKeys( 1, 3.5f, 0.0f ), NULL, TrackFrames );
+		Bone.RotationOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeRotationKeys( 1, 4.0f ), NULL, TrackFrames );
+		Bone.ScaleOffset = INDEX_NONE;
+		Bone.bRequestRotation = Bone.bRequestScale = false;
+		Bones.Add( Bone );
+	}
+
+	// Evenly spaced fixed48 rotation with every component
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = INDEX_NONE;
+		Bone.RotationOffset = AddTrack( ByteStream, ACF_Fixed48NoW, 7, MakeRotationKeys( NumFrames, 4.5f ), NULL, TrackFrames );
+		Bone.ScaleOffset = INDEX_NONE;
+		Bone.bRequestRotation = Bone.bRequestScale = true;
+		Bones.Add( Bone );
+	}
+
+	// Variable key fixed48 rotation around Z only
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeVectorKeys( 3, 5.0f, 0.0f ), NULL, TrackFrames );
+		Bone.RotationOffset = AddTrack( ByteStream, ACF_Fixed48NoW, 4, MakeRotationKeys( ARRAY_COUNT( RotationFrames ), 5.5f, 4 ), RotationFrames, TrackFrames );
+		Bone.ScaleOffset = INDEX_NONE;
+		Bone.bRequestRotation = Bone.bRequestScale = true;
+		Bones.Add( Bone );
+	}
+
+	// Evenly spaced fixed48 rotation without Z, single key scale
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = INDEX_NONE;
+		Bone.RotationOffset = AddTrack( ByteStream, ACF_Fixed48NoW, 3, MakeRotationKeys( 5, 6.0f, 3 ), NULL, TrackFrames );
+		Bone.ScaleOffset = AddTrack( ByteStream, ACF_Float96NoW, 7, MakeVectorKeys( 1, 6.5f, 1.0f ), NULL, TrackFrames );
+		Bone.bRequestRotation = Bone.bRequestScale = true;
+		Bones.Add( Bone );
+	}
+
+	// Single key fixed48 rotation without Y
+	{
+		FTestBone Bone = { 0 };
+		Bone.TranslationOffset = INDEX_NONE;
+		Bone.RotationOffset = AddTrack( ByteStream, ACF_Fixed48NoW, 5, MakeRotationKeys( 1, 7.0f, 5 ), NULL, TrackFrames );
+		Bone.ScaleOffset = INDEX_NONE;
+		Bone.bRequestRotation = Bone.bRequestScale = true;
+		Bones.Add( Bone );
+	}
+
+	UAnimSequence* Seq = NewObject<UAnimSequence>();
+	Seq->NumFrames = NumFrames;
+	Seq->SequenceLength = 1.0f;
+	Seq->KeyEncodingFormat = AKF_PerTrackCompression;
+	Seq->TranslationCompressionFormat = ACF_Identity;
+	Seq->RotationCompressionFormat = ACF_Identity;
+	Seq->ScaleCompressionFormat = ACF_Identity;
+	Seq->CompressedByteStream = ByteStream;
+	for ( int32 TrackIndex = 0; TrackIndex < Bones.Num(); TrackIndex++ )
+	{
+		Seq->CompressedTrackOffsets.Add( Bones[TrackIndex].TranslationOffset );
+		Seq->CompressedTrackOffsets.Add( Bones[TrackIndex].RotationOffset );
+	}
+	AnimationFormat_SetInterfaceLinks( *Seq );
+
+	// The pairs are in track order like the ones the animation code builds, one bone in the middle only asks for a translation
+	BoneTrackArray RotationPairs;
+	BoneTrackArray TranslationPairs;
+	BoneTrackArray ScalePairs;
+	for ( int32 TrackIndex = 0; TrackIndex < Bones.Num(); TrackIndex++ )
+	{
+		const int32 AtomIndex = TrackIndex;
+		TranslationPairs.Add( BoneTrackPair( AtomIndex, TrackIndex ) );
+		if ( Bones[TrackIndex].bRequestRotation )
+		{
+			RotationPairs.Add( BoneTrackPair( AtomIndex, TrackIndex ) );
+		}
+		if ( Bones[TrackIndex].bRequestScale )
+		{
+			ScalePairs.Add( BoneTrackPair( AtomIndex, TrackIndex ) );
+		}
+	}
+
+	AnimEncoding* Codec = (AnimEncoding*)Seq->RotationCodec;
+	TestTrue( TEXT( "Per-track sequence decodes every component with one codec" ), Codec != NULL && Seq->TranslationCodec == Seq->RotationCodec && Seq->ScaleCodec == Seq->RotationCodec );
+	if ( Codec == NULL )
+	{
+		return false;
+	}
+
+	// Once with scale tracks, once for a sequence without any
+	for ( int32 ScalePass = 0; ScalePass < 2; ScalePass++ )
+	{
+		const bool bHasScale = ScalePass == 0;
+		Seq->CompressedScaleOffsets.Empty();
+		if ( bHasScale )
+		{
+			Seq->CompressedScaleOffsets.AddUninitialized( Bones.Num() );
+			for ( int32 TrackIndex = 0; TrackIndex < Bones.Num(); TrackIndex++ )
+			{
+				Seq->CompressedScaleOffsets.SetOffsetData( TrackIndex, 0, Bones[TrackIndex].ScaleOffset );
+				Seq->CompressedScaleOffsets.SetOffsetData( TrackIndex, 1, 0 );
+			}
+		}
+
+		for ( int32 LoopPass = 0; LoopPass < 2; LoopPass++ )
+		{
+			const bool bLooping = LoopPass != 0;
+
+			for ( int32 TimeIndex = 0; TimeIndex < ARRAY_COUNT( TestTimes ); TimeIndex++ )
+			{
+				const float Time = TestTimes[TimeIndex];
+				const FString Context = FString::Printf( TEXT( "Scale %i, looping %i, time %.3f" ), (int32)bHasScale, (int32)bLooping, Time );
+
+				FMemMark Mark( FMemStack::Get() );
+				FTransformArray Atoms;
+				FTransformArray SeparateAtoms;
+				for ( int32 AtomIndex = 0; AtomIndex < Bones.Num(); AtomIndex++ )
+				{
+					Atoms.Add( FTransform::Identity );
+					SeparateAtoms.Add( FTransform::Identity );
+				}
+
+				Codec->GetPoseAtoms( Atoms, RotationPairs, TranslationPairs, ScalePairs, *Seq, Time, bLooping );
+
+				// The separate path AnimationFormat_GetAnimationPose takes for codecs that don't decode whole poses
+				Codec->GetPoseTranslations( SeparateAtoms, TranslationPairs, *Seq, Time, bLooping );
+				Codec->GetPoseRotations( SeparateAtoms, RotationPairs, *Seq, Time, bLooping );
+				if ( bHasScale )
+				{
+					Codec->GetPoseScales( SeparateAtoms, ScalePairs, *Seq, Time, bLooping );
+				}
+
+				for ( int32 AtomIndex = 0; AtomIndex < Atoms.Num(); AtomIndex++ )
+				{
+					TestTrue( *FString::Printf( TEXT( "%s, atom %i matches the separate decompression" ), *Context, AtomIndex ), AtomsMatch( Atoms[AtomIndex], SeparateAtoms[AtomIndex] ) );
+				}
+
+				// Both of the above share the vector rotation decompression, so also check against the scalar decompressors.
+				// The reference only finds keys for sequences which don't loop.
+				if ( !bLooping )
+				{
+					const float RelativePos = Time / Seq->SequenceLength;
+					for ( int32 AtomIndex = 0; AtomIndex < Bones.Num(); AtomIndex++ )
+					{
+						const FTestBone& Bone = Bones[AtomIndex];
+						FTransform Expected = FTransform::Identity;
+						DecompressReferenceTrack( ByteStream, TrackFrames, Bone.TranslationOffset, TC_Translation, RelativePos, Expected );
+						if ( Bone.bRequestRotation )
+						{
+							DecompressReferenceTrack( ByteStream, TrackFrames, Bone.RotationOffset, TC_Rotation, RelativePos, Expected );
+						}
+						if ( bHasScale && Bone.bRequestScale )
+						{
+							DecompressReferenceTrack( ByteStream, TrackFrames, Bone.ScaleOffset, TC_Scale, RelativePos, Expected );
+						}
+
+						TestTrue( *FString::Printf( TEXT( "%s, atom %i matches the scalar decompression" ), *Context, AtomIndex ), AtomsMatch( Atoms[AtomIndex], Expected ) );
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif // USE_ANIMATION_CODEC_BATCH_SOLVER
@@ -0,0 +1,170 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "AutomationTest.h"
+#include "Net/RepMovementDelta.h"
+
+namespace RepMovementSerializationTest
+{
+	/** Vectors at the edges of what each quantization level can represent, and a few ordinary ones */
+	static const FVector TestVectors[] =
+	{
+		FVector( 0.0f, 0.0f, 0.0f ),
+		FVector( 0.004f, -0.005f, 0.006f ),
+		FVector( 1.25f, -1.25f, 12345.678f ),
+		FVector( -99999.99f, 54321.5f, -0.5f ),
+		FVector( 5000000.0f, -5000000.0f, 5000000.0f ),
+		FVector( 1.0e12f, -1.0e12f, 0.0f ),
+	};
+
+	/** Rotators around the points where the compressed components wrap */
+	static const FRotator TestRotators[] =
+	{
+		FRotator( 0.0f, 0.0f, 0.0f ),
+		FRotator( 359.99f, -0.01f, 180.0f ),
+		FRotator( -180.0f, 90.0f, -90.0f ),
+		FRotator( 1.0f, 358.6f, 721.0f ),
+	};
+
+	static const EVectorQuantization::Type VectorLevels[] =
+	{
+		EVectorQuantization::RoundWholeNumber,
+		EVectorQuantization::RoundOneDecimal,
+		EVectorQuantization::RoundTwoDecimals,
+	};
+
+	static const ERotatorQuantization::Type RotatorLevels[] =
+	{
+		ERotatorQuantization::ByteComponents,
+		ERotatorQuantization::ShortComponents,
+	};
+
+	/** @return Movement with the given values and quantization levels */
+	static FRepMovement MakeMovement( const FVector & Vector, const FRotator & Rotator, EVectorQuantization::Type VectorLevel, ERotatorQuantization::Type RotatorLevel, bool bRepPhysics )
+	{
+		FRepMovement Movement;
+		Movement.LocationQuantizationLevel	= VectorLevel;
+		Movement.VelocityQuantizationLevel	= VectorLevel;
+		Movement.RotationQuantizationLevel	= RotatorLevel;
+		Movement.Location					= Vector;
+		Movement.LinearVelocity				= -Vector;
+		Movement.AngularVelocity			= FVector( Vector.Z, Vector.X, Vector.Y );
+		Movement.Rotation					= Rotator;
+		Movement.bRepPhysics				= bRepPhysics;
+		Movement.bSimulatedPhysicSleep		= !bRepPhysics;
+		return Movement;
+	}
+
+	/** @return Movement as the receiver should end up with it, every value rounded to its quantization level */
+	static FRepMovement GetExpectedMovement( const FRepMovement & Movement )
+	{
+		FQuantizedRepMovement Quantized;
+		Quantized.Quantize( Movement );
+
+		FRepMovement Expected = Movement;
+		Quantized.Dequantize( Expected );
+		return Expected;
+	}
+
+	/** @return true if the rotators are within one compressed step of each other on every axis */
+	static bool RotatorsMatch( const FRotator & A, const FRotator & B, ERotatorQuantization::Type Level )
+	{
+		const float Step = 360.0f / ( 1 << FRepMovement::GetRotationBits( Level ) ) + KINDA_SMALL_NUMBER;
+		const FRotator Delta = ( A - B ).GetNormalized();
+		return FMath::Abs( Delta.Pitch ) <= Step && FMath::Abs( Delta.Yaw ) <= Step && FMath::Abs( Delta.Roll ) <= Step;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRepMovementSerializationTest, "Engine.RepMovement Serialization", EAutomationTestFlags::ATF_SmokeTest)
+
+bool FRepMovementSerializationTest::RunTest(const FString& Parameters)
+{
+	using namespace RepMovementSerializationTest;
+
+	for ( int32 VectorLevelIdx = 0; VectorLevelIdx < ARRAY_COUNT( VectorLevels ); VectorLevelIdx++ )
+	{
+		const EVectorQuantization::Type VectorLevel = VectorLevels[VectorLevelIdx];
+		const float Scale = FRepMovement::GetQuantizationScale( VectorLevel );
+
+		for ( int32 RotatorLevelIdx = 0; RotatorLevelIdx < ARRAY_COUNT( RotatorLevels ); RotatorLevelIdx++ )
+		{
+			const ERotatorQuantization::Type RotatorLevel = RotatorLevels[RotatorLevelIdx];
+
+			// Sender and receiver of the delta compressed path, states go from one to the other like over a connection
+			FRepMovementDelta Sender;
+			FRepMovementDelta Receiver;
+			int32 PacketId = 0;
+
+			for ( int32 VectorIdx = 0; VectorIdx < ARRAY_COUNT( TestVectors ); VectorIdx++ )
+			{
+				for ( int32 RotatorIdx = 0; RotatorIdx < ARRAY_COUNT( TestRotators ); RotatorIdx++ )
+				{
+					const bool bRepPhysics = ( ( VectorIdx + RotatorIdx ) & 1 ) != 0;
+					const FRepMovement Movement = MakeMovement( TestVectors[VectorIdx], TestRotators[RotatorIdx], VectorLevel, RotatorLevel, bRepPhysics );
+					const FString Context = FString::Printf( TEXT( "Vector level %i, rotator level %i, vector %i, rotator %i" ), (int32)VectorLevel, (int32)RotatorLevel, VectorIdx, RotatorIdx );
+
+					// Full state, through NetSerialize
+					{
+						FNetBitWriter Writer( 1024 );
+						FRepMovement Source = Movement;
+						bool bSaveSuccess = false;
+						Source.NetSerialize( Writer, NULL, bSaveSuccess );
+
+						FNetBitReader Reader( NULL, Writer.GetData(), Writer.GetNumBits() );
+						FRepMovement Received = MakeMovement( FVector::ZeroVector, FRotator::ZeroRotator, VectorLevel, RotatorLevel, false );
+						bool bLoadSuccess = false;
+						Received.NetSerialize( Reader, NULL, bLoadSuccess );
+
+						TestFalse( *FString::Printf( TEXT( "%s: NetSerialize read past the end" ), *Context ), Reader.IsError() );
+						TestTrue( *FString::Printf( TEXT( "%s: NetSerialize flags" ), *Context ), Received.bRepPhysics == Movement.bRepPhysics );
+						TestTrue( *FString::Printf( TEXT( "%s: NetSerialize sleep flag" ), *Context ), Received.bSimulatedPhysicSleep == Movement.bSimulatedPhysicSleep );
+						TestTrue( *FString::Printf( TEXT( "%s: NetSerialize rotation" ), *Context ), RotatorsMatch( Received.Rotation, Movement.Rotation, RotatorLevel ) );
+
+						// Vectors the packed format can't hold are clamped and reported, everything else is within one step
+						if ( bSaveSuccess )
+						{
+							TestTrue( *FString::Printf( TEXT( "%s: NetSerialize location" ), *Context ), Received.Location.Equals( Movement.Location, 1.0f / Scale + KINDA_SMALL_NUMBER ) );
+							TestTrue( *FString::Printf( TEXT( "%s: NetSerialize linear velocity" ), *Context ), Received.LinearVelocity.Equals( Movement.LinearVelocity, 1.0f / Scale + KINDA_SMALL_NUMBER ) );
+
+							if ( bRepPhysics )
+							{
+								TestTrue( *FString::Printf( TEXT( "%s: NetSerialize angular velocity" ), *Context ), Received.AngularVelocity.Equals( Movement.AngularVelocity, 1.0f / Scale + KINDA_SMALL_NUMBER ) );
+							}
+						}
+					}
+
+					// Delta compressed, against the last state the receiver acked
+					{
+						FNetBitWriter Writer( 1024 );
+						Sender.Write( Writer, Movement );
+
+						PacketId++;
+						Sender.PostSend( FPacketIdRange( PacketId ), false, true );
+
+						FNetBitReader Reader( NULL, Writer.GetData(), Writer.GetNumBits() );
+						FRepMovement Received = MakeMovement( FVector::ZeroVector, FRotator::ZeroRotator, VectorLevel, RotatorLevel, false );
+
+						TestTrue( *FString::Printf( TEXT( "%s: Delta read" ), *Context ), Receiver.Read( Reader, Received ) );
+						TestEqual( *FString::Printf( TEXT( "%s: Delta read every bit" ), *Context ), Reader.GetPosBits(), Writer.GetNumBits() );
+
+						Sender.UpdateAcked( PacketId );
+
+						const FRepMovement Expected = GetExpectedMovement( Movement );
+						TestTrue( *FString::Printf( TEXT( "%s: Delta flags" ), *Context ), Received.bRepPhysics == Expected.bRepPhysics );
+						TestTrue( *FString::Printf( TEXT( "%s: Delta sleep flag" ), *Context ), Received.bSimulatedPhysicSleep == Expected.bSimulatedPhysicSleep );
+						TestEqual( *FString::Printf( TEXT( "%s: Delta location" ), *Context ), Received.Location, Expected.Location );
+						TestEqual( *FString::Printf( TEXT( "%s: Delta rotation" ), *Context ), Received.Rotation, Expected.Rotation );
+						TestEqual( *FString::Printf( TEXT( "%s: Delta linear velocity" ), *Context ), Received.LinearVelocity, Expected.LinearVelocity );
+
+						if ( bRepPhysics )
+						{
+							TestEqual( *FString::Printf( TEXT( "%s: Delta angular velocity" ), *Context ), Received.AngularVelocity, Expected.AngularVelocity );
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
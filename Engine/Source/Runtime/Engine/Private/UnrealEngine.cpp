@@ -32,6 +32,7 @@
 #include "TargetPlatform.h"
 #include "AudioEffect.h"
 #include "Net/NetworkProfiler.h"
+#include "Net/ReplayStream.h"
 #include "MallocProfiler.h"
 #include "../../Launch/Resources/Version.h"
 #include "StereoRendering.h"
@@ -2095,6 +2096,26 @@ bool UEngine::Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar )
 	{
 		return HandleReconnectCommand( Cmd, Ar, InWorld );
 	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOREC")) )
+	{
+		return HandleDemoRecordCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOSTOP")) )
+	{
+		return HandleDemoStopCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOPLAY")) )
+	{
+		return HandleDemoPlayCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOSCRUB")) )
+	{
+		return HandleDemoScrubCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOSPEED")) )
+	{
+		return HandleDemoSpeedCommand( Cmd, Ar, InWorld );
+	}
 	else if( FParse::Command( &Cmd, TEXT("TRAVEL") ) )
 	{
 		return HandleTravelCommand( Cmd, Ar, InWorld );
@@ -8593,6 +8614,15 @@ void UEngine::ShutdownWorldNetDriver( UWorld * World )
 			UE_LOG(LogNet, Log, TEXT("World NetDriver shutdown %s [%s]"), *NetDriver->GetName(), *NetDriver->NetDriverName.ToString());
 			DestroyNamedNetDriver(World, NetDriver->NetDriverName);
 		}
+
+		// A replay recorded next to the game net driver goes away with it
+		UDemoNetDriver* DemoNetDriver = World->DemoNetDriver;
+		World->DemoNetDriver = NULL;
+		if (DemoNetDriver && DemoNetDriver != NetDriver)
+		{
+			UE_LOG(LogNet, Log, TEXT("World DemoNetDriver shutdown %s"), *DemoNetDriver->DemoFilename);
+			DestroyNamedNetDriver(World, DemoNetDriver->NetDriverName);
+		}
 	}
 }
 
@@ -9099,6 +9129,126 @@ bool UEngine::HandleReconnectCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorl
 	return true;
 }
 
+bool UEngine::HandleDemoRecordCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld )
+{
+	if (InWorld == NULL || !InWorld->IsServer())
+	{
+		Ar.Logf(TEXT("Replays can only be recorded on a server or in a standalone game"));
+		return true;
+	}
+
+	if (InWorld->DemoNetDriver != NULL)
+	{
+		Ar.Logf(TEXT("Already recording %s"), *InWorld->DemoNetDriver->DemoFilename);
+		return true;
+	}
+
+	FString DemoName;
+	if (!FParse::Token(Cmd, DemoName, false))
+	{
+		DemoName = FString::Printf(TEXT("%s-%s"), *InWorld->GetMapName(), *FDateTime::Now().ToString());
+	}
+
+	if (!CreateNamedNetDriver(InWorld, NAME_DemoNetDriver, NAME_DemoNetDriver))
+	{
+		Ar.Logf(TEXT("Couldn't create the replay net driver"));
+		return true;
+	}
+
+	UDemoNetDriver* DemoNetDriver = CastChecked<UDemoNetDriver>(FindNamedNetDriver(InWorld, NAME_DemoNetDriver));
+	DemoNetDriver->SetWorld(InWorld);
+
+	FURL DemoURL;
+	DemoURL.Map = DemoName;
+
+	FString Error;
+	if (!DemoNetDriver->InitListen(InWorld, DemoURL, false, Error))
+	{
+		Ar.Logf(TEXT("Couldn't record replay %s: %s"), *DemoName, *Error);
+		DestroyNamedNetDriver(InWorld, NAME_DemoNetDriver);
+		return true;
+	}
+
+	InWorld->DemoNetDriver = DemoNetDriver;
+	Ar.Logf(TEXT("Recording replay %s"), *DemoNetDriver->DemoFilename);
+	return true;
+}
+
+bool UEngine::HandleDemoStopCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld )
+{
+	UDemoNetDriver* DemoNetDriver = InWorld ? InWorld->DemoNetDriver : NULL;
+	if (DemoNetDriver == NULL)
+	{
+		Ar.Logf(TEXT("No replay is being recorded or played"));
+		return true;
+	}
+
+	if (DemoNetDriver->IsRecording())
+	{
+		Ar.Logf(TEXT("Stopped recording %s"), *DemoNetDriver->DemoFilename);
+		InWorld->DemoNetDriver = NULL;
+		DestroyNamedNetDriver(InWorld, NAME_DemoNetDriver);
+	}
+	else
+	{
+		// The replay is the net driver of the world, leave it like a server that went away
+		InWorld->DemoNetDriver = NULL;
+		HandleDisconnect(InWorld, DemoNetDriver);
+	}
+	return true;
+}
+
+bool UEngine::HandleDemoPlayCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld )
+{
+	FString DemoName;
+	if (!FParse::Token(Cmd, DemoName, false))
+	{
+		Ar.Logf(TEXT("Usage: DEMOPLAY <name>"));
+		return true;
+	}
+
+	// Open the replay once here, so a bad file is reported without leaving the current map
+	FString Error;
+	FReplayStreamReader* Reader = FReplayStreamReader::Open(UDemoNetDriver::GetDemoFilename(DemoName), Error);
+	if (Reader == NULL)
+	{
+		Ar.Logf(TEXT("Couldn't play replay %s: %s"), *DemoName, *Error);
+		return true;
+	}
+
+	const FString MapName = Reader->GetHeader().MapName;
+	delete Reader;
+
+	SetClientTravel(InWorld, *FString::Printf(TEXT("%s?DemoPlay=%s"), *MapName, *DemoName), TRAVEL_Absolute);
+	return true;
+}
+
+bool UEngine::HandleDemoScrubCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld )
+{
+	UDemoNetDriver* DemoNetDriver = InWorld ? InWorld->DemoNetDriver : NULL;
+	if (DemoNetDriver == NULL || !DemoNetDriver->IsPlaying())
+	{
+		Ar.Logf(TEXT("No replay is being played"));
+		return true;
+	}
+
+	DemoNetDriver->GotoTime(FCString::Atof(Cmd));
+	return true;
+}
+
+bool UEngine::HandleDemoSpeedCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld )
+{
+	UDemoNetDriver* DemoNetDriver = InWorld ? InWorld->DemoNetDriver : NULL;
+	if (DemoNetDriver == NULL || !DemoNetDriver->IsPlaying())
+	{
+		Ar.Logf(TEXT("No replay is being played"));
+		return true;
+	}
+
+	DemoNetDriver->SetPlaybackSpeed(FCString::Atof(Cmd));
+	return true;
+}
+
 bool UEngine::MakeSureMapNameIsValid(FString& InOutMapName)
 {
 	// Check if the map name is long package name and if it actually exists.
@@ -9964,6 +10114,29 @@ bool UEngine::LoadMap( FWorldContext& WorldContext, FURL URL, class UPendingNetG
 		check(!WorldContext.World()->GetNetDriver());
 	}
 
+	// Play a replay, the replay net driver makes the world a client of the recorded server.
+	const bool bDemoPlayback = Pending == NULL && URL.HasOption(TEXT("DemoPlay"));
+	if (bDemoPlayback)
+	{
+		UWorld* World = WorldContext.World();
+		if (CreateNamedNetDriver(World, NAME_DemoNetDriver, NAME_DemoNetDriver))
+		{
+			UDemoNetDriver* DemoNetDriver = CastChecked<UDemoNetDriver>(FindNamedNetDriver(World, NAME_DemoNetDriver));
+			DemoNetDriver->SetWorld(World);
+			World->SetNetDriver(DemoNetDriver);
+			World->DemoNetDriver = DemoNetDriver;
+
+			FString DemoError;
+			if (!DemoNetDriver->InitConnect(World, URL, DemoError))
+			{
+				UE_LOG(LogNet, Error, TEXT("LoadMap: failed to play replay (%s)"), *DemoError);
+				World->SetNetDriver(NULL);
+				World->DemoNetDriver = NULL;
+				DestroyNamedNetDriver(World, NAME_DemoNetDriver);
+			}
+		}
+	}
+
 	WorldContext.World()->SetGameMode(URL);
 
 	if( GetAudioDevice() )
@@ -9972,7 +10145,7 @@ bool UEngine::LoadMap( FWorldContext& WorldContext, FURL URL, class UPendingNetG
 	}
 
 	// Listen for clients.
-	if (Pending == NULL && (!GIsClient || URL.HasOption(TEXT("Listen"))))
+	if (Pending == NULL && !bDemoPlayback && (!GIsClient || URL.HasOption(TEXT("Listen"))))
 	{
 		if (!WorldContext.World()->Listen(URL))
 		{
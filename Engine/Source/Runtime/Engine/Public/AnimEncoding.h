@@ -48,6 +48,28 @@ struct BoneTrackPair
 #define MAX_BONES 65536 // DesiredBones is passed to the decompression routines as a TArray<FBoneIndexType>, so we know this max is appropriate
 typedef TArray<BoneTrackPair> BoneTrackArray;
 
+/**
+ *	Key indices already looked up while decompressing one pose, at one time.
+ *	Every track with the same number of uniformly spaced keys interpolates the same pair of keys, so each key count is only looked up once.
+ *	Lives on the stack of the decompressing thread, so poses can be decompressed in parallel.
+ */
+struct FAnimKeyLookupCache
+{
+	enum { MaxEntries = 4 };
+
+	int32 NumEntries;
+	int32 NextEntry;
+	int32 NumKeys[MaxEntries];
+	int32 PosIndex0[MaxEntries];
+	int32 PosIndex1[MaxEntries];
+	float Alpha[MaxEntries];
+
+	FAnimKeyLookupCache()
+		: NumEntries(0)
+		, NextEntry(0)
+	{}
+};
+
 
 /**
  * Extracts a single BoneAtom from an Animation Sequence.
@@ -244,6 +266,28 @@ public:
 		const UAnimSequence& Seq,
 		float Time,
 		bool bLooping) PURE_VIRTUAL(AnimEncoding::GetPoseScales,);
+
+	/**
+	 * Decompress all requested rotation, translation and scale components from an Animation Sequence.
+	 * Only used when this codec decodes all three, codecs which can decode a whole pose in one pass override it.
+	 *
+	 * @param	Atoms				The FTransform array to fill in.
+	 * @param	RotationPairs		Array of bones requesting rotation data
+	 * @param	TranslationPairs	Array of bones requesting translation data
+	 * @param	ScalePairs			Array of bones requesting scale data
+	 * @param	Seq					The animation sequence to use.
+	 * @param	Time				Current time to solve for.
+	 * @param	bLooping			True when looping the stream in intended.
+	 * @return						None. 
+	 */
+	virtual void GetPoseAtoms(
+		FTransformArray& Atoms,
+		const BoneTrackArray& RotationPairs,
+		const BoneTrackArray& TranslationPairs,
+		const BoneTrackArray& ScalePairs,
+		const UAnimSequence& Seq,
+		float Time,
+		bool bLooping);
 #endif
 protected:
 
@@ -266,6 +310,28 @@ protected:
 		int32 &PosIndex0Out,
 		int32 &PosIndex1Out);
 
+	/**
+	 * Utility function to determine the two key indices to interpolate given a relative position in the animation,
+	 * reusing the lookup already made for another track of the pose with the same number of keys
+	 *
+	 * @param	Seq				The UAnimSequence container.
+	 * @param	RelativePos		The relative position to solve in the range [0,1] inclusive.
+	 * @param	bLooping		true if the animation should be consider cyclic (last frame interpolates back to the start)
+	 * @param	NumKeys			The number of keys present in the track being solved.
+	 * @param	KeyLookups		The lookups made so far for this pose.
+	 * @param	PosIndex0Out	Output value for the closest key index before the RelativePos specified.
+	 * @param	PosIndex1Out	Output value for the closest key index after the RelativePos specified.
+	 * @return	The rate at which to interpolate the two keys returned to obtain the final result.
+	 */
+	static float TimeToIndex(
+		const UAnimSequence& Seq,
+		float RelativePos,
+		bool bLooping,
+		int32 NumKeys,
+		FAnimKeyLookupCache& KeyLookups,
+		int32 &PosIndex0Out,
+		int32 &PosIndex1Out);
+
 	/**
 	 * Utility function to determine the two key indices to interpolate given a relative position in the animation
 	 *
@@ -521,117 +587,130 @@ FORCEINLINE float AnimEncoding::TimeToIndex(
 	int32 &PosIndex0Out,
 	int32 &PosIndex1Out)
 {
-	static int32		NumKeysCache = 0; // this value is guaranteed to not be used for valid data
-	static float	TimeCache;
-	static float	SequenceLengthCache;
-	static bool	LoopingCache;
-	static int32		PosIndex0CacheOut; 
-	static int32		PosIndex1CacheOut; 
-	static float	AlphaCacheOut;
-
-	const float SequenceLength= Seq.SequenceLength;
+	// No cache shared between calls here, poses are decompressed on several threads at once
+	PosIndex0Out = 0;
+	PosIndex1Out = 0;
 
 	if (NumKeys < 2)
 	{
 		checkSlow(NumKeys == 1); // check if data is empty for some reason.
-		PosIndex0Out = 0;
-		PosIndex1Out = 0;
 		return 0.0f;
 	}
-	if (
-		NumKeysCache		!= NumKeys ||
-		LoopingCache		!= bLooping ||
-		SequenceLengthCache != SequenceLength ||
-		TimeCache			!= RelativePos
-		)
+
+	// Check for before-first-frame case.
+	if( RelativePos <= 0.f )
+	{
+		return 0.0f;
+	}
+
+	if (!bLooping)
 	{
-		NumKeysCache		= NumKeys;
-		LoopingCache		= bLooping;
-		SequenceLengthCache = SequenceLength;
-		TimeCache			= RelativePos;
-		// Check for before-first-frame case.
-		if( RelativePos <= 0.f )
+		NumKeys -= 1; // never used without the minus one in this case
+		// Check for after-last-frame case.
+		if( RelativePos >= 1.0f )
 		{
-			PosIndex0CacheOut = 0;
-			PosIndex1CacheOut = 0;
-			AlphaCacheOut = 0.0f;
+			// If we're not looping, key n-1 is the final key.
+			PosIndex0Out = NumKeys;
+			PosIndex1Out = NumKeys;
+			return 0.0f;
 		}
-		else
+
+		// For non-looping animation, the last frame is the ending frame, and has no duration.
+		const float KeyPos = RelativePos * float(NumKeys);
+		checkSlow(KeyPos >= 0.0f);
+		const float KeyPosFloor = floorf(KeyPos);
+		PosIndex0Out = FMath::Min( FMath::Trunc(KeyPosFloor), NumKeys );
+		PosIndex1Out = FMath::Min( PosIndex0Out + 1, NumKeys );
+		return KeyPos - KeyPosFloor;
+	}
+
+	// we are looping
+	// Check for after-last-frame case.
+	if( RelativePos >= 1.0f )
+	{
+		// If we're looping, key 0 is the final key.
+		return 0.0f;
+	}
+
+	// Work with animation total frames, to handle looping last->first
+	// Our track might have a different number of frames, and we handle that below.
+	int32 const NumFrames = Seq.NumFrames;
+
+	// For looping animation, the last frame has duration, and interpolates back to the first one.
+	const float KeyPos = RelativePos * float(NumFrames);
+	checkSlow(KeyPos >= 0.0f);
+	const float KeyPosFloor = floorf(KeyPos);
+	PosIndex0Out = FMath::Min( FMath::Trunc(KeyPosFloor), NumFrames - 1 );
+	PosIndex1Out = PosIndex0Out + 1;
+	float Alpha = KeyPos - KeyPosFloor;
+
+	// Handle Looping
+	if( PosIndex1Out == NumFrames )
+	{
+		PosIndex0Out = NumKeys - 1;
+		PosIndex1Out = 0;
+	}
+	// Non Looping! Special treatment if NumKeys is not the same as NumFrames...
+	else if( NumFrames != NumKeys )
+	{
+		// Since we're not looping first to last, chop off the last chunk
+		// And do a simple non looping interp between those keys.
+		float const AdjustedPosition = (RelativePos * float(NumFrames)) / float(NumFrames-1);
+		float const AdjustedKeyPos = AdjustedPosition * float(NumKeys-1);
+		checkSlow(AdjustedKeyPos >= 0.0f);
+		float const AdjustedKeyPosFloor = floorf(AdjustedKeyPos);
+		PosIndex0Out = FMath::Min( FMath::Trunc(AdjustedKeyPosFloor), NumKeys - 1 );
+		Alpha = AdjustedKeyPos - AdjustedKeyPosFloor;
+		PosIndex1Out = FMath::Min( PosIndex0Out + 1, NumKeys - 1 );
+	}
+
+	return Alpha;
+}
+
+/**
+ * Utility function to determine the two key indices to interpolate given a relative position in the animation,
+ * reusing the lookup already made for another track of the pose with the same number of keys
+ *
+ * @param	Seq				The UAnimSequence container.
+ * @param	RelativePos		The relative position to solve in the range [0,1] inclusive.
+ * @param	bLooping		true if the animation should be consider cyclic (last frame interpolates back to the start)
+ * @param	NumKeys			The number of keys present in the track being solved.
+ * @param	KeyLookups		The lookups made so far for this pose.
+ * @param	PosIndex0Out	Output value for the closest key index before the RelativePos specified.
+ * @param	PosIndex1Out	Output value for the closest key index after the RelativePos specified.
+ * @return	The rate at which to interpolate the two keys returned to obtain the final result.
+ */
+FORCEINLINE float AnimEncoding::TimeToIndex(
+	const UAnimSequence& Seq,
+	float RelativePos,
+	bool bLooping,
+	int32 NumKeys,
+	FAnimKeyLookupCache& KeyLookups,
+	int32 &PosIndex0Out,
+	int32 &PosIndex1Out)
+{
+	for (int32 EntryIndex = 0; EntryIndex < KeyLookups.NumEntries; ++EntryIndex)
+	{
+		if (KeyLookups.NumKeys[EntryIndex] == NumKeys)
 		{
-			if (!bLooping)
-			{
-				NumKeys -= 1; // never used without the minus one in this case
-				// Check for after-last-frame case.
-				if( RelativePos >= 1.0f )
-				{
-					// If we're not looping, key n-1 is the final key.
-					PosIndex0CacheOut = NumKeys;
-					PosIndex1CacheOut = NumKeys;
-					AlphaCacheOut = 0.0f;
-				}
-				else
-				{
-					// For non-looping animation, the last frame is the ending frame, and has no duration.
-					const float KeyPos = RelativePos * float(NumKeys);
-					checkSlow(KeyPos >= 0.0f);
-					const float KeyPosFloor = floorf(KeyPos);
-					PosIndex0CacheOut = FMath::Min( FMath::Trunc(KeyPosFloor), NumKeys );
-					AlphaCacheOut = KeyPos - KeyPosFloor;
-					PosIndex1CacheOut = FMath::Min( PosIndex0CacheOut + 1, NumKeys );
-				}
-			}
-			else // we are looping
-			{
-				// Check for after-last-frame case.
-				if( RelativePos >= 1.0f )
-				{
-					// If we're looping, key 0 is the final key.
-					PosIndex0CacheOut = 0;
-					PosIndex1CacheOut = 0;
-					AlphaCacheOut = 0.0f;
-				}
-				else
-				{
-					// Work with animation total frames, to handle looping last->first
-					// Our track might have a different number of frames, and we handle that below.
-					int32 const NumFrames = Seq.NumFrames;
-
-					{
-						// For looping animation, the last frame has duration, and interpolates back to the first one.
-						const float KeyPos = RelativePos * float(NumFrames);
-						checkSlow(KeyPos >= 0.0f);
-						const float KeyPosFloor = floorf(KeyPos);
-						PosIndex0CacheOut = FMath::Min( FMath::Trunc(KeyPosFloor), NumFrames - 1 );
-						AlphaCacheOut = KeyPos - KeyPosFloor;
-						PosIndex1CacheOut = PosIndex0CacheOut + 1;
-					}
-
-					// Handle Looping
-					if( PosIndex1CacheOut == NumFrames )
-					{
-						PosIndex0CacheOut = NumKeys - 1;
-						PosIndex1CacheOut = 0;
-					}
-					// Non Looping! Special treatment if NumKeys is not the same as NumFrames...
-					else if( NumFrames != NumKeys )
-					{
-						// Since we're not looping first to last, chop off the last chunk
-						// And do a simple non looping interp between those keys.
-						float const AdjustedPosition = (RelativePos * float(NumFrames)) / float(NumFrames-1);
-						float const KeyPos = AdjustedPosition * float(NumKeys-1);
-						checkSlow(KeyPos >= 0.0f);
-						float const KeyPosFloor = floorf(KeyPos);
-						PosIndex0CacheOut = FMath::Min( FMath::Trunc(KeyPosFloor), NumKeys - 1 );
-						AlphaCacheOut = KeyPos - KeyPosFloor;
-						PosIndex1CacheOut = FMath::Min( PosIndex0CacheOut + 1, NumKeys - 1 );
-					}
-				}
-			}
+			PosIndex0Out = KeyLookups.PosIndex0[EntryIndex];
+			PosIndex1Out = KeyLookups.PosIndex1[EntryIndex];
+			return KeyLookups.Alpha[EntryIndex];
 		}
 	}
-	PosIndex0Out = PosIndex0CacheOut;
-	PosIndex1Out = PosIndex1CacheOut;
-	return AlphaCacheOut;
+
+	const float Alpha = TimeToIndex(Seq, RelativePos, bLooping, NumKeys, PosIndex0Out, PosIndex1Out);
+
+	// Once the cache is full the oldest lookup is replaced
+	const int32 EntryIndex = KeyLookups.NextEntry;
+	KeyLookups.NextEntry = (EntryIndex + 1) % FAnimKeyLookupCache::MaxEntries;
+	KeyLookups.NumEntries = FMath::Max(KeyLookups.NumEntries, EntryIndex + 1);
+	KeyLookups.NumKeys[EntryIndex] = NumKeys;
+	KeyLookups.PosIndex0[EntryIndex] = PosIndex0Out;
+	KeyLookups.PosIndex1[EntryIndex] = PosIndex1Out;
+	KeyLookups.Alpha[EntryIndex] = Alpha;
+
+	return Alpha;
 }
 
 /**
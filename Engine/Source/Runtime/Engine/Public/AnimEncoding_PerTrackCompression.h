@@ -8,6 +8,23 @@
 
 #include "AnimEncoding.h"
 
+/**
+ * The two keys of a track to interpolate, and the rate between them.
+ * Found while prefetching a track, so decompressing it doesn't search a variable key track's frame table again.
+ */
+struct FPerTrackKeyIndices
+{
+	int32 Index0;
+	int32 Index1;
+	float Alpha;
+
+	FPerTrackKeyIndices()
+		: Index0(0)
+		, Index1(0)
+		, Alpha(0.0f)
+	{}
+};
+
 /**
  * Decompression codec for the per-track compressor.
  */
@@ -106,6 +123,28 @@ public:
 		const UAnimSequence& Seq,
 		float Time,
 		bool bLooping);
+
+	/**
+	 * Decompress all requested rotation, translation and scale components from an Animation Sequence in one pass,
+	 * sharing key lookups between tracks and prefetching the keys of the bones ahead
+	 *
+	 * @param	Atoms				The FTransform array to fill in.
+	 * @param	RotationPairs		Array of bones requesting rotation data
+	 * @param	TranslationPairs	Array of bones requesting translation data
+	 * @param	ScalePairs			Array of bones requesting scale data
+	 * @param	Seq					The animation sequence to use.
+	 * @param	Time				Current time to solve for.
+	 * @param	bLooping			True when looping the stream in intended.
+	 * @return						None. 
+	 */
+	virtual void GetPoseAtoms(
+		FTransformArray& Atoms,
+		const BoneTrackArray& RotationPairs,
+		const BoneTrackArray& TranslationPairs,
+		const BoneTrackArray& ScalePairs,
+		const UAnimSequence& Seq,
+		float Time,
+		bool bLooping);
 #endif
 
 protected:
@@ -126,6 +165,53 @@ protected:
 	 */
 	static void PreservePadding(uint8*& TrackData, FMemoryArchive& MemoryStream);
 
+	/**
+	 * Finds the two keys of a track to interpolate
+	 *
+	 * @param	Seq				The animation sequence to use.
+	 * @param	TrackData		The compressed track, past its header.
+	 * @param	NumKeys			The number of keys in the track.
+	 * @param	FormatFlags		The format flags from the track header.
+	 * @param	BytesPerKey		The size of each key.
+	 * @param	FixedBytes		The size of the data ahead of the keys.
+	 * @param	RelativePos		Current position within the animation to solve for in the range [0.0,1.0].
+	 * @param	bLooping		True when looping the stream in intended.
+	 * @param	KeyLookups		Key lookups already made for the pose.
+	 * @param	Index0			Output value for the key before RelativePos.
+	 * @param	Index1			Output value for the key after RelativePos.
+	 * @return					The rate at which to interpolate the two keys.
+	 */
+	static float GetTrackKeyIndices(
+		const UAnimSequence& Seq,
+		const uint8* RESTRICT TrackData,
+		int32 NumKeys,
+		int32 FormatFlags,
+		int32 BytesPerKey,
+		int32 FixedBytes,
+		float RelativePos,
+		bool bLooping,
+		FAnimKeyLookupCache& KeyLookups,
+		int32& Index0,
+		int32& Index1);
+
+	/**
+	 * Prefetches the keys of a track which will be interpolated
+	 *
+	 * @param	Seq				The animation sequence to use.
+	 * @param	Offset			The offset of the track in the compressed byte stream, or INDEX_NONE for an identity track.
+	 * @param	RelativePos		Current position within the animation to solve for in the range [0.0,1.0].
+	 * @param	bLooping		True when looping the stream in intended.
+	 * @param	KeyLookups		Key lookups already made for the pose.
+	 * @param	OutKeys			Output value for the keys to interpolate, left alone for an identity track.
+	 */
+	static void PrefetchTrackKeys(
+		const UAnimSequence& Seq,
+		int32 Offset,
+		float RelativePos,
+		bool bLooping,
+		FAnimKeyLookupCache& KeyLookups,
+		FPerTrackKeyIndices& OutKeys);
+
 	/**
 	 * Decompress the Rotation component of a BoneAtom
 	 *
@@ -136,6 +222,8 @@ protected:
 	 * @param	Time			Current time to solve for.
 	 * @param	RelativePos		Current position within the animation to solve for in the range [0.0,1.0].
 	 * @param	bLooping		True when looping the stream in intended.
+	 * @param	KeyLookups		Key lookups already made for the pose.
+	 * @param	KnownKeys		The keys to interpolate if PrefetchTrackKeys already found them, otherwise NULL.
 	 * @return					None. 
 	 */
 	static void GetBoneAtomRotation(	
@@ -144,7 +232,9 @@ protected:
 		int32 Offset,
 		float Time,
 		float RelativePos,
-		bool bLooping);
+		bool bLooping,
+		FAnimKeyLookupCache& KeyLookups,
+		const FPerTrackKeyIndices* KnownKeys = NULL);
 
 	/**
 	 * Decompress the Translation component of a BoneAtom
@@ -156,6 +246,8 @@ protected:
 	 * @param	Time			Current time to solve for.
 	 * @param	RelativePos		Current position within the animation to solve for in the range [0.0,1.0].
 	 * @param	bLooping		True when looping the stream in intended.
+	 * @param	KeyLookups		Key lookups already made for the pose.
+	 * @param	KnownKeys		The keys to interpolate if PrefetchTrackKeys already found them, otherwise NULL.
 	 * @return					None. 
 	 */
 	static void GetBoneAtomTranslation(	
@@ -164,7 +256,9 @@ protected:
 		int32 Offset,
 		float Time,
 		float RelativePos,
-		bool bLooping);
+		bool bLooping,
+		FAnimKeyLookupCache& KeyLookups,
+		const FPerTrackKeyIndices* KnownKeys = NULL);
 
 	/**
 	 * Decompress the Scale component of a BoneAtom
@@ -176,6 +270,8 @@ protected:
 	 * @param	Time			Current time to solve for.
 	 * @param	RelativePos		Current position within the animation to solve for in the range [0.0,1.0].
 	 * @param	bLooping		True when looping the stream in intended.
+	 * @param	KeyLookups		Key lookups already made for the pose.
+	 * @param	KnownKeys		The keys to interpolate if PrefetchTrackKeys already found them, otherwise NULL.
 	 * @return					None. 
 	 */
 	static void GetBoneAtomScale(	
@@ -184,7 +280,9 @@ protected:
 		int32 Offset,
 		float Time,
 		float RelativePos,
-		bool bLooping);
+		bool bLooping,
+		FAnimKeyLookupCache& KeyLookups,
+		const FPerTrackKeyIndices* KnownKeys = NULL);
 };
 
 
@@ -217,6 +315,7 @@ FORCEINLINE_DEBUGGABLE void AEFPerTrackCompressionCodec::GetPoseRotations(
 {
 	const int32 PairCount = DesiredPairs.Num();
 	const float RelativePos = Time / Seq.SequenceLength;
+	FAnimKeyLookupCache KeyLookups;
 
 	for (int32 PairIndex = 0; PairIndex < PairCount; ++PairIndex)
 	{
@@ -228,7 +327,7 @@ FORCEINLINE_DEBUGGABLE void AEFPerTrackCompressionCodec::GetPoseRotations(
 		const int32* RESTRICT TrackData = Seq.CompressedTrackOffsets.GetTypedData() + (TrackIndex*2);
 		const int32 RotKeysOffset	= *(TrackData+1);
 
-		GetBoneAtomRotation(BoneAtom, Seq, RotKeysOffset, Time, RelativePos, bLooping);
+		GetBoneAtomRotation(BoneAtom, Seq, RotKeysOffset, Time, RelativePos, bLooping, KeyLookups);
 	}
 }
 
@@ -251,6 +350,7 @@ FORCEINLINE_DEBUGGABLE void AEFPerTrackCompressionCodec::GetPoseTranslations(
 {
 	const int32 PairCount = DesiredPairs.Num();
 	const float RelativePos = Time / Seq.SequenceLength;
+	FAnimKeyLookupCache KeyLookups;
 
 	for (int32 PairIndex = 0; PairIndex < PairCount; ++PairIndex)
 	{
@@ -262,7 +362,7 @@ FORCEINLINE_DEBUGGABLE void AEFPerTrackCompressionCodec::GetPoseTranslations(
 		const int32* RESTRICT TrackData = Seq.CompressedTrackOffsets.GetTypedData() + (TrackIndex*2);
 		const int32 PosKeysOffset	= *(TrackData+0);
 
-		GetBoneAtomTranslation(BoneAtom, Seq, PosKeysOffset, Time, RelativePos, bLooping);
+		GetBoneAtomTranslation(BoneAtom, Seq, PosKeysOffset, Time, RelativePos, bLooping, KeyLookups);
 	}
 }
 
@@ -287,6 +387,7 @@ FORCEINLINE_DEBUGGABLE void AEFPerTrackCompressionCodec::GetPoseScales(
 
 	const int32 PairCount = DesiredPairs.Num();
 	const float RelativePos = Time / Seq.SequenceLength;
+	FAnimKeyLookupCache KeyLookups;
 
 	for (int32 PairIndex = 0; PairIndex < PairCount; ++PairIndex)
 	{
@@ -297,7 +398,7 @@ FORCEINLINE_DEBUGGABLE void AEFPerTrackCompressionCodec::GetPoseScales(
 
 		const int32 ScaleKeysOffset	= Seq.CompressedScaleOffsets.GetOffsetData(TrackIndex, 0);
 
-		GetBoneAtomScale(BoneAtom, Seq, ScaleKeysOffset, Time, RelativePos, bLooping);
+		GetBoneAtomScale(BoneAtom, Seq, ScaleKeysOffset, Time, RelativePos, bLooping, KeyLookups);
 	}
 }
 
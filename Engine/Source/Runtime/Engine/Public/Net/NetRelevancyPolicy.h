@@ -0,0 +1,92 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetRelevancyPolicy.h:
+	Policies that narrow down the actors UNetDriver::ServerReplicateActors checks for relevancy per connection
+=============================================================================*/
+#pragma once
+
+/** INetRelevancyPolicy
+ *  Picks the actors a connection should consider each net update, so ServerReplicateActors doesn't have to check every
+ *  actor in the consider list against every connection. Set on the net driver with UNetDriver::SetRelevancyPolicy.
+ */
+class INetRelevancyPolicy
+{
+public:
+	virtual ~INetRelevancyPolicy() { }
+
+	/**
+	 * Called once per ServerReplicateActors, after the list of actors that want to replicate this frame has been built
+	 *
+	 * @param World				World the actors are in
+	 * @param ConsiderList		Actors that want to replicate this frame
+	 * @param ConsiderListSize	Number of actors in ConsiderList
+	 */
+	virtual void PrepareForReplication( UWorld * World, AActor ** ConsiderList, int32 ConsiderListSize ) = 0;
+
+	/**
+	 * Gathers the actors of the consider list that could be relevant to the connection
+	 * Must include every actor the connection has an open channel for, so the channel can be updated or closed
+	 *
+	 * @param Connection			Connection being replicated to
+	 * @param Viewers				Viewers of the connection and its children
+	 * @param bSkipDormantActors	If true, actors dormant on the connection are left out
+	 * @param OutActors				Actors to consider for the connection, without duplicates
+	 * @param OutPriorityScales		Scale applied to the replication priority of each actor in OutActors
+	 */
+	virtual void GatherActorsForConnection( UNetConnection * Connection, const TArray< FNetViewer > & Viewers, bool bSkipDormantActors, TArray< AActor * > & OutActors, TArray< float > & OutPriorityScales ) = 0;
+};
+
+/** FSpatialGridRelevancyPolicy
+ *  Buckets actors that are relevant based on distance only into the cells of a 2D grid covering their net cull distance,
+ *  so a connection only needs to look at the cells its viewers are in. Only actors returning true from
+ *  AActor::UsesDistanceBasedNetRelevancy are bucketed, every other actor is considered for every connection.
+ *  Bucketed actors N cells away from the nearest viewer get 1 / (N + 1) of their priority.
+ */
+class ENGINE_API FSpatialGridRelevancyPolicy : public INetRelevancyPolicy
+{
+public:
+	/**
+	 * @param InCellSize			Size of the grid cells in world units
+	 * @param InMaxCellsPerActor	Actors that would cover more cells than this are considered for every connection instead
+	 */
+	FSpatialGridRelevancyPolicy( float InCellSize, int32 InMaxCellsPerActor = 64 );
+
+	// Begin INetRelevancyPolicy interface
+	virtual void PrepareForReplication( UWorld * World, AActor ** ConsiderList, int32 ConsiderListSize ) OVERRIDE;
+	virtual void GatherActorsForConnection( UNetConnection * Connection, const TArray< FNetViewer > & Viewers, bool bSkipDormantActors, TArray< AActor * > & OutActors, TArray< float > & OutPriorityScales ) OVERRIDE;
+	// End INetRelevancyPolicy interface
+
+private:
+	/** @return Cell coordinates containing Location */
+	FIntPoint GetCell( const FVector & Location ) const;
+
+	/**
+	 * Adds the actor to OutActors unless it was already gathered for the current connection, or is dormant on it
+	 *
+	 * @param ActorIndex		Index of the actor in ConsideredActors
+	 * @param ViewerCells		Cells the viewers are in, to scale the priority of grid actors with, or NULL for actors considered for every connection
+	 * @param DormantActors		Actors dormant on the connection that should be left out, or NULL
+	 */
+	FORCEINLINE void GatherActor( int32 ActorIndex, const TArray< FIntPoint > * ViewerCells, const TSet< const AActor * > * DormantActors, TArray< AActor * > & OutActors, TArray< float > & OutPriorityScales );
+
+	float						CellSize;
+	int32						MaxCellsPerActor;
+
+	/** Actors of the consider list, indexed by the cell lists */
+	TArray< AActor * >			ConsideredActors;
+	/** Value of GatherTag when the actor was last gathered, parallel to ConsideredActors */
+	TArray< uint32 >			GatheredTags;
+	/** Index of each actor in ConsideredActors */
+	TMap< AActor *, int32 >		ConsideredActorIndices;
+	/** Cell the location of each grid actor is in, parallel to ConsideredActors */
+	TArray< FIntPoint >			ActorCells;
+
+	/** Indices of the spatially relevant actors covering each cell */
+	TMap< FIntPoint, TArray< int32 > >	Cells;
+	/** Indices of the actors that are considered for every connection */
+	TArray< int32 >				AlwaysConsideredActors;
+
+	/** Incremented for every gather, so actors covering several cells are only gathered once */
+	uint32						GatherTag;
+};
@@ -6,6 +6,8 @@
 =============================================================================*/
 #pragma once
 
+#include "RepMovementDelta.h"
+
 class FRepChangedParent
 {
 public:
@@ -18,6 +20,44 @@ public:
 	uint32				IsConditional	: 1;
 };
 
+class FRepLayout;
+
+/** FRepChangelistState
+ * Stores the change lists of an object that are shared by every connection replicating it
+ * The properties are compared against a shared shadow state once per frame, and each connection merges in the change lists it hasn't seen yet
+ */
+class FRepChangelistState
+{
+public:
+	FRepChangelistState() : 
+		HistoryStart( 0 ), 
+		HistoryEnd( 0 ), 
+		LastCompareFrame( 0 )
+	{ }
+
+	~FRepChangelistState();
+
+	static const int32 MIN_CHANGE_HISTORY = 4;
+	static const int32 MAX_CHANGE_HISTORY = 64;
+
+	// Gets the change list of a history index between HistoryStart and HistoryEnd
+	FORCEINLINE TArray< uint16 > & GetHistoryItem( const int32 HistoryIndex ) { return ChangeHistory[HistoryIndex % ChangeHistory.Num()]; }
+	FORCEINLINE const TArray< uint16 > & GetHistoryItem( const int32 HistoryIndex ) const { return ChangeHistory[HistoryIndex % ChangeHistory.Num()]; }
+
+	// Doubles the size of the history, up to MAX_CHANGE_HISTORY
+	void GrowHistory();
+
+	TSharedPtr< FRepLayout >	RepLayout;
+
+	TArray< uint8 >				StaticBuffer;		// Property state as of the last compare, allocated on the first compare
+
+	TArray< TArray< uint16 > >	ChangeHistory;		// Ring buffer of change lists, grown on demand since most objects only ever need a few
+	int32						HistoryStart;		// Not wrapped, so connections can remember how far they got with HistoryEnd
+	int32						HistoryEnd;
+
+	uint32						LastCompareFrame;	// Replication frame the properties were last compared on
+};
+
 /** FRepChangedPropertyTracker
  * This class is used to store the change list for a group of properties of a particular actor/object
  * This information is shared across connections when possible
@@ -25,7 +65,7 @@ public:
 class FRepChangedPropertyTracker : public IRepChangedPropertyTracker
 {
 public:
-	FRepChangedPropertyTracker() : LastReplicationGroupFrame( 0 ), LastReplicationFrame( 0 ), ActiveStatusChanged( false ), UnconditionalPropChanged( false ) { }
+	FRepChangedPropertyTracker() : ActiveStatusChanged( false ) { }
 	virtual ~FRepChangedPropertyTracker() { }
 
 	virtual void SetCustomIsActiveOverride( const uint16 RepIndex, const bool bIsActive ) OVERRIDE
@@ -44,17 +84,12 @@ public:
 		Parent.OldActive = Parent.Active;
 	}
 
-	uint32						LastReplicationGroupFrame;		// Most recent frame number of the last FRepState that was compared this frame
-	uint32						LastReplicationFrame;
-	class FRepState *			LastRepState;
-
 	TArray< FRepChangedParent >	Parents;
 
 	uint32						ActiveStatusChanged;
-	bool						UnconditionalPropChanged;
-};
 
-class FRepLayout;
+	FRepChangelistState			ChangelistState;
+};
 
 class FRepChangedHistory
 {
@@ -75,7 +110,7 @@ public:
 	FRepState() : 
 		HistoryStart( 0 ), 
 		HistoryEnd( 0 ),
-		LastReplicationFrame( 0 ),
+		LastChangelistIndex( 0 ),
 		NumNaks( 0 ),
 		UnmappedFrames( 0 ),
 		OpenAckedCalled( false ),
@@ -101,7 +136,7 @@ public:
 	int32						HistoryStart;
 	int32						HistoryEnd;
 
-	uint32						LastReplicationFrame;
+	int32						LastChangelistIndex;	// FRepChangelistState::HistoryEnd when we last merged in the shared change lists
 	int32						NumNaks;
 
 	int32						UnmappedFrames;		// Continuous frames that contain unmapped objects, used to warn when we have unmapped objects for too long
@@ -111,9 +146,13 @@ public:
 	bool							OpenAckedCalled;
 	bool							AwakeFromDormancy;
 
-	TArray< uint16 >				ConditionalLifetime;		// Properties the need to be checked conditionally (based on net initial, role, etc)
+	TBitArray<>						InactiveParents;			// Conditional properties that currently don't replicate to this connection (based on net initial, role, etc)
+	TArray< uint16 >				InactiveChangelist;			// Changes to inactive properties, sent once they become active again
+	TArray< uint16 >				ConnectionLifetime;			// Active properties whose value differs between connections, so they are compared against our own shadow state
 	FReplicationFlags				RepFlags;
 	uint32							ActiveStatusChanged;
+
+	FRepMovementDelta				MovementDelta;				// Sent and received states of the movement property, for delta compression
 };
 
 enum ERepLayoutCmdType
@@ -252,9 +291,10 @@ public:
 class FRepLayout
 {
 	friend class FRepState;
+	friend class FRepChangelistState;
 
 public:
-	FRepLayout() : FirstNonCustomParent( 0 ), RoleIndex( -1 ), RemoteRoleIndex( -1 ), Owner( NULL ) {}
+	FRepLayout() : FirstNonCustomParent( 0 ), RoleIndex( -1 ), RemoteRoleIndex( -1 ), MovementCmdIndex( -1 ), Owner( NULL ) {}
 
 	void OpenAcked( FRepState * RepState ) const;
 
@@ -296,14 +336,9 @@ public:
 		int32 &					LastIndex, 
 		bool &					bContentBlockWritten ) const;
 
-	bool GenerateChangelist( FRepState * RepState, const uint8 * Data, TArray< FRepChangedParent > & OutChangedParents ) const;
-
-	void ValidateChangelist(
-		FRepState *							RepState, 
-		const uint8 * 						Data, 
-		UActorChannel *						OwningChannel,
-		FRepState *							OtherRepState,
-		const TArray< FRepChangedParent > &	OtherChangedParents ) const;
+	// Compares the properties against the shadow state shared by all connections, once per replication frame
+	// Only touches the tracker of the object, so it is safe to call for different objects at the same time
+	void UpdateChangelistState( FRepChangedPropertyTracker * ChangeTracker, const uint8 * RESTRICT Data, const uint32 ReplicationFrame ) const;
 
 	void InitFromObjectClass( UClass * InObjectClass );
 
@@ -336,25 +371,12 @@ public:
 private:
 	void RebuildConditionalProperties( FRepState * RESTRICT	RepState, const FRepChangedPropertyTracker & ChangedTracker, const FReplicationFlags & RepFlags ) const;
 
-	void LogChangeListMismatches( 
-		const uint8 * 						Data, 
-		UActorChannel *						OwningChannel, 
-		const TArray< uint16 > &			PropertyList,
-		FRepState *							RepState1, 
-		FRepState * 						RepState2, 
-		const TArray< FRepChangedParent > & ChangedParents1,
-		const TArray< FRepChangedParent > & ChangedParents2 ) const;
-
-	void SanityCheckShadowStateAgainstChangeList(
-		FRepState * 						RepState, 
-		const uint8 * 						Data, 
-		UActorChannel *						OwningChannel, 
-		const TArray< uint16 > &			PropertyList,
-		FRepState *							OtherRepState,
-		const TArray< FRepChangedParent > & OtherChangedParents ) const;
-
 	void UpdateChangelistHistory( FRepState * RepState, UClass * ObjectClass, const uint8 * RESTRICT Data, const int32 AckPacketId, TArray< uint16 > * OutMerged ) const;
 
+	void GatherChangedProperties( FRepState * RepState, FRepChangedPropertyTracker * ChangeTracker, const uint8 * RESTRICT Data, TArray< uint16 > & OutChanged ) const;
+
+	void FilterChangeList( const TArray< uint16 > & Changed, const TBitArray<> & InactiveParents, TArray< uint16 > & OutInactive, TArray< uint16 > & OutActive ) const;
+
 	uint16 CompareProperties_r(
 		const int32				CmdStart,
 		const int32				CmdEnd,
@@ -397,6 +419,7 @@ private:
 		uint16					Handle ) const;
 
 	bool ReadProperty( FRepReaderState & ReaderState, const FRepLayoutCmd & Cmd, const int32 CurrentCmdIndex, uint8 * RESTRICT StoredData, uint8 * RESTRICT Data, const bool bDiscard ) const;
+	bool ReadPropertyValue( FRepReaderState & ReaderState, const FRepLayoutCmd & Cmd, const int32 CmdIndex, uint8 * RESTRICT Value ) const;
 
 	bool ReceiveProperties_AnyArray_r( 
 		FRepReaderState &	ReaderState, 
@@ -486,19 +509,20 @@ private:
 		void *				Data,
 		bool &				bHasUnmapped ) const;
 
-	void ConstructProperties( FRepState * RepState ) const;
-	void InitProperties( FRepState * RepState, uint8 * Src ) const;
-	void DestructProperties( FRepState * RepState ) const;
+	void ConstructProperties( TArray< uint8 > & ShadowData ) const;
+	void InitProperties( TArray< uint8 > & ShadowData, uint8 * Src ) const;
+	void DestructProperties( TArray< uint8 > & ShadowData ) const;
 
 	TArray< FRepParentCmd >		Parents;
 	TArray< FRepLayoutCmd >		Cmds;
 
-	TArray< uint16 >			UnconditionalLifetime;		// Properties that don't need special checks (net initial, role, etc)
 	TArray< FLifetimeProperty >	ConditionalLifetime;		// Properties the need to be checked conditionally (based on net initial, role, etc)
+	TArray< uint16 >			SharedLifetime;				// Properties compared once per frame for all connections, everything but RemoteRole
 
 	int32						FirstNonCustomParent;
 	int32						RoleIndex;
 	int32						RemoteRoleIndex;
+	int32						MovementCmdIndex;			// Top level FRepMovement property that is delta compressed, -1 if there is none
 
 	UObject *					Owner;						// Either a UCkass or UFunction
 };
@@ -0,0 +1,72 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	RepMovementDelta.h:
+	Delta compression of FRepMovement against the last state the connection acked
+=============================================================================*/
+#pragma once
+
+/** FRepMovement rounded to the precision of its quantization levels, the form it is delta compressed in */
+class FQuantizedRepMovement
+{
+public:
+	FQuantizedRepMovement()
+	{
+		FMemory::Memzero( this, sizeof( *this ) );
+	}
+
+	void Quantize( const FRepMovement & Movement );
+	void Dequantize( FRepMovement & OutMovement ) const;
+
+	int32	Location[3];
+	int32	Rotation[3];
+	int32	LinearVelocity[3];
+	int32	AngularVelocity[3];
+	uint8	Flags;
+};
+
+/** A movement state sent to or received from the connection */
+class FRepMovementHistoryItem
+{
+public:
+	FRepMovementHistoryItem() : Sequence( INDEX_NONE ), bCanBeBaseline( false ) {}
+
+	FQuantizedRepMovement	State;
+	FPacketIdRange			OutPacketIdRange;
+	int32					Sequence;
+	bool					bCanBeBaseline;		// False once we know the state may not have been received
+};
+
+/** FRepMovementDelta
+ * Delta compresses the FRepMovement property of an object for one connection
+ * The sender keeps the states it sent, and encodes new ones against the newest state the connection acked, with the
+ * differences bit packed. The receiver keeps the states it received by sequence, so it can decode against whichever
+ * one the sender used.
+ * Only unreliable bunches sent after the channel open was acked can be baselines, since only those are processed as
+ * soon as their packet arrives.
+ */
+class FRepMovementDelta
+{
+public:
+	static const int32 MAX_HISTORY		= 32;
+	static const int32 MAX_SEQUENCE		= 1024;		// Sequences are sent modulo this, must be a multiple of MAX_HISTORY
+
+	FRepMovementDelta();
+
+	/** Forgets all states, called when the object starts replicating on a new channel */
+	void Reset();
+
+	// Sending
+	void UpdateAcked( const int32 AckPacketId );
+	void Write( FArchive & Ar, const FRepMovement & Movement );
+	void PostSend( const FPacketIdRange & PacketRange, const bool bReliable, const bool bOpenAcked );
+	void ReceivedNak( const int32 NakPacketId );
+
+	// Receiving
+	bool Read( FArchive & Ar, FRepMovement & InOutMovement );
+
+private:
+	FRepMovementHistoryItem		History[MAX_HISTORY];	// Indexed by sequence % MAX_HISTORY
+	int32						NextSequence;			// Sender only
+	int32						BaselineSequence;		// Sender only, newest acked sequence or INDEX_NONE
+};
@@ -0,0 +1,236 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ReplayStream.h:
+	File format of the replays recorded by UDemoNetDriver, and the buffered writer and reader for it
+=============================================================================*/
+#pragma once
+
+/**
+ * A replay starts with an FReplayHeader, followed by chunks until the end of the file:
+ *
+ *   uint8	Type		EReplayChunk
+ *   float	Time		Seconds since the start of the recording
+ *   int32	Size		Size of the payload in bytes
+ *   uint8	Payload[Size]
+ *
+ * The payload of a frame chunk is a list of packets, each an int32 size followed by the packet data, exactly as
+ * the recording connection sent them.
+ *
+ * A checkpoint chunk is a snapshot of the replicated state, which is only read when playback jumps to it and
+ * skipped otherwise. It is written with an FArchive:
+ *
+ *   int32			PacketId		Id of the next packet the recording connection sends
+ *   int32			NumSequences	Followed by that many int32 pairs, the channel index and the last reliable
+ *									sequence the recording connection sent on it, for the channels that sent any
+ *   int32			NumGUIDs		Followed by that many static NetGUIDs known to the recording, and their path
+ *   TArray<uint8>	Packets			Packets in the frame format, opening a channel for every actor the recording
+ *									connection has one for, on the same index, and sending its whole state
+ */
+namespace EReplayChunk
+{
+	enum Type
+	{
+		Frame		= 0,
+		Checkpoint	= 1,
+		End			= 2,
+		Max,
+	};
+}
+
+/** Written at the start of every replay */
+struct FReplayHeader
+{
+	enum
+	{
+		/** "UREP" */
+		ReplayMagic		= 0x50455255,
+		/** Bump when the layout of the header or the chunks changes */
+		ReplayVersion	= 2,
+	};
+
+	uint32	Magic;
+	uint32	Version;
+	/** GEngineNetVersion of the recording build, the packets can only be read by a matching build */
+	int32	EngineNetVersion;
+	/** Map the replay was recorded on */
+	FString	MapName;
+
+	FReplayHeader()
+		: Magic(ReplayMagic)
+		, Version(ReplayVersion)
+		, EngineNetVersion(GEngineNetVersion)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FReplayHeader& Header)
+	{
+		Ar << Header.Magic << Header.Version << Header.EngineNetVersion << Header.MapName;
+		return Ar;
+	}
+};
+
+/** Size of the type, time and size fields in front of every chunk */
+#define REPLAY_CHUNK_HEADER_SIZE	(sizeof(uint8) + sizeof(float) + sizeof(int32))
+
+/**
+ * Writes a replay on a background thread.
+ * Chunks are appended to a buffer on the game thread, which is handed over to the writer thread once it is big
+ * enough, so recording never waits for the disk.
+ */
+class ENGINE_API FReplayStreamWriter : public FRunnable
+{
+public:
+	/**
+	 * Opens the file and starts the writer thread
+	 *
+	 * @param Filename			Replay file to create, an existing file is overwritten
+	 * @param Header			Header written at the start of the file
+	 * @param InFlushSize		Bytes buffered on the game thread before they are handed to the writer thread
+	 *
+	 * @return The writer, or NULL if the file could not be created
+	 */
+	static FReplayStreamWriter* Create(const FString& Filename, FReplayHeader& Header, int32 InFlushSize);
+
+	/** Writes everything that is still buffered, then stops the thread and closes the file */
+	virtual ~FReplayStreamWriter();
+
+	/** Appends a chunk, the payload is copied */
+	void WriteChunk(EReplayChunk::Type Type, float Time, const TArray<uint8>& Payload);
+
+	/** Hands everything buffered so far to the writer thread */
+	void Flush();
+
+	/** @return Total number of bytes written to the replay so far, including the ones not on disk yet */
+	int64 GetTotalBytes() const
+	{
+		return TotalBytes;
+	}
+
+	// FRunnable interface.
+	virtual bool Init() OVERRIDE { return true; }
+	virtual uint32 Run() OVERRIDE;
+	virtual void Stop() OVERRIDE;
+	virtual void Exit() OVERRIDE {}
+
+private:
+	FReplayStreamWriter(FArchive* InFileAr, int32 InFlushSize);
+
+	/** Replay file, only used by the writer thread once it was started */
+	FArchive*			FileAr;
+	FRunnableThread*	Thread;
+	/** Triggered when data was queued, or the thread needs to stop */
+	FEvent*				WorkEvent;
+
+	/** Bytes buffered before Flush is called */
+	int32				FlushSize;
+	int64				TotalBytes;
+
+	/** Chunks appended on the game thread since the last flush */
+	TArray<uint8>		GameThreadBuffer;
+
+	/** Protects QueuedBuffer and bStopping */
+	FCriticalSection	QueueCriticalSection;
+	/** Data handed to the writer thread, not written yet */
+	TArray<uint8>		QueuedBuffer;
+	bool				bStopping;
+
+	/** Data being written by the writer thread, swapped with QueuedBuffer so neither buffer is reallocated */
+	TArray<uint8>		WritingBuffer;
+};
+
+/** Position of a checkpoint chunk in a replay */
+struct FReplayCheckpoint
+{
+	/** Offset of the checkpoint chunk in the file, INDEX_NONE for the start of the replay, which has no snapshot */
+	int64	ChunkOffset;
+	/** Offset of the chunk following the checkpoint in the file */
+	int64	Offset;
+	float	Time;
+
+	FReplayCheckpoint(int64 InChunkOffset, int64 InOffset, float InTime)
+		: ChunkOffset(InChunkOffset)
+		, Offset(InOffset)
+		, Time(InTime)
+	{
+	}
+};
+
+/**
+ * Reads a replay for playback.
+ * Open scans the chunk headers once to find the checkpoints and the length of the replay, the payloads are only
+ * read while playing.
+ */
+class ENGINE_API FReplayStreamReader
+{
+public:
+	~FReplayStreamReader();
+
+	/**
+	 * Opens the replay and builds the checkpoint index
+	 *
+	 * @param Filename			Replay to open
+	 * @param Error				Set to the reason the replay can't be played on failure
+	 *
+	 * @return The reader, or NULL if the replay can't be played
+	 */
+	static FReplayStreamReader* Open(const FString& Filename, FString& Error);
+
+	const FReplayHeader& GetHeader() const
+	{
+		return Header;
+	}
+
+	/** @return Time of the last chunk in the replay */
+	float GetTotalTime() const
+	{
+		return TotalTime;
+	}
+
+	/** @return Checkpoints sorted by time, there is always one at the start of the replay */
+	const TArray<FReplayCheckpoint>& GetCheckpoints() const
+	{
+		return Checkpoints;
+	}
+
+	/** @return Index of the last checkpoint at or before Time */
+	int32 FindCheckpoint(float Time) const;
+
+	/**
+	 * Reads the snapshot of a checkpoint, and continues reading at the chunk following it
+	 *
+	 * @param CheckpointIndex	Checkpoint to jump to
+	 * @param OutSnapshot		Set to the payload of the checkpoint chunk, empty for the start of the replay
+	 *
+	 * @return false if the checkpoint chunk couldn't be read
+	 */
+	bool SeekToCheckpoint(int32 CheckpointIndex, TArray<uint8>& OutSnapshot);
+
+	/**
+	 * Returns the header of the next chunk without consuming it
+	 *
+	 * @return false at the end of the replay
+	 */
+	bool PeekChunk(EReplayChunk::Type& OutType, float& OutTime);
+
+	/** Reads the next chunk, the payload is read into OutPayload */
+	bool ReadChunk(EReplayChunk::Type& OutType, float& OutTime, TArray<uint8>& OutPayload);
+
+	/** Moves past the next chunk without reading its payload */
+	bool SkipChunk();
+
+private:
+	FReplayStreamReader(FArchive* InFileAr);
+
+	/** Reads a chunk header at the current position, fails on a truncated or corrupted chunk */
+	bool ReadChunkHeader(uint8& OutType, float& OutTime, int32& OutSize);
+
+	FArchive*					FileAr;
+	FReplayHeader				Header;
+	/** Offset of the first chunk */
+	int64						FirstChunkOffset;
+	/** Offset the last complete chunk ends at, anything after it was cut off while recording */
+	int64						EndOffset;
+	float						TotalTime;
+	TArray<FReplayCheckpoint>	Checkpoints;
+};
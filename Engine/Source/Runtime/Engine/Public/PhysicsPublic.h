@@ -24,6 +24,7 @@ DECLARE_CYCLE_STAT_EXTERN(TEXT("Phys SetBodyTransform"),STAT_SetBodyTransform,ST
 namespace physx
 {
 	class PxScene;
+	class PxRigidDynamic;
 	class PxConvexMesh;
 	class PxTriangleMesh;
 	class PxCooking;
@@ -269,6 +270,9 @@ private:
 	/** Completion events (task) for the physics scenes	(both apex and non-apex). This is a "join" of the above. */
 	FGraphEventRef PhysicsSceneCompletion;
 
+	/** Whether the sync scene was started this frame to run across the frame, with its results used next frame. */
+	bool bSyncSceneFrameLagged;
+
 #if WITH_PHYSX
 	/** Dispatcher for CPU tasks */
 	class PxCpuDispatcher*			CPUDispatcher;
@@ -276,6 +280,8 @@ private:
 	class FPhysXSimEventCallback*			SimEventCallback;
 	/** Vehicle scene */
 	class FPhysXVehicleManager*			VehicleManager;
+	/** Batch queries of the UWorld batch traces, for each scene type */
+	class FPhysXBatchTraceQueries*		BatchTraceQueries[PST_MAX];
 #endif	//
 
 public:
@@ -286,6 +292,9 @@ public:
 
 	/** Get the vehicle manager */
 	FPhysXVehicleManager*						GetVehicleManager();
+
+	/** Get the batch queries of the UWorld batch traces for the given EPhysicsSceneType, created on first use. Game thread only. */
+	FPhysXBatchTraceQueries*					GetBatchTraceQueries(uint32 SceneType);
 #endif
 
 #if WITH_APEX
@@ -365,6 +374,20 @@ public:
 	/** Sets a Kinematic actor's target position - We need to do this here to support substepping*/
 	void SetKinematicTarget(FBodyInstance * BodyInstance, const FTransform & TargetTM);
 
+	/**
+	 * Moves bodies of the sync scene to their recorded state at a past time, so that hits against them can be validated as of that time.
+	 * The bodies stay there until RestoreRewoundBodies is called, which has to happen before the scene is stepped again.
+	 * Needs p.PhysicsSnapshotHistory to cover the time, and the sync scene not to be simulating.
+	 * @param Bodies - The bodies to move.
+	 * @param NumBodies - The number of bodies.
+	 * @param Time - World time to move the bodies back to, states are interpolated between the snapshots around it.
+	 * @return The number of bodies which were recorded at that time and have been moved.
+	 */
+	ENGINE_API int32 RewindBodies(FBodyInstance* const* Bodies, int32 NumBodies, float Time);
+
+	/** Puts all bodies moved by RewindBodies back into their current state */
+	ENGINE_API void RestoreRewoundBodies();
+
 	/** Gets the collision disable table */
 	const TMap<uint32, TMap<struct FRigidBodyIndexPair, bool> *> & GetCollisionDisableTableLookup()
 	{
@@ -418,6 +441,95 @@ private:
 		TMap<struct FRigidBodyIndexPair, bool>* CollisionDisableTable;
 	};
 
+	/** A force, torque or kinematic target command for a body in a scene that is simulating across the frame */
+	struct FPendingBodyCommand
+	{
+		enum EType
+		{
+			Force,
+			ForceAtPosition,
+			Torque,
+			KinematicTarget
+		};
+
+		FPendingBodyCommand(FBodyInstance* InBodyInstance, EType InType, const FVector& InVector, const FTransform& InTransform = FTransform::Identity)
+			: BodyInstance(InBodyInstance)
+			, Type(InType)
+			, Vector(InVector)
+			, Transform(InTransform)
+		{
+		}
+
+		FBodyInstance* BodyInstance;
+		EType Type;
+		/** Force or torque, unused by kinematic targets */
+		FVector Vector;
+		/** Position of the force, or target of the kinematic body */
+		FTransform Transform;
+	};
+
+	/** Commands for the frame lagged sync scene, gathered during the frame and applied before the scene is stepped again */
+	TArray<FPendingBodyCommand> DeferredBodyCommandQueue;
+
+	/** @return Whether commands for the body have to be deferred because its scene is simulating across the frame */
+	bool ShouldDeferBodyCommand(FBodyInstance* BodyInstance) const;
+
+	/** Applies the commands gathered during the frame the sync scene was simulating across */
+	void FlushDeferredBodyCommands();
+
+	/** Waits for the sync scene started last frame, and moves components to its results */
+	void FinishFrameLaggedSyncScene();
+
+	/** World time the step of the sync scene started this frame ends at */
+	float SyncSceneStepTime;
+
+	/** Records the state of the dynamic bodies in the sync scene into the snapshot ring buffer, called after each step */
+	void RecordBodySnapshot(float Time);
+
+#if WITH_PHYSX
+	/** The state of a set of bodies, as parallel arrays sorted by actor */
+	struct FBodySnapshot
+	{
+		/** World time of the state */
+		float Time;
+
+		TArray<physx::PxRigidDynamic*> Actors;
+		/** Owners of the actors, so an actor released and reallocated at the same address as another body's is not mistaken for it */
+		TArray<FBodyInstance*> BodyInstances;
+		TArray<FVector> Positions;
+		TArray<FQuat> Rotations;
+		TArray<FVector> LinearVelocities;
+		TArray<FVector> AngularVelocities;
+
+		/** Empties the arrays, keeping their memory for the next use */
+		void Reset();
+
+		/** Appends a body, Find needs the actors to be appended in sorted order */
+		void Add(physx::PxRigidDynamic* Actor, FBodyInstance* BodyInstance, const FVector& Position, const FQuat& Rotation, const FVector& LinearVelocity, const FVector& AngularVelocity);
+
+		/** Removes every entry of a body, keeping the order of the rest */
+		void Remove(FBodyInstance* BodyInstance);
+
+		/** @return The index of the body's actor, or INDEX_NONE if it was not recorded */
+		int32 Find(physx::PxRigidDynamic* Actor, FBodyInstance* BodyInstance) const;
+	};
+
+	/** Ring buffer of the states after the most recent steps of the sync scene */
+	TArray<FBodySnapshot> BodySnapshots;
+
+	/** Index of the most recent snapshot in BodySnapshots */
+	int32 NewestBodySnapshot;
+
+	/** Number of valid snapshots, ending at NewestBodySnapshot */
+	int32 NumBodySnapshots;
+
+	/** Actors of the sync scene as returned by PhysX, kept between snapshots so recording one doesn't allocate */
+	TArray<physx::PxActor*> BodySnapshotActorBuffer;
+
+	/** The state to put back into the bodies moved by RewindBodies, in the order they were moved */
+	FBodySnapshot RewoundBodies;
+#endif
+
 	/** Updates CollisionDisableTableLookup with the deferred insertion and deletion */
 	void FlushDeferredCollisionDisableTableQueue();
 
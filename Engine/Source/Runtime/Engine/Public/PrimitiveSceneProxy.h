@@ -19,6 +19,14 @@ public:
 	bool bAffectTranslucency;
 };
 
+/** Low poly triangles in local space that are rendered into the software occlusion buffer to hide the primitives behind them. */
+class FOccluderMeshData
+{
+public:
+	TArray<FVector> Vertices;
+	TArray<uint32> Indices;
+};
+
 namespace EDrawDynamicFlags
 {
 	enum Type
@@ -312,6 +320,19 @@ public:
 		return GetBounds();
 	}
 
+	/**
+	 *	Returns the triangles the primitive occludes other primitives with in software occlusion culling.
+	 *	They must not cover anything the primitive does not, and must stay valid for the lifetime of the proxy.
+	 *	Proxies that deform or instance their mesh must return NULL, since the triangles are only transformed by the local to world matrix,
+	 *	as must proxies with masked or translucent materials, which can be seen through.
+	 *
+	 *	@return	const FOccluderMeshData*	The occluder triangles in local space, or NULL if the primitive is not an occluder.
+	 */
+	virtual const FOccluderMeshData* GetOccluderMeshData() const
+	{
+		return NULL;
+	}
+
 	/** 
 	 * Drawing helper. Draws nice bouncy line.
 	 */
@@ -2484,6 +2484,9 @@ struct FSceneViewInitOptions : public FSceneViewProjectionData
 	// Was there a camera cut this frame?
 	bool bInCameraCut;
 
+	/** Whether to cull the view by walking the scene's primitive octree rather than testing every primitive, see FSceneView::bUseHierarchicalCulling. */
+	bool bUseHierarchicalCulling;
+
 #if WITH_EDITOR
 	// default to 0'th view index, which is a bitfield of 1
 	uint64 EditorViewBitflag;
@@ -2508,6 +2511,7 @@ struct FSceneViewInitOptions : public FSceneViewProjectionData
 		, LODDistanceFactor(1.0f)
 		, OverrideFarClippingPlaneDistance(-1.0f)
 		, bInCameraCut(false)
+		, bUseHierarchicalCulling(false)
 #if WITH_EDITOR
 		, EditorViewBitflag(1)
 		, OverrideLODViewOrigin(ForceInitToZero)
@@ -2643,6 +2647,12 @@ public:
 	/** Whether this view is being used to render a reflection capture. */
 	bool bIsReflectionCapture;
 
+	/**
+	 * Whether to cull the view by walking the scene's primitive octree, which skips whole nodes outside the frustum.
+	 * Faster than testing every primitive for large, sparse scenes where the view sees a small part. Also enabled for every view by r.HierarchicalCulling.
+	 */
+	bool bUseHierarchicalCulling;
+
 	/** 0 if valid (we are rendering a screen postprocess pass )*/
 	struct FRenderingCompositePassContext* RenderingCompositePassContext; 
 
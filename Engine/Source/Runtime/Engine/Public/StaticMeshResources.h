@@ -614,6 +614,9 @@ public:
 	/** True if the mesh or LODs were reduced using Simplygon. */
 	bool bReducedBySimplygon;
 
+	/** Triangles of UStaticMesh::LODForOccluderMesh kept on the CPU for software occlusion culling, empty if the mesh is not an occluder. */
+	FOccluderMeshData OccluderData;
+
 #if WITH_EDITORONLY_DATA
 	/** The derived data key associated with this render data. */
 	FString DerivedDataKey;
@@ -637,6 +640,9 @@ public:
 	/** Serialization. */
 	void Serialize(FArchive& Ar, UStaticMesh* Owner, bool bCooked);
 
+	/** Copies the triangles of an LOD to OccluderData, must be called before InitResources as that may discard the CPU copy of the vertices. */
+	void InitOccluderData(int32 LODIndex);
+
 	/** Initialize the render resources. */
 	void InitResources(UStaticMesh* Owner);
 
@@ -756,6 +762,7 @@ public:
 	virtual int32 GetLOD(const FSceneView* View) const OVERRIDE;
 	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) OVERRIDE;
 	virtual bool CanBeOccluded() const OVERRIDE;
+	virtual const FOccluderMeshData* GetOccluderMeshData() const OVERRIDE;
 	virtual void GetLightRelevance(const FLightSceneProxy* LightSceneProxy, bool& bDynamic, bool& bRelevant, bool& bLightMapped, bool& bShadowMapped) const OVERRIDE;
 	virtual uint32 GetMemoryFootprint( void ) const OVERRIDE { return( sizeof( *this ) + GetAllocatedSize() ); }
 	uint32 GetAllocatedSize( void ) const { return( FPrimitiveSceneProxy::GetAllocatedSize() + LODs.GetAllocatedSize() ); }
@@ -205,6 +205,21 @@ struct FCollisionShape
 	}
 };
 
+/** A ray or sweep of a batch trace, see UWorld::BatchLineTraceSingle **/
+struct FBatchTraceQuery
+{
+	FVector Start;
+	FVector End;
+
+	FBatchTraceQuery() {}
+
+	FBatchTraceQuery(const FVector& InStart, const FVector& InEnd)
+		: Start(InStart)
+		, End(InEnd)
+	{
+	}
+};
+
 /** Trace Shape Shapes - Params packs all possible shape types **/
 struct FCollisionParameters
 {
@@ -7,6 +7,14 @@
 #pragma once
 #include "IpNetDriver.generated.h"
 
+/** A datagram queued by UIpNetDriver::QueueDatagram, its data is in UIpNetDriver::PendingDatagramData */
+struct FIpPendingDatagram
+{
+	int32 Offset;
+	int32 Size;
+	TSharedPtr<FInternetAddr> Address;
+};
+
 UCLASS(transient, config=Engine)
 class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 {
@@ -24,12 +32,22 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 	UPROPERTY(Config)
 	uint32 MaxPortCountToTry;
 
+	/** Receive and send several datagrams per system call (recvmmsg/sendmmsg), when the socket supports it. Sends are queued and flushed once per tick */
+	UPROPERTY(Config)
+	uint32 BatchDatagrams:1;
+
 	/** Local address this net driver is associated with */
 	TSharedPtr<FInternetAddr> LocalAddr;
 
 	/** Underlying socket communication */
 	FSocket* Socket;
 
+	/** Datagrams queued this tick, sent by FlushDatagrams */
+	TArray<FIpPendingDatagram> PendingDatagrams;
+
+	/** Data of all the queued datagrams */
+	TArray<uint8> PendingDatagramData;
+
 	// Begin UNetDriver interface.
 	virtual bool IsAvailable() const OVERRIDE;
 	virtual bool InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error) OVERRIDE;
@@ -37,6 +55,7 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 	virtual bool InitListen( FNetworkNotify* InNotify, FURL& LocalURL, bool bReuseAddressAndPort, FString& Error ) OVERRIDE;
 	virtual void ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject * SubObject = NULL) OVERRIDE;
 	virtual void TickDispatch( float DeltaTime ) OVERRIDE;
+	virtual void TickFlush( float DeltaSeconds ) OVERRIDE;
 	virtual FString LowLevelGetNetworkNumber() OVERRIDE;
 	virtual void LowLevelDestroy() OVERRIDE;
 	virtual class ISocketSubsystem* GetSocketSubsystem() OVERRIDE;
@@ -57,4 +76,46 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 
 	/** @return TCPIP connection to server */
 	UIpConnection* GetServerConnection();
+
+	/** @return true if sends should be queued with QueueDatagram rather than sent right away */
+	bool IsBatchingDatagrams() const
+	{
+		return BatchDatagrams && Socket != NULL && Socket->HasNativeDatagramBatching();
+	}
+
+	/**
+	 * Queues a datagram to be sent on the driver socket by the next FlushDatagrams
+	 *
+	 * @param Data the data to send
+	 * @param Count the number of bytes to send
+	 * @param Address the address to send to
+	 */
+	void QueueDatagram( const uint8* Data, int32 Count, const TSharedPtr<FInternetAddr>& Address );
+
+	/** Sends all the queued datagrams with as few system calls as possible */
+	void FlushDatagrams();
+
+protected:
+
+	/** @return the connection talking to Address, NULL if there isn't any */
+	UIpConnection* FindConnection( const FInternetAddr& Address );
+
+	/**
+	 * Hands a received datagram to the connection it came from, accepting a new connection if needed
+	 *
+	 * @param Data the datagram
+	 * @param Count the size of the datagram
+	 * @param FromAddr the address the datagram came from
+	 */
+	void ProcessReceivedDatagram( uint8* Data, int32 Count, const FInternetAddr& FromAddr );
+
+	/**
+	 * Handles an ICMP port unreachable error received from an address, closing the connection to it if needed
+	 *
+	 * @param FromAddr the address that can't be reached
+	 */
+	void ProcessPortUnreachable( const FInternetAddr& FromAddr );
+
+	/** Receives the pending datagrams with RecvFromMulti */
+	void TickDispatchBatched();
 };
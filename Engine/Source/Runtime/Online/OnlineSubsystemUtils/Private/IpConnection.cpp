@@ -128,6 +128,14 @@ void UIpConnection::LowLevelSend( void* Data, int32 Count )
 			ResolveInfo = NULL;
 		}
 	}
+	// Leave the packets sent on the driver socket to the driver, it sends them all at once when it flushes
+	UIpNetDriver* IpDriver = Cast<UIpNetDriver>(Driver);
+	if( IpDriver && IpDriver->Socket == Socket && IpDriver->IsBatchingDatagrams() )
+	{
+		IpDriver->QueueDatagram((uint8*)Data, Count, RemoteAddr);
+		return;
+	}
+
 	// Send to remote.
 	int32 BytesSent = 0;
 	CLOCK_CYCLES(Driver->SendCycles);
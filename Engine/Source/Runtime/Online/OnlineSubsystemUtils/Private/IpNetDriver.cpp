@@ -11,6 +11,7 @@ Notes:
 
 #include "IPAddress.h"
 #include "Sockets.h"
+#include "Net/NetworkProfiler.h"
 
 /*-----------------------------------------------------------------------------
 	Declarations.
@@ -19,6 +20,9 @@ Notes:
 /** Size of the network recv buffer */
 #define NETWORK_MAX_PACKET (576)
 
+/** Max number of datagrams read by a single RecvFromMulti call */
+#define NETWORK_MAX_RECV_BATCH (32)
+
 UIpNetDriver::UIpNetDriver(const class FPostConstructInitializeProperties& PCIP)
 	: Super(PCIP)
 {
@@ -147,10 +151,103 @@ bool UIpNetDriver::InitListen( FNetworkNotify* InNotify, FURL& LocalURL, bool bR
 	return true;
 }
 
+UIpConnection* UIpNetDriver::FindConnection( const FInternetAddr& Address )
+{
+	if (GetServerConnection() && (*GetServerConnection()->RemoteAddr == Address))
+	{
+		return GetServerConnection();
+	}
+	for( int32 i=0; i<ClientConnections.Num(); i++ )
+	{
+		UIpConnection* TestConnection = (UIpConnection*)ClientConnections[i]; 
+		check(TestConnection);
+		if(*TestConnection->RemoteAddr == Address)
+		{
+			return TestConnection;
+		}
+	}
+	return NULL;
+}
+
+void UIpNetDriver::ProcessReceivedDatagram( uint8* Data, int32 Count, const FInternetAddr& FromAddr )
+{
+	// Figure out which socket the received data came from.
+	UIpConnection* Connection = FindConnection(FromAddr);
+
+	// If we didn't find a client connection, maybe create a new one.
+	if( !Connection )
+	{
+		// Determine if allowing for client/server connections
+		const bool bAcceptingConnection = Notify->NotifyAcceptingConnection() == EAcceptConnection::Accept;
+
+		if (bAcceptingConnection)
+		{
+			Connection = ConstructObject<UIpConnection>(NetConnectionClass);
+			check(Connection);
+			Connection->InitRemoteConnection( this, Socket,  FURL(), FromAddr, USOCK_Open);
+			Notify->NotifyAcceptedConnection( Connection );
+			AddClientConnection(Connection);
+		}
+	}
+
+	// Send the packet to the connection for processing.
+	if( Connection )
+	{
+		Connection->ReceivedRawPacket( Data, Count );
+	}
+}
+
+void UIpNetDriver::ProcessPortUnreachable( const FInternetAddr& FromAddr )
+{
+	UIpConnection* Connection = FindConnection(FromAddr);
+	if( Connection )
+	{
+		if( Connection != GetServerConnection() )
+		{
+			// We received an ICMP port unreachable from the client, meaning the client is no longer running the game
+			// (or someone is trying to perform a DoS attack on the client)
+
+			// rcg08182002 Some buggy firewalls get occasional ICMP port
+			// unreachable messages from legitimate players. Still, this code
+			// will drop them unceremoniously, so there's an option in the .INI
+			// file for servers with such flakey connections to let these
+			// players slide...which means if the client's game crashes, they
+			// might get flooded to some degree with packets until they timeout.
+			// Either way, this should close up the usual DoS attacks.
+			if ((Connection->State != USOCK_Open) || (!AllowPlayerPortUnreach))
+			{
+				if (LogPortUnreach)
+				{
+					UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from client %s.  Disconnecting."),
+						*FromAddr.ToString(true));
+				}
+				Connection->CleanUp();
+			}
+		}
+	}
+	else
+	{
+		if (LogPortUnreach)
+		{
+			UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from %s.  No matching connection found."),
+				*FromAddr.ToString(true));
+		}
+	}
+}
+
 void UIpNetDriver::TickDispatch( float DeltaTime )
 {
 	Super::TickDispatch( DeltaTime );
 
+	if (IsBatchingDatagrams())
+	{
+		TickDispatchBatched();
+
+		// Send the replies queued while processing the packets (acks, handshakes) without waiting for TickFlush
+		FlushDatagrams();
+		return;
+	}
+
 	ISocketSubsystem* SocketSubsystem = GetSocketSubsystem();
 
 	// Process all incoming packets.
@@ -184,84 +281,125 @@ void UIpNetDriver::TickDispatch( float DeltaTime )
 					break;
 				}
 			}
+			ProcessPortUnreachable(*FromAddr);
 		}
-		// Figure out which socket the received data came from.
-		UIpConnection* Connection = NULL;
-		if (GetServerConnection() && (*GetServerConnection()->RemoteAddr == *FromAddr))
+		else
 		{
-			Connection = GetServerConnection();
+			ProcessReceivedDatagram(Data, BytesRead, *FromAddr);
 		}
-		for( int32 i=0; i<ClientConnections.Num() && !Connection; i++ )
+	}
+}
+
+void UIpNetDriver::TickDispatchBatched()
+{
+	ISocketSubsystem* SocketSubsystem = GetSocketSubsystem();
+
+	// Process all incoming packets, NETWORK_MAX_RECV_BATCH at a time.
+	uint8 Data[NETWORK_MAX_RECV_BATCH][NETWORK_MAX_PACKET];
+	TArray< TSharedRef<FInternetAddr>, TInlineAllocator<NETWORK_MAX_RECV_BATCH> > FromAddrs;
+	FSocketDatagram Datagrams[NETWORK_MAX_RECV_BATCH];
+	for( int32 i=0; i<NETWORK_MAX_RECV_BATCH; i++ )
+	{
+		FromAddrs.Add(SocketSubsystem->CreateInternetAddr());
+		Datagrams[i].Data = Data[i];
+		Datagrams[i].Size = NETWORK_MAX_PACKET;
+		Datagrams[i].Address = &FromAddrs[i].Get();
+	}
+
+	for( ; Socket != NULL; )
+	{
+		// An error is always reported for the first datagram of a call, clear its address so it can't be left over from the previous batch
+		FromAddrs[0]->SetIp(0u);
+		FromAddrs[0]->SetPort(0);
+
+		CLOCK_CYCLES(RecvCycles);
+		const int32 NumReceived = Socket->RecvFromMulti(Datagrams, NETWORK_MAX_RECV_BATCH);
+		UNCLOCK_CYCLES(RecvCycles);
+
+		if( NumReceived < 0 )
 		{
-			UIpConnection* TestConnection = (UIpConnection*)ClientConnections[i]; 
-            check(TestConnection);
-			if(*TestConnection->RemoteAddr == *FromAddr)
+			ESocketErrors Error = SocketSubsystem->GetLastErrorCode();
+			if(Error == SE_EWOULDBLOCK ||
+			   Error == SE_NO_ERROR)
 			{
-				Connection = TestConnection;
+				// No data or no error?
+				break;
 			}
-		}
-
-		if( bOk == false )
-		{
-			if( Connection )
+			if( Error != SE_ECONNRESET && Error != SE_UDP_ERR_PORT_UNREACH )
 			{
-				if( Connection != GetServerConnection() )
-				{
-					// We received an ICMP port unreachable from the client, meaning the client is no longer running the game
-					// (or someone is trying to perform a DoS attack on the client)
-
-					// rcg08182002 Some buggy firewalls get occasional ICMP port
-					// unreachable messages from legitimate players. Still, this code
-					// will drop them unceremoniously, so there's an option in the .INI
-					// file for servers with such flakey connections to let these
-					// players slide...which means if the client's game crashes, they
-					// might get flooded to some degree with packets until they timeout.
-					// Either way, this should close up the usual DoS attacks.
-					if ((Connection->State != USOCK_Open) || (!AllowPlayerPortUnreach))
-					{
-						if (LogPortUnreach)
-						{
-							UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from client %s.  Disconnecting."),
-								*FromAddr->ToString(true));
-						}
-						Connection->CleanUp();
-					}
-				}
+				UE_LOG(LogNet, Warning, TEXT("UDP recvmmsg error: %i (%s)"),
+					(int32)Error,
+					SocketSubsystem->GetSocketError(Error));
+				break;
 			}
-			else
+			// Like the single datagram path, the address is the one the socket reported for the failing datagram, if any
+			if( FromAddrs[0]->IsValid() )
 			{
-				if (LogPortUnreach)
-				{
-					UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from %s.  No matching connection found."),
-						*FromAddr->ToString(true));
-				}
+				ProcessPortUnreachable(*FromAddrs[0]);
 			}
+			continue;
 		}
-		else
+
+		for( int32 i=0; i<NumReceived && Socket != NULL; i++ )
 		{
-			// If we didn't find a client connection, maybe create a new one.
-			if( !Connection )
-			{
-				// Determine if allowing for client/server connections
-				const bool bAcceptingConnection = Notify->NotifyAcceptingConnection() == EAcceptConnection::Accept;
+			ProcessReceivedDatagram(Data[i], Datagrams[i].BytesTransferred, *FromAddrs[i]);
+		}
 
-				if (bAcceptingConnection)
-				{
-					Connection = ConstructObject<UIpConnection>(NetConnectionClass);
-                    check(Connection);
-					Connection->InitRemoteConnection( this, Socket,  FURL(), *FromAddr, USOCK_Open);
-					Notify->NotifyAcceptedConnection( Connection );
-					AddClientConnection(Connection);
-				}
-			}
+		// A partial batch means the socket has been drained
+		if( NumReceived < NETWORK_MAX_RECV_BATCH )
+		{
+			break;
+		}
+	}
+}
 
-			// Send the packet to the connection for processing.
-			if( Connection )
-			{
-				Connection->ReceivedRawPacket( Data, BytesRead );
-			}
+void UIpNetDriver::TickFlush( float DeltaSeconds )
+{
+	// Connections queue their packets while they are ticked, send them all at once
+	Super::TickFlush( DeltaSeconds );
+
+	FlushDatagrams();
+}
+
+void UIpNetDriver::QueueDatagram( const uint8* Data, int32 Count, const TSharedPtr<FInternetAddr>& Address )
+{
+	FIpPendingDatagram& Datagram = *new(PendingDatagrams) FIpPendingDatagram;
+	Datagram.Offset = PendingDatagramData.Num();
+	Datagram.Size = Count;
+	Datagram.Address = Address;
+	PendingDatagramData.Append(Data, Count);
+}
+
+void UIpNetDriver::FlushDatagrams()
+{
+	if( PendingDatagrams.Num() == 0 )
+	{
+		return;
+	}
+
+	if( Socket != NULL )
+	{
+		TArray< FSocketDatagram, TInlineAllocator<64> > Datagrams;
+		Datagrams.AddZeroed(PendingDatagrams.Num());
+		for( int32 i=0; i<PendingDatagrams.Num(); i++ )
+		{
+			Datagrams[i].Data = PendingDatagramData.GetTypedData() + PendingDatagrams[i].Offset;
+			Datagrams[i].Size = PendingDatagrams[i].Size;
+			Datagrams[i].Address = PendingDatagrams[i].Address.Get();
+		}
+
+		CLOCK_CYCLES(SendCycles);
+		Socket->SendToMulti(Datagrams.GetTypedData(), Datagrams.Num());
+		UNCLOCK_CYCLES(SendCycles);
+
+		for( int32 i=0; i<Datagrams.Num(); i++ )
+		{
+			NETWORK_PROFILER(GNetworkProfiler.TrackSocketSendTo(Socket->GetDescription(),Datagrams[i].Data,Datagrams[i].BytesTransferred,*Datagrams[i].Address));
 		}
 	}
+
+	PendingDatagrams.Reset();
+	PendingDatagramData.Reset();
 }
 
 void UIpNetDriver::ProcessRemoteFunction(class AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, class UObject * SubObject )
@@ -336,6 +474,11 @@ void UIpNetDriver::LowLevelDestroy()
 {
 	Super::LowLevelDestroy();
 
+	// Send what is still queued (like the close bunches of the connections) while the socket is open
+	FlushDatagrams();
+	PendingDatagrams.Empty();
+	PendingDatagramData.Empty();
+
 	// Close the socket.
 	if( Socket && !HasAnyFlags(RF_ClassDefaultObject) )
 	{
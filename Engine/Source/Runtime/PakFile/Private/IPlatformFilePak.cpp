@@ -31,6 +31,11 @@ bool FPakEntry::VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEnt
 		UE_LOG(LogPakFile, Error, TEXT("Pak header file compression method mismatch, got: %d, expected: %d"), FileEntryB.CompressionMethod, FileEntryA.CompressionMethod);
 		bResult = false;
 	}
+	if (FileEntryA.CompressionBlockSize != FileEntryB.CompressionBlockSize || FileEntryA.CompressionBlocks != FileEntryB.CompressionBlocks)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Pak header file compression blocks mismatch, got: %d blocks of %u bytes, expected: %d blocks of %u bytes"), FileEntryB.CompressionBlocks.Num(), FileEntryB.CompressionBlockSize, FileEntryA.CompressionBlocks.Num(), FileEntryA.CompressionBlockSize);
+		bResult = false;
+	}
 	if (FMemory::Memcmp(FileEntryA.Hash, FileEntryB.Hash, sizeof(FileEntryA.Hash)) != 0)
 	{
 		UE_LOG(LogPakFile, Error, TEXT("Pak file hash does not match its index entry"));
@@ -39,10 +44,105 @@ bool FPakEntry::VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEnt
 	return bResult;
 }
 
+bool FPakEntry::HasValidCompressionBlocks(int64 PakFileSize) const
+{
+	if (CompressionBlockSize == 0 || UncompressedSize < 0)
+	{
+		return false;
+	}
+	const int64 ExpectedBlockCount = (UncompressedSize + CompressionBlockSize - 1) / CompressionBlockSize;
+	if (CompressionBlocks.Num() != ExpectedBlockCount)
+	{
+		return false;
+	}
+	for (int32 BlockIndex = 0; BlockIndex < CompressionBlocks.Num(); ++BlockIndex)
+	{
+		const FPakCompressedBlock& Block = CompressionBlocks[BlockIndex];
+		if (Block.CompressedStart < 0 || Block.CompressedEnd < Block.CompressedStart || Offset + Block.CompressedEnd > PakFileSize)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+const uint8* FPakFileHandle::GetDecompressedBlock(int32 BlockIndex)
+{
+	// Look for the block in cache first and find the least recently used slot in case it's not there.
+	FCachedBlock* Slot = &CachedBlocks[0];
+	for (int32 CacheIndex = 0; CacheIndex < MaxCachedBlocks; ++CacheIndex)
+	{
+		FCachedBlock& CachedBlock = CachedBlocks[CacheIndex];
+		if (CachedBlock.BlockIndex == BlockIndex)
+		{
+			CachedBlock.LastUsed = ++BlockAccessCounter;
+			return CachedBlock.Data.GetData();
+		}
+		if (CachedBlock.LastUsed < Slot->LastUsed)
+		{
+			Slot = &CachedBlock;
+		}
+	}
+
+	const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[BlockIndex];
+	const int64 CompressedBlockSize = Block.CompressedEnd - Block.CompressedStart;
+	const int64 UncompressedBlockSize = PakEntry.GetUncompressedBlockSize(BlockIndex);
+	const uint8* CompressedData = NULL;
+	if (MappedData)
+	{
+		// Inflate straight from the mapping.
+		CompressedData = MappedData + PakEntry.Offset + Block.CompressedStart;
+	}
+	else
+	{
+		CompressedBuffer.Reset();
+		CompressedBuffer.AddUninitialized(CompressedBlockSize);
+		PakReader->Seek(PakEntry.Offset + Block.CompressedStart);
+		PakReader->Serialize(CompressedBuffer.GetData(), CompressedBlockSize);
+		CompressedData = CompressedBuffer.GetData();
+	}
+
+	Slot->BlockIndex = INDEX_NONE;
+	Slot->Data.Reset();
+	Slot->Data.AddUninitialized(UncompressedBlockSize);
+	if (!FCompression::UncompressMemory((ECompressionFlags)PakEntry.CompressionMethod, Slot->Data.GetData(), UncompressedBlockSize, CompressedData, CompressedBlockSize))
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Failed to decompress block %d of a pak entry at offset %lld in \"%s\"."), BlockIndex, PakEntry.Offset, *PakFile.GetFilename());
+		return NULL;
+	}
+	Slot->BlockIndex = BlockIndex;
+	Slot->LastUsed = ++BlockAccessCounter;
+	return Slot->Data.GetData();
+}
+
+bool FPakFileHandle::ReadCompressed(uint8* Destination, int64 BytesToRead)
+{
+	// VerifyHeader has already validated the block table.
+	checkSlow(PakEntry.CompressionBlockSize > 0);
+	while (BytesToRead > 0)
+	{
+		const int32 BlockIndex = (int32)(ReadPos / PakEntry.CompressionBlockSize);
+		const int64 BlockOffset = ReadPos % PakEntry.CompressionBlockSize;
+		const uint8* BlockData = GetDecompressedBlock(BlockIndex);
+		if (!BlockData)
+		{
+			return false;
+		}
+		const int64 SizeToCopy = FMath::Min(BytesToRead, PakEntry.GetUncompressedBlockSize(BlockIndex) - BlockOffset);
+		FMemory::Memcpy(Destination, BlockData + BlockOffset, SizeToCopy);
+		Destination += SizeToCopy;
+		ReadPos += SizeToCopy;
+		BytesToRead -= SizeToCopy;
+	}
+	return true;
+}
+
 FPakFile::FPakFile(const TCHAR* Filename, bool bIsSigned)
 	: PakFilename(Filename)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, MappedRegion(NULL)
+	, CachedTotalSize(0)
 {
 	FArchive* Reader = GetSharedReader(NULL);
 	if (Reader)
@@ -56,6 +156,8 @@ FPakFile::FPakFile(IPlatformFile* LowerLevel, const TCHAR* Filename, bool bIsSig
 	: PakFilename(Filename)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, MappedRegion(NULL)
+	, CachedTotalSize(0)
 {
 	FArchive* Reader = GetSharedReader(LowerLevel);
 	if (Reader)
@@ -67,6 +169,59 @@ FPakFile::FPakFile(IPlatformFile* LowerLevel, const TCHAR* Filename, bool bIsSig
 
 FPakFile::~FPakFile()
 {
+	if (MappedRegion)
+	{
+		FPlatformMemory::UnmapFile(MappedRegion);
+		MappedRegion = NULL;
+	}
+}
+
+bool FPakFile::MapIntoMemory(IPlatformFile* LowerLevel)
+{
+	if (MappedRegion)
+	{
+		return true;
+	}
+	if (!bIsValid || bSigned || Decryptor.IsValid())
+	{
+		// Signed data has to go through FSignedArchiveReader.
+		return false;
+	}
+
+	const FString PlatformFilename = LowerLevel ? LowerLevel->ConvertToAbsolutePathForExternalAppForRead(*PakFilename) : IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*PakFilename);
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapFileReadOnly(*PlatformFilename);
+	if (Region == NULL)
+	{
+		UE_LOG(LogPakFile, Log, TEXT("Unable to map pak \"%s\" into memory, falling back to file reads."), *PakFilename);
+		return false;
+	}
+
+	// Make sure we mapped the same file the index was loaded from.
+	FArchive* Reader = GetSharedReader(LowerLevel);
+	if (Reader == NULL || (int64)Region->GetSize() != Reader->TotalSize())
+	{
+		UE_LOG(LogPakFile, Warning, TEXT("Mapped pak \"%s\" size mismatch, falling back to file reads."), *PakFilename);
+		FPlatformMemory::UnmapFile(Region);
+		return false;
+	}
+
+	MappedRegion = Region;
+	UE_LOG(LogPakFile, Log, TEXT("Mapped pak \"%s\" into memory (%llu bytes)."), *PakFilename, (uint64)Region->GetSize());
+	return true;
+}
+
+bool FPakFile::IsEntryMapped(const FPakEntry& Entry) const
+{
+	if (MappedRegion == NULL)
+	{
+		return false;
+	}
+	const int64 MappedSize = (int64)MappedRegion->GetSize();
+	if (Entry.Offset < 0 || Entry.Size < 0 || Entry.Offset + Entry.GetSerializedSize(Info.Version) + Entry.Size > MappedSize)
+	{
+		return false;
+	}
+	return !Entry.IsCompressed() || Entry.HasValidCompressionBlocks(MappedSize);
 }
 
 FArchive* FPakFile::CreatePakReader(const TCHAR* Filename)
@@ -104,6 +259,8 @@ void FPakFile::Initialize(FArchive* Reader)
 	}
 	else
 	{
+		CachedTotalSize = Reader->TotalSize();
+
 		// Serialize trailer and check if everything is as expected.
 		Reader->Seek(Reader->TotalSize() - Info.GetSerializedSize());
 		Info.Serialize(*Reader);
@@ -195,6 +352,36 @@ void FPakFile::LoadIndex(FArchive* Reader)
 				}
 			}
 		}
+
+		// Point filenames at the strings owned by the directory index instead of keeping a second copy.
+		// Entries shadowed by a duplicate filename keep an empty name and can't be found by path.
+		Filenames.Init(TEXT(""), NumEntries);
+		for (TMap<FString, FPakDirectory>::TConstIterator DirectoryIt(Index); DirectoryIt; ++DirectoryIt)
+		{
+			for (FPakDirectory::TConstIterator FileIt(DirectoryIt.Value()); FileIt; ++FileIt)
+			{
+				Filenames[FileIt.Value() - Files.GetData()] = *FileIt.Key();
+			}
+		}
+
+		if (Info.Version >= FPakInfo::PakFile_Version_PathHashIndex)
+		{
+			IndexReader << PathHashIndex;
+			if (PathHashIndex.Num() != NumEntries)
+			{
+				UE_LOG(LogPakFile, Fatal, TEXT("Corrupted path hash index in pak file (%d hashes for %d entries)."), PathHashIndex.Num(), NumEntries);
+			}
+		}
+		else
+		{
+			// Older pak files don't store path hashes so compute them now.
+			PathHashIndex.Empty(NumEntries);
+			for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+			{
+				PathHashIndex.Add(FPakPathHashEntry(HashPath(Filenames[EntryIndex]), EntryIndex));
+			}
+			PathHashIndex.Sort();
+		}
 	}
 }
 
@@ -290,6 +477,10 @@ void FPakPlatformFile::HandlePakListCommand(const TCHAR* Cmd, FOutputDevice& Ar)
 FPakPlatformFile::FPakPlatformFile()
 	: LowerLevel(NULL)
 	, bSigned(false)
+	, bMapPakFiles(false)
+	, CurrentSnapshot(new FPakMountSnapshot)
+	, NumRetiredSnapshots(0)
+	, NumActiveReaders(0)
 {
 }
 
@@ -306,10 +497,14 @@ FPakPlatformFile::~FPakPlatformFile()
 
 	{
 		FScopeLock ScopedLock(&PakListCritical);
-		for (int32 PakFileIndex = 0; PakFileIndex < PakFiles.Num(); PakFileIndex++)
+		for (int32 PakFileIndex = 0; PakFileIndex < CurrentSnapshot->PakFiles.Num(); PakFileIndex++)
 		{
-			delete PakFiles[PakFileIndex];
+			delete CurrentSnapshot->PakFiles[PakFileIndex];
 		}
+		delete CurrentSnapshot;
+		CurrentSnapshot = NULL;
+		RetiredSnapshots.Empty();
+		NumRetiredSnapshots = 0;
 	}	
 }
 
@@ -412,6 +607,13 @@ bool FPakPlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CmdLine)
 #else
 	bSigned = true;
 #endif
+
+	// Memory mapping is on by default for 64-bit Linux (dedicated servers share the page cache this way) and can be requested elsewhere.
+#if PLATFORM_LINUX && PLATFORM_64BITS
+	bMapPakFiles = !FParse::Param(CmdLine, TEXT("NoMappedPak"));
+#else
+	bMapPakFiles = FParse::Param(CmdLine, TEXT("MappedPak"));
+#endif
 	
 	TArray<FString> PaksToLoad;
 #if !UE_BUILD_SHIPPING
@@ -466,10 +668,23 @@ bool FPakPlatformFile::Mount(const TCHAR* InPakFilename, const TCHAR* InPath /*=
 			{
 				Pak->SetMountPoint(InPath);
 			}
+			if (bMapPakFiles)
+			{
+				// Falls back to regular reads if the pak can't be mapped.
+				Pak->MapIntoMemory(LowerLevel);
+			}
+			TSharedPtr<FPakMountTable, ESPMode::ThreadSafe> MountTable = CreateMountTable(Pak);
 			{
-				// Add new pak file
+				// Add new pak file to a copy of the current snapshot and publish it once it's complete.
+				// The hash tables of the other paks are shared, so only the lists are copied.
 				FScopeLock ScopedLock(&PakListCritical);
-				PakFiles.Add(Pak);
+				FPakMountSnapshot* NewSnapshot = new FPakMountSnapshot(*CurrentSnapshot);
+				NewSnapshot->PakFiles.Add(Pak);
+				NewSnapshot->MountTables.Add(MountTable);
+				FPakMountSnapshot* OldSnapshot = (FPakMountSnapshot*)FPlatformAtomics::InterlockedExchangePtr((void**)&CurrentSnapshot, NewSnapshot);
+				RetiredSnapshots.Add(OldSnapshot);
+				NumRetiredSnapshots = RetiredSnapshots.Num();
+				DeleteRetiredSnapshots();
 			}
 			bSuccess = true;
 		}
@@ -485,10 +700,115 @@ bool FPakPlatformFile::Mount(const TCHAR* InPakFilename, const TCHAR* InPath /*=
 	return bSuccess;
 }
 
+TSharedPtr<FPakPlatformFile::FPakMountTable, ESPMode::ThreadSafe> FPakPlatformFile::CreateMountTable(FPakFile* Pak)
+{
+	TSharedPtr<FPakMountTable, ESPMode::ThreadSafe> Table = MakeShareable(new FPakMountTable);
+	Table->PakFile = Pak;
+
+	// The path hash index is sorted, so files sharing a hash follow the first one.
+	const TArray<FPakPathHashEntry>& PathHashIndex = Pak->GetPathHashIndex();
+	Table->HashToFile.Reserve(PathHashIndex.Num());
+	for (int32 HashIndex = 0; HashIndex < PathHashIndex.Num(); HashIndex++)
+	{
+		if (HashIndex == 0 || PathHashIndex[HashIndex].PathHash != PathHashIndex[HashIndex - 1].PathHash)
+		{
+			Table->HashToFile.Add(PathHashIndex[HashIndex].PathHash, HashIndex);
+		}
+	}
+	return Table;
+}
+
+void FPakPlatformFile::DeleteRetiredSnapshots()
+{
+	// A lookup starting after this check reads CurrentSnapshot, which is never retired while the lock is held.
+	if (NumActiveReaders == 0 && RetiredSnapshots.Num() > 0)
+	{
+		RetiredSnapshots.Empty();
+		NumRetiredSnapshots = 0;
+	}
+}
+
+bool FPakPlatformFile::IsStandardFilename(const TCHAR* Filename)
+{
+	// Standard filenames start with the relative path to root directory, use forward slashes only
+	// and have no inner relative directories or duplicate slashes.
+	const FString& RelativePathToRoot = FPaths::GetRelativePathToRoot();
+	if (RelativePathToRoot.Len() == 0 || FCString::Strncmp(Filename, *RelativePathToRoot, RelativePathToRoot.Len()) != 0)
+	{
+		return false;
+	}
+	const TCHAR* Char = Filename + RelativePathToRoot.Len() - 1;
+	for (; *Char; ++Char)
+	{
+		if (*Char == '\\' || (*Char == '/' && (Char[1] == '/' || (Char[1] == '.' && (Char[2] == '/' || Char[2] == 0 || (Char[2] == '.' && (Char[3] == '/' || Char[3] == 0)))))))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+const FPakEntry* FPakPlatformFile::FindFileInMountTables(const TCHAR* StandardFilename, FPakFile** OutPakFile)
+{
+	// Snapshots are never modified once published, so no lock is needed.
+	FSnapshotReadScope Snapshot(*this);
+
+	// Paks sharing a mount point length see the same relative filename, so its hash is only computed again when the length changes.
+	int32 HashedMountPointLen = INDEX_NONE;
+	uint64 PathHash = 0;
+
+	// Paks are in priority order, so the first match wins.
+	for (int32 TableIndex = 0; TableIndex < Snapshot->MountTables.Num(); TableIndex++)
+	{
+		const FPakMountTable& Table = *Snapshot->MountTables[TableIndex];
+		const FString& MountPoint = Table.PakFile->GetMountPoint();
+		const int32 MountPointLen = MountPoint.Len();
+		if (FCString::Strnicmp(StandardFilename, *MountPoint, MountPointLen) != 0)
+		{
+			continue;
+		}
+		const TCHAR* RelativeFilename = StandardFilename + MountPointLen;
+		if (MountPointLen != HashedMountPointLen)
+		{
+			PathHash = FPakFile::HashPath(RelativeFilename);
+			HashedMountPointLen = MountPointLen;
+		}
+		const int32* FirstHashIndex = Table.HashToFile.Find(PathHash);
+		if (!FirstHashIndex)
+		{
+			continue;
+		}
+		const TArray<FPakPathHashEntry>& PathHashIndex = Table.PakFile->GetPathHashIndex();
+		for (int32 HashIndex = *FirstHashIndex; HashIndex < PathHashIndex.Num() && PathHashIndex[HashIndex].PathHash == PathHash; HashIndex++)
+		{
+			// Verify the filename in case of hash collisions.
+			const int32 EntryIndex = PathHashIndex[HashIndex].EntryIndex;
+			if (FCString::Stricmp(Table.PakFile->GetRelativeFilename(EntryIndex), RelativeFilename) == 0)
+			{
+				if (OutPakFile != NULL)
+				{
+					*OutPakFile = Table.PakFile;
+				}
+				return &Table.PakFile->GetEntry(EntryIndex);
+			}
+		}
+	}
+	return NULL;
+}
+
 IFileHandle* FPakPlatformFile::CreatePakFileHandle(const TCHAR* Filename, FPakFile* PakFile, const FPakEntry* FileEntry)
 {
 	IFileHandle* Result = NULL;
-	FArchive* PakReader = PakFile->GetSharedReader(LowerLevel);
+	// Mapped paks don't need per-thread readers, unless the entry points outside of the mapping.
+	FArchive* PakReader = NULL;
+	if (!PakFile->IsEntryMapped(*FileEntry))
+	{
+		if (PakFile->GetMappedData())
+		{
+			UE_LOG(LogPakFile, Warning, TEXT("\"%s\" lies outside of mapped pak \"%s\", reading it through a file handle instead."), Filename, *PakFile->GetFilename());
+		}
+		PakReader = PakFile->GetSharedReader(LowerLevel);
+	}
 
 	// Create the handle.
 	Result = new FPakFileHandle(*PakFile, *FileEntry, PakReader, true);		
@@ -22,8 +22,10 @@ struct FPakInfo
 	{
 		PakFile_Version_Initial = 1,
 		PakFile_Version_NoTimestamps = 2,
+		PakFile_Version_CompressionBlocks = 3,
+		PakFile_Version_PathHashIndex = 4,
 
-		PakFile_Version_Latest = PakFile_Version_NoTimestamps
+		PakFile_Version_Latest = PakFile_Version_PathHashIndex
 	};
 
 	/** Pak file magic value. */
@@ -80,6 +82,34 @@ struct FPakInfo
 	}
 };
 
+/**
+ * Struct storing offsets and sizes of a compressed block.
+ */
+struct FPakCompressedBlock
+{
+	/** Offset of the start of a compression block. Offset is relative to the start of the file entry (including its header). */
+	int64 CompressedStart;
+	/** Offset of the end of a compression block. This may not align completely with the start of the next block. Offset is relative to the start of the file entry. */
+	int64 CompressedEnd;
+
+	bool operator == (const FPakCompressedBlock& B) const
+	{
+		return CompressedStart == B.CompressedStart && CompressedEnd == B.CompressedEnd;
+	}
+
+	bool operator != (const FPakCompressedBlock& B) const
+	{
+		return !(*this == B);
+	}
+};
+
+FORCEINLINE FArchive& operator<<(FArchive& Ar, FPakCompressedBlock& Block)
+{
+	Ar << Block.CompressedStart;
+	Ar << Block.CompressedEnd;
+	return Ar;
+}
+
 /**
  * Struct holding info about a single file stored in pak file.
  */
@@ -95,6 +125,10 @@ struct FPakEntry
 	int32 CompressionMethod;
 	/** File SHA1 value. */
 	uint8 Hash[20];
+	/** Array of compression blocks that describe how to decompress this pak entry. */
+	TArray<FPakCompressedBlock> CompressionBlocks;
+	/** Size of a compressed block in the file (uncompressed size of all but the last block). */
+	uint32 CompressionBlockSize;
 	/** Flag is set to true when FileHeader has been checked against PakHeader. It is not serialized */
 	mutable bool  Verified;
 
@@ -106,6 +140,7 @@ struct FPakEntry
 		, Size(0)
 		, UncompressedSize(0)
 		, CompressionMethod(0)
+		, CompressionBlockSize(0)
 		, Verified(false)
 	{
 		FMemory::Memset(Hash, 0, sizeof(Hash));
@@ -124,9 +159,44 @@ struct FPakEntry
 			// Timestamp
 			SerializedSize += sizeof(int64);
 		}
+		if (Version >= FPakInfo::PakFile_Version_CompressionBlocks && CompressionMethod != COMPRESS_None)
+		{
+			// Block table (array count + blocks) and block size
+			SerializedSize += sizeof(int32) + sizeof(FPakCompressedBlock) * CompressionBlocks.Num() + sizeof(CompressionBlockSize);
+		}
 		return SerializedSize;
 	}
 
+	/**
+	 * Checks if this entry is stored as a sequence of compressed blocks.
+	 *
+	 * @return true if the entry data needs to be decompressed before use.
+	 */
+	FORCEINLINE bool IsCompressed() const
+	{
+		return CompressionMethod != COMPRESS_None;
+	}
+
+	/**
+	 * Gets the uncompressed size of a single compression block.
+	 *
+	 * @param BlockIndex Index of the block.
+	 * @return Number of bytes the block inflates to.
+	 */
+	FORCEINLINE int64 GetUncompressedBlockSize(int32 BlockIndex) const
+	{
+		return FMath::Min<int64>(CompressionBlockSize, UncompressedSize - (int64)BlockIndex * CompressionBlockSize);
+	}
+
+	/**
+	 * Checks that the compression block table covers the whole entry and that every block lies within the pak file.
+	 * Compressed entries from paks older than PakFile_Version_CompressionBlocks have no block table and always fail this check.
+	 *
+	 * @param PakFileSize Total size of the pak file this entry is stored in.
+	 * @return true if the blocks can be safely read and decompressed.
+	 */
+	bool HasValidCompressionBlocks(int64 PakFileSize) const;
+
 	/**
 	 * Compares two FPakEntry structs.
 	 */
@@ -137,6 +207,8 @@ struct FPakEntry
 		return Size == B.Size && 
 			UncompressedSize == B.UncompressedSize &&
 			CompressionMethod == B.CompressionMethod &&
+			CompressionBlockSize == B.CompressionBlockSize &&
+			CompressionBlocks == B.CompressionBlocks &&
 			FMemory::Memcmp(Hash, B.Hash, sizeof(Hash)) == 0;
 	}
 
@@ -150,6 +222,8 @@ struct FPakEntry
 		return Size != B.Size || 
 			UncompressedSize != B.UncompressedSize ||
 			CompressionMethod != B.CompressionMethod ||
+			CompressionBlockSize != B.CompressionBlockSize ||
+			CompressionBlocks != B.CompressionBlocks ||
 			FMemory::Memcmp(Hash, B.Hash, sizeof(Hash)) != 0;
 	}
 
@@ -171,6 +245,14 @@ struct FPakEntry
 			Ar << Timestamp;
 		}
 		Ar.Serialize(Hash, sizeof(Hash));
+		if (Version >= FPakInfo::PakFile_Version_CompressionBlocks)
+		{
+			if (CompressionMethod != COMPRESS_None)
+			{
+				Ar << CompressionBlocks;
+				Ar << CompressionBlockSize;
+			}
+		}
 	}
 
 	/**
@@ -182,6 +264,39 @@ struct FPakEntry
 	static bool VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEntry& FileEntryB);
 };
 
+/**
+ * Entry in the precomputed path hash table stored in pak index. The table is sorted by PathHash.
+ */
+struct FPakPathHashEntry
+{
+	/** Hash of the filename relative to the pak mount point (see FPakFile::HashPath). */
+	uint64 PathHash;
+	/** Index of the file in pak index. */
+	int32 EntryIndex;
+
+	FPakPathHashEntry()
+		: PathHash(0)
+		, EntryIndex(INDEX_NONE)
+	{}
+
+	FPakPathHashEntry(uint64 InPathHash, int32 InEntryIndex)
+		: PathHash(InPathHash)
+		, EntryIndex(InEntryIndex)
+	{}
+
+	FORCEINLINE bool operator<(const FPakPathHashEntry& Other) const
+	{
+		return PathHash != Other.PathHash ? PathHash < Other.PathHash : EntryIndex < Other.EntryIndex;
+	}
+};
+
+FORCEINLINE FArchive& operator<<(FArchive& Ar, FPakPathHashEntry& Entry)
+{
+	Ar << Entry.PathHash;
+	Ar << Entry.EntryIndex;
+	return Ar;
+}
+
 /** Pak directory type. */
 typedef TMap<FString, FPakEntry*> FPakDirectory;
 
@@ -204,6 +319,10 @@ class PAKFILE_API FPakFile
 	FString MountPoint;
 	/** Info on all files stored in pak. */
 	TArray<FPakEntry> Files;	
+	/** Filenames (relative to mount point) of all files stored in pak, in the same order as Files. Points into the keys of Index, which own the strings. */
+	TArray<const TCHAR*> Filenames;
+	/** Precomputed filename hashes sorted by hash value. */
+	TArray<FPakPathHashEntry> PathHashIndex;
 	/** Pak Index organized as a map of directories for faster Directory iteration. */
 	TMap<FString, FPakDirectory> Index;
 	/** Timestamp of this pak file. */
@@ -212,6 +331,10 @@ class PAKFILE_API FPakFile
 	bool bSigned;
 	/** True if this pak file is valid and usable */
 	bool bIsValid;
+	/** Whole pak file mapped into memory, NULL if the pak is read through ReaderMap archives. */
+	FPlatformMemory::FSharedMemoryRegion* MappedRegion;
+	/** Size of the pak file on disk. */
+	int64 CachedTotalSize;
 
 	FArchive* CreatePakReader(const TCHAR* Filename);
 	FArchive* CreatePakReader(IFileHandle& InHandle, const TCHAR* Filename);
@@ -268,6 +391,34 @@ public:
 		return Index;
 	}
 
+	/**
+	 * Maps the whole pak file into memory so that reads can be served without going through the file system.
+	 * Signed pak files can't be mapped as their data needs to be verified when read.
+	 *
+	 * @param LowerLevel Lower level platform file used to resolve the pak file path.
+	 * @return true if the pak is now mapped, false if file handles should be used instead.
+	 */
+	bool MapIntoMemory(IPlatformFile* LowerLevel);
+
+	/**
+	 * Gets the start of the memory mapped pak file.
+	 *
+	 * @return Pointer to the start of pak file data or NULL if the pak is not mapped.
+	 */
+	FORCEINLINE const uint8* GetMappedData() const
+	{
+		return MappedRegion ? (const uint8*)MappedRegion->GetAddress() : NULL;
+	}
+
+	/**
+	 * Checks if an entry can be read straight from the memory mapped pak, i.e. its header, data and
+	 * compression blocks all lie within the mapping.
+	 *
+	 * @param Entry Entry to check.
+	 * @return true if the pak is mapped and the entry is fully contained in the mapping.
+	 */
+	bool IsEntryMapped(const FPakEntry& Entry) const;
+
 	/**
 	 * Gets shared pak file archive for given thrad
 	 *
@@ -275,26 +426,114 @@ public:
 	 */
 	FArchive* GetSharedReader(IPlatformFile* LowerLevel);
 
+	/**
+	 * Finds an entry in the pak file matching the given filename. Does not allocate memory.
+	 *
+	 * @param Filename File to find (standardized, see FPaths::MakeStandardFilename).
+	 * @return Pointer to pak file entry if the file was found, NULL otherwise.
+	 */
+	const FPakEntry* Find(const TCHAR* Filename) const
+	{		
+		const int32 MountPointLen = MountPoint.Len();
+		if (FCString::Strnicmp(Filename, *MountPoint, MountPointLen) == 0)
+		{
+			const TCHAR* RelativeFilename = Filename + MountPointLen;
+			const int32 EntryIndex = FindEntryIndex(RelativeFilename, HashPath(RelativeFilename));
+			if (EntryIndex != INDEX_NONE)
+			{
+				return &Files[EntryIndex];
+			}
+		}
+		return NULL;
+	}
+
 	/**
 	 * Finds an entry in the pak file matching the given filename.
 	 *
 	 * @param Filename File to find.
 	 * @return Pointer to pak file entry if the file was found, NULL otherwise.
 	 */
-	const FPakEntry* Find(const FString& Filename) const
-	{		
-		const FPakEntry*const * FoundFile = NULL;
-		if (Filename.StartsWith(MountPoint))
+	FORCEINLINE const FPakEntry* Find(const FString& Filename) const
+	{
+		return Find(*Filename);
+	}
+
+	/**
+	 * Finds a file using its precomputed path hash.
+	 *
+	 * @param RelativeFilename Filename relative to the mount point, used to verify hash collisions.
+	 * @param PathHash Hash of RelativeFilename.
+	 * @return Index of the entry if the file was found, INDEX_NONE otherwise.
+	 */
+	int32 FindEntryIndex(const TCHAR* RelativeFilename, uint64 PathHash) const
+	{
+		// Lower bound binary search in the sorted hash table.
+		int32 Min = 0;
+		int32 Max = PathHashIndex.Num();
+		while (Min < Max)
+		{
+			const int32 Mid = (Min + Max) / 2;
+			if (PathHashIndex[Mid].PathHash < PathHash)
+			{
+				Min = Mid + 1;
+			}
+			else
+			{
+				Max = Mid;
+			}
+		}
+		for (int32 HashIndex = Min; HashIndex < PathHashIndex.Num() && PathHashIndex[HashIndex].PathHash == PathHash; ++HashIndex)
 		{
-			FString Path(FPaths::GetPath(Filename));
-			const FPakDirectory* PakDirectory = FindDirectory(*Path);
-			if (PakDirectory != NULL)
+			const int32 EntryIndex = PathHashIndex[HashIndex].EntryIndex;
+			if (FCString::Stricmp(Filenames[EntryIndex], RelativeFilename) == 0)
 			{
-				FString RelativeFilename(Filename.Mid(MountPoint.Len()));
-				FoundFile = PakDirectory->Find(RelativeFilename);
+				return EntryIndex;
 			}
 		}
-		return FoundFile ? *FoundFile : NULL;
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Gets the precomputed path hash table.
+	 *
+	 * @return Array of path hashes sorted by hash value.
+	 */
+	const TArray<FPakPathHashEntry>& GetPathHashIndex() const
+	{
+		return PathHashIndex;
+	}
+
+	/**
+	 * Gets a file entry by its index.
+	 */
+	FORCEINLINE const FPakEntry& GetEntry(int32 EntryIndex) const
+	{
+		return Files[EntryIndex];
+	}
+
+	/**
+	 * Gets a filename (relative to the mount point) by its entry index.
+	 */
+	FORCEINLINE const TCHAR* GetRelativeFilename(int32 EntryIndex) const
+	{
+		return Filenames[EntryIndex];
+	}
+
+	/**
+	 * Calculates a case insensitive 64-bit FNV-1a hash of a path. Backslashes are treated as forward slashes.
+	 *
+	 * @param Path Path to hash.
+	 * @return Path hash.
+	 */
+	static uint64 HashPath(const TCHAR* Path)
+	{
+		uint64 Hash = 0xcbf29ce484222325ULL;
+		for (; *Path; ++Path)
+		{
+			const TCHAR Char = (*Path == '\\') ? '/' : FChar::ToLower(*Path);
+			Hash = (Hash ^ (uint32)Char) * 0x100000001b3ULL;
+		}
+		return Hash;
 	}
 
 	/**
@@ -485,6 +724,16 @@ public:
 		return Info;
 	}
 
+	/**
+	 * Gets the size of this pak file.
+	 *
+	 * @return Pak file size in bytes.
+	 */
+	int64 TotalSize() const
+	{
+		return CachedTotalSize;
+	}
+
 	/**
 	 * Gets this pak file's tiemstamp.
 	 *
@@ -528,18 +777,95 @@ public:
  */
 class PAKFILE_API FPakFileHandle : public IFileHandle
 {	
+	enum
+	{
+		/** Number of decompressed blocks kept around by each handle. */
+		MaxCachedBlocks = 2,
+	};
+
+	/** Single decompressed block cached by this handle. */
+	struct FCachedBlock
+	{
+		/** Index of the block in the entry's block table, INDEX_NONE if the slot is unused. */
+		int32 BlockIndex;
+		/** Value of BlockAccessCounter when the block was last used. */
+		uint32 LastUsed;
+		/** Decompressed block data. */
+		TArray<uint8> Data;
+
+		FCachedBlock()
+			: BlockIndex(INDEX_NONE)
+			, LastUsed(0)
+		{}
+	};
+
 	/** Pak file that own this file data */
 	const FPakFile& PakFile;
 	/** Pak file entry for this file. */
 	const FPakEntry& PakEntry;
-	/** Pak file archive to read the data from. */
+	/** Pak file archive to read the data from. NULL when reading from a memory mapped pak. */
 	FArchive* PakReader;
+	/** Start of the memory mapped pak file, NULL if the pak is not mapped or the entry lies outside of the mapping. */
+	const uint8* MappedData;
 	/** True if PakReader is shared and should not be deleted by this handle. */
 	const bool bSharedReader;
 	/** Offset to the file in pak (including the file header). */
 	int64 OffsetToFile;
 	/** Current read position. */
 	int64 ReadPos;
+	/** Recently decompressed blocks (only used by compressed entries). */
+	FCachedBlock CachedBlocks[MaxCachedBlocks];
+	/** Incremented each time a cached block is accessed, used to find the least recently used block. */
+	uint32 BlockAccessCounter;
+	/** Scratch buffer compressed data is read into before decompression. */
+	TArray<uint8> CompressedBuffer;
+
+	/**
+	 * Checks that the file header stored in pak matches the index entry and, for compressed entries,
+	 * that the block table is usable.
+	 *
+	 * @return true if the header is valid.
+	 */
+	bool VerifyHeader()
+	{
+		if (!PakEntry.Verified)
+		{
+			if (PakEntry.IsCompressed() && !PakEntry.HasValidCompressionBlocks(PakFile.TotalSize()))
+			{
+				UE_LOG(LogPakFile, Error, TEXT("Invalid compression block table for a pak entry at offset %lld in \"%s\"."), PakEntry.Offset, *PakFile.GetFilename());
+				return false;
+			}
+			FPakEntry FileHeader;
+			if (MappedData)
+			{
+				FBufferReader HeaderReader((void*)(MappedData + PakEntry.Offset), PakEntry.GetSerializedSize(PakFile.GetInfo().Version), false);
+				FileHeader.Serialize(HeaderReader, PakFile.GetInfo().Version);
+			}
+			else
+			{
+				PakReader->Seek(PakEntry.Offset);
+				FileHeader.Serialize(*PakReader, PakFile.GetInfo().Version);
+			}
+			if (FPakEntry::VerifyPakEntriesMatch(PakEntry, FileHeader))
+			{
+				PakEntry.Verified = true;
+			}
+		}
+		return PakEntry.Verified;
+	}
+
+	/**
+	 * Gets a decompressed block, reading and inflating it from pak if it's not cached yet.
+	 *
+	 * @param BlockIndex Index of the block to get.
+	 * @return Pointer to the decompressed block data or NULL if the block could not be decompressed.
+	 */
+	const uint8* GetDecompressedBlock(int32 BlockIndex);
+
+	/**
+	 * Reads data from a compressed entry, inflating only the blocks that overlap the requested range.
+	 */
+	bool ReadCompressed(uint8* Destination, int64 BytesToRead);
 
 public:
 
@@ -554,8 +880,10 @@ public:
 		: PakFile(InPakFile)
 		, PakEntry(InPakEntry)
 		, PakReader(InPakReader)
+		, MappedData(InPakFile.IsEntryMapped(InPakEntry) ? InPakFile.GetMappedData() : NULL)
 		, bSharedReader(bIsSharedReader)
 		, ReadPos(0)
+		, BlockAccessCounter(0)
 	{
 		OffsetToFile = PakEntry.Offset + PakEntry.GetSerializedSize(PakFile.GetInfo().Version);
 	}
@@ -578,7 +906,7 @@ public:
 	}
 	virtual bool Seek(int64 NewPosition) OVERRIDE
 	{
-		if (NewPosition > PakEntry.Size || NewPosition < 0)
+		if (NewPosition > PakEntry.UncompressedSize || NewPosition < 0)
 		{
 			return false;
 		}
@@ -587,39 +915,37 @@ public:
 	}
 	virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd) OVERRIDE
 	{
-		return Seek(PakEntry.Size - NewPositionRelativeToEnd);
+		return Seek(PakEntry.UncompressedSize - NewPositionRelativeToEnd);
 	}
 	virtual bool Read(uint8* Destination, int64 BytesToRead) OVERRIDE
 	{
 		// Check that the file header is OK
-		if (!PakEntry.Verified)
+		if (!VerifyHeader())
 		{
-			FPakEntry FileHeader;
-			PakReader->Seek(PakEntry.Offset);
-			FileHeader.Serialize(*PakReader, PakFile.GetInfo().Version);
-			if (FPakEntry::VerifyPakEntriesMatch(PakEntry, FileHeader))
-			{
-				PakEntry.Verified = true;
-			}
-			else
-			{
-				//Header is corrupt, fail the read
-				return false;
-			}
+			//Header is corrupt, fail the read
+			return false;
 		}
-		//
-		PakReader->Seek(OffsetToFile + ReadPos);
-		if (PakEntry.Size >= (ReadPos + BytesToRead))
+		if (PakEntry.UncompressedSize < (ReadPos + BytesToRead))
 		{
-			// Read directly from Pak.
-			PakReader->Serialize(Destination, BytesToRead);
-			ReadPos += BytesToRead;
-			return true;
+			return false;
+		}
+		if (PakEntry.IsCompressed())
+		{
+			return ReadCompressed(Destination, BytesToRead);
+		}
+		if (MappedData)
+		{
+			// Copy straight out of the mapping, no file system calls involved.
+			FMemory::Memcpy(Destination, MappedData + OffsetToFile + ReadPos, BytesToRead);
 		}
 		else
 		{
-			return false;
+			// Read directly from Pak.
+			PakReader->Seek(OffsetToFile + ReadPos);
+			PakReader->Serialize(Destination, BytesToRead);
 		}
+		ReadPos += BytesToRead;
+		return true;
 	}
 	virtual bool Write(const uint8* Source, int64 BytesToWrite) OVERRIDE
 	{
@@ -628,9 +954,23 @@ public:
 	}
 	virtual int64 Size() OVERRIDE
 	{
-		return PakEntry.Size;
+		return PakEntry.UncompressedSize;
 	}
 	/// END IFileHandle Interface
+
+	/**
+	 * Gets a pointer to the file data inside of a memory mapped pak. The pointer stays valid for as long as the pak is mounted.
+	 *
+	 * @return Pointer to the start of the file data or NULL if the pak is not mapped or the file is compressed.
+	 */
+	const uint8* GetMappedFileData()
+	{
+		if (!MappedData || PakEntry.IsCompressed() || !VerifyHeader())
+		{
+			return NULL;
+		}
+		return MappedData + OffsetToFile;
+	}
 };
 
 /**
@@ -640,20 +980,97 @@ class PAKFILE_API FPakPlatformFile : public IPlatformFile
 {
 	/** Wrapped file */
 	IPlatformFile* LowerLevel;
-	/** List of all available pak files. */
-	TArray<FPakFile*> PakFiles;
 	/** True if this we're using signed content. */
 	bool bSigned;
-	/** Synchronization object for accessing the list of currently mounted pak files. */
+	/** True if pak files should be memory mapped when mounted. */
+	bool bMapPakFiles;
+	/** Synchronization object for mounting pak files. Lookups go through CurrentSnapshot and don't lock. */
 	FCriticalSection PakListCritical;
 
+	/** Hash table of the files of one mounted pak. Never modified once built, so it's shared by every snapshot the pak is in. */
+	struct FPakMountTable
+	{
+		/** Pak file the table was built for. */
+		FPakFile* PakFile;
+		/** Maps path hash (relative to the pak mount point) to the first entry with that hash in the pak's path hash index. */
+		TMap<uint64, int32> HashToFile;
+	};
+
+	/** Immutable view of the mounted pak files. Mounting builds a new snapshot instead of modifying the current one. */
+	struct FPakMountSnapshot
+	{
+		/** Mounted pak files, in priority order. */
+		TArray<FPakFile*> PakFiles;
+		/** Hash table of each pak in PakFiles. */
+		TArray<TSharedPtr<FPakMountTable, ESPMode::ThreadSafe> > MountTables;
+	};
+
+	/** Counts the lookups in progress, so retired snapshots are only deleted once nothing can be reading them. */
+	class FSnapshotReadScope
+	{
+		FPakPlatformFile& PlatformFile;
+		const FPakMountSnapshot* Snapshot;
+	public:
+		FSnapshotReadScope(FPakPlatformFile& InPlatformFile)
+			: PlatformFile(InPlatformFile)
+		{
+			// The snapshot is read after the count is incremented, so a mount that sees no readers has nothing left to wait for.
+			FPlatformAtomics::InterlockedIncrement(&PlatformFile.NumActiveReaders);
+			Snapshot = PlatformFile.CurrentSnapshot;
+		}
+		~FSnapshotReadScope()
+		{
+			if (FPlatformAtomics::InterlockedDecrement(&PlatformFile.NumActiveReaders) == 0 && PlatformFile.NumRetiredSnapshots > 0)
+			{
+				FScopeLock ScopedLock(&PlatformFile.PakListCritical);
+				PlatformFile.DeleteRetiredSnapshots();
+			}
+		}
+		FORCEINLINE const FPakMountSnapshot* operator->() const
+		{
+			return Snapshot;
+		}
+	};
+
+	/** Snapshot used by lookups, read without locking. Only replaced while PakListCritical is locked. */
+	FPakMountSnapshot* volatile CurrentSnapshot;
+	/** Snapshots replaced by later mounts, deleted once no lookup is in progress. Only accessed while PakListCritical is locked. */
+	TIndirectArray<FPakMountSnapshot> RetiredSnapshots;
+	/** Number of entries in RetiredSnapshots, checked by lookups without locking. */
+	volatile int32 NumRetiredSnapshots;
+	/** Number of lookups in progress, see FSnapshotReadScope. */
+	volatile int32 NumActiveReaders;
+
+	/**
+	 * Builds the hash table of a pak file that is about to be mounted.
+	 *
+	 * @param Pak Pak file to build the table for.
+	 * @return The new table.
+	 */
+	static TSharedPtr<FPakMountTable, ESPMode::ThreadSafe> CreateMountTable(FPakFile* Pak);
+
+	/**
+	 * Deletes the retired snapshots if no lookup is in progress. PakListCritical must be locked.
+	 */
+	void DeleteRetiredSnapshots();
+
+	/**
+	 * Checks if a filename is already in the form produced by FPaths::MakeStandardFilename and can be looked up as is.
+	 */
+	static bool IsStandardFilename(const TCHAR* Filename);
+
+	/**
+	 * Looks up a standardized filename in the global hash table. Does not allocate memory.
+	 */
+	const FPakEntry* FindFileInMountTables(const TCHAR* StandardFilename, FPakFile** OutPakFile);
+
 	/**
 	 * Gets mounted pak files
 	 */
 	FORCEINLINE void GetMountedPaks(TArray<FPakFile*>& Paks)
 	{
-		FScopeLock ScopedLock(&PakListCritical);
-		Paks.Append(PakFiles);
+		FSnapshotReadScope Snapshot(*this);
+		Paks.Append(Snapshot->PakFiles);
 	}
 
 	/**
@@ -783,13 +1200,18 @@ public:
 	 */
 	FORCEINLINE static const FPakEntry* FindFileInPakFiles(TArray<FPakFile*>& Paks, const TCHAR* Filename,  FPakFile** OutPakFile)
 	{
-		FString StandardFilename(Filename);
-		FPaths::MakeStandardFilename(StandardFilename);
+		FString StandardFilename;
+		if (!IsStandardFilename(Filename))
+		{
+			StandardFilename = Filename;
+			FPaths::MakeStandardFilename(StandardFilename);
+			Filename = *StandardFilename;
+		}
 		const FPakEntry* FoundEntry = NULL;
 
 		for (int32 PakIndex = 0; !FoundEntry && PakIndex < Paks.Num(); PakIndex++)
 		{
-			FoundEntry = Paks[PakIndex]->Find(*StandardFilename);
+			FoundEntry = Paks[PakIndex]->Find(Filename);
 			if (FoundEntry != NULL)
 			{
 				if (OutPakFile != NULL)
@@ -803,7 +1225,7 @@ public:
 	}
 
 	/**
-	 * Finds a file in all available pak files.
+	 * Finds a file in all available pak files using the global hash table. Standardized filenames are looked up without allocating memory.
 	 *
 	 * @param Filename File to find in pak files.
 	 * @param OutPakFile Optional pointer to a pak file where the filename was found.
@@ -811,10 +1233,13 @@ public:
 	 */
 	const FPakEntry* FindFileInPakFiles(const TCHAR* Filename, FPakFile** OutPakFile = NULL)
 	{
-		TArray<FPakFile*> Paks;
-		GetMountedPaks(Paks);
-
-		return FindFileInPakFiles(Paks, Filename, OutPakFile);
+		if (IsStandardFilename(Filename))
+		{
+			return FindFileInMountTables(Filename, OutPakFile);
+		}
+		FString StandardFilename(Filename);
+		FPaths::MakeStandardFilename(StandardFilename);
+		return FindFileInMountTables(*StandardFilename, OutPakFile);
 	}
 
 	// BEGIN IPlatformFile Interface
@@ -836,7 +1261,7 @@ public:
 		const FPakEntry* FileEntry = FindFileInPakFiles(Filename);
 		if (FileEntry != NULL)
 		{
-			return FileEntry->Size;
+			return FileEntry->UncompressedSize;
 		}
 		// First look for the file in the user dir.
 		int64 Result = LowerLevel->FileSize(Filename);
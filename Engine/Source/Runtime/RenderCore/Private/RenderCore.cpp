@@ -85,6 +85,8 @@ DEFINE_STAT(STAT_ViewVisibilityTime);
 
 DEFINE_STAT(STAT_ProcessedPrimitives);
 DEFINE_STAT(STAT_CulledPrimitives);
+DEFINE_STAT(STAT_FrustumCullOctreeNodes);
+DEFINE_STAT(STAT_FrustumCullPrimitiveTests);
 DEFINE_STAT(STAT_StaticallyOccludedPrimitives);
 DEFINE_STAT(STAT_OccludedPrimitives);
 DEFINE_STAT(STAT_OcclusionQueries);
@@ -194,13 +194,14 @@ void FPrimitiveSceneInfo::AddToScene(bool bUpdateStaticDrawLists)
 	check(OctreeId.IsValidId());
 
 	// Set bounds.
-	FPrimitiveBounds& PrimitiveBounds = Scene->PrimitiveBounds[PackedIndex];
+	FPrimitiveBounds PrimitiveBounds;
 	FBoxSphereBounds BoxSphereBounds = Proxy->GetBounds();
 	PrimitiveBounds.Origin = BoxSphereBounds.Origin;
 	PrimitiveBounds.SphereRadius = BoxSphereBounds.SphereRadius;
 	PrimitiveBounds.BoxExtent = BoxSphereBounds.BoxExtent;
 	PrimitiveBounds.MinDrawDistanceSq = FMath::Square(Proxy->GetMinDrawDistance());
 	PrimitiveBounds.MaxDrawDistance = Proxy->GetMaxDrawDistance();
+	Scene->SetPrimitiveBounds(PackedIndex, PrimitiveBounds);
 
 	// Store precomputed visibility ID.
 	int32 VisibilityBitIndex = Proxy->GetVisibilityId();
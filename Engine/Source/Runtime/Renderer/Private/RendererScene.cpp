@@ -91,12 +91,28 @@ SIZE_T FScene::GetSizeBytes() const
 void FScene::CheckPrimitiveArrays()
 {
 	check(Primitives.Num() == PrimitiveBounds.Num());
+	check(PrimitiveBoundsPackets.Num() == FMath::DivideAndRoundUp(Primitives.Num(), (int32)FPrimitiveBoundsPacket::NumLanes));
 	check(Primitives.Num() == PrimitiveVisibilityIds.Num());
 	check(Primitives.Num() == PrimitiveOcclusionFlags.Num());
 	check(Primitives.Num() == PrimitiveComponentIds.Num());
 	check(Primitives.Num() == PrimitiveOcclusionBounds.Num());
 }
 
+float FScene::GetMaxPrimitiveDrawDistance()
+{
+	if (bMaxPrimitiveDrawDistanceDirty)
+	{
+		MaxPrimitiveDrawDistance = 0.0f;
+		for (int32 PrimitiveIndex = 0; PrimitiveIndex < PrimitiveBounds.Num(); PrimitiveIndex++)
+		{
+			MaxPrimitiveDrawDistance = FMath::Max(MaxPrimitiveDrawDistance, PrimitiveBounds[PrimitiveIndex].MaxDrawDistance);
+		}
+		bMaxPrimitiveDrawDistanceDirty = false;
+	}
+
+	return MaxPrimitiveDrawDistance;
+}
+
 void FScene::AddPrimitiveSceneInfo_RenderThread(FPrimitiveSceneInfo* PrimitiveSceneInfo)
 {
 	SCOPE_CYCLE_COUNTER(STAT_AddScenePrimitiveRenderThreadTime);
@@ -107,6 +123,10 @@ void FScene::AddPrimitiveSceneInfo_RenderThread(FPrimitiveSceneInfo* PrimitiveSc
 	PrimitiveSceneInfo->PackedIndex = PrimitiveIndex;
 
 	PrimitiveBounds.AddUninitialized();
+	if (PrimitiveIndex % FPrimitiveBoundsPacket::NumLanes == 0)
+	{
+		PrimitiveBoundsPackets.AddZeroed();
+	}
 	PrimitiveVisibilityIds.AddUninitialized();
 	PrimitiveOcclusionFlags.AddUninitialized();
 	PrimitiveComponentIds.AddUninitialized();
@@ -156,6 +176,8 @@ FScene::FScene(UWorld* InWorld, bool bInRequiresHitProxies, bool bInIsEditorScen
 ,	PrecomputedVisibilityHandler(NULL)
 ,	LightOctree(FVector::ZeroVector,HALF_WORLD_MAX)
 ,	PrimitiveOctree(FVector::ZeroVector,HALF_WORLD_MAX)
+,	MaxPrimitiveDrawDistance(0.0f)
+,	bMaxPrimitiveDrawDistanceDirty(false)
 ,	bRequiresHitProxies(bInRequiresHitProxies)
 ,	bIsEditorScene(bInIsEditorScene)
 ,	NumUncachedStaticLightingInteractions(0)
@@ -475,8 +497,28 @@ void FScene::RemovePrimitiveSceneInfo_RenderThread(FPrimitiveSceneInfo* Primitiv
 	CheckPrimitiveArrays();
 
 	int32 PrimitiveIndex = PrimitiveSceneInfo->PackedIndex;
+	if (PrimitiveBounds[PrimitiveIndex].MaxDrawDistance >= MaxPrimitiveDrawDistance)
+	{
+		bMaxPrimitiveDrawDistanceDirty = true;
+	}
 	Primitives.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveBounds.RemoveAtSwap(PrimitiveIndex);
+	{
+		// Mirror the swap in the packets, then clear the lane that was the last primitive
+		const int32 LastIndex = Primitives.Num();
+		if (PrimitiveIndex < LastIndex)
+		{
+			PrimitiveBoundsPackets[PrimitiveIndex / FPrimitiveBoundsPacket::NumLanes].SetLane(PrimitiveIndex % FPrimitiveBoundsPacket::NumLanes, PrimitiveBounds[PrimitiveIndex]);
+		}
+		if (LastIndex % FPrimitiveBoundsPacket::NumLanes == 0)
+		{
+			PrimitiveBoundsPackets.RemoveAt(PrimitiveBoundsPackets.Num() - 1);
+		}
+		else
+		{
+			PrimitiveBoundsPackets.Last().ClearLane(LastIndex % FPrimitiveBoundsPacket::NumLanes);
+		}
+	}
 	PrimitiveVisibilityIds.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveOcclusionFlags.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveComponentIds.RemoveAtSwap(PrimitiveIndex);
@@ -1856,6 +1898,7 @@ void FScene::ApplyWorldOffset_RenderThread(FVector InOffset)
 	for (auto It = PrimitiveBounds.CreateIterator(); It; ++It)
 	{
 		(*It).Origin+= InOffset;
+		PrimitiveBoundsPackets[It.GetIndex() / FPrimitiveBoundsPacket::NumLanes].SetLane(It.GetIndex() % FPrimitiveBoundsPacket::NumLanes, *It);
 	}
 
 	// Primitive occlusion bounds
@@ -1028,6 +1028,45 @@ struct FPrimitiveBounds
 	float MaxDrawDistance;
 };
 
+/**
+ * The bounds of four consecutive primitives in structure of arrays layout, so frustum culling can test them with one vector instruction per plane.
+ * FScene::PrimitiveBoundsPackets mirrors FScene::PrimitiveBounds with one packet per four primitives; unused lanes of the last packet are zeroed.
+ */
+MS_ALIGN(16) struct FPrimitiveBoundsPacket
+{
+	enum { NumLanes = 4 };
+
+	float OriginX[NumLanes];
+	float OriginY[NumLanes];
+	float OriginZ[NumLanes];
+	float SphereRadius[NumLanes];
+	float BoxExtentX[NumLanes];
+	float BoxExtentY[NumLanes];
+	float BoxExtentZ[NumLanes];
+	float MinDrawDistanceSq[NumLanes];
+	float MaxDrawDistance[NumLanes];
+
+	void SetLane(int32 Lane, const FPrimitiveBounds& Bounds)
+	{
+		OriginX[Lane] = Bounds.Origin.X;
+		OriginY[Lane] = Bounds.Origin.Y;
+		OriginZ[Lane] = Bounds.Origin.Z;
+		SphereRadius[Lane] = Bounds.SphereRadius;
+		BoxExtentX[Lane] = Bounds.BoxExtent.X;
+		BoxExtentY[Lane] = Bounds.BoxExtent.Y;
+		BoxExtentZ[Lane] = Bounds.BoxExtent.Z;
+		MinDrawDistanceSq[Lane] = Bounds.MinDrawDistanceSq;
+		MaxDrawDistance[Lane] = Bounds.MaxDrawDistance;
+	}
+
+	void ClearLane(int32 Lane)
+	{
+		FPrimitiveBounds ZeroBounds;
+		FMemory::Memzero(&ZeroBounds, sizeof(ZeroBounds));
+		SetLane(Lane, ZeroBounds);
+	}
+} GCC_ALIGN(16);
+
 /**
  * Precomputed primitive visibility ID.
  */
@@ -1174,6 +1213,8 @@ public:
 	TArray<FPrimitiveSceneInfo*> Primitives;
 	/** Packed array of primitive bounds. */
 	TArray<FPrimitiveBounds> PrimitiveBounds;
+	/** PrimitiveBounds in packets of four, used by frustum culling. Only modify through SetPrimitiveBounds. */
+	TArray<FPrimitiveBoundsPacket, TAlignedHeapAllocator<16> > PrimitiveBoundsPackets;
 	/** Packed array of precomputed primitive visibility IDs. */
 	TArray<FPrimitiveVisibilityId> PrimitiveVisibilityIds;
 	/** Packed array of primitive occlusion flags. See EOcclusionFlags. */
@@ -1260,6 +1301,12 @@ public:
 	/** An octree containing the primitives in the scene. */
 	FScenePrimitiveOctree PrimitiveOctree;
 
+	/** Largest MaxDrawDistance of the primitives in PrimitiveBounds, may be too large after a primitive was updated. */
+	float MaxPrimitiveDrawDistance;
+
+	/** Set when the primitive with the largest draw distance was removed, so MaxPrimitiveDrawDistance must be recomputed. */
+	bool bMaxPrimitiveDrawDistanceDirty;
+
 	/** Indicates whether this scene requires hit proxy rendering. */
 	bool bRequiresHitProxies;
 
@@ -1417,6 +1464,21 @@ public:
 		return FUniformBufferRHIParamRef();
 	}
 
+	/**
+	 * Sets the culling bounds of a primitive, keeping PrimitiveBounds and PrimitiveBoundsPackets in sync.
+	 */
+	void SetPrimitiveBounds(int32 PackedIndex, const FPrimitiveBounds& Bounds)
+	{
+		PrimitiveBounds[PackedIndex] = Bounds;
+		PrimitiveBoundsPackets[PackedIndex / FPrimitiveBoundsPacket::NumLanes].SetLane(PackedIndex % FPrimitiveBoundsPacket::NumLanes, Bounds);
+		MaxPrimitiveDrawDistance = FMath::Max(MaxPrimitiveDrawDistance, Bounds.MaxDrawDistance);
+	}
+
+	/**
+	 * @return An upper bound of the max draw distance of every primitive in the scene, nothing is drawn further away from the view than this.
+	 */
+	float GetMaxPrimitiveDrawDistance();
+
 	virtual void ApplyWorldOffset(FVector InOffset) OVERRIDE;
 
 	virtual void OnLevelAddedToWorld(FName InLevelName) OVERRIDE;
@@ -0,0 +1,494 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	SceneSoftwareOcclusion.cpp: Occlusion culling with a CPU depth rasterizer.
+=============================================================================*/
+
+#include "RendererPrivate.h"
+#include "ScenePrivate.h"
+#include "ParallelFor.h"
+#include "SceneSoftwareOcclusion.h"
+
+static int32 GSoftwareOcclusion = 0;
+static FAutoConsoleVariableRef CVarSoftwareOcclusion(
+	TEXT("r.SoftwareOcclusion"),
+	GSoftwareOcclusion,
+	TEXT("Whether to occlusion cull primitives against occluder meshes rasterized on the CPU in the same frame.\n")
+	TEXT(" 0: off (default)\n")
+	TEXT(" 1: on\n")
+	TEXT("Occluders are static meshes with LODForOccluderMesh set."),
+	ECVF_RenderThreadSafe
+	);
+
+static float GSoftwareOcclusionMinScreenRadius = 0.1f;
+static FAutoConsoleVariableRef CVarSoftwareOcclusionMinScreenRadius(
+	TEXT("r.SoftwareOcclusion.MinOccluderScreenRadius"),
+	GSoftwareOcclusionMinScreenRadius,
+	TEXT("Smallest screen radius, as a fraction of the screen, of a mesh to be used as an occluder."),
+	ECVF_RenderThreadSafe
+	);
+
+static int32 GSoftwareOcclusionMaxTriangles = 4096;
+static FAutoConsoleVariableRef CVarSoftwareOcclusionMaxTriangles(
+	TEXT("r.SoftwareOcclusion.MaxOccluderTriangles"),
+	GSoftwareOcclusionMaxTriangles,
+	TEXT("Most occluder triangles to rasterize per view, the largest occluders on screen are added first."),
+	ECVF_RenderThreadSafe
+	);
+
+static int32 GSoftwareOcclusionParallel = 1;
+static FAutoConsoleVariableRef CVarSoftwareOcclusionParallel(
+	TEXT("r.SoftwareOcclusion.Parallel"),
+	GSoftwareOcclusionParallel,
+	TEXT("Whether to rasterize occluders and test primitives on the task graph worker threads."),
+	ECVF_RenderThreadSafe
+	);
+
+/** Vertices with W below this are behind or too close to the near plane to be projected. */
+static const float SoftwareOcclusionMinW = 1.0e-3f;
+
+/** Number of visibility map words tested by each task. */
+static const int32 SoftwareOcclusionWordsPerTask = 16;
+
+FSoftwareOcclusionBuffer::FSoftwareOcclusionBuffer()
+{
+	checkAtCompileTime(Width % 4 == 0, SoftwareOcclusionRowsMustBeVectorAligned);
+	checkAtCompileTime(Height % BinHeight == 0, SoftwareOcclusionBinsMustCoverBuffer);
+
+	Depths.AddUninitialized(Width * Height);
+	Reset();
+}
+
+void FSoftwareOcclusionBuffer::Reset()
+{
+	Triangles.Reset();
+	FMemory::Memzero(Depths.GetData(), Depths.Num() * sizeof(float));
+}
+
+int32 FSoftwareOcclusionBuffer::AddOccluder(const FMatrix& LocalToClip, const FOccluderMeshData& Mesh)
+{
+	const int32 NumVertices = Mesh.Vertices.Num();
+	const int32 NumIndices = Mesh.Indices.Num() - Mesh.Indices.Num() % 3;
+
+	// Project the vertices, screen Y goes down and Z holds 1 / W
+	TArray<FVector, SceneRenderingAllocator> ScreenVertices;
+	ScreenVertices.AddUninitialized(NumVertices);
+
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		const FVector4 Clip = LocalToClip.TransformPosition(Mesh.Vertices[VertexIndex]);
+		FVector& Screen = ScreenVertices[VertexIndex];
+
+		if (Clip.W > SoftwareOcclusionMinW)
+		{
+			const float InvW = 1.0f / Clip.W;
+			Screen.X = (Clip.X * InvW * 0.5f + 0.5f) * Width;
+			Screen.Y = (0.5f - Clip.Y * InvW * 0.5f) * Height;
+			Screen.Z = InvW;
+		}
+		else
+		{
+			Screen.Z = 0.0f;
+		}
+	}
+
+	int32 NumAdded = 0;
+
+	for (int32 Index = 0; Index < NumIndices; Index += 3)
+	{
+		const uint32 Index0 = Mesh.Indices[Index + 0];
+		uint32 Index1 = Mesh.Indices[Index + 1];
+		uint32 Index2 = Mesh.Indices[Index + 2];
+
+		if (Index0 >= (uint32)NumVertices || Index1 >= (uint32)NumVertices || Index2 >= (uint32)NumVertices)
+		{
+			continue;
+		}
+
+		if (ScreenVertices[Index0].Z == 0.0f || ScreenVertices[Index1].Z == 0.0f || ScreenVertices[Index2].Z == 0.0f)
+		{
+			continue;
+		}
+
+		float Area = (ScreenVertices[Index1].X - ScreenVertices[Index0].X) * (ScreenVertices[Index2].Y - ScreenVertices[Index0].Y)
+			- (ScreenVertices[Index2].X - ScreenVertices[Index0].X) * (ScreenVertices[Index1].Y - ScreenVertices[Index0].Y);
+
+		// Occluders hide what is behind them from either side, so back facing triangles are flipped rather than culled
+		if (Area < 0.0f)
+		{
+			Swap(Index1, Index2);
+			Area = -Area;
+		}
+
+		if (Area < KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		const FVector& V0 = ScreenVertices[Index0];
+		const FVector& V1 = ScreenVertices[Index1];
+		const FVector& V2 = ScreenVertices[Index2];
+
+		const float MinX = FMath::Max(FMath::Min3(V0.X, V1.X, V2.X), 0.0f);
+		const float MaxX = FMath::Min(FMath::Max3(V0.X, V1.X, V2.X), (float)Width);
+		const float MinY = FMath::Max(FMath::Min3(V0.Y, V1.Y, V2.Y), 0.0f);
+		const float MaxY = FMath::Min(FMath::Max3(V0.Y, V1.Y, V2.Y), (float)Height);
+
+		// Pixel centers are at half integers
+		FScreenTriangle Triangle;
+		Triangle.MinX = FMath::Ceil(MinX - 0.5f);
+		Triangle.MaxX = FMath::Min(FMath::Floor(MaxX - 0.5f), Width - 1);
+		Triangle.MinY = FMath::Ceil(MinY - 0.5f);
+		Triangle.MaxY = FMath::Min(FMath::Floor(MaxY - 0.5f), Height - 1);
+
+		if (Triangle.MinX > Triangle.MaxX || Triangle.MinY > Triangle.MaxY)
+		{
+			continue;
+		}
+
+		// Edges are moved half a pixel inwards, so a pixel center is inside them only when the whole pixel is inside the triangle
+		const FVector* Edges[4] = { &V0, &V1, &V2, &V0 };
+		for (int32 EdgeIndex = 0; EdgeIndex < 3; EdgeIndex++)
+		{
+			const FVector& A = *Edges[EdgeIndex];
+			const FVector& B = *Edges[EdgeIndex + 1];
+			Triangle.EdgeA[EdgeIndex] = A.Y - B.Y;
+			Triangle.EdgeB[EdgeIndex] = B.X - A.X;
+			Triangle.EdgeC[EdgeIndex] = A.X * B.Y - A.Y * B.X - 0.5f * (FMath::Abs(Triangle.EdgeA[EdgeIndex]) + FMath::Abs(Triangle.EdgeB[EdgeIndex]));
+		}
+
+		// The depth plane is moved back by half a pixel of slope, so a pixel center gets the farthest depth of the triangle over the pixel
+		const float InvArea = 1.0f / Area;
+		Triangle.DepthA = ((V1.Z - V0.Z) * (V2.Y - V0.Y) - (V2.Z - V0.Z) * (V1.Y - V0.Y)) * InvArea;
+		Triangle.DepthB = ((V2.Z - V0.Z) * (V1.X - V0.X) - (V1.Z - V0.Z) * (V2.X - V0.X)) * InvArea;
+		Triangle.DepthC = V0.Z - Triangle.DepthA * V0.X - Triangle.DepthB * V0.Y - 0.5f * (FMath::Abs(Triangle.DepthA) + FMath::Abs(Triangle.DepthB));
+
+		Triangles.Add(Triangle);
+		NumAdded++;
+	}
+
+	return NumAdded;
+}
+
+void FSoftwareOcclusionBuffer::RasterizeBin(int32 BinIndex)
+{
+	const int32 BinMinY = BinIndex * BinHeight;
+	const int32 BinMaxY = BinMinY + BinHeight - 1;
+
+	const VectorRegister LaneOffsets = MakeVectorRegister(0.5f, 1.5f, 2.5f, 3.5f);
+	const VectorRegister Zero = VectorZero();
+
+	for (int32 TriangleIndex = 0; TriangleIndex < Triangles.Num(); TriangleIndex++)
+	{
+		const FScreenTriangle& Triangle = Triangles[TriangleIndex];
+		const int32 MinY = FMath::Max(Triangle.MinY, BinMinY);
+		const int32 MaxY = FMath::Min(Triangle.MaxY, BinMaxY);
+
+		if (MinY > MaxY)
+		{
+			continue;
+		}
+
+		const VectorRegister EdgeA0 = VectorLoadFloat1(&Triangle.EdgeA[0]);
+		const VectorRegister EdgeA1 = VectorLoadFloat1(&Triangle.EdgeA[1]);
+		const VectorRegister EdgeA2 = VectorLoadFloat1(&Triangle.EdgeA[2]);
+		const VectorRegister DepthA = VectorLoadFloat1(&Triangle.DepthA);
+		const int32 StartX = Triangle.MinX & ~3;
+
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			const float PixelY = Y + 0.5f;
+			const float RowEdge0 = Triangle.EdgeB[0] * PixelY + Triangle.EdgeC[0];
+			const float RowEdge1 = Triangle.EdgeB[1] * PixelY + Triangle.EdgeC[1];
+			const float RowEdge2 = Triangle.EdgeB[2] * PixelY + Triangle.EdgeC[2];
+			const float RowDepth = Triangle.DepthB * PixelY + Triangle.DepthC;
+			const VectorRegister Edge0 = VectorLoadFloat1(&RowEdge0);
+			const VectorRegister Edge1 = VectorLoadFloat1(&RowEdge1);
+			const VectorRegister Edge2 = VectorLoadFloat1(&RowEdge2);
+			const VectorRegister Depth = VectorLoadFloat1(&RowDepth);
+
+			float* RESTRICT Row = &Depths[Y * Width];
+
+			for (int32 X = StartX; X <= Triangle.MaxX; X += 4)
+			{
+				const float BlockX = (float)X;
+				const VectorRegister PixelX = VectorAdd(VectorLoadFloat1(&BlockX), LaneOffsets);
+
+				// Pixels are covered when their centers are on the inner side of all three shrunk edges
+				VectorRegister Inside = VectorCompareGE(VectorMultiplyAdd(EdgeA0, PixelX, Edge0), Zero);
+				Inside = VectorBitwiseAnd(Inside, VectorCompareGE(VectorMultiplyAdd(EdgeA1, PixelX, Edge1), Zero));
+				Inside = VectorBitwiseAnd(Inside, VectorCompareGE(VectorMultiplyAdd(EdgeA2, PixelX, Edge2), Zero));
+
+				if (VectorMaskBits(Inside))
+				{
+					const VectorRegister OldDepth = VectorLoadAligned(Row + X);
+					const VectorRegister NewDepth = VectorMax(OldDepth, VectorMultiplyAdd(DepthA, PixelX, Depth));
+					VectorStoreAligned(VectorSelect(Inside, NewDepth, OldDepth), Row + X);
+				}
+			}
+		}
+	}
+}
+
+/** Rasterizes one bin of a software occlusion buffer per task. */
+struct FRasterizeOcclusionBinBody
+{
+	FSoftwareOcclusionBuffer& Buffer;
+
+	FRasterizeOcclusionBinBody(FSoftwareOcclusionBuffer& InBuffer)
+		: Buffer(InBuffer)
+	{
+	}
+
+	void operator()(int32 BinIndex) const
+	{
+		Buffer.RasterizeBin(BinIndex);
+	}
+};
+
+void FSoftwareOcclusionBuffer::Rasterize(bool bParallel)
+{
+	// Bins cover separate rows, so they can be rasterized at the same time without synchronization
+	ParallelFor(NumBins, FRasterizeOcclusionBinBody(*this), 1, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+bool FSoftwareOcclusionBuffer::IsOccluded(const FMatrix& WorldToClip, const FVector& Origin, const FVector& Extent) const
+{
+	float MinX = FLT_MAX;
+	float MaxX = -FLT_MAX;
+	float MinY = FLT_MAX;
+	float MaxY = -FLT_MAX;
+	float MaxInvW = 0.0f;
+
+	// W is linear over the box, so the nearest point of the box is one of its corners
+	for (int32 CornerIndex = 0; CornerIndex < 8; CornerIndex++)
+	{
+		const FVector Corner(
+			Origin.X + ((CornerIndex & 1) ? Extent.X : -Extent.X),
+			Origin.Y + ((CornerIndex & 2) ? Extent.Y : -Extent.Y),
+			Origin.Z + ((CornerIndex & 4) ? Extent.Z : -Extent.Z)
+			);
+		const FVector4 Clip = WorldToClip.TransformPosition(Corner);
+
+		if (Clip.W <= SoftwareOcclusionMinW)
+		{
+			// The box crosses the near plane
+			return false;
+		}
+
+		const float InvW = 1.0f / Clip.W;
+		const float ScreenX = (Clip.X * InvW * 0.5f + 0.5f) * Width;
+		const float ScreenY = (0.5f - Clip.Y * InvW * 0.5f) * Height;
+		MinX = FMath::Min(MinX, ScreenX);
+		MaxX = FMath::Max(MaxX, ScreenX);
+		MinY = FMath::Min(MinY, ScreenY);
+		MaxY = FMath::Max(MaxY, ScreenY);
+		MaxInvW = FMath::Max(MaxInvW, InvW);
+	}
+
+	// Boxes reaching off the screen may be visible outside of the buffer
+	if (MinX < 0.0f || MaxX > Width || MinY < 0.0f || MaxY > Height)
+	{
+		return false;
+	}
+
+	// Every pixel the box touches must have an occluder in front of it
+	const int32 PixelMinX = FMath::Floor(MinX);
+	const int32 PixelMaxX = FMath::Min(FMath::Floor(MaxX), Width - 1);
+	const int32 PixelMinY = FMath::Floor(MinY);
+	const int32 PixelMaxY = FMath::Min(FMath::Floor(MaxY), Height - 1);
+
+	const float RangeMinX = (float)PixelMinX;
+	const float RangeMaxX = (float)PixelMaxX;
+	const VectorRegister LaneOffsets = MakeVectorRegister(0.0f, 1.0f, 2.0f, 3.0f);
+	const VectorRegister RangeMin = VectorLoadFloat1(&RangeMinX);
+	const VectorRegister RangeMax = VectorLoadFloat1(&RangeMaxX);
+	const VectorRegister BoxDepth = VectorLoadFloat1(&MaxInvW);
+
+	for (int32 Y = PixelMinY; Y <= PixelMaxY; Y++)
+	{
+		const float* RESTRICT Row = &Depths[Y * Width];
+
+		for (int32 X = PixelMinX & ~3; X <= PixelMaxX; X += 4)
+		{
+			const float BlockX = (float)X;
+			const VectorRegister PixelX = VectorAdd(VectorLoadFloat1(&BlockX), LaneOffsets);
+			const VectorRegister InRange = VectorBitwiseAnd(VectorCompareGE(PixelX, RangeMin), VectorCompareGE(RangeMax, PixelX));
+			const VectorRegister Visible = VectorBitwiseAnd(InRange, VectorCompareGE(BoxDepth, VectorLoadAligned(Row + X)));
+
+			if (VectorMaskBits(Visible))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/** A primitive to rasterize as an occluder. */
+struct FOccluderCandidate
+{
+	int32 PrimitiveIndex;
+	/** Square of the screen radius scaled by the square of the distance, only used for ordering. */
+	float ScreenSize;
+	const FOccluderMeshData* Mesh;
+};
+
+/** Orders occluder candidates from largest to smallest on screen. */
+struct FCompareOccluderCandidateScreenSize
+{
+	FORCEINLINE bool operator()(const FOccluderCandidate& A, const FOccluderCandidate& B) const
+	{
+		return A.ScreenSize > B.ScreenSize;
+	}
+};
+
+/** Tests the primitives of a range of visibility map words against the occlusion buffer per task. */
+struct FSoftwareOcclusionCullBody
+{
+	const FScene* Scene;
+	const FSoftwareOcclusionBuffer& Buffer;
+	const FMatrix& WorldToClip;
+	uint32* VisibilityWords;
+	const uint32* OccluderWords;
+	int32 NumWords;
+	volatile int32* NumOccludedPrimitives;
+
+	FSoftwareOcclusionCullBody(const FScene* InScene, const FSoftwareOcclusionBuffer& InBuffer, FViewInfo& View, const FSceneBitArray& OccluderMap, volatile int32* InNumOccludedPrimitives)
+		: Scene(InScene)
+		, Buffer(InBuffer)
+		, WorldToClip(View.ViewProjectionMatrix)
+		, VisibilityWords(View.PrimitiveVisibilityMap.GetData())
+		, OccluderWords(OccluderMap.GetData())
+		, NumWords(FMath::DivideAndRoundUp(View.PrimitiveVisibilityMap.Num(), (int32)NumBitsPerDWORD))
+		, NumOccludedPrimitives(InNumOccludedPrimitives)
+	{
+	}
+
+	void operator()(int32 TaskIndex) const
+	{
+		int32 NumOccludedInTask = 0;
+		const int32 FirstWord = TaskIndex * SoftwareOcclusionWordsPerTask;
+		const int32 LastWord = FMath::Min(FirstWord + SoftwareOcclusionWordsPerTask, NumWords);
+
+		for (int32 WordIndex = FirstWord; WordIndex < LastWord; WordIndex++)
+		{
+			// Occluders would be hidden by their own depths
+			const uint32 TestBits = VisibilityWords[WordIndex] & ~OccluderWords[WordIndex];
+			uint32 OccludedBits = 0;
+
+			for (uint32 BitIndex = 0; BitIndex < NumBitsPerDWORD; BitIndex++)
+			{
+				const uint32 BitMask = 1u << BitIndex;
+				if ((TestBits & BitMask) == 0)
+				{
+					continue;
+				}
+
+				const int32 PrimitiveIndex = WordIndex * NumBitsPerDWORD + BitIndex;
+				if ((Scene->PrimitiveOcclusionFlags[PrimitiveIndex] & EOcclusionFlags::CanBeOccluded) == 0)
+				{
+					continue;
+				}
+
+				// Selected primitives are drawn with an outline even when occluded
+				if (GIsEditor && Scene->Primitives[PrimitiveIndex]->Proxy->IsSelected())
+				{
+					continue;
+				}
+
+				const FBoxSphereBounds& Bounds = Scene->PrimitiveOcclusionBounds[PrimitiveIndex];
+				if (Buffer.IsOccluded(WorldToClip, Bounds.Origin, Bounds.BoxExtent))
+				{
+					OccludedBits |= BitMask;
+					NumOccludedInTask++;
+				}
+			}
+
+			VisibilityWords[WordIndex] &= ~OccludedBits;
+		}
+
+		if (NumOccludedInTask)
+		{
+			FPlatformAtomics::InterlockedAdd(NumOccludedPrimitives, NumOccludedInTask);
+		}
+	}
+};
+
+int32 SoftwareOcclusionCull(const FScene* Scene, FViewInfo& View)
+{
+	if (!GSoftwareOcclusion || !View.IsPerspectiveProjection())
+	{
+		return 0;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SoftwareOcclusionCull);
+
+	// Pick the visible occluders which are large enough on screen
+	TArray<FOccluderCandidate, SceneRenderingAllocator> Candidates;
+	const FVector ViewOrigin = View.ViewMatrices.ViewOrigin;
+	const float MinScreenRadiusSquared = FMath::Square(GSoftwareOcclusionMinScreenRadius * View.LODDistanceFactor);
+
+	for (FSceneSetBitIterator BitIt(View.PrimitiveVisibilityMap); BitIt; ++BitIt)
+	{
+		const int32 PrimitiveIndex = BitIt.GetIndex();
+		const FOccluderMeshData* Mesh = Scene->Primitives[PrimitiveIndex]->Proxy->GetOccluderMeshData();
+
+		if (Mesh)
+		{
+			const FPrimitiveBounds& Bounds = Scene->PrimitiveBounds[PrimitiveIndex];
+			const float DistanceSquared = FMath::Max((Bounds.Origin - ViewOrigin).SizeSquared(), 1.0f);
+			const float RadiusSquared = FMath::Square(Bounds.SphereRadius);
+
+			if (RadiusSquared > MinScreenRadiusSquared * DistanceSquared)
+			{
+				FOccluderCandidate Candidate;
+				Candidate.PrimitiveIndex = PrimitiveIndex;
+				Candidate.ScreenSize = RadiusSquared / DistanceSquared;
+				Candidate.Mesh = Mesh;
+				Candidates.Add(Candidate);
+			}
+		}
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		return 0;
+	}
+
+	Candidates.Sort(FCompareOccluderCandidateScreenSize());
+
+	FSoftwareOcclusionBuffer Buffer;
+	FSceneBitArray OccluderMap(false, View.PrimitiveVisibilityMap.Num());
+
+	for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); CandidateIndex++)
+	{
+		const FOccluderCandidate& Candidate = Candidates[CandidateIndex];
+
+		if (Buffer.GetNumTriangles() + Candidate.Mesh->Indices.Num() / 3 > GSoftwareOcclusionMaxTriangles)
+		{
+			continue;
+		}
+
+		const FMatrix LocalToClip = Scene->Primitives[Candidate.PrimitiveIndex]->Proxy->GetLocalToWorld() * View.ViewProjectionMatrix;
+		Buffer.AddOccluder(LocalToClip, *Candidate.Mesh);
+		OccluderMap[Candidate.PrimitiveIndex] = true;
+	}
+
+	if (Buffer.GetNumTriangles() == 0)
+	{
+		return 0;
+	}
+
+	const bool bParallel = GSoftwareOcclusionParallel != 0;
+	Buffer.Rasterize(bParallel);
+
+	volatile int32 NumOccludedPrimitives = 0;
+	FSoftwareOcclusionCullBody CullBody(Scene, Buffer, View, OccluderMap, &NumOccludedPrimitives);
+	const int32 NumTasks = FMath::DivideAndRoundUp(CullBody.NumWords, SoftwareOcclusionWordsPerTask);
+
+	ParallelFor(NumTasks, CullBody, 1, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	return NumOccludedPrimitives;
+}
@@ -0,0 +1,91 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	SceneSoftwareOcclusion.h: Occlusion culling with a CPU depth rasterizer.
+=============================================================================*/
+
+#pragma once
+
+/**
+ * A small depth buffer that occluder triangles are rasterized into on the CPU, so primitive bounds can be tested against it in the same frame.
+ * Depths are stored as 1 / W, which is linear in screen space, so larger values are nearer and the buffer clears to 0.
+ * The buffer is split into bins of rows which are rasterized in parallel, every bin rasterizing the triangles that overlap it.
+ */
+class FSoftwareOcclusionBuffer
+{
+public:
+	enum { Width = 256 };
+	enum { Height = 128 };
+	enum { BinHeight = 16 };
+	enum { NumBins = Height / BinHeight };
+
+	FSoftwareOcclusionBuffer();
+
+	/** Removes all occluders and clears the depth buffer. */
+	void Reset();
+
+	/**
+	 * Transforms the triangles of an occluder to the screen and adds them to the triangles to rasterize.
+	 * Triangles which cross the near plane are left out, which only makes the occluder smaller.
+	 * @param LocalToClip - Transform from the occluder's local space to clip space.
+	 * @param Mesh - The occluder's triangles.
+	 * @return The number of triangles added.
+	 */
+	int32 AddOccluder(const FMatrix& LocalToClip, const FOccluderMeshData& Mesh);
+
+	/**
+	 * Rasterizes the added triangles into the depth buffer.
+	 * Coverage is conservative: a triangle only writes the pixels it covers entirely, with its farthest depth over the pixel,
+	 * so a primitive seen through a gap between occluders, however narrow, is never culled.
+	 * @param bParallel - Whether to rasterize the bins on the task graph worker threads.
+	 */
+	void Rasterize(bool bParallel);
+
+	/** Rasterizes the rows of one bin, called by Rasterize. */
+	void RasterizeBin(int32 BinIndex);
+
+	/**
+	 * Tests a box against the depth buffer, Rasterize must have been called.
+	 * @param WorldToClip - Transform from world space to clip space.
+	 * @param Origin - Origin of the box.
+	 * @param Extent - Extent of the box along each axis.
+	 * @return true if the box is behind the occluders in every pixel it covers.
+	 */
+	bool IsOccluded(const FMatrix& WorldToClip, const FVector& Origin, const FVector& Extent) const;
+
+	int32 GetNumTriangles() const
+	{
+		return Triangles.Num();
+	}
+
+private:
+	/** An occluder triangle in screen space, set up for rasterizing. */
+	struct FScreenTriangle
+	{
+		/** Edge functions A * X + B * Y + C, shrunk by half a pixel, which are positive at the centers of pixels entirely inside the triangle. */
+		float EdgeA[3];
+		float EdgeB[3];
+		float EdgeC[3];
+		/** 1 / W as the plane DepthA * X + DepthB * Y + DepthC, offset to the farthest depth over the pixel around each point. */
+		float DepthA;
+		float DepthB;
+		float DepthC;
+		/** Inclusive range of pixels whose centers may be covered. */
+		int32 MinX;
+		int32 MaxX;
+		int32 MinY;
+		int32 MaxY;
+	};
+
+	TArray<FScreenTriangle> Triangles;
+
+	/** Width * Height depths, rows are 16 byte aligned. */
+	TArray<float, TAlignedHeapAllocator<16> > Depths;
+};
+
+/**
+ * Renders the largest occluders among the primitives in the view's visibility map into a software occlusion buffer,
+ * and removes the primitives hidden behind them from the map. Does nothing unless r.SoftwareOcclusion is set.
+ * @return The number of primitives occluded.
+ */
+extern int32 SoftwareOcclusionCull(const FScene* Scene, FViewInfo& View);
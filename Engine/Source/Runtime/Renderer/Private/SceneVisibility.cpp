@@ -8,6 +8,8 @@
 #include "EnginePrivate.h"
 #include "ScenePrivate.h"
 #include "FXSystem.h"
+#include "ParallelFor.h"
+#include "SceneSoftwareOcclusion.h"
 #include "../../Engine/Private/SkeletalRenderGPUSkin.h"		// GPrevPerBoneMotionBlur
 
 /*------------------------------------------------------------------------------
@@ -86,6 +88,26 @@ static FAutoConsoleVariableRef CVarLODFadeTime( TEXT("r.LODFadeTime"), GFadeTime
 static float GDistanceFadeMaxTravel = 1000.0f;
 static FAutoConsoleVariableRef CVarDistanceFadeMaxTravel( TEXT("r.DistanceFadeMaxTravel"), GDistanceFadeMaxTravel, TEXT("Max distance that the player can travel during the fade time."), ECVF_RenderThreadSafe );
 
+static int32 GParallelFrustumCull = 1;
+static FAutoConsoleVariableRef CVarParallelFrustumCull(
+	TEXT("r.ParallelFrustumCull"),
+	GParallelFrustumCull,
+	TEXT("Whether frustum culling is spread over the task graph worker threads.\n")
+	TEXT(" 0: Cull on the rendering thread\n")
+	TEXT(" 1: Cull on worker threads (default)"),
+	ECVF_RenderThreadSafe
+	);
+
+static int32 GHierarchicalCulling = 0;
+static FAutoConsoleVariableRef CVarHierarchicalCulling(
+	TEXT("r.HierarchicalCulling"),
+	GHierarchicalCulling,
+	TEXT("Whether views are frustum culled by walking the primitive octree.\n")
+	TEXT(" 0: Only views with bUseHierarchicalCulling set walk the octree, the others test every primitive (default)\n")
+	TEXT(" 1: All views walk the octree"),
+	ECVF_RenderThreadSafe
+	);
+
 /*------------------------------------------------------------------------------
 	Visibility determination.
 ------------------------------------------------------------------------------*/
@@ -240,6 +262,146 @@ bool FViewInfo::IsDistanceCulled( float DistanceSquared, float MinDrawDistance,
 	return ( bDistanceCulled && !bStillFading );
 }
 
+/** Number of visibility map words, of 32 primitives each, culled by one frustum culling task. */
+static const int32 FrustumCullWordsPerTask = 32;
+
+/**
+ * Frustum and distance culls the primitives of a range of words of the view's visibility maps.
+ * Four primitives are tested at a time from FScene::PrimitiveBoundsPackets. Every task owns whole words of
+ * PrimitiveVisibilityMap and PotentiallyFadingPrimitiveMap, so tasks never write to the same word.
+ */
+struct FFrustumCullBody
+{
+	const FScene* Scene;
+	FViewInfo& View;
+	uint32* VisibilityWords;
+	uint32* FadingWords;
+	int32 NumWords;
+	float MaxDrawDistanceScale;
+	float MaxDrawDistanceFloor;
+	float FadeRadius;
+	volatile int32* NumCulledPrimitives;
+
+	FFrustumCullBody(const FScene* InScene, FViewInfo& InView, volatile int32* InNumCulledPrimitives)
+		: Scene(InScene)
+		, View(InView)
+		, VisibilityWords(InView.PrimitiveVisibilityMap.GetData())
+		, FadingWords(InView.PotentiallyFadingPrimitiveMap.GetData())
+		, NumWords(FMath::DivideAndRoundUp(InView.PrimitiveVisibilityMap.Num(), (int32)NumBitsPerDWORD))
+		, NumCulledPrimitives(InNumCulledPrimitives)
+	{
+		MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
+		FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+
+		// If cull distance is disabled, always show
+		MaxDrawDistanceFloor = View.Family->EngineShowFlags.DistanceCulledPrimitives ? FLT_MAX : 0.0f;
+	}
+
+	void operator()(int32 TaskIndex) const
+	{
+		checkAtCompileTime(NumBitsPerDWORD % FPrimitiveBoundsPacket::NumLanes == 0, PrimitiveBoundsPacketsMustNotStraddleWords);
+
+		const FPrimitiveBoundsPacket* RESTRICT Packets = Scene->PrimitiveBoundsPackets.GetData();
+		const TArray<FPlane>& Planes = View.ViewFrustum.Planes;
+		const int32 NumPlanes = Planes.Num();
+		const int32 NumPrimitives = View.PrimitiveVisibilityMap.Num();
+
+		const VectorRegister ViewOriginX = VectorLoadFloat1(&View.ViewMatrices.ViewOrigin.X);
+		const VectorRegister ViewOriginY = VectorLoadFloat1(&View.ViewMatrices.ViewOrigin.Y);
+		const VectorRegister ViewOriginZ = VectorLoadFloat1(&View.ViewMatrices.ViewOrigin.Z);
+		const VectorRegister DrawDistanceScale = VectorLoadFloat1(&MaxDrawDistanceScale);
+		const VectorRegister DrawDistanceFloor = VectorLoadFloat1(&MaxDrawDistanceFloor);
+		const VectorRegister Fade = VectorLoadFloat1(&FadeRadius);
+
+		STAT(int32 NumCulledInTask = 0;)
+		const int32 FirstWord = TaskIndex * FrustumCullWordsPerTask;
+		const int32 LastWord = FMath::Min(FirstWord + FrustumCullWordsPerTask, NumWords);
+
+		for (int32 WordIndex = FirstWord; WordIndex < LastWord; WordIndex++)
+		{
+			uint32 CulledBits = 0;
+			uint32 VisibleBits = 0;
+			uint32 FadingBits = 0;
+
+			const int32 FirstPacket = WordIndex * (NumBitsPerDWORD / FPrimitiveBoundsPacket::NumLanes);
+			const int32 LastPacket = FMath::Min(FirstPacket + (int32)(NumBitsPerDWORD / FPrimitiveBoundsPacket::NumLanes), Scene->PrimitiveBoundsPackets.Num());
+
+			for (int32 PacketIndex = FirstPacket; PacketIndex < LastPacket; PacketIndex++)
+			{
+				const FPrimitiveBoundsPacket& Packet = Packets[PacketIndex];
+				const VectorRegister OriginX = VectorLoadAligned(Packet.OriginX);
+				const VectorRegister OriginY = VectorLoadAligned(Packet.OriginY);
+				const VectorRegister OriginZ = VectorLoadAligned(Packet.OriginZ);
+				const VectorRegister AbsExtentX = VectorAbs(VectorLoadAligned(Packet.BoxExtentX));
+				const VectorRegister AbsExtentY = VectorAbs(VectorLoadAligned(Packet.BoxExtentY));
+				const VectorRegister AbsExtentZ = VectorAbs(VectorLoadAligned(Packet.BoxExtentZ));
+				const VectorRegister SphereRadius = VectorLoadAligned(Packet.SphereRadius);
+
+				// The primitive lies outside the frustum if it is in front of any plane by more than its sphere radius or its box push out
+				VectorRegister Outside = VectorZero();
+				for (int32 PlaneIndex = 0; PlaneIndex < NumPlanes; PlaneIndex++)
+				{
+					const FPlane& Plane = Planes[PlaneIndex];
+					const VectorRegister PlaneX = VectorLoadFloat1(&Plane.X);
+					const VectorRegister PlaneY = VectorLoadFloat1(&Plane.Y);
+					const VectorRegister PlaneZ = VectorLoadFloat1(&Plane.Z);
+					const VectorRegister PlaneW = VectorLoadFloat1(&Plane.W);
+					// Calculate the distance (x * x) + (y * y) + (z * z) - w
+					VectorRegister Distance = VectorMultiply(OriginX, PlaneX);
+					Distance = VectorMultiplyAdd(OriginY, PlaneY, Distance);
+					Distance = VectorMultiplyAdd(OriginZ, PlaneZ, Distance);
+					Distance = VectorSubtract(Distance, PlaneW);
+					// Now do the push out FMath::Abs(x * x) + FMath::Abs(y * y) + FMath::Abs(z * z)
+					VectorRegister PushOut = VectorMultiply(AbsExtentX, VectorAbs(PlaneX));
+					PushOut = VectorMultiplyAdd(AbsExtentY, VectorAbs(PlaneY), PushOut);
+					PushOut = VectorMultiplyAdd(AbsExtentZ, VectorAbs(PlaneZ), PushOut);
+					Outside = VectorBitwiseOr(Outside, VectorCompareGT(Distance, VectorMin(PushOut, SphereRadius)));
+				}
+
+				const VectorRegister DeltaX = VectorSubtract(OriginX, ViewOriginX);
+				const VectorRegister DeltaY = VectorSubtract(OriginY, ViewOriginY);
+				const VectorRegister DeltaZ = VectorSubtract(OriginZ, ViewOriginZ);
+				VectorRegister DistanceSquared = VectorMultiply(DeltaX, DeltaX);
+				DistanceSquared = VectorMultiplyAdd(DeltaY, DeltaY, DistanceSquared);
+				DistanceSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, DistanceSquared);
+
+				const VectorRegister MaxDrawDistance = VectorMax(VectorMultiply(VectorLoadAligned(Packet.MaxDrawDistance), DrawDistanceScale), DrawDistanceFloor);
+				const VectorRegister MaxFadeDistance = VectorAdd(MaxDrawDistance, Fade);
+				const VectorRegister MinFadeDistance = VectorSubtract(MaxDrawDistance, Fade);
+
+				// The primitive is always culled if it exceeds the max fade distance or lay outside the view frustum.
+				const VectorRegister Culled = VectorBitwiseOr(Outside, VectorBitwiseOr(
+					VectorCompareGT(DistanceSquared, VectorMultiply(MaxFadeDistance, MaxFadeDistance)),
+					VectorCompareGT(VectorLoadAligned(Packet.MinDrawDistanceSq), DistanceSquared)));
+				const VectorRegister BeyondMaxDrawDistance = VectorCompareGT(DistanceSquared, VectorMultiply(MaxDrawDistance, MaxDrawDistance));
+				const VectorRegister BeyondMinFadeDistance = VectorCompareGT(DistanceSquared, VectorMultiply(MinFadeDistance, MinFadeDistance));
+
+				const uint32 Shift = (PacketIndex - FirstPacket) * FPrimitiveBoundsPacket::NumLanes;
+				CulledBits |= VectorMaskBits(Culled) << Shift;
+				VisibleBits |= (VectorMaskBits(BeyondMaxDrawDistance) ^ 0xf) << Shift;
+				FadingBits |= VectorMaskBits(VectorBitwiseOr(BeyondMaxDrawDistance, BeyondMinFadeDistance)) << Shift;
+			}
+
+			// Ignore the unused lanes of the last packet
+			const int32 NumBitsInWord = FMath::Min(NumPrimitives - WordIndex * (int32)NumBitsPerDWORD, (int32)NumBitsPerDWORD);
+			const uint32 ValidBits = NumBitsInWord == NumBitsPerDWORD ? ~0u : ((1u << NumBitsInWord) - 1);
+			const uint32 KeptBits = ~CulledBits & ValidBits;
+
+			VisibilityWords[WordIndex] |= VisibleBits & KeptBits;
+			FadingWords[WordIndex] |= FadingBits & KeptBits;
+
+#if STATS
+			for (uint32 CulledKeptBits = CulledBits & ValidBits; CulledKeptBits; CulledKeptBits &= CulledKeptBits - 1)
+			{
+				NumCulledInTask++;
+			}
+#endif
+		}
+
+		STAT(FPlatformAtomics::InterlockedAdd(NumCulledPrimitives, NumCulledInTask));
+	}
+};
+
 /**
  * Frustum cull primitives in the scene against the view.
  */
@@ -247,49 +409,111 @@ static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FrustumCull);
 
-	int32 NumCulledPrimitives = 0;
-	FVector ViewOriginForDistanceCulling = View.ViewMatrices.ViewOrigin;
-	float MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
-	float FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+	check(Scene->PrimitiveBoundsPackets.Num() == FMath::DivideAndRoundUp(View.PrimitiveVisibilityMap.Num(), (int32)FPrimitiveBoundsPacket::NumLanes));
+	check(View.PotentiallyFadingPrimitiveMap.Num() == View.PrimitiveVisibilityMap.Num());
 
-	for (FSceneBitArray::FIterator BitIt(View.PrimitiveVisibilityMap); BitIt; ++BitIt)
+	volatile int32 NumCulledPrimitives = 0;
+	FFrustumCullBody FrustumCullBody(Scene, View, &NumCulledPrimitives);
+	const int32 NumTasks = FMath::DivideAndRoundUp(FrustumCullBody.NumWords, FrustumCullWordsPerTask);
+
+	ParallelFor(NumTasks, FrustumCullBody, 1, GParallelFrustumCull ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	INC_DWORD_STAT_BY(STAT_FrustumCullPrimitiveTests, View.PrimitiveVisibilityMap.Num());
+
+	return NumCulledPrimitives;
+}
+
+/**
+ * Frustum cull primitives in the scene against the view by walking the primitive octree.
+ * Nodes outside the frustum or further than any primitive's draw distance are skipped with everything below them,
+ * and nodes fully inside the frustum only distance cull their primitives.
+ */
+static int32 OctreeFrustumCull(FScene* Scene, FViewInfo& View)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FrustumCull);
+
+	int32 NumTestedPrimitives = 0;
+	int32 NumCulledTestedPrimitives = 0;
+	STAT(int32 NumVisitedNodes = 0);
+
+	const FVector ViewOriginForDistanceCulling = View.ViewMatrices.ViewOrigin;
+	const float MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
+	const float FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+	const bool bDistanceCulling = !View.Family->EngineShowFlags.DistanceCulledPrimitives;
+	const float MaxNodeDistanceSquared = FMath::Square(Scene->GetMaxPrimitiveDrawDistance() * MaxDrawDistanceScale + FadeRadius);
+
+	for (FScenePrimitiveOctree::TConstIterator<SceneRenderingAllocator> NodeIt(Scene->PrimitiveOctree); NodeIt.HasPendingNodes(); NodeIt.Advance())
 	{
-		const FPrimitiveBounds& Bounds = Scene->PrimitiveBounds[BitIt.GetIndex()];
-		float DistanceSquared = (Bounds.Origin - ViewOriginForDistanceCulling).SizeSquared();
-		float MaxDrawDistance = Bounds.MaxDrawDistance * MaxDrawDistanceScale;
+		const FScenePrimitiveOctree::FNode& Node = NodeIt.GetCurrentNode();
+		const FOctreeNodeContext& Context = NodeIt.GetCurrentContext();
+		// InCullBits is set when the node is fully inside the frustum, and is zero at the root
+		const bool bNodeInsideFrustum = Context.InCullBits != 0;
+		STAT(NumVisitedNodes++);
 
-		// If cull distance is disabled, always show
-		if (View.Family->EngineShowFlags.DistanceCulledPrimitives)
+		FOREACH_OCTREE_CHILD_NODE(ChildRef)
 		{
-			MaxDrawDistance = FLT_MAX;
-		}
+			if (Node.HasChild(ChildRef))
+			{
+				FOctreeNodeContext ChildContext = Context.GetChildContext(ChildRef);
+				const FVector ChildCenter = ChildContext.Bounds.Center;
+				const FVector ChildExtent = ChildContext.Bounds.Extent;
 
-		// The primitive is always culled if it exceeds the max fade distance or lay outside the view frustum.
-		if (DistanceSquared > FMath::Square(MaxDrawDistance + FadeRadius) ||
-			DistanceSquared < Bounds.MinDrawDistanceSq ||
-			View.ViewFrustum.IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false ||
-			View.ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false)
-		{
-			STAT(NumCulledPrimitives++);
-			continue;
-		}
+				if (bDistanceCulling && ComputeSquaredDistanceFromBoxToPoint(ChildCenter - ChildExtent, ChildCenter + ChildExtent, ViewOriginForDistanceCulling) > MaxNodeDistanceSquared)
+				{
+					continue;
+				}
 
-		if (DistanceSquared > FMath::Square(MaxDrawDistance))
-		{
-			View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
+				bool bChildInsideFrustum = bNodeInsideFrustum;
+				if (!bChildInsideFrustum && !View.ViewFrustum.IntersectBox(ChildCenter, ChildExtent, bChildInsideFrustum))
+				{
+					continue;
+				}
+
+				ChildContext.InCullBits = bChildInsideFrustum ? 1 : 0;
+				ChildContext.OutCullBits = 0;
+				NodeIt.PushChild(ChildRef, ChildContext);
+			}
 		}
-		else
+
+		for (FScenePrimitiveOctree::ElementConstIt ElementIt(Node.GetElementIt()); ElementIt; ++ElementIt)
 		{
-			// The primitive is visible!
-			BitIt.GetValue() = true;
-			if (DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
+			const int32 PrimitiveIndex = ElementIt->PrimitiveSceneInfo->PackedIndex;
+			const FPrimitiveBounds& Bounds = Scene->PrimitiveBounds[PrimitiveIndex];
+			float DistanceSquared = (Bounds.Origin - ViewOriginForDistanceCulling).SizeSquared();
+			float MaxDrawDistance = bDistanceCulling ? Bounds.MaxDrawDistance * MaxDrawDistanceScale : FLT_MAX;
+			NumTestedPrimitives++;
+
+			// The primitive is always culled if it exceeds the max fade distance or lay outside the view frustum.
+			if (DistanceSquared > FMath::Square(MaxDrawDistance + FadeRadius) ||
+				DistanceSquared < Bounds.MinDrawDistanceSq ||
+				(!bNodeInsideFrustum && View.ViewFrustum.IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false) ||
+				(!bNodeInsideFrustum && View.ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false))
 			{
-				View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
+				NumCulledTestedPrimitives++;
+				continue;
+			}
+
+			if (DistanceSquared > FMath::Square(MaxDrawDistance))
+			{
+				View.PotentiallyFadingPrimitiveMap[PrimitiveIndex] = true;
+			}
+			else
+			{
+				// The primitive is visible!
+				View.PrimitiveVisibilityMap[PrimitiveIndex] = true;
+				if (DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
+				{
+					View.PotentiallyFadingPrimitiveMap[PrimitiveIndex] = true;
+				}
 			}
 		}
 	}
 
-	return NumCulledPrimitives;
+	INC_DWORD_STAT_BY(STAT_FrustumCullOctreeNodes, NumVisitedNodes);
+	INC_DWORD_STAT_BY(STAT_FrustumCullPrimitiveTests, NumTestedPrimitives);
+
+	// Primitives in skipped nodes were culled without being tested
+	return View.PrimitiveVisibilityMap.Num() - NumTestedPrimitives + NumCulledTestedPrimitives;
 }
 
 /**
@@ -379,6 +603,9 @@ static int32 OcclusionCull(const FScene* Scene, FViewInfo& View)
 		}
 	}
 
+	// Remove primitives hidden behind occluder meshes rasterized on the CPU, before any queries are issued for them
+	NumOccludedPrimitives += SoftwareOcclusionCull(Scene, View);
+
 	float CurrentRealTime = View.Family->CurrentRealTime;
 	if (ViewState)
 	{
@@ -1347,7 +1574,7 @@ void FSceneRenderer::ComputeViewVisibility()
 		// Most views use standard frustum culling.
 		if (bNeedsFrustumCulling)
 		{
-			int32 NumCulledPrimitivesForView = FrustumCull(Scene, View);
+			int32 NumCulledPrimitivesForView = (GHierarchicalCulling || View.bUseHierarchicalCulling) ? OctreeFrustumCull(Scene, View) : FrustumCull(Scene, View);
 			STAT(NumCulledPrimitives += NumCulledPrimitivesForView);
 			UpdatePrimitiveFading(Scene, View);			
 		}
@@ -68,6 +68,10 @@ inline FDrawListSortKey GetSortKey(bool bBackground, float BoundsRadius, float D
 
 /**
  * A set of static meshs, each associated with a mesh drawing policy of a particular type.
+ * The drawing policies stay sorted by state as meshes are added and removed. Submission walks the compact element array
+ * of each policy and draws the visible elements through the policy's SetMeshRenderState and DrawMesh, which still read
+ * the mesh and its proxy at draw time: the policies bind per primitive state (uniform buffers, LOD dithering, ...) that
+ * can change without the mesh being re-added, so it is not baked into precomputed draw commands.
  * @param DrawingPolicyType - The drawing policy type used to draw mesh in this draw list.
  * @param HashSize - The number of buckets to use in the drawing policy hash.
  */
@@ -106,16 +110,22 @@ private:
 	};
 
 	/**
-	 * This structure stores the info needed for visibility culling a static mesh element.
+	 * This structure stores the info needed for visibility culling a static mesh element, and what is precomputed for submitting it.
 	 * Stored separately to avoid bringing the other info about non-visible meshes into the cache.
 	 */
 	struct FElementCompact
 	{
-		int32 MeshId;
+		/** Packed with the flag below so the element stays 4 bytes, mesh ids are never negative. */
+		uint32 MeshId : 31;
+		/** Whether the mesh has a single batch element, so its batch visibility doesn't need to be looked up. */
+		uint32 bSingleBatchElement : 1;
 		FElementCompact() {}
-		FElementCompact(int32 InMeshId)
+		FElementCompact(int32 InMeshId, bool bInSingleBatchElement)
 		: MeshId(InMeshId)
-		{}
+		, bSingleBatchElement(bInSingleBatchElement)
+		{
+			checkSlow(InMeshId >= 0);
+		}
 	};
 
 	struct FElement
@@ -170,6 +180,10 @@ private:
 		/** Used when sorting policy links */
 		FSphere						CachedBoundingSphere;
 
+		/** Bounds of all elements, grown as elements are added and rebuilt before sorting after one is removed. */
+		FBoxSphereBounds			CachedBounds;
+		bool						bCachedBoundsDirty;
+
 		/** The id of this link in the draw list's set of drawing policy links. */
 		FSetElementId SetId;
 
@@ -178,6 +192,8 @@ private:
 		/** Initialization constructor. */
 		FDrawingPolicyLink(TStaticMeshDrawList* InDrawList,const DrawingPolicyType& InDrawingPolicy):
 			DrawingPolicy(InDrawingPolicy),
+			CachedBounds(ForceInit),
+			bCachedBoundsDirty(false),
 			DrawList(InDrawList)
 		{
 			CreateBoundShaderState();
@@ -197,6 +213,34 @@ private:
 		{
 			BoundShaderState = DrawingPolicy.CreateBoundShaderState();
 		}
+
+		/** Rebuilds the cached bounds from the elements if any were removed, and updates the bounding sphere from them. */
+		void UpdateCachedBounds()
+		{
+			if (bCachedBoundsDirty)
+			{
+				CachedBounds = Elements.Num() ? Elements[0].Bounds : FBoxSphereBounds(ForceInit);
+				for (int32 ElementIndex = 1; ElementIndex < Elements.Num(); ElementIndex++)
+				{
+					CachedBounds = CachedBounds + Elements[ElementIndex].Bounds;
+				}
+				bCachedBoundsDirty = false;
+			}
+			CachedBoundingSphere = CachedBounds.GetSphere();
+		}
+	};
+
+	/** Key for sorting drawing policy links front to back, background links last. */
+	struct FDrawingPolicySortKey
+	{
+		bool bBackground;
+		float DistanceSquared;
+		FSetElementId SetId;
+
+		FORCEINLINE bool operator<(const FDrawingPolicySortKey& Other) const
+		{
+			return bBackground != Other.bBackground ? Other.bBackground : DistanceSquared < Other.DistanceSquared;
+		}
 	};
 
 	/** Functions to extract the drawing policy from FDrawingPolicyLink as a key for TSet. */
@@ -269,7 +313,10 @@ public:
 	 */
 	int32 DrawVisibleFrontToBack(const FViewInfo& View, const TBitArray<SceneRenderingBitArrayAllocator>& StaticMeshVisibilityMap, const TArray<uint64,SceneRenderingAllocator>& BatchVisibilityArray, int32 MaxToDraw);
 
-	/** Sorts OrderedDrawingPolicies front to back. */
+	/**
+	 * Sorts OrderedDrawingPolicies front to back.
+	 * The order is kept between calls and only adjusted for what moved, so this is cheap while the view moves smoothly.
+	 */
 	void SortFrontToBack(FVector ViewPosition);
 
 	/** Builds a list of primitives that use the given materials in this static draw list. */
@@ -293,9 +340,6 @@ public:
 	// FRenderResource interface.
 	virtual void ReleaseRHI();
 
-	/** Sorts OrderedDrawingPolicies front to back.  Relies on static variables SortDrawingPolicySet and SortViewPosition being set. */
-	static int32 Compare(FSetElementId A, FSetElementId B);
-
 	/** Computes statistics for this draw list. */
 	FDrawListStats GetStats() const;
 
@@ -307,23 +351,11 @@ private:
 	/** All drawing policy element sets in the draw list, hashed by drawing policy. */
 	TDrawingPolicySet DrawingPolicySet;
 
-	/** 
-	 * Static variables for getting data into the Compare function.
-	 * Ideally Sort would accept a non-static member function which would avoid having to go through globals.
-	 */ 
-	static TDrawingPolicySet* SortDrawingPolicySet;
-	static FVector SortViewPosition;
-};
+	/** The view position OrderedDrawingPolicies was last sorted for. */
+	FVector LastSortViewPosition;
 
-/** Helper stuct for sorting */
-template<typename DrawingPolicyType>
-struct TCompareStaticMeshDrawList
-{
-	FORCEINLINE bool operator()( const FSetElementId& A, const FSetElementId& B ) const
-	{
-		// Use static Compare from TStaticMeshDrawList
-		return TStaticMeshDrawList<DrawingPolicyType>::Compare( A, B ) < 0;
-	}
+	/** Set when drawing policies or elements were added or removed since the last sort. */
+	bool bFrontToBackSortDirty;
 };
 
 #include "StaticMeshDrawList.inl"
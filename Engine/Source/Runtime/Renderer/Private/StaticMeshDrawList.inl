@@ -34,6 +34,9 @@ void TStaticMeshDrawList<DrawingPolicyType>::FElementHandle::Remove()
 
 	LocalDrawList->TotalBytesUsed -= DrawingPolicySizeDiff;
 
+	// The bounds can only shrink, so they are rebuilt when the draw list is next sorted
+	LocalDrawingPolicyLink->bCachedBoundsDirty = true;
+	LocalDrawList->bFrontToBackSortDirty = true;
 
 	if (LocalElementIndex < LocalDrawingPolicyLink->Elements.Num())
 	{
@@ -147,13 +150,22 @@ void TStaticMeshDrawList<DrawingPolicyType>::AddMesh(
 	const SIZE_T PreviousElementsSize = DrawingPolicyLink->Elements.GetAllocatedSize();
 	const SIZE_T PreviousCompactElementsSize = DrawingPolicyLink->CompactElements.GetAllocatedSize();
 	FElement* Element = new(DrawingPolicyLink->Elements) FElement(Mesh, PolicyData, this, DrawingPolicyLink->SetId, ElementIndex);
-	new(DrawingPolicyLink->CompactElements) FElementCompact(Mesh->Id);
+	new(DrawingPolicyLink->CompactElements) FElementCompact(Mesh->Id, Mesh->Elements.Num() == 1);
 	TotalBytesUsed += DrawingPolicyLink->Elements.GetAllocatedSize() - PreviousElementsSize + DrawingPolicyLink->CompactElements.GetAllocatedSize() - PreviousCompactElementsSize;
 	Mesh->LinkDrawList(Element->Handle);
+
+	// Grow the drawing policy's bounds, unless they will be rebuilt from all elements anyway
+	if (!DrawingPolicyLink->bCachedBoundsDirty)
+	{
+		DrawingPolicyLink->CachedBounds = ElementIndex == 0 ? Element->Bounds : DrawingPolicyLink->CachedBounds + Element->Bounds;
+	}
+	bFrontToBackSortDirty = true;
 }
 
 template<typename DrawingPolicyType>
 TStaticMeshDrawList<DrawingPolicyType>::TStaticMeshDrawList()
+	: LastSortViewPosition(0)
+	, bFrontToBackSortDirty(false)
 {
 	if(IsInRenderingThread())
 	{
@@ -208,7 +220,6 @@ bool TStaticMeshDrawList<DrawingPolicyType>::DrawVisible(
 		bool bDrawnShared = false;
 		FPlatformMisc::Prefetch(DrawingPolicyLink->CompactElements.GetTypedData());
 		const int32 NumElements = DrawingPolicyLink->Elements.Num();
-		FPlatformMisc::Prefetch(&DrawingPolicyLink->CompactElements.GetTypedData()->MeshId);
 		const FElementCompact* CompactElementPtr = DrawingPolicyLink->CompactElements.GetTypedData();
 		for(int32 ElementIndex = 0; ElementIndex < NumElements; ElementIndex++, CompactElementPtr++)
 		{
@@ -217,7 +228,7 @@ bool TStaticMeshDrawList<DrawingPolicyType>::DrawVisible(
 				const FElement& Element = DrawingPolicyLink->Elements[ElementIndex];
 				INC_DWORD_STAT_BY(STAT_StaticMeshTriangles,Element.Mesh->GetNumPrimitives());
 				// Avoid the virtual call looking up batch visibility if there is only one element.
-				uint32 BatchElementMask = Element.Mesh->Elements.Num() == 1 ? 1 : Element.Mesh->VertexFactory->GetStaticBatchElementVisibility(View,Element.Mesh);
+				uint32 BatchElementMask = CompactElementPtr->bSingleBatchElement ? 1 : Element.Mesh->VertexFactory->GetStaticBatchElementVisibility(View,Element.Mesh);
 				DrawElement(View, Element, BatchElementMask, DrawingPolicyLink, bDrawnShared);
 				bDirty = true;
 			}
@@ -240,7 +251,6 @@ bool TStaticMeshDrawList<DrawingPolicyType>::DrawVisible(
 		bool bDrawnShared = false;
 		FPlatformMisc::Prefetch(DrawingPolicyLink->CompactElements.GetTypedData());
 		const int32 NumElements = DrawingPolicyLink->Elements.Num();
-		FPlatformMisc::Prefetch(&DrawingPolicyLink->CompactElements.GetTypedData()->MeshId);
 		const FElementCompact* CompactElementPtr = DrawingPolicyLink->CompactElements.GetTypedData();
 		for(int32 ElementIndex = 0; ElementIndex < NumElements; ElementIndex++, CompactElementPtr++)
 		{
@@ -249,7 +259,7 @@ bool TStaticMeshDrawList<DrawingPolicyType>::DrawVisible(
 				const FElement& Element = DrawingPolicyLink->Elements[ElementIndex];
 				INC_DWORD_STAT_BY(STAT_StaticMeshTriangles,Element.Mesh->GetNumPrimitives());
 				// Avoid the cache miss looking up batch visibility if there is only one element.
-				uint64 BatchElementMask = Element.Mesh->Elements.Num() == 1 ? 1 : BatchVisibilityArray[Element.Mesh->Id];
+				uint64 BatchElementMask = CompactElementPtr->bSingleBatchElement ? 1 : BatchVisibilityArray[CompactElementPtr->MeshId];
 				DrawElement(View, Element, BatchElementMask, DrawingPolicyLink, bDrawnShared);
 				bDirty = true;
 			}
@@ -277,7 +287,6 @@ int32 TStaticMeshDrawList<DrawingPolicyType>::DrawVisibleFrontToBack(
 		FVector DrawingPolicyCenter = DrawingPolicyLink->CachedBoundingSphere.Center;
 		FPlatformMisc::Prefetch(DrawingPolicyLink->CompactElements.GetTypedData());
 		const int32 NumElements = DrawingPolicyLink->Elements.Num();
-		FPlatformMisc::Prefetch(&DrawingPolicyLink->CompactElements.GetTypedData()->MeshId);
 		const FElementCompact* CompactElementPtr = DrawingPolicyLink->CompactElements.GetTypedData();
 		for(int32 ElementIndex = 0; ElementIndex < NumElements; ElementIndex++, CompactElementPtr++)
 		{
@@ -320,64 +329,59 @@ int32 TStaticMeshDrawList<DrawingPolicyType>::DrawVisibleFrontToBack(
 }
 
 template<typename DrawingPolicyType>
-FVector TStaticMeshDrawList<DrawingPolicyType>::SortViewPosition = FVector(0);
-
-template<typename DrawingPolicyType>
-typename TStaticMeshDrawList<DrawingPolicyType>::TDrawingPolicySet* TStaticMeshDrawList<DrawingPolicyType>::SortDrawingPolicySet;
-
-template<typename DrawingPolicyType>
-int32 TStaticMeshDrawList<DrawingPolicyType>::Compare(FSetElementId A, FSetElementId B)
+void TStaticMeshDrawList<DrawingPolicyType>::SortFrontToBack(FVector ViewPosition)
 {
-	const FSphere& BoundsA = (*SortDrawingPolicySet)(A).CachedBoundingSphere;
-	const FSphere& BoundsB = (*SortDrawingPolicySet)(B).CachedBoundingSphere;
-
-	// Assume state buckets with large bounds are background geometry
-	if (BoundsA.W >= HALF_WORLD_MAX / 2 && BoundsB.W < HALF_WORLD_MAX / 2)
+	// Nothing that affects the order changed since the last sort
+	if (!bFrontToBackSortDirty && ViewPosition == LastSortViewPosition)
 	{
-		return 1;
+		return;
 	}
-	else if (BoundsB.W >= HALF_WORLD_MAX / 2 && BoundsA.W < HALF_WORLD_MAX / 2)
-	{
-		return -1;
-	}
-	else
+
+	const int32 NumDrawingPolicies = OrderedDrawingPolicies.Num();
+	TArray<FDrawingPolicySortKey,SceneRenderingAllocator> SortKeys;
+	SortKeys.AddUninitialized(NumDrawingPolicies);
+
+	for (int32 Index = 0; Index < NumDrawingPolicies; Index++)
 	{
-		const float DistanceASquared = (BoundsA.Center - SortViewPosition).SizeSquared();
-		const float DistanceBSquared = (BoundsB.Center - SortViewPosition).SizeSquared();
-		// Sort front to back
-		return DistanceASquared > DistanceBSquared ? 1 : -1;
+		FDrawingPolicyLink& DrawingPolicyLink = DrawingPolicySet(OrderedDrawingPolicies[Index]);
+		DrawingPolicyLink.UpdateCachedBounds();
+
+		// Assume state buckets with large bounds are background geometry
+		FDrawingPolicySortKey& SortKey = SortKeys[Index];
+		SortKey.bBackground = DrawingPolicyLink.CachedBoundingSphere.W >= HALF_WORLD_MAX / 2;
+		SortKey.DistanceSquared = (DrawingPolicyLink.CachedBoundingSphere.Center - ViewPosition).SizeSquared();
+		SortKey.SetId = OrderedDrawingPolicies[Index];
 	}
-}
 
-template<typename DrawingPolicyType>
-void TStaticMeshDrawList<DrawingPolicyType>::SortFrontToBack(FVector ViewPosition)
-{
-	// Cache policy link bounds
-	for (typename TDrawingPolicySet::TIterator DrawingPolicyIt(DrawingPolicySet); DrawingPolicyIt; ++DrawingPolicyIt)
+	// The order from the last sort is usually close, so an insertion sort only moves a few keys.
+	// Fall back to a full sort when the view jumped and the order changed a lot.
+	const int32 MaxMoves = NumDrawingPolicies * 4;
+	int32 NumMoves = 0;
+	for (int32 Index = 1; Index < NumDrawingPolicies && NumMoves <= MaxMoves; Index++)
 	{
-		FBoxSphereBounds AccumulatedBounds(ForceInit);
-
-		FDrawingPolicyLink& DrawingPolicyLink = *DrawingPolicyIt;
-		for (int32 ElementIndex = 0; ElementIndex < DrawingPolicyLink.Elements.Num(); ElementIndex++)
+		const FDrawingPolicySortKey SortKey = SortKeys[Index];
+		int32 InsertIndex = Index;
+		while (InsertIndex > 0 && SortKey < SortKeys[InsertIndex - 1])
 		{
-			FElement& Element = DrawingPolicyLink.Elements[ElementIndex];
-
-			if (ElementIndex == 0)
-			{
-				AccumulatedBounds = Element.Bounds;
-			}
-			else
-			{
-				AccumulatedBounds = AccumulatedBounds + Element.Bounds;
-			}
+			SortKeys[InsertIndex] = SortKeys[InsertIndex - 1];
+			InsertIndex--;
+			NumMoves++;
 		}
-		DrawingPolicyIt->CachedBoundingSphere = AccumulatedBounds.GetSphere();
+		SortKeys[InsertIndex] = SortKey;
+	}
+
+	if (NumMoves > MaxMoves)
+	{
+		SortKeys.Sort();
 	}
 
-	SortViewPosition = ViewPosition;
-	SortDrawingPolicySet = &DrawingPolicySet;
+	for (int32 Index = 0; Index < NumDrawingPolicies; Index++)
+	{
+		OrderedDrawingPolicies[Index] = SortKeys[Index].SetId;
+	}
 
-	OrderedDrawingPolicies.Sort( TCompareStaticMeshDrawList<DrawingPolicyType>() );
+	LastSortViewPosition = ViewPosition;
+	bFrontToBackSortDirty = false;
 }
 
 template<typename DrawingPolicyType>
@@ -459,6 +463,7 @@ void TStaticMeshDrawList<DrawingPolicyType>::ApplyWorldOffset(FVector InOffset)
 			Element.Bounds.Origin+= InOffset;
 		}
 
+		DrawingPolicyLink.CachedBounds.Origin+= InOffset;
 		DrawingPolicyLink.CachedBoundingSphere.Center+= InOffset;
 	}
 }
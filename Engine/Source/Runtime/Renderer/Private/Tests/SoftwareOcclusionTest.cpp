@@ -0,0 +1,59 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "RendererPrivate.h"
+#include "ScenePrivate.h"
+#include "AutomationTest.h"
+#include "SceneSoftwareOcclusion.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSoftwareOcclusionTest, "Renderer.Software Occlusion", EAutomationTestFlags::ATF_SmokeTest)
+
+bool FSoftwareOcclusionTest::RunTest(const FString& Parameters)
+{
+	// Looking down +X from the origin, with the buffer's aspect ratio
+	const FMatrix ViewMatrix(
+		FPlane(0, 0, 1, 0),
+		FPlane(1, 0, 0, 0),
+		FPlane(0, 1, 0, 0),
+		FPlane(0, 0, 0, 1));
+	const FMatrix ProjectionMatrix = FPerspectiveMatrix(PI / 4.0f, FSoftwareOcclusionBuffer::Width, FSoftwareOcclusionBuffer::Height, 10.0f);
+	const FMatrix ViewProjectionMatrix = ViewMatrix * ProjectionMatrix;
+
+	// A wall facing the view, 1000 units away
+	FOccluderMeshData Wall;
+	Wall.Vertices.Add(FVector(1000.0f, -500.0f, -400.0f));
+	Wall.Vertices.Add(FVector(1000.0f, 500.0f, -400.0f));
+	Wall.Vertices.Add(FVector(1000.0f, 500.0f, 400.0f));
+	Wall.Vertices.Add(FVector(1000.0f, -500.0f, 400.0f));
+	const uint32 WallIndices[] = { 0, 1, 2, 0, 2, 3 };
+	Wall.Indices.Append(WallIndices, ARRAY_COUNT(WallIndices));
+
+	FSoftwareOcclusionBuffer Buffer;
+	const FVector Extent(50.0f, 50.0f, 50.0f);
+
+	// Behind the wall, clear of the diagonal seam between its triangles
+	const FVector BehindWall(2000.0f, -250.0f, 250.0f);
+
+	Buffer.Rasterize(false);
+	TestFalse(TEXT("Nothing is occluded by an empty buffer"), Buffer.IsOccluded(ViewProjectionMatrix, FVector(2000.0f, 0.0f, 0.0f), Extent));
+
+	TestEqual(TEXT("Both wall triangles are added"), Buffer.AddOccluder(ViewProjectionMatrix, Wall), 2);
+	Buffer.Rasterize(false);
+
+	TestTrue(TEXT("A box behind the wall is occluded"), Buffer.IsOccluded(ViewProjectionMatrix, BehindWall, Extent));
+	TestFalse(TEXT("A box behind the seam between the wall's triangles is not occluded, as neither triangle covers the pixels along it"), Buffer.IsOccluded(ViewProjectionMatrix, FVector(2000.0f, 0.0f, 0.0f), Extent));
+	TestFalse(TEXT("A box in front of the wall is not occluded"), Buffer.IsOccluded(ViewProjectionMatrix, FVector(500.0f, 0.0f, 0.0f), Extent));
+	TestFalse(TEXT("A box beside the wall is not occluded"), Buffer.IsOccluded(ViewProjectionMatrix, FVector(2000.0f, 1500.0f, 0.0f), Extent));
+	TestFalse(TEXT("A box crossing the near plane is not occluded"), Buffer.IsOccluded(ViewProjectionMatrix, FVector(0.0f, 0.0f, 0.0f), Extent));
+
+	// The wall seen from behind still occludes, and rasterizing the bins in parallel gives the same result
+	Buffer.Reset();
+	const uint32 FlippedWallIndices[] = { 0, 2, 1, 0, 3, 2 };
+	Wall.Indices.Reset();
+	Wall.Indices.Append(FlippedWallIndices, ARRAY_COUNT(FlippedWallIndices));
+	Buffer.AddOccluder(ViewProjectionMatrix, Wall);
+	Buffer.Rasterize(true);
+
+	TestTrue(TEXT("A box behind a back facing wall is occluded"), Buffer.IsOccluded(ViewProjectionMatrix, BehindWall, Extent));
+
+	return true;
+}
@@ -232,6 +232,116 @@ bool FSocketBSD::Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketRe
 }
 
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_RECVMMSG
+
+/** Max number of datagrams handed to a single sendmmsg or recvmmsg call */
+#define MAX_DATAGRAMS_PER_SYSCALL 64
+
+int32 FSocketBSD::SendToMulti(FSocketDatagram* Datagrams, int32 NumDatagrams)
+{
+	mmsghdr Headers[MAX_DATAGRAMS_PER_SYSCALL];
+	iovec Buffers[MAX_DATAGRAMS_PER_SYSCALL];
+
+	int32 NumSent = 0;
+	int32 First = 0;
+	while (First < NumDatagrams)
+	{
+		const int32 Count = FMath::Min(NumDatagrams - First, MAX_DATAGRAMS_PER_SYSCALL);
+		FMemory::Memzero(Headers, sizeof(mmsghdr) * Count);
+		for (int32 Index = 0; Index < Count; Index++)
+		{
+			FSocketDatagram& Datagram = Datagrams[First + Index];
+			Buffers[Index].iov_base = Datagram.Data;
+			Buffers[Index].iov_len = Datagram.Size;
+			Headers[Index].msg_hdr.msg_name = (sockaddr*)(FInternetAddrBSD&)*Datagram.Address;
+			Headers[Index].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			Headers[Index].msg_hdr.msg_iov = &Buffers[Index];
+			Headers[Index].msg_hdr.msg_iovlen = 1;
+		}
+
+		// Sends datagrams in order, until all of them are sent or one fails
+		const int32 Result = sendmmsg(Socket, Headers, Count, 0);
+		if (Result > 0)
+		{
+			for (int32 Index = 0; Index < Result; Index++)
+			{
+				Datagrams[First + Index].BytesTransferred = Headers[Index].msg_len;
+			}
+			NumSent += Result;
+			First += Result;
+		}
+		else
+		{
+			check(SocketSubsystem);
+			const ESocketErrors Error = SocketSubsystem->GetLastErrorCode();
+
+			if (Error == SE_EINTR)
+			{
+				// Interrupted before anything was sent, try the same datagrams again
+				continue;
+			}
+
+			if (Error == SE_EWOULDBLOCK)
+			{
+				// The send buffer is full, so none of the remaining datagrams can go out either
+				for (int32 Index = First; Index < NumDatagrams; Index++)
+				{
+					Datagrams[Index].BytesTransferred = -1;
+				}
+				break;
+			}
+
+			// Only the first datagram of the batch is at fault (bad address, too large, ...), skip it so the ones after it still go out
+			Datagrams[First].BytesTransferred = -1;
+			First++;
+		}
+	}
+
+	if (NumSent > 0)
+	{
+		LastActivityTime = FDateTime::UtcNow();
+	}
+	return NumSent;
+}
+
+
+int32 FSocketBSD::RecvFromMulti(FSocketDatagram* Datagrams, int32 NumDatagrams, ESocketReceiveFlags::Type Flags)
+{
+	mmsghdr Headers[MAX_DATAGRAMS_PER_SYSCALL];
+	iovec Buffers[MAX_DATAGRAMS_PER_SYSCALL];
+
+	const int32 Count = FMath::Min(NumDatagrams, MAX_DATAGRAMS_PER_SYSCALL);
+	FMemory::Memzero(Headers, sizeof(mmsghdr) * Count);
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		FSocketDatagram& Datagram = Datagrams[Index];
+		Buffers[Index].iov_base = Datagram.Data;
+		Buffers[Index].iov_len = Datagram.Size;
+		Headers[Index].msg_hdr.msg_name = (sockaddr*)(FInternetAddrBSD&)*Datagram.Address;
+		Headers[Index].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		Headers[Index].msg_hdr.msg_iov = &Buffers[Index];
+		Headers[Index].msg_hdr.msg_iovlen = 1;
+	}
+
+	// Without MSG_WAITFORONE, this returns whatever is queued on the socket, up to Count datagrams
+	const int32 Result = recvmmsg(Socket, Headers, Count, Flags, NULL);
+	if (Result <= 0)
+	{
+		return -1;
+	}
+
+	for (int32 Index = 0; Index < Result; Index++)
+	{
+		Datagrams[Index].BytesTransferred = Headers[Index].msg_len;
+	}
+
+	LastActivityTime = FDateTime::UtcNow();
+	return Result;
+}
+
+#endif
+
+
 bool FSocketBSD::Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime)
 {
 	if ((Condition == ESocketWaitConditions::WaitForRead) || (Condition == ESocketWaitConditions::WaitForReadOrWrite))
@@ -87,6 +87,17 @@ public:
 
 	virtual bool Recv(uint8* Data,int32 BufferSize,int32& BytesRead, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None) OVERRIDE;
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_RECVMMSG
+	virtual int32 SendToMulti(FSocketDatagram* Datagrams, int32 NumDatagrams) OVERRIDE;
+
+	virtual int32 RecvFromMulti(FSocketDatagram* Datagrams, int32 NumDatagrams, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None) OVERRIDE;
+
+	virtual bool HasNativeDatagramBatching() OVERRIDE
+	{
+		return true;
+	}
+#endif
+
 	virtual bool Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime) OVERRIDE;
 
 	virtual ESocketConnectionState GetConnectionState() OVERRIDE;
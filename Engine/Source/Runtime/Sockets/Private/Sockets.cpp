@@ -41,4 +41,33 @@ bool FSocket::Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketRecei
 		UE_LOG(LogSockets, Verbose, TEXT("Socket '%s' Recv %i Bytes"), *SocketDescription, BytesRead );
 	}
 	return true;
-}
\ No newline at end of file
+}
+
+int32 FSocket::SendToMulti(FSocketDatagram* Datagrams, int32 NumDatagrams)
+{
+	int32 NumSent = 0;
+	for (int32 Index = 0; Index < NumDatagrams; Index++)
+	{
+		FSocketDatagram& Datagram = Datagrams[Index];
+		if (SendTo(Datagram.Data, Datagram.Size, Datagram.BytesTransferred, *Datagram.Address))
+		{
+			NumSent++;
+		}
+		else
+		{
+			Datagram.BytesTransferred = -1;
+		}
+	}
+	return NumSent;
+}
+
+
+int32 FSocket::RecvFromMulti(FSocketDatagram* Datagrams, int32 NumDatagrams, ESocketReceiveFlags::Type Flags)
+{
+	// Only read a single datagram, so an error is reported right after the datagrams that came before it
+	if (NumDatagrams > 0 && RecvFrom(Datagrams[0].Data, Datagrams[0].Size, Datagrams[0].BytesTransferred, *Datagrams[0].Address, Flags))
+	{
+		return 1;
+	}
+	return -1;
+}
@@ -6,6 +6,32 @@
 #include "IPAddress.h"
 #include "SocketTypes.h"
 
+/**
+ * A single datagram of FSocket::SendToMulti or FSocket::RecvFromMulti
+ */
+struct FSocketDatagram
+{
+	/** The data to send, or the buffer to receive into */
+	uint8* Data;
+
+	/** The number of bytes to send, or the size of the receive buffer */
+	int32 Size;
+
+	/** Out param indicating how many bytes were sent or received, -1 if the datagram couldn't be sent */
+	int32 BytesTransferred;
+
+	/** The network byte ordered address to send to, or out param receiving the address of the sender */
+	FInternetAddr* Address;
+
+	FSocketDatagram()
+		: Data(NULL)
+		, Size(0)
+		, BytesTransferred(0)
+		, Address(NULL)
+	{
+	}
+};
+
 /**
  * This is our abstract base class that hides the platform specific socket implementation
  */
@@ -155,6 +181,38 @@ public:
 	 */
 	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None);
 
+	/**
+	 * Sends several datagrams, each one to its own network byte ordered address.
+	 * Datagrams that can't be sent are skipped, the others are still sent. If the socket would block,
+	 * that datagram and all the ones after it are reported as failed.
+	 *
+	 * @param Datagrams the datagrams to send, BytesTransferred is set for each of them
+	 * @param NumDatagrams the number of datagrams to send
+	 *
+	 * @return the number of datagrams that were sent
+	 */
+	virtual int32 SendToMulti(FSocketDatagram* Datagrams, int32 NumDatagrams);
+
+	/**
+	 * Reads up to NumDatagrams datagrams from the socket, along with their source addresses
+	 *
+	 * @param Datagrams the buffers to read into, BytesTransferred and Address are set for each datagram received
+	 * @param NumDatagrams the max number of datagrams to read
+	 * @param Flags the receive flags
+	 *
+	 * @return the number of datagrams read, or -1 if nothing could be read (use the socket subsystem to get the error)
+	 */
+	virtual int32 RecvFromMulti(FSocketDatagram* Datagrams, int32 NumDatagrams, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None);
+
+	/**
+	 * @return true if SendToMulti and RecvFromMulti handle several datagrams per system call,
+	 *         otherwise they fall back to a SendTo or RecvFrom call per datagram
+	 */
+	virtual bool HasNativeDatagramBatching()
+	{
+		return false;
+	}
+
 	/**
 	 * Blocks until the specified condition is met.
 	 *